@@ -230,6 +230,30 @@ int msg_send(msg_t *m, kernel_pid_t target_pid);
  */
 int msg_try_send(msg_t *m, kernel_pid_t target_pid);
 
+/**
+ * @brief Send a batch of messages (non-blocking).
+ *
+ * This function sends up to @p n messages to another thread under a single
+ * IRQ lock. If the receiver is waiting, the first message is delivered
+ * directly, all others are put into the receiver's message queue until it is
+ * full. The receiver is woken up at most once, causing at most one context
+ * switch (if it has a higher priority than the sender). This function never
+ * blocks and can also be called from ISR context.
+ *
+ * Sending messages one by one, the same messages would be received in the
+ * same order.
+ *
+ * @param[in] m             Array of @p n preallocated ``msg_t`` structures,
+ *                          their sender_pid fields are overwritten
+ * @param[in] n             Number of messages in @p m
+ * @param[in] target_pid    PID of target thread
+ *
+ * @return number of messages delivered (the first ones of @p m), 0 if the
+ *         receiver is not waiting and its queue is full (or inexistent)
+ * @return -1, on error (invalid PID)
+ */
+int msg_send_batch(msg_t *m, unsigned n, kernel_pid_t target_pid);
+
 /**
  * @brief Send a message to the current thread.
  * @details Will work only if the thread has a message queue.
@@ -307,6 +331,34 @@ int msg_receive(msg_t *m);
  */
 int msg_try_receive(msg_t *m);
 
+/**
+ * @brief Receive a batch of messages.
+ *
+ * This function blocks until at least one message was received, then takes
+ * up to @p max messages out of the message queue and from threads blocked in
+ * @ref msg_send under a single IRQ lock. All senders that are unblocked by
+ * this cause at most one context switch.
+ *
+ * @param[out] m    Array of @p max preallocated ``msg_t`` structures
+ * @param[in]  max  Maximum number of messages to receive, must not be 0
+ *
+ * @return  number of messages received (at least 1)
+ */
+int msg_receive_batch(msg_t *m, unsigned max);
+
+/**
+ * @brief Try to receive a batch of messages.
+ *
+ * Like @ref msg_receive_batch, but does not block if no message can be
+ * received.
+ *
+ * @param[out] m    Array of @p max preallocated ``msg_t`` structures
+ * @param[in]  max  Maximum number of messages to receive
+ *
+ * @return  number of messages received, 0 if there was none
+ */
+int msg_try_receive_batch(msg_t *m, unsigned max);
+
 /**
  * @brief Send a message, block until reply received.
  *
@@ -91,6 +91,39 @@
  *       `MUTEX_LOCK`.
  *     - The scheduler is run, so that if the unblocked waiting thread can
  *       run now, in case it has a higher priority than the running thread.
+ *
+ * Priority Inheritance
+ * --------------------
+ *
+ * Waiters are woken in priority order, but by default the thread holding a
+ * mutex keeps its priority. A high priority thread waiting for a mutex held by
+ * a low priority thread is therefore also delayed by every thread of medium
+ * priority (priority inversion, see `tests/thread_priority_inversion`).
+ *
+ * With the module `core_mutex_priority_inheritance`, a mutex remembers the
+ * thread that locked it. That thread runs at the highest priority of its own
+ * and of the first waiter of every mutex it holds:
+ *
+ * 1. When a thread blocks on a mutex, the owner is boosted to its priority. If
+ *    the owner itself is blocked on a mutex, it is moved to its new position
+ *    in that wait queue and the boost is passed on to the next owner, so
+ *    nested locks are covered.
+ * 2. When a mutex is unlocked, it is removed from the mutexes held by its
+ *    owner, and the priority of the owner is recomputed from the remaining
+ *    ones. The woken waiter becomes the new owner.
+ * 3. When a @ref mutex_lock_cancelable is cancelled, the owner is deboosted
+ *    accordingly.
+ *
+ * All of this happens with IRQs disabled. The time spent is bounded by the
+ * length of the chain of blocked owners times the number of mutexes held by
+ * each of them, which are both small in practice. Mutexes locked by
+ * @ref MUTEX_INIT_LOCKED or unlocked by a different thread than the one
+ * locking them (e.g. used for signaling) work as before, but a mutex that
+ * was locked statically or with @ref mutex_trylock from an ISR has no owner
+ * to boost.
+ *
+ * The module adds a PID and a pointer to every `mutex_t` and three fields to
+ * every `thread_t`.
  * @{
  *
  * @file
@@ -120,13 +153,25 @@ extern "C" {
 /**
  * @brief Mutex structure. Must never be modified by the user.
  */
-typedef struct {
+typedef struct mutex {
     /**
      * @brief   The process waiting queue of the mutex. **Must never be changed
      *          by the user.**
      * @internal
      */
     list_node_t queue;
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    /**
+     * @brief   The thread holding the mutex, or `KERNEL_PID_UNDEF`
+     * @internal
+     */
+    kernel_pid_t owner;
+    /**
+     * @brief   The next mutex held by @ref mutex_t::owner
+     * @internal
+     */
+    struct mutex *next_held;
+#endif
 } mutex_t;
 
 /**
@@ -145,12 +190,12 @@ typedef struct {
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
-#define MUTEX_INIT { { NULL } }
+#define MUTEX_INIT { .queue = { .next = NULL } }
 
 /**
  * @brief Static initializer for mutex_t with a locked mutex
  */
-#define MUTEX_INIT_LOCKED { { MUTEX_LOCKED } }
+#define MUTEX_INIT_LOCKED { .queue = { .next = MUTEX_LOCKED } }
 
 /**
  * @cond INTERNAL
@@ -171,6 +216,10 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#if IS_USED(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE)
+    mutex->owner = KERNEL_PID_UNDEF;
+    mutex->next_held = NULL;
+#endif
 }
 
 /**
@@ -231,6 +280,15 @@ static inline int mutex_trylock(mutex_t *mutex)
 
     if (mutex->queue.next == NULL) {
         mutex->queue.next = MUTEX_LOCKED;
+#if IS_USED(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE)
+        /* an ISR does not own the thread it interrupted */
+        if (!irq_is_in()) {
+            thread_t *me = thread_get_active();
+            mutex->owner = me->pid;
+            mutex->next_held = me->held_mutexes;
+            me->held_mutexes = mutex;
+        }
+#endif
         retval = 1;
     }
     irq_restore(irq_state);
@@ -160,6 +160,42 @@ int ringbuffer_peek_one(const ringbuffer_t *__restrict rb);
 unsigned ringbuffer_peek(const ringbuffer_t *__restrict rb, char *buf,
                          unsigned n);
 
+/**
+ * @brief           Get the contiguous free space after the last element.
+ * @details         Up to the returned number of elements may be written to
+ *                  @p span directly and added with ringbuffer_commit().
+ *                  If less space is returned than ringbuffer_get_free(), call
+ *                  this function again after committing to get the part that
+ *                  wraps around.
+ * @param[in,out]   rb     Ringbuffer to operate on.
+ * @param[out]      span   Start of the free space.
+ * @returns         Number of elements that can be written to @p span, 0 iff
+ *                  rb is full.
+ */
+unsigned ringbuffer_reserve(ringbuffer_t *__restrict rb, char **span);
+
+/**
+ * @brief           Add elements written to the span of ringbuffer_reserve().
+ * @param[in,out]   rb    Ringbuffer to operate on.
+ * @param[in]       n     Number of elements written, at most the value
+ *                        returned by ringbuffer_reserve().
+ */
+void ringbuffer_commit(ringbuffer_t *__restrict rb, unsigned n);
+
+/**
+ * @brief           Get the contiguous elements at the start of the buffer,
+ *                  without removing them.
+ * @details         Up to the returned number of elements may be read from
+ *                  @p span directly and then be removed with
+ *                  ringbuffer_remove().
+ * @param[in]       rb     Ringbuffer to operate on.
+ * @param[out]      span   Start of the oldest element.
+ * @returns         Number of elements that can be read from @p span, 0 iff
+ *                  rb is empty.
+ */
+unsigned ringbuffer_peek_span(const ringbuffer_t *__restrict rb,
+                              const char **span);
+
 #ifdef __cplusplus
 }
 #endif
@@ -221,6 +221,25 @@ void sched_set_status(thread_t *process, thread_status_t status);
  */
 void sched_switch(uint16_t other_prio);
 
+/**
+ * @brief       Change the priority of the given thread
+ *
+ * If @p thread is on a run queue, it is moved to the run queue of
+ * @p priority. The running thread stays at the head of its new run queue.
+ *
+ * @note        This function does not yield. Call @ref sched_switch or
+ *              @ref thread_yield_higher afterwards if the change may require
+ *              a context switch.
+ * @note        Used by `core_mutex_priority_inheritance`. Threads blocked on
+ *              a mutex are *not* resorted in its wait queue by this function.
+ *
+ * @pre         IRQs are disabled
+ *
+ * @param[in,out]   thread      thread to change the priority of
+ * @param[in]       priority    new priority, less than @ref SCHED_PRIO_LEVELS
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+
 /**
  * @brief   Call context switching at thread exit
  */
@@ -287,6 +306,24 @@ typedef void (*sched_callback_t)(kernel_pid_t active, kernel_pid_t next);
 void sched_register_cb(sched_callback_t callback);
 #endif /* MODULE_SCHED_CB */
 
+#if IS_USED(MODULE_SCHED_WAKE_CALLBACK) || defined(DOXYGEN)
+/**
+ * @brief   Scheduler wake up callback
+ *
+ * @details Function has to be provided by the user of this API.
+ *          It will be called with interrupts disabled whenever a thread
+ *          that was not runnable enters its runqueue (e.g. because it got
+ *          unblocked or was just created).
+ *
+ * @warning This API is not intended for out of tree users.
+ *          Breaking API changes will be done without notice and
+ *          without deprecation. Consider yourself warned!
+ *
+ * @param   pid       the pid of the thread that became runnable
+ */
+extern void sched_wake_callback(kernel_pid_t pid);
+#endif
+
 /**
  * @brief   Advance a runqueue
  *
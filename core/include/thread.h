@@ -196,6 +196,11 @@ struct _thread {
     msg_t *msg_array;               /**< memory holding messages sent
                                          to this thread's message queue */
 #endif
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    uint8_t base_priority;          /**< priority without inherited boost */
+    struct mutex *held_mutexes;     /**< mutexes held by this thread    */
+    struct mutex *blocked_on;       /**< mutex this thread waits for    */
+#endif
 #if defined(DEVELHELP) || IS_ACTIVE(SCHED_TEST_STACK) \
     || defined(MODULE_MPU_STACK_GUARD) || defined(DOXYGEN)
     char *stack_start;              /**< thread's stack start address   */
@@ -177,6 +177,50 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block,
     return 1;
 }
 
+int msg_send_batch(msg_t *m, unsigned n, kernel_pid_t target_pid)
+{
+    kernel_pid_t sender_pid = irq_is_in() ? KERNEL_PID_ISR : thread_getpid();
+
+    for (unsigned i = 0; i < n; i++) {
+        m[i].sender_pid = sender_pid;
+    }
+
+    unsigned state = irq_disable();
+    thread_t *target = thread_get_unchecked(target_pid);
+
+    if (target == NULL) {
+        DEBUG("msg_send_batch(): target thread %d does not exist\n",
+              target_pid);
+        irq_restore(state);
+        return -1;
+    }
+
+    bool was_blocked = target->status < STATUS_ON_RUNQUEUE;
+    unsigned sent = 0;
+
+    if ((n > 0) && (target->status == STATUS_RECEIVE_BLOCKED)) {
+        DEBUG("msg_send_batch(): direct msg copy to %" PRIkernel_pid ".\n",
+              target_pid);
+        *(msg_t *)target->wait_data = m[0];
+        sched_set_status(target, STATUS_PENDING);
+        sent = 1;
+    }
+    while ((sent < n) && queue_msg(target, &m[sent])) {
+        sent++;
+    }
+
+    /* the target might also have been woken up waiting for thread flags */
+    bool woken = was_blocked && (target->status >= STATUS_ON_RUNQUEUE);
+    uint16_t target_prio = target->priority;
+
+    irq_restore(state);
+    if (woken) {
+        sched_switch(target_prio);
+    }
+
+    return sent;
+}
+
 int msg_send_to_self(msg_t *m)
 {
     unsigned state = irq_disable();
@@ -433,6 +477,67 @@ static int _msg_receive(msg_t *m, int block)
     DEBUG("This should have never been reached!\n");
 }
 
+int msg_try_receive_batch(msg_t *m, unsigned max)
+{
+    unsigned state = irq_disable();
+    thread_t *me = thread_get_active();
+    uint16_t sender_prio = THREAD_PRIORITY_IDLE;
+    unsigned n = 0;
+
+    /* queued messages are older than those of blocked senders */
+    if (thread_has_msg_queue(me)) {
+        int queue_index;
+        while ((n < max) &&
+               ((queue_index = cib_get(&(me->msg_queue))) >= 0)) {
+            m[n++] = me->msg_array[queue_index];
+        }
+    }
+
+    while (n < max) {
+        list_node_t *next = list_remove_head(&me->msg_waiters);
+        if (next == NULL) {
+            break;
+        }
+
+        thread_t *sender =
+            container_of((clist_node_t *)next, thread_t, rq_entry);
+        m[n++] = *(msg_t *)sender->wait_data;
+
+        if (sender->status != STATUS_REPLY_BLOCKED) {
+            sender->wait_data = NULL;
+            sched_set_status(sender, STATUS_PENDING);
+            if (sender->priority < sender_prio) {
+                sender_prio = sender->priority;
+            }
+        }
+    }
+
+    DEBUG("msg_try_receive_batch: %" PRIkernel_pid ": got %u messages.\n",
+          thread_getpid(), n);
+
+    irq_restore(state);
+    if (sender_prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(sender_prio);
+    }
+
+    return n;
+}
+
+int msg_receive_batch(msg_t *m, unsigned max)
+{
+    assert(max > 0);
+
+    int n = msg_try_receive_batch(m, max);
+
+    if (n == 0) {
+        /* block for the first message, then take what else is there */
+        _msg_receive(m, 1);
+        n = 1 + msg_try_receive_batch(m + 1, max - 1);
+    }
+
+    return n;
+}
+
 unsigned msg_avail(void)
 {
     DEBUG("msg_available: %" PRIkernel_pid ": msg_available.\n",
@@ -33,6 +33,162 @@
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
+/**
+ * @brief   Insert @p thread into the wait queue of @p mutex, sorted by
+ *          priority
+ * @pre     IRQs are disabled
+ * @pre     @p mutex is locked
+ */
+static void _enqueue(mutex_t *mutex, thread_t *thread)
+{
+    if (mutex->queue.next == MUTEX_LOCKED) {
+        mutex->queue.next = (list_node_t *)&thread->rq_entry;
+        mutex->queue.next->next = NULL;
+    }
+    else {
+        thread_add_to_list(&mutex->queue, thread);
+    }
+}
+
+#if IS_USED(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE)
+/**
+ * @brief   Get the priority @p thread has to run at: the highest of its base
+ *          priority and the priorities of the first waiters of all mutexes it
+ *          holds
+ */
+static uint8_t _pi_priority(thread_t *thread)
+{
+    uint8_t prio = thread->base_priority;
+
+    for (mutex_t *m = thread->held_mutexes; m; m = m->next_held) {
+        if ((m->queue.next != NULL) && (m->queue.next != MUTEX_LOCKED)) {
+            /* the wait queue is sorted, the first waiter has the highest
+             * priority */
+            thread_t *waiter = container_of((clist_node_t *)m->queue.next,
+                                            thread_t, rq_entry);
+            if (waiter->priority < prio) {
+                prio = waiter->priority;
+            }
+        }
+    }
+
+    return prio;
+}
+
+/**
+ * @brief   Update the priority of @p thread and pass the change on along the
+ *          chain of mutex owners @p thread is (transitively) waiting for
+ * @pre     IRQs are disabled
+ */
+static void _pi_update(thread_t *thread)
+{
+    while (thread) {
+        uint8_t prio = _pi_priority(thread);
+
+        if (prio == thread->priority) {
+            return;
+        }
+        DEBUG("PID[%" PRIkernel_pid "] mutex: priority of %" PRIkernel_pid
+              " %" PRIu8 " -> %" PRIu8 "\n", thread_getpid(), thread->pid,
+              thread->priority, prio);
+        sched_change_priority(thread, prio);
+
+        mutex_t *mutex = thread->blocked_on;
+        if (mutex == NULL) {
+            return;
+        }
+        /* keep the wait queue sorted */
+        list_remove(&mutex->queue, (list_node_t *)&thread->rq_entry);
+        if (mutex->queue.next == NULL) {
+            mutex->queue.next = MUTEX_LOCKED;
+        }
+        _enqueue(mutex, thread);
+        thread = thread_get(mutex->owner);
+    }
+}
+
+/**
+ * @brief   Make @p thread the owner of @p mutex
+ * @pre     IRQs are disabled
+ */
+static void _pi_acquired(mutex_t *mutex, thread_t *thread)
+{
+    thread->blocked_on = NULL;
+    mutex->owner = thread->pid;
+    mutex->next_held = thread->held_mutexes;
+    thread->held_mutexes = mutex;
+    /* inherit the priority of the remaining waiters, if any */
+    _pi_update(thread);
+}
+
+/**
+ * @brief   Remove the owner of @p mutex and drop what it inherited through it
+ * @pre     IRQs are disabled
+ */
+static void _pi_released(mutex_t *mutex)
+{
+    thread_t *owner = thread_get(mutex->owner);
+
+    mutex->owner = KERNEL_PID_UNDEF;
+    if (owner == NULL) {
+        return;
+    }
+    for (mutex_t **m = &owner->held_mutexes; *m; m = &(*m)->next_held) {
+        if (*m == mutex) {
+            *m = mutex->next_held;
+            break;
+        }
+    }
+    mutex->next_held = NULL;
+    _pi_update(owner);
+}
+
+/**
+ * @brief   Boost the owner of @p mutex, @p thread was just added to the wait
+ *          queue of @p mutex
+ * @pre     IRQs are disabled
+ */
+static void _pi_blocked(mutex_t *mutex, thread_t *thread)
+{
+    thread->blocked_on = mutex;
+    _pi_update(thread_get(mutex->owner));
+}
+
+/**
+ * @brief   Deboost the owner of @p mutex, @p thread was just removed from the
+ *          wait queue without getting the mutex
+ * @pre     IRQs are disabled
+ */
+static void _pi_cancelled(mutex_t *mutex, thread_t *thread)
+{
+    thread->blocked_on = NULL;
+    _pi_update(thread_get(mutex->owner));
+}
+#else
+static inline void _pi_acquired(mutex_t *mutex, thread_t *thread)
+{
+    (void)mutex;
+    (void)thread;
+}
+
+static inline void _pi_released(mutex_t *mutex)
+{
+    (void)mutex;
+}
+
+static inline void _pi_blocked(mutex_t *mutex, thread_t *thread)
+{
+    (void)mutex;
+    (void)thread;
+}
+
+static inline void _pi_cancelled(mutex_t *mutex, thread_t *thread)
+{
+    (void)mutex;
+    (void)thread;
+}
+#endif
+
 /**
  * @brief   Block waiting for a locked mutex
  * @pre     IRQs are disabled
@@ -56,13 +212,8 @@ static inline __attribute__((always_inline)) void _block(mutex_t *mutex,
     DEBUG("PID[%" PRIkernel_pid "] mutex_lock() Adding node to mutex queue: "
           "prio: %" PRIu32 "\n", thread_getpid(), (uint32_t)me->priority);
     sched_set_status(me, STATUS_MUTEX_BLOCKED);
-    if (mutex->queue.next == MUTEX_LOCKED) {
-        mutex->queue.next = (list_node_t *)&me->rq_entry;
-        mutex->queue.next->next = NULL;
-    }
-    else {
-        thread_add_to_list(&mutex->queue, me);
-    }
+    _enqueue(mutex, me);
+    _pi_blocked(mutex, me);
 
     irq_restore(irq_state);
     thread_yield_higher();
@@ -78,6 +229,7 @@ void mutex_lock(mutex_t *mutex)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+        _pi_acquired(mutex, thread_get_active());
         DEBUG("PID[%" PRIkernel_pid "] mutex_lock(): early out.\n",
               thread_getpid());
         irq_restore(irq_state);
@@ -106,6 +258,7 @@ int mutex_lock_cancelable(mutex_cancel_t *mc)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+        _pi_acquired(mutex, thread_get_active());
         DEBUG("PID[%" PRIkernel_pid "] mutex_lock_cancelable() early out.\n",
               thread_getpid());
         irq_restore(irq_state);
@@ -136,6 +289,7 @@ void mutex_unlock(mutex_t *mutex)
 
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
+        _pi_released(mutex);
         /* the mutex was locked and no thread was waiting for it */
         irq_restore(irqstate);
         return;
@@ -147,12 +301,15 @@ void mutex_unlock(mutex_t *mutex)
 
     DEBUG("PID[%" PRIkernel_pid "] mutex_unlock(): waking up waiting thread %"
           PRIkernel_pid "\n", thread_getpid(),  process->pid);
-    sched_set_status(process, STATUS_PENDING);
 
     if (!mutex->queue.next) {
         mutex->queue.next = MUTEX_LOCKED;
     }
 
+    _pi_released(mutex);
+    _pi_acquired(mutex, process);
+    sched_set_status(process, STATUS_PENDING);
+
     uint16_t process_priority = process->priority;
 
     irq_restore(irqstate);
@@ -168,6 +325,7 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
     if (mutex->queue.next) {
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
+            _pi_released(mutex);
         }
         else {
             list_node_t *next = list_remove_head(&mutex->queue);
@@ -175,10 +333,12 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
                                              rq_entry);
             DEBUG("PID[%" PRIkernel_pid "] mutex_unlock_and_sleep(): waking up "
                   "waiter.\n", process->pid);
-            sched_set_status(process, STATUS_PENDING);
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
             }
+            _pi_released(mutex);
+            _pi_acquired(mutex, process);
+            sched_set_status(process, STATUS_PENDING);
         }
     }
 
@@ -212,6 +372,7 @@ void mutex_cancel(mutex_cancel_t *mc)
         if (mutex->queue.next == NULL) {
             mutex->queue.next = MUTEX_LOCKED;
         }
+        _pi_cancelled(mutex, thread);
         sched_set_status(thread, STATUS_PENDING);
         irq_restore(irq_state);
         sched_switch(thread->priority);
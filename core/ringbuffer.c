@@ -18,6 +18,7 @@
 
 #include "ringbuffer.h"
 
+#include <assert.h>
 #include <string.h>
 
 /**
@@ -54,17 +55,41 @@ static char get_head(ringbuffer_t *restrict rb)
     return result;
 }
 
+/**
+ * @brief           Get the position after the last element.
+ * @param[in]       rb   Ringbuffer to operate on.
+ * @returns         Index into rb->buf where the next element is added.
+ */
+static unsigned tail(const ringbuffer_t *restrict rb)
+{
+    unsigned pos = rb->start + rb->avail;
+
+    if (pos >= rb->size) {
+        pos -= rb->size;
+    }
+    return pos;
+}
+
 unsigned ringbuffer_add(ringbuffer_t *restrict rb, const char *buf, unsigned n)
 {
-    unsigned i;
+    unsigned free = rb->size - rb->avail;
 
-    for (i = 0; i < n; i++) {
-        if (ringbuffer_full(rb)) {
-            break;
+    if (n > free) {
+        n = free;
+    }
+    if (n > 0) {
+        unsigned pos = tail(rb);
+        unsigned bytes_till_end = rb->size - pos;
+        if (bytes_till_end >= n) {
+            memcpy(rb->buf + pos, buf, n);
         }
-        add_tail(rb, buf[i]);
+        else {
+            memcpy(rb->buf + pos, buf, bytes_till_end);
+            memcpy(rb->buf, buf + bytes_till_end, n - bytes_till_end);
+        }
+        rb->avail += n;
     }
-    return i;
+    return n;
 }
 
 int ringbuffer_add_one(ringbuffer_t *restrict rb, char c)
@@ -147,3 +172,37 @@ unsigned ringbuffer_peek(const ringbuffer_t *restrict rb_, char *buf,
 
     return ringbuffer_get(&rb, buf, n);
 }
+
+unsigned ringbuffer_reserve(ringbuffer_t *restrict rb, char **span)
+{
+    if (rb->avail == 0) {
+        /* make the whole buffer available as one span */
+        rb->start = 0;
+    }
+
+    unsigned pos = tail(rb);
+    *span = rb->buf + pos;
+
+    if (pos < rb->start) {
+        return rb->start - pos;
+    }
+    else if (ringbuffer_full(rb)) {
+        return 0;
+    }
+    return rb->size - pos;
+}
+
+void ringbuffer_commit(ringbuffer_t *restrict rb, unsigned n)
+{
+    assert(n <= ringbuffer_get_free(rb));
+    rb->avail += n;
+}
+
+unsigned ringbuffer_peek_span(const ringbuffer_t *restrict rb,
+                              const char **span)
+{
+    unsigned bytes_till_end = rb->size - rb->start;
+
+    *span = rb->buf + rb->start;
+    return (rb->avail < bytes_till_end) ? rb->avail : bytes_till_end;
+}
@@ -19,6 +19,7 @@
  * @}
  */
 
+#include <assert.h>
 #include <stdint.h>
 #include <inttypes.h>
 
@@ -229,6 +230,10 @@ void sched_set_status(thread_t *process, thread_status_t status)
                         &(process->rq_entry));
             _set_runqueue_bit(process);
 
+#if (IS_USED(MODULE_SCHED_WAKE_CALLBACK))
+            sched_wake_callback(process->pid);
+#endif
+
             /* some thread entered a runqueue
              * if it is the active runqueue
              * inform the runqueue_change callback */
@@ -285,6 +290,38 @@ void sched_switch(uint16_t other_prio)
     }
 }
 
+void sched_change_priority(thread_t *thread, uint8_t priority)
+{
+    assert(thread && (priority < SCHED_PRIO_LEVELS));
+
+    if (thread->priority == priority) {
+        return;
+    }
+
+    DEBUG("sched_change_priority: thread %" PRIkernel_pid ": %" PRIu8
+          " -> %" PRIu8 "\n", thread->pid, thread->priority, priority);
+
+    if (thread->status >= STATUS_ON_RUNQUEUE) {
+        clist_remove(&sched_runqueues[thread->priority], &thread->rq_entry);
+        if (!sched_runqueues[thread->priority].next) {
+            _clear_runqueue_bit(thread);
+        }
+        thread->priority = priority;
+        /* sched_set_status() expects the running thread at the head of its
+         * run queue */
+        if (thread == thread_get_active()) {
+            clist_lpush(&sched_runqueues[priority], &thread->rq_entry);
+        }
+        else {
+            clist_rpush(&sched_runqueues[priority], &thread->rq_entry);
+        }
+        _set_runqueue_bit(thread);
+    }
+    else {
+        thread->priority = priority;
+    }
+}
+
 NORETURN void sched_task_exit(void)
 {
     DEBUG("sched_task_exit: ending thread %" PRIkernel_pid "...\n",
@@ -292,6 +292,12 @@ kernel_pid_t thread_create(char *stack, int stacksize, uint8_t priority,
 
     thread->rq_entry.next = NULL;
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    thread->base_priority = priority;
+    thread->held_mutexes = NULL;
+    thread->blocked_on = NULL;
+#endif
+
 #ifdef MODULE_CORE_MSG
     thread->wait_data = NULL;
     thread->msg_waiters.next = NULL;
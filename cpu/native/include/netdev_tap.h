@@ -9,6 +9,14 @@
 /**
  * @ingroup     drivers_netdev
  * @brief       Low-level ethernet driver for native tap interfaces
+ *
+ * By default, the driver reads one frame per SIGIO. With the module
+ * `netdev_tap_batch`, it reads all frames available, up to
+ * @ref CONFIG_NETDEV_TAP_RX_BATCH, into a receive buffer on each wakeup and
+ * passes them up one after the other. This saves a signal and a context
+ * switch per frame under load, at the cost of the receive buffer.
+ *
+ * Frames are sent with a single `writev()` of the @ref iolist_t.
  * @{
  *
  * @file
@@ -25,8 +33,11 @@ extern "C" {
 #endif
 
 #include <stdint.h>
+
+#include "kernel_defines.h"
 #include "net/netdev.h"
 
+#include "net/ethernet.h"
 #include "net/ethernet/hdr.h"
 
 #ifdef __MACH__
@@ -35,6 +46,17 @@ extern "C" {
 #include "net/if.h"
 #endif
 
+/**
+ * @brief   Maximum number of frames read from the TAP per wakeup
+ *
+ * Only used with the module `netdev_tap_batch`. Each frame takes
+ * @ref ETHERNET_FRAME_LEN bytes of receive buffer per interface. Must be
+ * between 1 and 255.
+ */
+#ifndef CONFIG_NETDEV_TAP_RX_BATCH
+#define CONFIG_NETDEV_TAP_RX_BATCH  (8U)
+#endif
+
 /**
  * @brief tap interface state
  */
@@ -44,6 +66,14 @@ typedef struct netdev_tap {
     int tap_fd;                         /**< host file descriptor for the TAP */
     uint8_t addr[ETHERNET_ADDR_LEN];    /**< The MAC address of the TAP */
     uint8_t promiscuous;                 /**< Flag for promiscuous mode */
+#if IS_USED(MODULE_NETDEV_TAP_BATCH) || defined(DOXYGEN)
+    uint8_t rx_head;                    /**< next frame in rx_buf to pass up */
+    uint8_t rx_num;                     /**< number of frames in rx_buf */
+    uint16_t rx_len[CONFIG_NETDEV_TAP_RX_BATCH];    /**< length of the frames
+                                                     *   in rx_buf */
+    uint8_t rx_buf[CONFIG_NETDEV_TAP_RX_BATCH][ETHERNET_FRAME_LEN];
+                                        /**< frames read from the TAP */
+#endif
 } netdev_tap_t;
 
 /**
@@ -64,10 +64,18 @@
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
+#if IS_USED(MODULE_NETDEV_TAP_BATCH)
+/* netdev_tap_t::rx_head and netdev_tap_t::rx_num are 8 bit wide */
+static_assert((CONFIG_NETDEV_TAP_RX_BATCH > 0) &&
+              (CONFIG_NETDEV_TAP_RX_BATCH <= UINT8_MAX),
+              "CONFIG_NETDEV_TAP_RX_BATCH must be between 1 and 255");
+#endif
+
 /* netdev interface */
 static int _init(netdev_t *netdev);
 static int _send(netdev_t *netdev, const iolist_t *iolist);
 static int _recv(netdev_t *netdev, void *buf, size_t n, void *info);
+static int _recv_iol(netdev_t *netdev, const iolist_t *iolist, void *info);
 
 static inline void _get_mac_addr(netdev_t *netdev, uint8_t *dst)
 {
@@ -94,6 +102,36 @@ static inline int _set_promiscuous(netdev_t *netdev, int value)
     return value;
 }
 
+#if IS_USED(MODULE_NETDEV_TAP_BATCH)
+static unsigned _read_batch(netdev_tap_t *dev);
+static void _continue_reading(netdev_tap_t *dev);
+
+static inline void _isr(netdev_t *netdev)
+{
+    netdev_tap_t *dev = container_of(netdev, netdev_tap_t, netdev);
+    unsigned num = _read_batch(dev);
+
+    if (netdev->event_callback) {
+        /* every event makes the upper layer receive one frame */
+        for (unsigned i = 0; (i < num) && (dev->rx_num > 0); i++) {
+            netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        }
+    }
+#if DEVELHELP
+    else {
+        puts("netdev_tap: _isr(): no event_callback set.");
+    }
+#endif
+    dev->rx_num = 0;
+    if (num == CONFIG_NETDEV_TAP_RX_BATCH) {
+        /* more frames may be waiting */
+        _continue_reading(dev);
+    }
+    else {
+        native_async_read_continue(dev->tap_fd);
+    }
+}
+#else /* IS_USED(MODULE_NETDEV_TAP_BATCH) */
 static inline void _isr(netdev_t *netdev)
 {
     if (netdev->event_callback) {
@@ -105,6 +143,7 @@ static inline void _isr(netdev_t *netdev)
     }
 #endif
 }
+#endif /* IS_USED(MODULE_NETDEV_TAP_BATCH) */
 
 static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
 {
@@ -158,6 +197,7 @@ static int _set(netdev_t *dev, netopt_t opt, const void *value, size_t value_len
 static const netdev_driver_t netdev_driver_tap = {
     .send = _send,
     .recv = _recv,
+    .recv_iol = _recv_iol,
     .init = _init,
     .isr = _isr,
     .get = _get,
@@ -204,6 +244,102 @@ static void _continue_reading(netdev_tap_t *dev)
     _native_in_syscall--;
 }
 
+static bool _is_for_me(netdev_tap_t *dev, const uint8_t *dst)
+{
+    if (dev->promiscuous || _is_addr_multicast((uint8_t *)dst) ||
+        _is_addr_broadcast((uint8_t *)dst) ||
+        (memcmp(dst, dev->addr, ETHERNET_ADDR_LEN) == 0)) {
+        return true;
+    }
+    DEBUG("netdev_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
+          "That's not me => Dropped\n",
+          dst[0], dst[1], dst[2], dst[3], dst[4], dst[5]);
+    return false;
+}
+
+#if IS_USED(MODULE_NETDEV_TAP_BATCH)
+/* Reads the frames available up to the size of the receive buffer. Returns
+ * the number of reads that returned a frame, including dropped ones. */
+static unsigned _read_batch(netdev_tap_t *dev)
+{
+    unsigned num = 0;
+
+    dev->rx_head = 0;
+    dev->rx_num = 0;
+
+    _native_in_syscall++; /* no switching here */
+    while (num < CONFIG_NETDEV_TAP_RX_BATCH) {
+        uint8_t *buf = dev->rx_buf[dev->rx_num];
+        ssize_t nread = real_read(dev->tap_fd, buf, ETHERNET_FRAME_LEN);
+
+        if (nread <= 0) {
+            if ((nread < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+                err(EXIT_FAILURE, "netdev_tap: read");
+            }
+            break;
+        }
+        num++;
+        if ((nread < (ssize_t)sizeof(ethernet_hdr_t)) ||
+            !_is_for_me(dev, ((ethernet_hdr_t *)buf)->dst)) {
+            continue;
+        }
+        dev->rx_len[dev->rx_num++] = nread;
+    }
+    _native_in_syscall--;
+
+    DEBUG("netdev_tap: read %u frames, %u for me\n", num, dev->rx_num);
+    return num;
+}
+
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    netdev_tap_t *dev = container_of(netdev, netdev_tap_t, netdev);
+    (void)info;
+
+    if (dev->rx_num == 0) {
+        return 0;
+    }
+
+    size_t size = dev->rx_len[dev->rx_head];
+
+    if (!buf) {
+        if (len > 0) {
+            /* no memory available in pktbuf, discarding the frame */
+            DEBUG("netdev_tap: discarding the frame\n");
+            dev->rx_head++;
+            dev->rx_num--;
+        }
+        return size;
+    }
+    dev->rx_head++;
+    dev->rx_num--;
+    if (len < size) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, dev->rx_buf[dev->rx_head - 1], size);
+    return size;
+}
+
+static int _recv_iol(netdev_t *netdev, const iolist_t *iolist, void *info)
+{
+    netdev_tap_t *dev = container_of(netdev, netdev_tap_t, netdev);
+    (void)info;
+
+    if (dev->rx_num == 0) {
+        return 0;
+    }
+
+    size_t size = dev->rx_len[dev->rx_head];
+    const uint8_t *frame = dev->rx_buf[dev->rx_head];
+
+    dev->rx_head++;
+    dev->rx_num--;
+    if (iolist_fill(iolist, 0, frame, size) < size) {
+        return -ENOBUFS;
+    }
+    return size;
+}
+#else /* IS_USED(MODULE_NETDEV_TAP_BATCH) */
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     netdev_tap_t *dev = container_of(netdev, netdev_tap_t, netdev);
@@ -238,15 +374,7 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     DEBUG("netdev_tap: read %d bytes\n", nread);
 
     if (nread > 0) {
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)buf;
-        if (!(dev->promiscuous) && !_is_addr_multicast(hdr->dst) &&
-            !_is_addr_broadcast(hdr->dst) &&
-            (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
-            DEBUG("netdev_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
-                  "That's not me => Dropped\n",
-                  hdr->dst[0], hdr->dst[1], hdr->dst[2],
-                  hdr->dst[3], hdr->dst[4], hdr->dst[5]);
-
+        if (!_is_for_me(dev, ((ethernet_hdr_t *)buf)->dst)) {
             native_async_read_continue(dev->tap_fd);
 
             return 0;
@@ -273,6 +401,60 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     return -1;
 }
 
+static int _recv_iol(netdev_t *netdev, const iolist_t *iolist, void *info)
+{
+    netdev_tap_t *dev = container_of(netdev, netdev_tap_t, netdev);
+    /* takes what does not fit into iolist, the TAP would truncate the frame
+     * silently otherwise */
+    static uint8_t overflow[ETHERNET_FRAME_LEN];
+    struct iovec iov[iolist_count(iolist) + 1];
+    uint8_t dst[ETHERNET_ADDR_LEN];
+    unsigned n;
+    (void)info;
+
+    size_t size = iolist_to_iovec(iolist, iov, &n);
+    iov[n].iov_base = overflow;
+    iov[n].iov_len = sizeof(overflow);
+
+    ssize_t nread = real_readv(dev->tap_fd, iov, n + 1);
+    DEBUG("netdev_tap: read %d bytes\n", (int)nread);
+
+    if (nread < 0) {
+        if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+            err(EXIT_FAILURE, "netdev_tap: read");
+        }
+        return 0;
+    }
+    if ((size_t)nread > size) {
+        DEBUG("netdev_tap: frame does not fit, dropping it\n");
+        _continue_reading(dev);
+        return -ENOBUFS;
+    }
+    if ((size_t)nread < sizeof(ethernet_hdr_t)) {
+        native_async_read_continue(dev->tap_fd);
+        return 0;
+    }
+    /* the destination address may span several buffers */
+    for (unsigned i = 0, pos = 0; pos < sizeof(dst); i++) {
+        size_t chunk = sizeof(dst) - pos;
+
+        if (chunk > iov[i].iov_len) {
+            chunk = iov[i].iov_len;
+        }
+
+        memcpy(&dst[pos], iov[i].iov_base, chunk);
+        pos += chunk;
+    }
+    if (!_is_for_me(dev, dst)) {
+        native_async_read_continue(dev->tap_fd);
+        return 0;
+    }
+
+    _continue_reading(dev);
+    return nread;
+}
+#endif /* IS_USED(MODULE_NETDEV_TAP_BATCH) */
+
 static int _send(netdev_t *netdev, const iolist_t *iolist)
 {
     netdev_tap_t *dev = container_of(netdev, netdev_tap_t, netdev);
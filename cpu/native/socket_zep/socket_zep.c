@@ -24,6 +24,7 @@
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <sys/time.h>
+#include <sys/uio.h>
 
 #include "async_read.h"
 #include "byteorder.h"
@@ -495,14 +496,21 @@ static int _read(ieee802154_dev_t *dev, void *buf, size_t max_size,
 {
     int res;
     socket_zep_t *zepdev = dev->priv;
+    zep_v2_data_hdr_t *zep = (zep_v2_data_hdr_t *)zepdev->rcv_buf;
+    uint8_t *overflow = zepdev->rcv_buf + sizeof(*zep);
 
     DEBUG("socket_zep::read: reading up to %u bytes into %p\n", max_size, buf);
 
-    if (max_size + sizeof(zep_v2_data_hdr_t) > sizeof(zepdev->rcv_buf)) {
-        return 0;
-    }
+    /* the PSDU is read into buf directly, only the ZEP header and what does
+     * not fit into buf (at least the FCS) end up in the receive buffer */
+    struct iovec iov[] = {
+        { .iov_base = zep, .iov_len = sizeof(*zep) },
+        { .iov_base = buf, .iov_len = max_size },
+        { .iov_base = overflow,
+          .iov_len = sizeof(zepdev->rcv_buf) - sizeof(*zep) },
+    };
 
-    res = real_read(zepdev->sock_fd, zepdev->rcv_buf, max_size + sizeof(zep_v2_data_hdr_t));
+    res = real_readv(zepdev->sock_fd, iov, ARRAY_SIZE(iov));
 
     DEBUG("socket_zep::read: got %d bytes\n", res);
 
@@ -511,43 +519,65 @@ static int _read(ieee802154_dev_t *dev, void *buf, size_t max_size,
         goto out;
     }
 
-    zep_hdr_t *tmp = (zep_hdr_t *)zepdev->rcv_buf;
+    if (buf == NULL) {
+        /* frame is dropped, the datagram is consumed */
+        res = 0;
+        goto out;
+    }
 
-    if ((tmp->preamble[0] != 'E') || (tmp->preamble[1] != 'X')) {
+    if ((zep->hdr.preamble[0] != 'E') || (zep->hdr.preamble[1] != 'X')) {
         DEBUG("socket_zep::read: invalid ZEP header\n");
         res = -EINVAL;
         goto out;
     }
 
-    if (tmp->version != 2) {
-        DEBUG("socket_zep::read: unsupported ZEP version %u\n", tmp->version);
+    if (zep->hdr.version != 2) {
+        DEBUG("socket_zep::read: unsupported ZEP version %u\n", zep->hdr.version);
         res = -EINVAL;
         goto out;
     }
 
-    switch (((zep_v2_ack_hdr_t *)tmp)->type) {
+    switch (zep->type) {
     case ZEP_V2_TYPE_DATA: {
-        zep_v2_data_hdr_t *zep = (zep_v2_data_hdr_t *)tmp;
+        size_t psdu_len = res - sizeof(*zep);
+
+        if ((zep->length < IEEE802154_FCS_LEN) || (zep->length > psdu_len)) {
+            DEBUG("socket_zep::read: invalid length %u\n", zep->length);
+            res = -EINVAL;
+            break;
+        }
+        /* report size without checksum */
+        psdu_len = zep->length - IEEE802154_FCS_LEN;
+        if (psdu_len < IEEE802154_MIN_FRAME_LEN) {
+            DEBUG("socket_zep::read: frame too short\n");
+            res = -EINVAL;
+            break;
+        }
+        if (psdu_len > max_size) {
+            DEBUG("socket_zep::read: frame does not fit\n");
+            res = -ENOBUFS;
+            break;
+        }
 
         if (info) {
             info->lqi = zep->lqi_val;
             info->rssi = -IEEE802154_RADIO_RSSI_OFFSET;
         }
 
-        if (_dst_not_me(zepdev, zep + 1)) {
+        if (_dst_not_me(zepdev, buf)) {
             DEBUG("socket_zep::read: dst not me\n");
+            res = 0;
             break;
         }
 
-        _send_ack(zepdev, zep + 1);
+        _send_ack(zepdev, buf);
 
-        memcpy(buf, zep + 1, max_size);
-        res = max_size;
+        res = psdu_len;
 
         break;
     }
     default:
-        DEBUG("socket_zep::read: unknown type %u\n", ((zep_v2_ack_hdr_t *)tmp)->type);
+        DEBUG("socket_zep::read: unknown type %u\n", zep->type);
         res = -EINVAL;
         break;
     }
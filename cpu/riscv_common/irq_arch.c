@@ -32,6 +32,9 @@
 #include "plic.h"
 #include "clic.h"
 #include "thread.h"
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ)
+#include "schedstatistics.h"
+#endif
 
 #include "vendor/riscv_csr.h"
 
@@ -111,6 +114,10 @@ static void handle_trap(uint32_t mcause)
      *  calling thread_yield(). */
     riscv_in_isr = 1;
 
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ)
+    sched_statistics_irq_enter();
+#endif
+
     uint32_t trap = mcause & CPU_CSR_MCAUSE_CAUSE_MSK;
 
     /* Check for INT or TRAP */
@@ -164,6 +171,10 @@ static void handle_trap(uint32_t mcause)
             core_panic(PANIC_GENERAL_ERROR, "Unhandled trap");
         }
     }
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ)
+    sched_statistics_irq_exit();
+#endif
+
     /* ISR done - no more changes to thread states */
     riscv_in_isr = 0;
 }
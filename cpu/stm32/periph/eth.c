@@ -675,6 +675,54 @@ static int stm32_eth_recv(netdev_t *netdev, void *_buf, size_t max_len,
     return size;
 }
 
+static int stm32_eth_recv_iol(netdev_t *netdev, const iolist_t *iolist,
+                              void *_info)
+{
+    (void)netdev;
+    netdev_eth_rx_info_t *info = _info;
+    int size = get_rx_frame_size();
+
+    if (size < 0) {
+        if (size != -EAGAIN) {
+            DEBUG("[stm32_eth] Dropping frame due to error\n");
+            drop_frame_and_update_rx_curr();
+        }
+        return (size == -EAGAIN) ? 0 : size;
+    }
+
+    if (iolist_size(iolist) < (size_t)size) {
+        DEBUG("[stm32_eth] Buffers provided by upper layer are too small\n");
+        drop_frame_and_update_rx_curr();
+        return -ENOBUFS;
+    }
+
+    /* Copy the frame from the DMA buffers directly to where the upper layer
+     * wants it and hand the DMA descriptors back to the DMA */
+    size_t pos = 0;
+    while (1) {
+        if (pos < (size_t)size) {
+            size_t chunk = MIN((size_t)size - pos, ETH_RX_BUFFER_SIZE);
+            pos += iolist_fill(iolist, pos, rx_curr->buffer_addr, chunk);
+        }
+        if (rx_curr->status & RX_DESC_STAT_LS) {
+            if (IS_USED(MODULE_PERIPH_PTP) && info) {
+                info->timestamp = rx_curr->ts_low;
+                info->timestamp += (uint64_t)rx_curr->ts_high * NS_PER_SEC;
+                info->flags |= NETDEV_ETH_RX_INFO_FLAG_TIMESTAMP;
+            }
+            rx_curr->status = RX_DESC_STAT_OWN;
+            rx_curr = rx_curr->desc_next;
+            break;
+        }
+        rx_curr->status = RX_DESC_STAT_OWN;
+        rx_curr = rx_curr->desc_next;
+    }
+
+    _debug_rx_descriptor_info(__LINE__);
+    handle_lost_rx_irqs();
+    return size;
+}
+
 void stm32_eth_isr_eth_wkup(void)
 {
     cortexm_isr_end();
@@ -709,6 +757,7 @@ static void stm32_eth_isr(netdev_t *netdev)
 static const netdev_driver_t netdev_driver_stm32f4eth = {
     .send = stm32_eth_send,
     .recv = stm32_eth_recv,
+    .recv_iol = stm32_eth_recv_iol,
     .init = stm32_eth_init,
     .isr = stm32_eth_isr,
     .get = stm32_eth_get,
@@ -0,0 +1,84 @@
+#! /usr/bin/env python3
+#
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""
+Compares the JSON results of the `benchmark` module (`BENCHMARK_STATS()`) of
+two runs, e.g. of last night's and tonight's build, and reports regressions.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    """Collect all benchmark results from a terminal log or JSON file"""
+    results = {}
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            start = line.find("[")
+            if start < 0:
+                continue
+            try:
+                entries = json.loads(line[start:])
+            except ValueError:
+                continue
+            if not isinstance(entries, list):
+                continue
+            for entry in entries:
+                if isinstance(entry, dict) and "median_ns" in entry:
+                    results[entry["name"]] = entry
+    return results
+
+
+def compare(old, new, threshold, noise_ns):
+    """Yield (name, old median, new median, change, regression) tuples"""
+    for name in sorted(old.keys() & new.keys()):
+        before = old[name]["median_ns"]
+        after = new[name]["median_ns"]
+        change = (after - before) / before if before else 0.0
+        # a change must exceed the threshold, the noise floor and the
+        # spread of the previous run to count as regression
+        regression = (change > threshold and after - before > noise_ns and
+                      after - before > old[name].get("stddev_ns", 0))
+        yield name, before, after, change, regression
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("old", help="results of the reference run")
+    parser.add_argument("new", help="results of the run to check")
+    parser.add_argument("-t", "--threshold", type=float, default=0.1,
+                        help="relative slowdown of the median regarded as "
+                             "regression (default: 0.1)")
+    parser.add_argument("-n", "--noise", type=int, default=10,
+                        help="absolute slowdown in ns below which changes "
+                             "are ignored (default: 10)")
+    args = parser.parse_args()
+
+    old = load(args.old)
+    new = load(args.new)
+    regressions = 0
+
+    print("{:<36} {:>12} {:>12} {:>8}".format("benchmark", "old [ns]",
+                                               "new [ns]", "change"))
+    for name, before, after, change, regression in compare(
+            old, new, args.threshold, args.noise):
+        regressions += regression
+        print("{:<36} {:>12} {:>12} {:>+7.1f}%{}".format(
+            name, before, after, change * 100,
+            "  REGRESSION" if regression else ""))
+    for name in sorted(old.keys() - new.keys()):
+        print("{:<36} missing in new results".format(name))
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,195 @@
+#! /usr/bin/env python3
+#
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""
+Converts a dump of the `trace` module (`trace_dump_bin()` or
+`trace_dump_hex()`) into a timeline, either in the Trace Event Format of
+chrome://tracing and Perfetto or as plain text.
+"""
+
+import argparse
+import collections
+import json
+import struct
+import sys
+
+HEX_BEGIN = "==== trace begin ===="
+HEX_END = "==== trace end ===="
+
+MAGIC = 0x52545243
+VERSION = 1
+FLAG_CYCLES = 0x01
+HEADER_FMT = "IBBHII"
+RECORD_FMT = "IIHH"
+
+CTX_ISR = 0xffff
+EVENT_LOST = 0x3fff
+KIND_BEGIN = 0x4000
+KIND_END = 0x8000
+
+Record = collections.namedtuple("Record", "time payload id ctx")
+Event = collections.namedtuple("Event", "ts ctx id payload")
+
+
+class Dump:
+    """Parsed trace dump"""
+
+    def __init__(self, data):
+        for endian in "<>":
+            magic, = struct.unpack_from(endian + "I", data)
+            if magic == MAGIC:
+                break
+        else:
+            raise ValueError("not a trace dump (bad magic)")
+        (_, version, self.flags, record_size, self.freq,
+         self.now) = struct.unpack_from(endian + HEADER_FMT, data)
+        if version != VERSION:
+            raise ValueError("unsupported format version {}".format(version))
+        hdr_size = struct.calcsize(endian + HEADER_FMT)
+        self.records = [
+            Record(*struct.unpack_from(endian + RECORD_FMT, data, off))
+            for off in range(hdr_size, len(data) - record_size + 1,
+                             record_size)
+        ]
+
+    @property
+    def unit(self):
+        """Unit of Event.ts"""
+        if self.freq:
+            return "us"
+        return "cycles" if self.flags & FLAG_CYCLES else "ticks"
+
+    def events(self):
+        """Records in chronological order, with time stamps relative to the
+        oldest record, in microseconds if the time stamp frequency is known"""
+        events = []
+        for rec in self.records:
+            if rec.id == EVENT_LOST:
+                # lost records carry no time stamp, put them at the start
+                age = None
+            else:
+                age = (self.now - rec.time) & 0xffffffff
+            events.append((age, rec))
+        oldest = max((age for age, _ in events if age is not None), default=0)
+        scale = 1e6 / self.freq if self.freq else 1
+        res = []
+        for age, rec in events:
+            ticks = 0 if age is None else oldest - age
+            res.append(Event(ticks * scale, rec.ctx, rec.id, rec.payload))
+        return sorted(res, key=lambda e: e.ts)
+
+
+def parse_hex(lines):
+    """Parse the output of trace_dump_hex(). Lines outside of the begin and
+    end markers are ignored."""
+    data = bytearray()
+    inside = False
+    for line in lines:
+        line = line.strip()
+        if isinstance(line, bytes):
+            line = line.decode(errors="replace")
+        if line.endswith(HEX_BEGIN):
+            inside = True
+            data = bytearray()
+        elif line.endswith(HEX_END):
+            break
+        elif inside and line:
+            data += bytes.fromhex(line)
+    return Dump(bytes(data))
+
+
+def parse(data):
+    """Parse either a binary dump or a terminal log containing a hex dump"""
+    try:
+        return Dump(data)
+    except (ValueError, struct.error):
+        return parse_hex(data.decode(errors="replace").splitlines())
+
+
+def ctx_name(ctx):
+    return "isr" if ctx == CTX_ISR else "pid {}".format(ctx)
+
+
+def event_name(event_id, names):
+    plain = event_id & ~(KIND_BEGIN | KIND_END)
+    if plain == EVENT_LOST:
+        return "lost"
+    return names.get(plain, "0x{:04x}".format(plain))
+
+
+def to_chrome(dump, names):
+    """Trace Event Format, see https://docs.google.com/document/d/
+    1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU"""
+    out = []
+    for ctx in sorted({rec.ctx for rec in dump.records}):
+        out.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": ctx,
+                    "args": {"name": ctx_name(ctx)}})
+    for ev in dump.events():
+        entry = {"name": event_name(ev.id, names), "pid": 0, "tid": ev.ctx,
+                 "ts": ev.ts, "args": {"payload": ev.payload}}
+        if ev.id & KIND_BEGIN:
+            entry["ph"] = "B"
+        elif ev.id & KIND_END:
+            entry["ph"] = "E"
+        else:
+            entry["ph"] = "i"
+            entry["s"] = "t"
+        out.append(entry)
+    return json.dumps({"traceEvents": out, "displayTimeUnit": "ns"}, indent=1)
+
+
+def to_text(dump, names):
+    lines = ["# time [{}]  context  event  payload".format(dump.unit)]
+    for ev in dump.events():
+        kind = "B" if ev.id & KIND_BEGIN else "E" if ev.id & KIND_END else " "
+        lines.append("{:14.3f}  {:>7}  {} {:<16} 0x{:08x}".format(
+            ev.ts, ctx_name(ev.ctx), kind, event_name(ev.id, names),
+            ev.payload))
+    return "\n".join(lines)
+
+
+def read_names(path):
+    """Read 'ID NAME' lines, ID in decimal or with 0x prefix"""
+    names = {}
+    with open(path) as f:
+        for line in f:
+            line = line.split("#", 1)[0].split(None, 1)
+            if len(line) == 2:
+                names[int(line[0], 0)] = line[1].strip()
+    return names
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("dump", nargs="?", default="-",
+                        help="binary dump or terminal log with a hex dump "
+                             "(default: stdin)")
+    parser.add_argument("-f", "--format", choices=("chrome", "text"),
+                        default="chrome", help="output format")
+    parser.add_argument("-n", "--names", help="file mapping event IDs to names")
+    parser.add_argument("-o", "--output", help="output file (default: stdout)")
+    args = parser.parse_args()
+
+    if args.dump == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.dump, "rb") as f:
+            data = f.read()
+    dump = parse(data)
+    names = read_names(args.names) if args.names else {}
+    res = (to_chrome if args.format == "chrome" else to_text)(dump, names)
+
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(res + "\n")
+    else:
+        print(res)
+
+
+if __name__ == "__main__":
+    main()
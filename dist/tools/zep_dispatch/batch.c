@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU General Public
+ * License v2. See the file LICENSE for more details.
+ */
+
+/* recvmmsg() / sendmmsg() */
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "net/zep.h"
+#include "batch.h"
+
+#ifdef MSG_WAITFORONE
+_Static_assert(sizeof(zep_mmsghdr_t) == sizeof(struct mmsghdr),
+               "zep_mmsghdr_t must match struct mmsghdr");
+_Static_assert(offsetof(zep_mmsghdr_t, msg_len) == offsetof(struct mmsghdr, msg_len),
+               "zep_mmsghdr_t must match struct mmsghdr");
+
+static int _recvmmsg(int sock, zep_mmsghdr_t *msgs, unsigned vlen)
+{
+    /* wait for the first frame, then take what is there already */
+    return recvmmsg(sock, (struct mmsghdr *)msgs, vlen, MSG_WAITFORONE, NULL);
+}
+
+static int _sendmmsg(int sock, zep_mmsghdr_t *msgs, unsigned vlen)
+{
+    return sendmmsg(sock, (struct mmsghdr *)msgs, vlen, 0);
+}
+#else
+/* one system call per frame where batching is not available */
+static int _recvmmsg(int sock, zep_mmsghdr_t *msgs, unsigned vlen)
+{
+    (void)vlen;
+
+    ssize_t res = recvmsg(sock, &msgs[0].msg_hdr, 0);
+    if (res < 0) {
+        return -1;
+    }
+    msgs[0].msg_len = res;
+    return 1;
+}
+
+static int _sendmmsg(int sock, zep_mmsghdr_t *msgs, unsigned vlen)
+{
+    for (unsigned i = 0; i < vlen; ++i) {
+        ssize_t res = sendmsg(sock, &msgs[i].msg_hdr, 0);
+        if (res < 0) {
+            return i ? (int)i : -1;
+        }
+        msgs[i].msg_len = res;
+    }
+    return vlen;
+}
+#endif
+
+int zep_rx_batch(int sock, zep_rx_batch_t *batch)
+{
+    for (unsigned i = 0; i < ZEP_DISPATCH_RX_BATCH; ++i) {
+        batch->iov[i].iov_base = batch->buf[i];
+        batch->iov[i].iov_len = sizeof(batch->buf[i]);
+        memset(&batch->msgs[i].msg_hdr, 0, sizeof(batch->msgs[i].msg_hdr));
+        batch->msgs[i].msg_hdr.msg_name = &batch->addr[i];
+        batch->msgs[i].msg_hdr.msg_namelen = sizeof(batch->addr[i]);
+        batch->msgs[i].msg_hdr.msg_iov = &batch->iov[i];
+        batch->msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    return _recvmmsg(sock, batch->msgs, ZEP_DISPATCH_RX_BATCH);
+}
+
+void zep_tx_init(zep_tx_queue_t *q, int sock, zep_tx_error_cb_t on_error,
+                 void *ctx)
+{
+    q->sock = sock;
+    q->num = 0;
+    q->on_error = on_error;
+    q->ctx = ctx;
+}
+
+void zep_tx_add(zep_tx_queue_t *q, const struct sockaddr_in6 *dst,
+                void *buffer, size_t len, int lqi)
+{
+    const zep_v2_data_hdr_t *zep = buffer;
+    const size_t lqi_pos = offsetof(zep_v2_data_hdr_t, lqi_val);
+    struct msghdr *msg = &q->msgs[q->num].msg_hdr;
+    struct iovec *iov = q->iov[q->num];
+
+    memcpy(&q->addr[q->num], dst, sizeof(*dst));
+    memset(msg, 0, sizeof(*msg));
+    msg->msg_name = &q->addr[q->num];
+    msg->msg_namelen = sizeof(q->addr[q->num]);
+    msg->msg_iov = iov;
+
+    if ((lqi < 0) || (len <= lqi_pos) || (zep->type != ZEP_V2_TYPE_DATA)) {
+        iov[0].iov_base = buffer;
+        iov[0].iov_len = len;
+        msg->msg_iovlen = 1;
+    }
+    else {
+        /* the frame is shared by all destinations, so the LQI is sent from
+         * a copy of its own */
+        q->lqi[q->num] = lqi;
+        iov[0].iov_base = buffer;
+        iov[0].iov_len = lqi_pos;
+        iov[1].iov_base = &q->lqi[q->num];
+        iov[1].iov_len = 1;
+        iov[2].iov_base = (uint8_t *)buffer + lqi_pos + 1;
+        iov[2].iov_len = len - lqi_pos - 1;
+        msg->msg_iovlen = 3;
+    }
+
+    if (++q->num == ZEP_DISPATCH_TX_BATCH) {
+        zep_tx_flush(q);
+    }
+}
+
+void zep_tx_flush(zep_tx_queue_t *q)
+{
+    unsigned sent = 0;
+
+    while (sent < q->num) {
+        int res = _sendmmsg(q->sock, &q->msgs[sent], q->num - sent);
+
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            /* the first remaining frame failed, skip it */
+            if (q->on_error) {
+                q->on_error(q->ctx, &q->addr[sent]);
+            }
+            res = 1;
+        }
+        sent += res;
+    }
+
+    q->num = 0;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU General Public
+ * License v2. See the file LICENSE for more details.
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdint.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum size of a ZEP frame
+ */
+#ifndef ZEP_DISPATCH_PDU
+#define ZEP_DISPATCH_PDU    256
+#endif
+
+/**
+ * @brief   Number of frames received with a single system call
+ */
+#ifndef ZEP_DISPATCH_RX_BATCH
+#define ZEP_DISPATCH_RX_BATCH   32
+#endif
+
+/**
+ * @brief   Number of frames sent with a single system call
+ */
+#ifndef ZEP_DISPATCH_TX_BATCH
+#define ZEP_DISPATCH_TX_BATCH   64
+#endif
+
+/**
+ * @brief   Message of recvmmsg() / sendmmsg()
+ *
+ * Same layout as `struct mmsghdr`, which is only declared with `_GNU_SOURCE`
+ */
+typedef struct {
+    struct msghdr msg_hdr;  /**< the message */
+    unsigned int msg_len;   /**< bytes transmitted */
+} zep_mmsghdr_t;
+
+/**
+ * @brief   Frames received at once
+ */
+typedef struct {
+    zep_mmsghdr_t msgs[ZEP_DISPATCH_RX_BATCH];              /**< messages */
+    struct iovec iov[ZEP_DISPATCH_RX_BATCH];                /**< buffers */
+    struct sockaddr_in6 addr[ZEP_DISPATCH_RX_BATCH];        /**< senders */
+    uint8_t buf[ZEP_DISPATCH_RX_BATCH][ZEP_DISPATCH_PDU];   /**< frames */
+} zep_rx_batch_t;
+
+/**
+ * @brief   Called for every frame the send queue failed to send
+ *
+ * @param[in] ctx   context of the send queue
+ * @param[in] addr  destination of the frame
+ */
+typedef void (*zep_tx_error_cb_t)(void *ctx, const struct sockaddr_in6 *addr);
+
+/**
+ * @brief   Frames to be sent at once
+ *
+ * Frames are not copied, they have to stay valid until the queue is flushed.
+ * Only the LQI of a frame can be set per destination.
+ */
+typedef struct {
+    int sock;                                           /**< socket to use */
+    unsigned num;                                       /**< queued frames */
+    zep_tx_error_cb_t on_error;                         /**< error callback */
+    void *ctx;                                          /**< its context */
+    zep_mmsghdr_t msgs[ZEP_DISPATCH_TX_BATCH];          /**< messages */
+    struct iovec iov[ZEP_DISPATCH_TX_BATCH][3];         /**< frame parts */
+    struct sockaddr_in6 addr[ZEP_DISPATCH_TX_BATCH];    /**< destinations */
+    uint8_t lqi[ZEP_DISPATCH_TX_BATCH];                 /**< LQI per frame */
+} zep_tx_queue_t;
+
+/**
+ * @brief   Receive a batch of frames
+ *
+ * Blocks until at least one frame was received.
+ *
+ * @param[in]  sock     socket to receive from
+ * @param[out] batch    the received frames, the length of frame i is
+ *                      `batch->msgs[i].msg_len`
+ *
+ * @return number of frames received, -1 on error
+ */
+int zep_rx_batch(int sock, zep_rx_batch_t *batch);
+
+/**
+ * @brief   Initialize a send queue
+ *
+ * @param[out] q        the send queue
+ * @param[in]  sock     socket to send with
+ * @param[in]  on_error called for frames that could not be sent, may be NULL
+ * @param[in]  ctx      context for @p on_error
+ */
+void zep_tx_init(zep_tx_queue_t *q, int sock, zep_tx_error_cb_t on_error,
+                 void *ctx);
+
+/**
+ * @brief   Queue a frame for sending, flushes the queue if it is full
+ *
+ * @param[in, out] q    the send queue
+ * @param[in] dst       destination of the frame
+ * @param[in] buffer    ZEP frame to send
+ * @param[in] len       ZEP frame length
+ * @param[in] lqi       LQI to send the frame with, -1 to keep it
+ */
+void zep_tx_add(zep_tx_queue_t *q, const struct sockaddr_in6 *dst,
+                void *buffer, size_t len, int lqi);
+
+/**
+ * @brief   Send all queued frames
+ *
+ * @param[in, out] q    the send queue
+ */
+void zep_tx_flush(zep_tx_queue_t *q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BATCH_H */
@@ -0,0 +1,28 @@
+#!/bin/bash
+
+NUM=${1:-100}
+TIME=${2:-10}
+WORKERS=${3:-1}
+
+PORT=${ZEP_PORT_BASE:-17754}
+FILE=$(mktemp --suffix=.topo)
+
+# keep the density of the network the same for any number of nodes
+SIZE=$(awk "BEGIN { printf \"%d\", sqrt($NUM * 1000) }")
+RANGE=40
+VARIANCE=15
+
+trap 'rm -f "$FILE"' EXIT
+
+./bin/topogen -w $SIZE -h $SIZE -r $RANGE -v $VARIANCE -n $NUM > "$FILE"
+
+./bin/zep_dispatch -t "$FILE" -w $WORKERS ::1 $PORT &
+PID=$!
+sleep 1
+
+./bin/zep_bench -n $NUM -t $TIME ::1 $PORT
+
+kill -USR2 $PID
+sleep 1
+kill $PID
+wait $PID 2> /dev/null
@@ -5,12 +5,11 @@
  * License v2. See the file LICENSE for more details.
  */
 
-#ifndef ZEP_DISPATCH_PDU
-#define ZEP_DISPATCH_PDU    256
-#endif
-
 #include <arpa/inet.h>
+#include <errno.h>
+#include <inttypes.h>
 #include <netdb.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -20,60 +19,142 @@
 #include <unistd.h>
 
 #include "kernel_defines.h"
+#include "batch.h"
 #include "topology.h"
 #include "zep_parser.h"
 
+/* size of the socket receive buffer, absorbs bursts from many nodes */
+#define ZEP_DISPATCH_RCVBUF     (4 * 1024 * 1024)
+
 typedef struct {
     list_node_t node;
     struct sockaddr_in6 addr;
+    uint64_t frames_in;     /* frames received from the client */
+    uint64_t frames_out;    /* frames sent to the client */
 } zep_client_t;
 
-typedef void (*dispatch_cb_t)(void *ctx, void *buffer, size_t len,
-                              int sock, struct sockaddr_in6 *src_addr);
+typedef struct worker worker_t;
+
+typedef void (*dispatch_cb_t)(void *ctx, worker_t *w, void *buffer, size_t len,
+                              struct sockaddr_in6 *src_addr);
+
+struct worker {
+    pthread_t thread;
+    int sock;
+    unsigned seed;              /* state of the simulated packet loss */
+    dispatch_cb_t dispatch;
+    void *ctx;
+    zep_rx_batch_t rx;
+    zep_tx_queue_t tx;
+    /* clients that could not be reached, removed after the batch was sent */
+    struct sockaddr_in6 dead[ZEP_DISPATCH_TX_BATCH];
+    unsigned num_dead;
+};
+
+/* the clients of a flat topology */
+static pthread_mutex_t _clients_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static volatile sig_atomic_t _stats_requested;
 
 /* all nodes are directly connected */
-static void _send_flat(void *ctx, void *buffer, size_t len,
-                       int sock, struct sockaddr_in6 *src_addr)
+static void _send_flat(void *ctx, worker_t *w, void *buffer, size_t len,
+                       struct sockaddr_in6 *src_addr)
 {
     list_node_t *head = ctx;
     char addr_str[INET6_ADDRSTRLEN];
 
     /* send packet to all other clients */
     bool known_node = false;
-    list_node_t *prev = head;
+
+    pthread_mutex_lock(&_clients_lock);
 
     for (list_node_t *n = head->next; n; n = n->next) {
-        struct sockaddr_in6 *addr = &container_of(n, zep_client_t, node)->addr;
+        zep_client_t *client = container_of(n, zep_client_t, node);
 
         /* don't echo packet back to sender */
-        if (memcmp(src_addr, addr, sizeof(*addr)) == 0) {
+        if (memcmp(src_addr, &client->addr, sizeof(client->addr)) == 0) {
             known_node = true;
-            /* remove client if sending fails */
+            client->frames_in++;
         }
-        else if (sendto(sock, buffer, len, 0, (struct sockaddr *)addr, sizeof(*addr)) < 0) {
-            inet_ntop(src_addr->sin6_family, &addr->sin6_addr, addr_str, INET6_ADDRSTRLEN);
-            printf("removing [%s]:%d\n", addr_str, ntohs(addr->sin6_port));
-            prev->next = n->next;
-            free(n);
-            continue;
+        else {
+            client->frames_out++;
+            zep_tx_add(&w->tx, &client->addr, buffer, len, -1);
         }
-
-        prev = n;
     }
 
     /* if the client new, add it to the broadcast list */
     if (!known_node) {
         inet_ntop(src_addr->sin6_family, &src_addr->sin6_addr, addr_str, INET6_ADDRSTRLEN);
         printf("adding [%s]:%d\n", addr_str, ntohs(src_addr->sin6_port));
-        zep_client_t *client = malloc(sizeof(zep_client_t));
+        zep_client_t *client = calloc(1, sizeof(zep_client_t));
         memcpy(&client->addr, src_addr, sizeof(*src_addr));
+        client->frames_in = 1;
         list_add(head, &client->node);
     }
+
+    pthread_mutex_unlock(&_clients_lock);
+}
+
+/* remove clients if sending to them failed */
+static void _flat_send_error(void *ctx, const struct sockaddr_in6 *addr)
+{
+    worker_t *w = ctx;
+
+    if (w->num_dead < ARRAY_SIZE(w->dead)) {
+        memcpy(&w->dead[w->num_dead++], addr, sizeof(*addr));
+    }
+}
+
+static void _flat_remove_dead(worker_t *w)
+{
+    list_node_t *head = w->ctx;
+    char addr_str[INET6_ADDRSTRLEN];
+
+    pthread_mutex_lock(&_clients_lock);
+
+    for (unsigned i = 0; i < w->num_dead; ++i) {
+        const struct sockaddr_in6 *addr = &w->dead[i];
+
+        for (list_node_t *prev = head, *n = head->next; n; prev = n, n = n->next) {
+            zep_client_t *client = container_of(n, zep_client_t, node);
+
+            if (memcmp(addr, &client->addr, sizeof(*addr)) == 0) {
+                inet_ntop(addr->sin6_family, &addr->sin6_addr, addr_str, INET6_ADDRSTRLEN);
+                printf("removing [%s]:%d\n", addr_str, ntohs(addr->sin6_port));
+                prev->next = n->next;
+                free(client);
+                break;
+            }
+        }
+    }
+    w->num_dead = 0;
+
+    pthread_mutex_unlock(&_clients_lock);
+}
+
+static void _flat_print_stats(FILE *out, list_node_t *head)
+{
+    char addr_str[INET6_ADDRSTRLEN];
+
+    fprintf(out, "%-40s %12s %12s\n", "client", "frames in", "frames out");
+
+    pthread_mutex_lock(&_clients_lock);
+    for (list_node_t *n = head->next; n; n = n->next) {
+        zep_client_t *client = container_of(n, zep_client_t, node);
+        char name[INET6_ADDRSTRLEN + 8];
+
+        inet_ntop(client->addr.sin6_family, &client->addr.sin6_addr,
+                  addr_str, INET6_ADDRSTRLEN);
+        snprintf(name, sizeof(name), "[%s]:%d", addr_str, ntohs(client->addr.sin6_port));
+        fprintf(out, "%-40s %12" PRIu64 " %12" PRIu64 "\n", name,
+                client->frames_in, client->frames_out);
+    }
+    pthread_mutex_unlock(&_clients_lock);
 }
 
 /* nodes are connected as described by topology */
-static void _send_topology(void *ctx, void *buffer, size_t len,
-                           int sock, struct sockaddr_in6 *src_addr)
+static void _send_topology(void *ctx, worker_t *w, void *buffer, size_t len,
+                           struct sockaddr_in6 *src_addr)
 {
     uint8_t mac_src[8];
     uint8_t mac_src_len;
@@ -86,27 +167,42 @@ static void _send_topology(void *ctx, void *buffer, size_t len,
             topology_add(ctx, mac_src, mac_src_len, src_addr);
         }
     }
-    topology_send(ctx, sock, src_addr, buffer, len);
+    topology_send(ctx, &w->tx, &w->seed, src_addr, buffer, len);
 }
 
-static void dispatch_loop(int sock, dispatch_cb_t dispatch, void *ctx)
+static void _print_stats(worker_t *w);
+
+static void *dispatch_loop(void *arg)
 {
-    puts("entering loop…");
+    worker_t *w = arg;
+
     while (1) {
-        uint8_t buffer[ZEP_DISPATCH_PDU];
-        struct sockaddr_in6 src_addr;
-        socklen_t addr_len = sizeof(src_addr);
+        /* receive incoming packets */
+        int num = zep_rx_batch(w->sock, &w->rx);
 
-        /* receive incoming packet */
-        ssize_t bytes_in = recvfrom(sock, buffer, sizeof(buffer), 0,
-                                    (struct sockaddr *)&src_addr, &addr_len);
+        for (int i = 0; i < num; ++i) {
+            if (w->rx.msgs[i].msg_len == 0) {
+                continue;
+            }
 
-        if (bytes_in <= 0) {
-            continue;
+            w->dispatch(w->ctx, w, w->rx.buf[i], w->rx.msgs[i].msg_len,
+                        &w->rx.addr[i]);
         }
 
-        dispatch(ctx, buffer, bytes_in, sock, &src_addr);
+        /* received frames stay valid until they were sent */
+        zep_tx_flush(&w->tx);
+
+        if (w->num_dead) {
+            _flat_remove_dead(w);
+        }
+
+        if (_stats_requested) {
+            _stats_requested = 0;
+            _print_stats(w);
+        }
     }
+
+    return NULL;
 }
 
 static topology_t topology;
@@ -125,9 +221,64 @@ static void _info_handler(int signal)
     }
 }
 
+static void _stats_handler(int signal)
+{
+    (void)signal;
+
+    /* printed by the worker the signal interrupted */
+    _stats_requested = 1;
+}
+
+static void _print_stats(worker_t *w)
+{
+    if (topology.flat) {
+        _flat_print_stats(stdout, w->ctx);
+    }
+    else {
+        topology_print_stats(stdout, &topology);
+    }
+    fflush(stdout);
+}
+
+static int _open_socket(const struct addrinfo *server_addr, bool shared)
+{
+    int sock = socket(server_addr->ai_family, server_addr->ai_socktype,
+                      server_addr->ai_protocol);
+
+    if (sock < 0) {
+        perror("socket() failed");
+        exit(1);
+    }
+
+    int rcvbuf = ZEP_DISPATCH_RCVBUF;
+    setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    if (shared) {
+#ifdef SO_REUSEPORT
+        /* the kernel distributes the nodes among the workers */
+        int enable = 1;
+        if (setsockopt(sock, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) < 0) {
+            perror("setsockopt(SO_REUSEPORT) failed");
+            exit(1);
+        }
+#else
+        fprintf(stderr, "multiple workers are not supported on this system\n");
+        exit(1);
+#endif
+    }
+
+    if (bind(sock, server_addr->ai_addr, server_addr->ai_addrlen) < 0) {
+        perror("bind() failed");
+        exit(1);
+    }
+
+    return sock;
+}
+
 static void _print_help(const char *progname)
 {
-    fprintf(stderr, "usage: %s [-t topology] [-s seed] [-g graphviz_out] <address> <port>\n",
+    fprintf(stderr, "usage: %s [-t topology] [-s seed] [-g graphviz_out] [-w workers] "
+                    "<address> <port>\n",
             progname);
 
     fprintf(stderr, "\npositional arguments:\n");
@@ -138,16 +289,19 @@ static void _print_help(const char *progname)
     fprintf(stderr, "\t-t <file>\tLoad toplogy from file\n");
     fprintf(stderr, "\t-s <seed>\tRandom seed used to simulate packet loss\n");
     fprintf(stderr, "\t-g <file>\tFile to dump topology as Graphviz visualisation on SIGUSR1\n");
+    fprintf(stderr, "\t-w <num>\tNumber of threads forwarding frames (default: 1)\n");
+    fprintf(stderr, "\nSend SIGUSR2 to print the number of forwarded frames\n");
 }
 
 int main(int argc, char **argv)
 {
     int c;
     unsigned int seed = time(NULL);
+    unsigned num_workers = 1;
     const char *topo_file = NULL;
     const char *progname = argv[0];
 
-    while ((c = getopt(argc, argv, "t:s:g:")) != -1) {
+    while ((c = getopt(argc, argv, "t:s:g:w:")) != -1) {
         switch (c) {
         case 't':
             topo_file = optarg;
@@ -158,6 +312,9 @@ int main(int argc, char **argv)
         case 'g':
             graphviz_file = optarg;
             break;
+        case 'w':
+            num_workers = atoi(optarg);
+            break;
         default:
             _print_help(progname);
             exit(1);
@@ -167,13 +324,11 @@ int main(int argc, char **argv)
     argc -= optind;
     argv += optind;
 
-    if (argc != 2) {
+    if (argc != 2 || num_workers == 0) {
         _print_help(progname);
         exit(1);
     }
 
-    srand(seed);
-
     if (topo_file) {
         if (topology_parse(topo_file, &topology)) {
             fprintf(stderr, "can't open '%s'\n", topo_file);
@@ -189,6 +344,11 @@ int main(int argc, char **argv)
         signal(SIGUSR1, _info_handler);
     }
 
+    /* interrupt the workers, so the statistics are printed right away */
+    struct sigaction sa = { .sa_handler = _stats_handler };
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGUSR2, &sa, NULL);
+
     struct addrinfo hint = {
         .ai_family   = AF_UNSPEC,
         .ai_socktype = SOCK_DGRAM,
@@ -205,29 +365,45 @@ int main(int argc, char **argv)
         exit(1);
     }
 
-    int sock = socket(server_addr->ai_family, server_addr->ai_socktype,
-                      server_addr->ai_protocol);
+    worker_t *workers = calloc(num_workers, sizeof(*workers));
 
-    if (sock < 0) {
-        perror("socket() failed");
+    if (workers == NULL) {
+        perror("calloc() failed");
         exit(1);
     }
 
-    if (bind(sock, server_addr->ai_addr, server_addr->ai_addrlen) < 0) {
-        perror("bind() failed");
-        exit(1);
+    for (unsigned i = 0; i < num_workers; ++i) {
+        worker_t *w = &workers[i];
+
+        w->sock = _open_socket(server_addr, num_workers > 1);
+        w->seed = seed + i;
+
+        if (topology.flat) {
+            w->dispatch = _send_flat;
+            w->ctx = &topology.nodes;
+            zep_tx_init(&w->tx, w->sock, _flat_send_error, w);
+        }
+        else {
+            w->dispatch = _send_topology;
+            w->ctx = &topology;
+            zep_tx_init(&w->tx, w->sock, NULL, NULL);
+        }
     }
 
     freeaddrinfo(server_addr);
 
-    if (topology.flat) {
-        dispatch_loop(sock, _send_flat, &topology.nodes);
-    }
-    else {
-        dispatch_loop(sock, _send_topology, &topology);
+    puts("entering loop…");
+    for (unsigned i = 1; i < num_workers; ++i) {
+        if (pthread_create(&workers[i].thread, NULL, dispatch_loop, &workers[i])) {
+            fprintf(stderr, "can't start worker %u\n", i);
+            exit(1);
+        }
     }
+    dispatch_loop(&workers[0]);
 
-    close(sock);
+    for (unsigned i = 0; i < num_workers; ++i) {
+        close(workers[i].sock);
+    }
 
     return 0;
 }
@@ -67,7 +67,7 @@ static void node_name(struct node *n, unsigned idx)
     do {
         uint8_t rem = idx % 26;
         *s++ = 'A' + rem;
-        idx -= rem;
+        idx /= 26;
     } while (idx && s != end);
     *s = 0;
 }
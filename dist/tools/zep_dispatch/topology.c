@@ -6,6 +6,7 @@
  */
 
 #include <arpa/inet.h>
+#include <inttypes.h>
 #include <netdb.h>
 #include <stdbool.h>
 #include <stdio.h>
@@ -16,10 +17,19 @@
 
 #include "kernel_defines.h"
 #include "topology.h"
-#include "zep_parser.h"
 
 #define NODE_NAME_MAX_LEN   32
 #define HW_ADDR_MAX_LEN      8
+#define INDEX_SIZE_MIN      16
+
+struct link {
+    struct node *dst;
+    float weight;
+    uint64_t frames;        /* frames sent over the link */
+    uint64_t bytes;         /* bytes sent over the link */
+    uint64_t lost;          /* frames lost on the link */
+    uint64_t frames_last;   /* frames when statistics were last printed */
+};
 
 struct node {
     list_node_t next;
@@ -27,6 +37,10 @@ struct node {
     uint8_t mac[HW_ADDR_MAX_LEN];
     struct sockaddr_in6 addr;
     uint8_t mac_len;
+    struct link *links;         /* links to the neighbors of the node */
+    unsigned num_links;
+    struct node *next_addr;     /* next node in the socket address bucket */
+    struct node *next_mac;      /* next node in the l2 address bucket */
 };
 
 struct edge {
@@ -53,6 +67,101 @@ static char *_fmt_addr(char *out, size_t out_len, const uint8_t *addr, uint8_t a
     return start;
 }
 
+/* FNV-1a */
+static uint32_t _hash(const void *data, size_t len)
+{
+    const uint8_t *p = data;
+    uint32_t hash = 2166136261U;
+
+    while (len--) {
+        hash = (hash ^ *p++) * 16777619U;
+    }
+
+    return hash;
+}
+
+static struct node **_addr_bucket(const topology_t *t,
+                                  const struct sockaddr_in6 *addr)
+{
+    uint32_t hash = _hash(&addr->sin6_addr, sizeof(addr->sin6_addr))
+                  ^ addr->sin6_port;
+
+    return &t->addr_index[hash & t->index_mask];
+}
+
+static struct node **_mac_bucket(const topology_t *t, const uint8_t *mac,
+                                 uint8_t mac_len)
+{
+    return &t->mac_index[_hash(mac, mac_len) & t->index_mask];
+}
+
+static struct node *_find_node_by_addr(const topology_t *t,
+                                       const struct sockaddr_in6 *addr)
+{
+    for (struct node *n = *_addr_bucket(t, addr); n; n = n->next_addr) {
+        if (memcmp(&n->addr, addr, sizeof(*addr)) == 0) {
+            return n;
+        }
+    }
+
+    return NULL;
+}
+
+static struct node *_find_node_by_mac(const topology_t *t, const uint8_t *mac,
+                                      uint8_t mac_len)
+{
+    for (struct node *n = *_mac_bucket(t, mac, mac_len); n; n = n->next_mac) {
+        if ((n->mac_len == mac_len) && (memcmp(n->mac, mac, mac_len) == 0)) {
+            return n;
+        }
+    }
+
+    return NULL;
+}
+
+static void _add_link(struct node *src, struct node *dst, float weight)
+{
+    if (weight > 0) {
+        struct link *l = &src->links[src->num_links++];
+        l->dst = dst;
+        l->weight = weight;
+    }
+}
+
+/* turn the edge list into per-node link arrays and set up the indices */
+static void _build_index(topology_t *t)
+{
+    unsigned num_nodes = 0;
+    unsigned size = INDEX_SIZE_MIN;
+
+    for (list_node_t *edge = t->edges.next; edge; edge = edge->next) {
+        struct edge *super = container_of(edge, struct edge, next);
+        super->a->num_links += super->weight_a_b > 0;
+        super->b->num_links += super->weight_b_a > 0;
+    }
+
+    for (list_node_t *node = t->nodes.next; node; node = node->next) {
+        struct node *super = container_of(node, struct node, next);
+        super->links = calloc(super->num_links, sizeof(*super->links));
+        super->num_links = 0;
+        ++num_nodes;
+    }
+
+    for (list_node_t *edge = t->edges.next; edge; edge = edge->next) {
+        struct edge *super = container_of(edge, struct edge, next);
+        _add_link(super->a, super->b, super->weight_a_b);
+        _add_link(super->b, super->a, super->weight_b_a);
+    }
+
+    /* keep the buckets short */
+    while (size < 2 * num_nodes) {
+        size *= 2;
+    }
+    t->addr_index = calloc(size, sizeof(*t->addr_index));
+    t->mac_index = calloc(size, sizeof(*t->mac_index));
+    t->index_mask = size - 1;
+}
+
 static struct node *_find_node_by_name(const list_node_t *nodes, const char *name)
 {
     for (list_node_t *node = nodes->next; node; node = node->next) {
@@ -70,9 +179,8 @@ static struct node *_find_or_create_node(list_node_t *nodes, const char *name)
     struct node *node = _find_node_by_name(nodes, name);
 
     if (node == NULL) {
-        node = malloc(sizeof(*node));
+        node = calloc(1, sizeof(*node));
         strncpy(node->name, name, sizeof(node->name) - 1);
-        node->mac_len = 0;
         list_add(nodes, &node->next);
     }
 
@@ -198,46 +306,80 @@ int topology_parse(const char *file, topology_t *out)
         free(line);
     }
 
+    _build_index(out);
+    pthread_rwlock_init(&out->lock, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &out->last_stats);
+
     return 0;
 }
 
-void topology_send(const topology_t *t, int sock,
+void topology_send(topology_t *t, zep_tx_queue_t *q, unsigned *seed,
                    const struct sockaddr_in6 *src_addr,
                    void *buffer, size_t len)
 {
+    pthread_rwlock_rdlock(&t->lock);
+
     if (t->has_sniffer) {
-        sendto(sock, buffer, len, 0,
-               (struct sockaddr *)&t->sniffer_addr, sizeof(t->sniffer_addr));
+        zep_tx_add(q, &t->sniffer_addr, buffer, len, -1);
     }
 
-    for (list_node_t *edge = t->edges.next; edge; edge = edge->next) {
-        struct edge *super = container_of(edge, struct edge, next);
+    struct node *src = _find_node_by_addr(t, src_addr);
 
-        if (!super->a->mac_len || !super->b->mac_len) {
+    for (unsigned i = 0; src && i < src->num_links; ++i) {
+        struct link *l = &src->links[i];
+
+        if (!l->dst->mac_len) {
             continue;
         }
 
-        if (memcmp(&super->a->addr, src_addr, sizeof(*src_addr)) == 0) {
-            /* packet loss */
-            if (random() > super->weight_a_b * RAND_MAX) {
-                return;
-            }
-            zep_set_lqi(buffer, super->weight_a_b * 0xFF);
-            sendto(sock, buffer, len, 0,
-                   (struct sockaddr *)&super->b->addr,
-                   sizeof(super->b->addr));
+        /* packet loss */
+        if (rand_r(seed) > l->weight * RAND_MAX) {
+            __atomic_fetch_add(&l->lost, 1, __ATOMIC_RELAXED);
+            continue;
         }
-        else if (memcmp(&super->b->addr, src_addr, sizeof(*src_addr)) == 0) {
-            /* packet loss */
-            if (random() > super->weight_b_a * RAND_MAX) {
-                return;
+
+        __atomic_fetch_add(&l->frames, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&l->bytes, len, __ATOMIC_RELAXED);
+        zep_tx_add(q, &l->dst->addr, buffer, len, l->weight * 0xFF);
+    }
+
+    pthread_rwlock_unlock(&t->lock);
+}
+
+void topology_print_stats(FILE *out, topology_t *t)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double elapsed = (now.tv_sec - t->last_stats.tv_sec)
+                   + (now.tv_nsec - t->last_stats.tv_nsec) / 1e9;
+
+    fprintf(out, "%-10s %-10s %12s %14s %10s %10s\n",
+            "from", "to", "frames", "bytes", "lost", "frames/s");
+
+    pthread_rwlock_rdlock(&t->lock);
+    for (list_node_t *node = t->nodes.next; node; node = node->next) {
+        struct node *super = container_of(node, struct node, next);
+
+        for (unsigned i = 0; i < super->num_links; ++i) {
+            struct link *l = &super->links[i];
+            uint64_t frames = __atomic_load_n(&l->frames, __ATOMIC_RELAXED);
+            uint64_t lost = __atomic_load_n(&l->lost, __ATOMIC_RELAXED);
+
+            if (!frames && !lost) {
+                continue;
             }
-            zep_set_lqi(buffer, super->weight_b_a * 0xFF);
-            sendto(sock, buffer, len, 0,
-                   (struct sockaddr *)&super->a->addr,
-                   sizeof(super->a->addr));
+
+            fprintf(out, "%-10s %-10s %12" PRIu64 " %14" PRIu64 " %10" PRIu64
+                         " %10.0f\n", super->name, l->dst->name, frames,
+                    __atomic_load_n(&l->bytes, __ATOMIC_RELAXED), lost,
+                    (frames - l->frames_last) / elapsed);
+            l->frames_last = frames;
         }
     }
+    pthread_rwlock_unlock(&t->lock);
+
+    t->last_stats = now;
 }
 
 bool topology_add(topology_t *t, const uint8_t *mac, uint8_t mac_len,
@@ -251,27 +393,35 @@ bool topology_add(topology_t *t, const uint8_t *mac, uint8_t mac_len,
         return false;
     }
 
+    /* fast path: node is already in the topology */
+    pthread_rwlock_rdlock(&t->lock);
+    bool known = _find_node_by_mac(t, mac, mac_len) != NULL;
+    pthread_rwlock_unlock(&t->lock);
+
+    if (known) {
+        return true;
+    }
+
+    pthread_rwlock_wrlock(&t->lock);
+
+    /* another thread may have added the node in the meantime */
+    if (_find_node_by_mac(t, mac, mac_len)) {
+        pthread_rwlock_unlock(&t->lock);
+        return true;
+    }
+
     for (list_node_t *node = t->nodes.next; node; node = node->next) {
         struct node *super = container_of(node, struct node, next);
 
         /* store free node */
         if (!super->mac_len) {
             empty = super;
-            continue;
-        }
-
-        if (mac_len != super->mac_len) {
-            continue;
-        }
-
-        /* abort if node is already in list */
-        if (memcmp(super->mac, mac, mac_len) == 0) {
-            return true;
         }
     }
 
     /* topology full - can't add node */
     if (empty == NULL) {
+        pthread_rwlock_unlock(&t->lock);
         fprintf(stderr, "can't add %s - topology full\n",
                 _fmt_addr(addr_str, sizeof(addr_str), mac, mac_len));
         return false;
@@ -284,6 +434,16 @@ bool topology_add(topology_t *t, const uint8_t *mac, uint8_t mac_len,
     memcpy(&empty->addr, addr, sizeof(empty->addr));
     empty->mac_len = mac_len;
 
+    struct node **bucket = _addr_bucket(t, addr);
+    empty->next_addr = *bucket;
+    *bucket = empty;
+
+    bucket = _mac_bucket(t, mac, mac_len);
+    empty->next_mac = *bucket;
+    *bucket = empty;
+
+    pthread_rwlock_unlock(&t->lock);
+
     return true;
 }
 
@@ -298,6 +458,8 @@ void topology_set_sniffer(topology_t *t, struct sockaddr_in6 *addr)
         printf("adding sniffer %s\n", addr_str);
     }
 
+    pthread_rwlock_wrlock(&t->lock);
     memcpy(&t->sniffer_addr, addr, sizeof(t->sniffer_addr));
     t->has_sniffer = true;
+    pthread_rwlock_unlock(&t->lock);
 }
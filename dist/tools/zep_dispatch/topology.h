@@ -10,13 +10,23 @@
 
 #include "list.h"
 #include <netinet/in.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "batch.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+struct node;
+
 /**
  * @brief   Struct describing a graph of nodes and their connections
+ *
+ * Nodes are found by their socket address and by their l2 address through
+ * hash tables, every node has an array of the links to its neighbors.
  */
 typedef struct {
     list_node_t nodes;  /**< list of nodes */
@@ -24,6 +34,11 @@ typedef struct {
     struct sockaddr_in6 sniffer_addr;   /**< address of sniffer node. Unused if topology is flat */
     bool has_sniffer;   /**< true if a sniffer node is connected. Unused if topology is flat */
     bool flat;          /**< flat topology, all nodes are connected to each other */
+    struct node **addr_index;   /**< connected nodes by socket address */
+    struct node **mac_index;    /**< connected nodes by l2 address */
+    unsigned index_mask;        /**< number of hash buckets - 1 */
+    pthread_rwlock_t lock;      /**< protects nodes against concurrent adds */
+    struct timespec last_stats; /**< time the statistics were last printed */
 } topology_t;
 
 /**
@@ -72,18 +87,31 @@ bool topology_add(topology_t *t, const uint8_t *mac, uint8_t mac_len,
 void topology_set_sniffer(topology_t *t, struct sockaddr_in6 *addr);
 
 /**
- * @brief   Send a buffer to all nodes connected to a source node
+ * @brief   Queue a buffer for all nodes connected to a source node
  *
  * @param[in] t             topology to use
- * @param[in] sock          socket to use for sending
+ * @param[in, out] q        queue to send the buffer with
+ * @param[in, out] seed     state of the random number generator that
+ *                          simulates packet loss
  * @param[in] src_addr      source node address
- * @param[in] buffer        ZEP frame to send
+ * @param[in] buffer        ZEP frame to send, must stay valid until @p q is
+ *                          flushed
  * @param[in] len           ZEP frame length
  */
-void topology_send(const topology_t *t, int sock,
+void topology_send(topology_t *t, zep_tx_queue_t *q, unsigned *seed,
                    const struct sockaddr_in6 *src_addr,
                    void *buffer, size_t len);
 
+/**
+ * @brief   Print the number of frames sent and lost on every link
+ *
+ * The throughput is calculated since the last call.
+ *
+ * @param[in] out           stream to print to
+ * @param[in, out] t        topology to use
+ */
+void topology_print_stats(FILE *out, topology_t *t);
+
 #ifdef __cplusplus
 }
 #endif
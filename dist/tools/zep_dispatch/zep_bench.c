@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU General Public
+ * License v2. See the file LICENSE for more details.
+ */
+
+/*
+ * Load generator for the ZEP dispatcher: simulates a number of nodes that
+ * each send IEEE 802.15.4 frames to the dispatcher and counts the frames
+ * the dispatcher forwards to them.
+ */
+
+/* before the system headers, they define htons() & co as macros */
+#include "net/ieee802154.h"
+#include "net/zep.h"
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#define FRAME_LEN_MAX   (sizeof(zep_v2_data_hdr_t) + IEEE802154_FRAME_LEN_MAX)
+#define FCS_LEN         (2)
+
+struct bench_node {
+    int sock;
+    uint8_t frame[FRAME_LEN_MAX];
+    size_t frame_len;
+    uint32_t seq;
+};
+
+static uint64_t _now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static void _node_init(struct bench_node *n, unsigned idx, size_t payload_len,
+                       const struct addrinfo *dispatcher)
+{
+    const uint8_t dst[] = IEEE802154_ADDR_BCAST;
+    const le_uint16_t pan = { .u16 = 0x23 };
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN] = { 0x02, 'Z', 'E', 'P' };
+    zep_v2_data_hdr_t *zep = (void *)n->frame;
+    uint8_t *mhr = (uint8_t *)(zep + 1);
+
+    src[4] = idx >> 24;
+    src[5] = idx >> 16;
+    src[6] = idx >> 8;
+    src[7] = idx;
+
+    size_t mhr_len = ieee802154_set_frame_hdr(mhr, src, sizeof(src),
+                                              dst, sizeof(dst), pan, pan,
+                                              IEEE802154_FCF_TYPE_DATA, 0);
+    size_t psdu_len = mhr_len + payload_len + FCS_LEN;
+
+    if (psdu_len > IEEE802154_FRAME_LEN_MAX) {
+        psdu_len = IEEE802154_FRAME_LEN_MAX;
+    }
+
+    memset(zep, 0, sizeof(*zep));
+    zep->hdr.preamble[0] = 'E';
+    zep->hdr.preamble[1] = 'X';
+    zep->hdr.version = 2;
+    zep->type = ZEP_V2_TYPE_DATA;
+    zep->chan = 26;
+    zep->dev = byteorder_htons(idx);
+    zep->lqi_mode = 1;
+    zep->lqi_val = 0xff;
+    zep->length = psdu_len;
+    memset(mhr + mhr_len, 0xaa, psdu_len - mhr_len);
+    n->frame_len = sizeof(*zep) + psdu_len;
+
+    n->sock = socket(dispatcher->ai_family, dispatcher->ai_socktype,
+                     dispatcher->ai_protocol);
+    if (n->sock < 0) {
+        perror("socket() failed");
+        exit(1);
+    }
+
+    /* only receive frames from the dispatcher */
+    if (connect(n->sock, dispatcher->ai_addr, dispatcher->ai_addrlen) < 0) {
+        perror("connect() failed");
+        exit(1);
+    }
+
+    fcntl(n->sock, F_SETFL, fcntl(n->sock, F_GETFL) | O_NONBLOCK);
+}
+
+static bool _node_send(struct bench_node *n)
+{
+    zep_v2_data_hdr_t *zep = (void *)n->frame;
+
+    zep->seq = byteorder_htonl(n->seq++);
+    return send(n->sock, n->frame, n->frame_len, 0) > 0;
+}
+
+/* receive all frames that are available, waiting up to timeout_ms */
+static uint64_t _drain(struct bench_node *nodes, struct pollfd *fds,
+                       unsigned num, int timeout_ms)
+{
+    uint8_t buf[FRAME_LEN_MAX];
+    uint64_t received = 0;
+
+    if (poll(fds, num, timeout_ms) <= 0) {
+        return 0;
+    }
+
+    for (unsigned i = 0; i < num; ++i) {
+        if (!(fds[i].revents & POLLIN)) {
+            continue;
+        }
+        while (recv(nodes[i].sock, buf, sizeof(buf), 0) > 0) {
+            ++received;
+        }
+    }
+
+    return received;
+}
+
+static void _print_help(const char *progname)
+{
+    fprintf(stderr, "usage: %s [-n nodes] [-t seconds] [-r rate] [-l length] "
+                    "<address> <port>\n", progname);
+
+    fprintf(stderr, "\npositional arguments:\n");
+    fprintf(stderr, "\taddress\t\taddress of the ZEP dispatcher\n");
+    fprintf(stderr, "\tport\t\tport of the ZEP dispatcher\n");
+
+    fprintf(stderr, "\noptional arguments:\n");
+    fprintf(stderr, "\t-n <num>\tNumber of simulated nodes (default: 100)\n");
+    fprintf(stderr, "\t-t <sec>\tDuration of the benchmark (default: 10)\n");
+    fprintf(stderr, "\t-r <rate>\tFrames per second sent by each node "
+                    "(default: as fast as possible)\n");
+    fprintf(stderr, "\t-l <len>\tPayload length of the frames (default: 50)\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *progname = argv[0];
+    unsigned num = 100;
+    unsigned duration = 10;
+    unsigned rate = 0;
+    size_t payload_len = 50;
+    int c;
+
+    while ((c = getopt(argc, argv, "n:t:r:l:")) != -1) {
+        switch (c) {
+        case 'n':
+            num = atoi(optarg);
+            break;
+        case 't':
+            duration = atoi(optarg);
+            break;
+        case 'r':
+            rate = atoi(optarg);
+            break;
+        case 'l':
+            payload_len = atoi(optarg);
+            break;
+        default:
+            _print_help(progname);
+            exit(1);
+        }
+    }
+
+    argc -= optind;
+    argv += optind;
+
+    if (argc != 2 || num == 0) {
+        _print_help(progname);
+        exit(1);
+    }
+
+    /* every node needs a socket */
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < num + 16) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    struct addrinfo hint = {
+        .ai_family   = AF_UNSPEC,
+        .ai_socktype = SOCK_DGRAM,
+        .ai_protocol = IPPROTO_UDP,
+        .ai_flags    = AI_NUMERICHOST,
+    };
+
+    struct addrinfo *dispatcher;
+    if (getaddrinfo(argv[0], argv[1], &hint, &dispatcher) != 0) {
+        perror("getaddrinfo()");
+        exit(1);
+    }
+
+    struct bench_node *nodes = calloc(num, sizeof(*nodes));
+    struct pollfd *fds = calloc(num, sizeof(*fds));
+
+    if (nodes == NULL || fds == NULL) {
+        perror("calloc() failed");
+        exit(1);
+    }
+
+    for (unsigned i = 0; i < num; ++i) {
+        _node_init(&nodes[i], i, payload_len, dispatcher);
+        fds[i].fd = nodes[i].sock;
+        fds[i].events = POLLIN;
+    }
+
+    freeaddrinfo(dispatcher);
+
+    /* the dispatcher learns the nodes from their first frame */
+    for (unsigned i = 0; i < num; ++i) {
+        _node_send(&nodes[i]);
+    }
+    while (_drain(nodes, fds, num, 500)) {}
+
+    uint64_t sent = 0;
+    uint64_t received = 0;
+    uint64_t start = _now_us();
+    uint64_t end = start + duration * 1000000ULL;
+    uint64_t interval = rate ? 1000000ULL / rate : 0;
+    uint64_t next = start;
+
+    while (_now_us() < end) {
+        for (unsigned i = 0; i < num; ++i) {
+            sent += _node_send(&nodes[i]);
+        }
+        received += _drain(nodes, fds, num, 0);
+
+        if (interval) {
+            next += interval;
+            while (_now_us() < next) {
+                received += _drain(nodes, fds, num, (next - _now_us()) / 1000);
+            }
+        }
+    }
+
+    double elapsed = (_now_us() - start) / 1e6;
+
+    /* collect the frames still in flight */
+    uint64_t more;
+    while ((more = _drain(nodes, fds, num, 500))) {
+        received += more;
+    }
+
+    printf("nodes: %u, duration: %.2f s\n", num, elapsed);
+    printf("sent: %" PRIu64 " frames (%.0f frames/s)\n", sent, sent / elapsed);
+    printf("received: %" PRIu64 " frames (%.0f frames/s)\n", received,
+           received / elapsed);
+    printf("fan-out: %.2f\n", sent ? (double)received / sent : 0.0);
+
+    for (unsigned i = 0; i < num; ++i) {
+        close(nodes[i].sock);
+    }
+
+    return 0;
+}
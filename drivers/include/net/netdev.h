@@ -98,6 +98,15 @@
  * This receive sequence can of course be simplified by skipping steps 2 and 3
  * when using fixed sized pre-allocated buffers or similar means. *
  *
+ * Drivers that provide @ref netdev_driver_t::recv_iol "recv_iol()" let the
+ * upper layer lend them buffers for the frame instead: the upper layer
+ * allocates buffers large enough for the frame (asking for its size as in
+ * step 2) or for any frame, e.g. directly in its packet buffer, and the driver
+ * writes the frame there in a single call. As the
+ * buffers are passed as an @ref iolist_t, the link layer header and the
+ * payload can be received into separate buffers, so the payload does not
+ * have to be moved to strip the header afterwards.
+ *
  * @note    The @ref netdev_driver_t::send "send()" and
  *          @ref netdev_driver_t::recv "recv()" functions **must** never be
  *          called from interrupt context.
@@ -509,6 +518,36 @@ typedef struct netdev_driver {
      */
     int (*recv)(netdev_t *dev, void *buf, size_t len, void *info);
 
+    /**
+     * @brief   Get a received frame into buffers lent by the upper layer
+     *
+     * @pre     `(dev != NULL) && (iolist != NULL)`
+     *
+     * Optional, may be NULL. If provided, it may be called from
+     * @ref netdev_t::event_callback "netdev->event_callback()" instead of
+     * @ref netdev_driver_t::recv "recv()" without asking for the frame size
+     * first.
+     *
+     * The frame is written to the buffers of @p iolist in order. The driver
+     * writes it there directly from the device or its DMA buffers, so the
+     * frame is not copied through an intermediate buffer.
+     *
+     * If the frame does not fit into @p iolist, it is dropped and `-ENOBUFS`
+     * is returned. The content of the buffers becomes invalid in that case.
+     * To drop a frame without reading it, call
+     * @ref netdev_driver_t::recv "recv()" with `buf == NULL` and `len > 0`.
+     *
+     * @param[in]   dev     network device descriptor. Must not be NULL.
+     * @param[out]  iolist  buffers to write the frame into
+     * @param[out]  info    status information for the received frame, same
+     *                      as for @ref netdev_driver_t::recv "recv()"
+     *
+     * @retval  -ENOBUFS    if the frame does not fit into @p iolist
+     * @retval  <0          other error
+     * @return  number of bytes written to @p iolist, 0 if there was no frame
+     */
+    int (*recv_iol)(netdev_t *dev, const iolist_t *iolist, void *info);
+
     /**
      * @brief   the driver's initialization function
      *
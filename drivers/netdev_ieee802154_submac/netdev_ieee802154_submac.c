@@ -264,6 +264,22 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     return res;
 }
 
+static int _recv_iol(netdev_t *netdev, const iolist_t *iolist, void *info)
+{
+    if (iolist->iol_next == NULL) {
+        return _recv(netdev, iolist->iol_base, iolist->iol_len, info);
+    }
+
+    /* the radio HAL only reads into a single buffer */
+    uint8_t frame[IEEE802154_FRAME_LEN_MAX];
+    int res = _recv(netdev, frame, sizeof(frame), info);
+
+    if ((res > 0) && (iolist_fill(iolist, 0, frame, res) < (size_t)res)) {
+        return -ENOBUFS;
+    }
+    return res;
+}
+
 static void submac_tx_done(ieee802154_submac_t *submac, int status,
                            ieee802154_tx_info_t *info)
 {
@@ -391,6 +407,7 @@ static const netdev_driver_t netdev_submac_driver = {
     .set = _set,
     .send = _send,
     .recv = _recv,
+    .recv_iol = _recv_iol,
     .isr = _isr,
     .init = _init,
 };
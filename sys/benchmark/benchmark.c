@@ -19,9 +19,12 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "timex.h"
 
 #include "benchmark.h"
+#include "cycle_counter.h"
 
 void benchmark_print_time(uint32_t time, unsigned long runs, const char *name)
 {
@@ -35,3 +38,160 @@ void benchmark_print_time(uint32_t time, unsigned long runs, const char *name)
            "  ---  %9" PRIu32 " calls per sec\n",
            name, time, full, div, per_sec);
 }
+
+uint32_t benchmark_now(void)
+{
+#if CYCLE_COUNTER_AVAILABLE
+    return cycle_counter_now();
+#else
+    return ztimer_now(ZTIMER_USEC);
+#endif
+}
+
+uint32_t benchmark_ticks_per_sec(void)
+{
+#if CYCLE_COUNTER_AVAILABLE
+    return cycle_counter_freq();
+#else
+    return US_PER_SEC;
+#endif
+}
+
+void benchmark_init(benchmark_t *bench, const char *name)
+{
+#if CYCLE_COUNTER_AVAILABLE
+    cycle_counter_init();
+#endif
+    memset(bench, 0, sizeof(*bench));
+    bench->name = name;
+    bench->stats = MATSTAT_STATE_INIT;
+}
+
+bool benchmark_add_sample(benchmark_t *bench, uint32_t ticks, uint32_t calls)
+{
+    uint64_t ns = ((uint64_t)ticks * NS_PER_SEC) /
+                  ((uint64_t)benchmark_ticks_per_sec() * calls);
+    int32_t val = (ns > INT32_MAX) ? INT32_MAX : (int32_t)ns;
+
+    bench->iterations = calls;
+    if (bench->count >= CONFIG_BENCHMARK_WARMUP) {
+        unsigned idx = bench->count - CONFIG_BENCHMARK_WARMUP;
+        if (idx >= CONFIG_BENCHMARK_SAMPLES) {
+            return true;
+        }
+        bench->samples[idx] = val;
+        matstat_add(&bench->stats, val);
+    }
+    bench->count++;
+
+    return bench->count >= CONFIG_BENCHMARK_WARMUP + CONFIG_BENCHMARK_SAMPLES;
+}
+
+uint32_t benchmark_next(benchmark_t *bench)
+{
+    uint32_t ticks = benchmark_now() - bench->start;
+
+    if (bench->iterations == 0) {
+        /* the very first call only starts the calibration */
+        bench->iterations = 1;
+    }
+    else if (!bench->calibrated) {
+        uint64_t min = ((uint64_t)CONFIG_BENCHMARK_SAMPLE_MIN_US *
+                        benchmark_ticks_per_sec()) / US_PER_SEC;
+
+        if ((ticks < min) && (bench->iterations < (UINT32_MAX / 2))) {
+            bench->iterations *= 2;
+        }
+        else {
+            /* the calibration run doubles as first warm-up sample */
+            bench->calibrated = true;
+            benchmark_add_sample(bench, ticks, bench->iterations);
+        }
+    }
+    else if (benchmark_add_sample(bench, ticks, bench->iterations)) {
+        return 0;
+    }
+
+    bench->start = benchmark_now();
+    return bench->iterations;
+}
+
+static int _cmp(const void *a, const void *b)
+{
+    int32_t x = *(const int32_t *)a;
+    int32_t y = *(const int32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static uint32_t _isqrt(uint64_t x)
+{
+    uint64_t res = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        }
+        else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+void benchmark_result(benchmark_t *bench, benchmark_result_t *res)
+{
+    unsigned n = bench->stats.count;
+
+    memset(res, 0, sizeof(*res));
+    if (n == 0) {
+        return;
+    }
+    qsort(bench->samples, n, sizeof(bench->samples[0]), _cmp);
+
+    res->min = bench->stats.min;
+    res->max = bench->stats.max;
+    res->mean = matstat_mean(&bench->stats);
+    res->stddev = _isqrt(matstat_variance(&bench->stats));
+    res->median = (n & 1) ? bench->samples[n / 2]
+                          : (bench->samples[n / 2 - 1] / 2 +
+                             bench->samples[n / 2] / 2);
+    /* nearest rank: ceil(0.99 * n) */
+    res->p99 = bench->samples[(99 * n + 99) / 100 - 1];
+}
+
+static void _dict_s32(turo_t *ctx, const char *key, int32_t val)
+{
+    turo_dict_key(ctx, key);
+    turo_s32(ctx, val);
+}
+
+void benchmark_turo(turo_t *ctx, benchmark_t *bench)
+{
+    benchmark_result_t res;
+
+    benchmark_result(bench, &res);
+
+    turo_dict_open(ctx);
+    turo_dict_key(ctx, "name");
+    turo_string(ctx, bench->name);
+    turo_dict_key(ctx, "clock");
+    turo_string(ctx, CYCLE_COUNTER_AVAILABLE ? "cycles" : "usec");
+    turo_dict_key(ctx, "iterations");
+    turo_u32(ctx, bench->iterations);
+    _dict_s32(ctx, "samples", bench->stats.count);
+    _dict_s32(ctx, "min_ns", res.min);
+    _dict_s32(ctx, "median_ns", res.median);
+    _dict_s32(ctx, "p99_ns", res.p99);
+    _dict_s32(ctx, "max_ns", res.max);
+    _dict_s32(ctx, "mean_ns", res.mean);
+    turo_dict_key(ctx, "stddev_ns");
+    turo_u32(ctx, res.stddev);
+    turo_dict_close(ctx);
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include "timex.h"
+
+#include "congure/cocoa.h"
+
+/**
+ * @brief   Exchanges retransmitted more often than this are not used for
+ *          estimation
+ */
+#define COCOA_WEAK_RESENDS_MAX  (2U)
+
+static void _snd_init(congure_snd_t *cong, void *ctx);
+static int32_t _snd_inter_msg_interval(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msg_sent(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msg_discarded(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msgs_lost(congure_snd_t *cong, congure_snd_msg_t *msgs);
+static void _snd_report_msg_acked(congure_snd_t *cong, congure_snd_msg_t *msg,
+                                  congure_snd_ack_t *ack);
+static void _snd_report_ecn_ce(congure_snd_t *cong, ztimer_now_t time);
+
+static const congure_snd_driver_t _driver = {
+    .init = _snd_init,
+    .inter_msg_interval = _snd_inter_msg_interval,
+    .report_msg_sent = _snd_report_msg_sent,
+    .report_msg_discarded = _snd_report_msg_discarded,
+    /* the backoff of the exchange already reacts to timeouts */
+    .report_msgs_timeout = _snd_report_msgs_lost,
+    .report_msgs_lost = _snd_report_msgs_lost,
+    .report_msg_acked = _snd_report_msg_acked,
+    .report_ecn_ce = _snd_report_ecn_ce,
+};
+
+void congure_cocoa_snd_setup(congure_cocoa_snd_t *c)
+{
+    c->super.driver = &_driver;
+}
+
+static inline uint32_t _limit(uint32_t rto)
+{
+    return (rto > CONFIG_CONGURE_COCOA_MAX_RTO_MS)
+         ? CONFIG_CONGURE_COCOA_MAX_RTO_MS : rto;
+}
+
+uint32_t congure_cocoa_get_rto(congure_cocoa_snd_t *c, ztimer_now_t now)
+{
+    /* a small RTO is doubled after 16 RTOs without new estimate */
+    while ((c->rto < MS_PER_SEC) &&
+           ((uint32_t)(now - c->rto_time) >= (16 * c->rto))) {
+        c->rto_time += 16 * c->rto;
+        c->rto *= 2;
+    }
+    /* a large RTO moves halfway to 2 s after 4 RTOs without new estimate */
+    while ((c->rto > (3 * MS_PER_SEC)) &&
+           ((uint32_t)(now - c->rto_time) >= (4 * c->rto))) {
+        c->rto_time += 4 * c->rto;
+        c->rto = (2 * MS_PER_SEC + c->rto) / 2;
+    }
+    return c->rto;
+}
+
+uint32_t congure_cocoa_backoff(uint32_t timeout)
+{
+    /* variable backoff factor */
+    if (timeout < MS_PER_SEC) {
+        return _limit(timeout * 3);
+    }
+    else if (timeout > (3 * MS_PER_SEC)) {
+        return _limit(timeout + timeout / 2);
+    }
+    return _limit(timeout * 2);
+}
+
+static void _snd_init(congure_snd_t *cong, void *ctx)
+{
+    congure_cocoa_snd_t *c = (congure_cocoa_snd_t *)cong;
+
+    c->super.ctx = ctx;
+    /* NSTART = 1 */
+    c->super.cwnd = 1;
+    c->strong.srtt = 0;
+    c->strong.rttvar = 0;
+    c->weak.srtt = 0;
+    c->weak.rttvar = 0;
+    c->rto = CONFIG_CONGURE_COCOA_INITIAL_RTO_MS;
+    c->rto_time = 0;
+}
+
+static int32_t _snd_inter_msg_interval(congure_snd_t *cong, unsigned msg_size)
+{
+    (void)cong;
+    (void)msg_size;
+    /* no pacing */
+    return -1;
+}
+
+static void _snd_report_msg_sent(congure_snd_t *cong, unsigned msg_size)
+{
+    (void)cong;
+    (void)msg_size;
+}
+
+static void _snd_report_msg_discarded(congure_snd_t *cong, unsigned msg_size)
+{
+    (void)cong;
+    (void)msg_size;
+}
+
+static void _snd_report_msgs_lost(congure_snd_t *cong, congure_snd_msg_t *msgs)
+{
+    (void)cong;
+    (void)msgs;
+}
+
+/* returns SRTT + k * RTTVAR after adding the sample (RFC 6298, section 2) */
+static uint32_t _estimate(congure_cocoa_rtt_t *est, uint32_t rtt, unsigned k)
+{
+    if (est->srtt == 0) {
+        est->srtt = rtt;
+        est->rttvar = rtt / 2;
+    }
+    else {
+        uint32_t diff = (est->srtt > rtt) ? est->srtt - rtt : rtt - est->srtt;
+
+        est->rttvar = (3 * est->rttvar + diff) / 4;
+        est->srtt = (7 * est->srtt + rtt) / 8;
+    }
+    return est->srtt + k * est->rttvar;
+}
+
+static void _snd_report_msg_acked(congure_snd_t *cong, congure_snd_msg_t *msg,
+                                  congure_snd_ack_t *ack)
+{
+    congure_cocoa_snd_t *c = (congure_cocoa_snd_t *)cong;
+    uint32_t rtt = ack->recv_time - msg->send_time;
+
+    /* 0 marks an estimator without samples */
+    if (rtt == 0) {
+        rtt = 1;
+    }
+    if (msg->resends == 0) {
+        uint32_t rto = _estimate(&c->strong, rtt, 4);
+
+        c->rto = _limit((rto + c->rto) / 2);
+    }
+    else if (msg->resends <= COCOA_WEAK_RESENDS_MAX) {
+        uint32_t rto = _estimate(&c->weak, rtt, 1);
+
+        c->rto = _limit((rto + 3 * c->rto) / 4);
+    }
+    else {
+        return;
+    }
+    c->rto_time = ack->recv_time;
+}
+
+static void _snd_report_ecn_ce(congure_snd_t *cong, ztimer_now_t time)
+{
+    (void)cong;
+    (void)time;
+}
+
+/** @} */
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include "congure/cubic.h"
+
+/**
+ * @brief   Maximum distance in ms to the plateau the cubic function is
+ *          evaluated for
+ *
+ * Keeps the cube within 64 bit. The window is limited to
+ * @ref CONGURE_WND_SIZE_MAX long before that distance is reached.
+ */
+#define CUBIC_DT_MAX            (30000)
+
+static void _init(congure_reno_snd_t *c);
+static void _ca_cwnd_inc(congure_reno_snd_t *c, const congure_snd_msg_t *msg,
+                         const congure_snd_ack_t *ack);
+static void _ssthresh_dec(congure_reno_snd_t *c);
+
+static const congure_reno_snd_methods_t _methods = {
+    .init = _init,
+    .ca_cwnd_inc = _ca_cwnd_inc,
+    .ssthresh_dec = _ssthresh_dec,
+};
+
+void congure_cubic_snd_setup(congure_cubic_snd_t *c,
+                             const congure_reno_snd_consts_t *consts)
+{
+    congure_reno_snd_setup(&c->super, consts);
+    c->super.methods = &_methods;
+}
+
+static inline congure_wnd_size_t _clamp(uint32_t wnd)
+{
+    return (wnd > CONGURE_WND_SIZE_MAX) ? CONGURE_WND_SIZE_MAX : wnd;
+}
+
+/* integer cube root, see Hacker's Delight, section 11-2 */
+static uint32_t _cbrt(uint64_t x)
+{
+    uint64_t y = 0;
+
+    for (int s = 63; s >= 0; s -= 3) {
+        uint64_t b;
+
+        y <<= 1;
+        b = 3 * y * (y + 1) + 1;
+        if ((x >> s) >= b) {
+            x -= b << s;
+            y++;
+        }
+    }
+    return y;
+}
+
+/* W_cubic(t) of RFC 8312, equation (1), with t in ms since the epoch start */
+static uint32_t _w_cubic(const congure_cubic_snd_t *c, uint32_t t)
+{
+    int64_t dt = (int64_t)t - c->k;
+    int64_t w;
+
+    if (dt > CUBIC_DT_MAX) {
+        dt = CUBIC_DT_MAX;
+    }
+    else if (dt < -CUBIC_DT_MAX) {
+        dt = -CUBIC_DT_MAX;
+    }
+    /* C = 0.4 per s^3 and MSS, so 4 / 10^10 per ms^3 and MSS */
+    w = c->origin + (4 * dt * dt * dt * c->super.mss) / 10000000000LL;
+    return (w < 0) ? 0 : (uint32_t)w;
+}
+
+static void _init(congure_reno_snd_t *c)
+{
+    congure_cubic_snd_t *cubic = (congure_cubic_snd_t *)c;
+
+    cubic->k = 0;
+    cubic->min_rtt = UINT32_MAX;
+    cubic->w_est = 0;
+    cubic->w_max = 0;
+    cubic->origin = 0;
+    cubic->in_epoch = false;
+}
+
+static void _ca_cwnd_inc(congure_reno_snd_t *c, const congure_snd_msg_t *msg,
+                         const congure_snd_ack_t *ack)
+{
+    congure_cubic_snd_t *cubic = (congure_cubic_snd_t *)c;
+    uint32_t cwnd = c->super.cwnd;
+    uint32_t target, t;
+
+    if (msg->resends == 0) {
+        uint32_t rtt = ack->recv_time - msg->send_time;
+
+        if ((rtt > 0) && (rtt < cubic->min_rtt)) {
+            cubic->min_rtt = rtt;
+        }
+    }
+    if (!cubic->in_epoch) {
+        cubic->in_epoch = true;
+        cubic->epoch_start = ack->recv_time;
+        cubic->w_est = cwnd;
+        if (cwnd < cubic->w_max) {
+            /* K = cubic_root((W_max - cwnd) / C), RFC 8312, equation (2) */
+            cubic->k = _cbrt(((uint64_t)(cubic->w_max - cwnd) * 2500000000ULL) /
+                             c->mss);
+            cubic->origin = cubic->w_max;
+        }
+        else {
+            cubic->k = 0;
+            cubic->origin = cwnd;
+        }
+    }
+    t = ack->recv_time - cubic->epoch_start;
+
+    /* TCP-friendly region, RFC 8312, section 4.2, with
+     * 3 * (1 - beta) / (1 + beta) = 9 / 17 */
+    cubic->w_est += ((uint64_t)9 * msg->size * c->mss) / (17 * cwnd);
+    cubic->w_est = _clamp(cubic->w_est);
+    if (_w_cubic(cubic, t) < cubic->w_est) {
+        c->super.cwnd = cubic->w_est;
+        return;
+    }
+
+    /* concave and convex region, RFC 8312, sections 4.3 and 4.4 */
+    target = _w_cubic(cubic, t + ((cubic->min_rtt == UINT32_MAX)
+                                  ? 0 : cubic->min_rtt));
+    if (target > (cwnd + cwnd / 2)) {
+        target = cwnd + cwnd / 2;
+    }
+    if (target > cwnd) {
+        uint32_t inc = ((uint64_t)(target - cwnd) * msg->size) / cwnd;
+
+        c->super.cwnd = _clamp(cwnd + ((inc > 0) ? inc : 1));
+    }
+}
+
+static void _ssthresh_dec(congure_reno_snd_t *c)
+{
+    congure_cubic_snd_t *cubic = (congure_cubic_snd_t *)c;
+    uint32_t cwnd = c->super.cwnd;
+    uint32_t ssthresh = (cwnd * 7) / 10;
+    uint32_t min = 2U * c->mss;
+
+    /* fast convergence, RFC 8312, section 4.6 */
+    if (cwnd < cubic->w_max) {
+        cubic->w_max = (cwnd * 17) / 20;
+    }
+    else {
+        cubic->w_max = cwnd;
+    }
+    /* multiplicative decrease, RFC 8312, section 4.5 */
+    c->ssthresh = _clamp((ssthresh > min) ? ssthresh : min);
+    cubic->in_epoch = false;
+}
+
+/** @} */
@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+
+#include "congure/reno.h"
+
+static void _snd_init(congure_snd_t *cong, void *ctx);
+static int32_t _snd_inter_msg_interval(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msg_sent(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msg_discarded(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msgs_lost(congure_snd_t *cong, congure_snd_msg_t *msgs);
+static void _snd_report_msgs_timeout(congure_snd_t *cong,
+                                     congure_snd_msg_t *msgs);
+static void _snd_report_msg_acked(congure_snd_t *cong, congure_snd_msg_t *msg,
+                                  congure_snd_ack_t *ack);
+static void _snd_report_ecn_ce(congure_snd_t *cong, ztimer_now_t time);
+
+static const congure_snd_driver_t _driver = {
+    .init = _snd_init,
+    .inter_msg_interval = _snd_inter_msg_interval,
+    .report_msg_sent = _snd_report_msg_sent,
+    .report_msg_discarded = _snd_report_msg_discarded,
+    .report_msgs_timeout = _snd_report_msgs_timeout,
+    .report_msgs_lost = _snd_report_msgs_lost,
+    .report_msg_acked = _snd_report_msg_acked,
+    .report_ecn_ce = _snd_report_ecn_ce,
+};
+
+void congure_reno_snd_setup(congure_reno_snd_t *c,
+                            const congure_reno_snd_consts_t *consts)
+{
+    assert(consts && consts->fr);
+    c->super.driver = &_driver;
+    c->consts = consts;
+    c->methods = NULL;
+    c->mss = consts->init_mss;
+}
+
+static inline congure_wnd_size_t _clamp(uint32_t wnd)
+{
+    return (wnd > CONGURE_WND_SIZE_MAX) ? CONGURE_WND_SIZE_MAX : wnd;
+}
+
+static void _set_ssthresh(congure_reno_snd_t *c)
+{
+    if (c->methods && c->methods->ssthresh_dec) {
+        c->methods->ssthresh_dec(c);
+    }
+    else {
+        /* RFC 5681, equation (4) */
+        uint32_t half = c->in_flight / 2;
+        uint32_t min = 2U * c->mss;
+
+        c->ssthresh = _clamp((half > min) ? half : min);
+    }
+    /* the data in flight needs to be acknowledged before the next reduction */
+    c->recover = c->in_flight;
+}
+
+static void _snd_init(congure_snd_t *cong, void *ctx)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    c->super.ctx = ctx;
+    /* initial window, RFC 5681, section 3.1 */
+    if (c->mss > 2190) {
+        c->super.cwnd = _clamp(2U * c->mss);
+    }
+    else if (c->mss > 1095) {
+        c->super.cwnd = _clamp(3U * c->mss);
+    }
+    else {
+        c->super.cwnd = _clamp(4U * c->mss);
+    }
+    c->ssthresh = CONGURE_WND_SIZE_MAX;
+    c->in_flight = 0;
+    c->recover = 0;
+    c->last_wnd = 0;
+    c->dup_acks = 0;
+    c->in_fast_recovery = false;
+    if (c->methods && c->methods->init) {
+        c->methods->init(c);
+    }
+}
+
+static int32_t _snd_inter_msg_interval(congure_snd_t *cong, unsigned msg_size)
+{
+    (void)cong;
+    (void)msg_size;
+    /* no pacing */
+    return -1;
+}
+
+static void _snd_report_msg_sent(congure_snd_t *cong, unsigned msg_size)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    c->in_flight += msg_size;
+}
+
+static void _snd_report_msg_discarded(congure_snd_t *cong, unsigned msg_size)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    c->in_flight -= (msg_size < c->in_flight) ? msg_size : c->in_flight;
+}
+
+static void _snd_report_msgs_lost(congure_snd_t *cong, congure_snd_msg_t *msgs)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    (void)msgs;
+    /* the caller detected the loss and resends by itself */
+    if (!c->in_fast_recovery && (c->recover == 0)) {
+        _set_ssthresh(c);
+        c->super.cwnd = c->ssthresh;
+        c->in_fast_recovery = true;
+    }
+}
+
+static void _snd_report_msgs_timeout(congure_snd_t *cong,
+                                     congure_snd_msg_t *msgs)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+    congure_snd_msg_t *msg = msgs;
+    bool first = false;
+
+    /* RFC 5681, section 3.1: ssthresh is only reduced on the first timeout of
+     * a message */
+    do {
+        first |= (msg->resends == 0);
+        msg = (congure_snd_msg_t *)msg->super.next;
+    } while (msg && (msg != msgs));
+    if (first) {
+        _set_ssthresh(c);
+    }
+    else {
+        c->recover = c->in_flight;
+    }
+    c->super.cwnd = c->mss;
+    c->dup_acks = 0;
+    c->in_fast_recovery = false;
+}
+
+static void _dup_ack(congure_reno_snd_t *c)
+{
+    if (c->in_fast_recovery) {
+        /* inflate the window for every message that left the network */
+        c->super.cwnd = _clamp((uint32_t)c->super.cwnd + c->mss);
+    }
+    /* RFC 6582: only one fast retransmit per window of data */
+    else if ((++c->dup_acks == c->consts->frthresh) && (c->recover == 0)) {
+        _set_ssthresh(c);
+        c->super.cwnd = _clamp((uint32_t)c->ssthresh +
+                               (uint32_t)c->consts->frthresh * c->mss);
+        c->in_fast_recovery = true;
+        c->consts->fr(c);
+    }
+}
+
+static void _snd_report_msg_acked(congure_snd_t *cong, congure_snd_msg_t *msg,
+                                  congure_snd_ack_t *ack)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+    uint32_t acked = msg->size;
+    uint32_t cwnd = c->super.cwnd;
+
+    if (acked == 0) {
+        if ((ack->size == 0) && ack->clean && (ack->wnd == c->last_wnd) &&
+            (c->in_flight > 0)) {
+            _dup_ack(c);
+        }
+        c->last_wnd = ack->wnd;
+        return;
+    }
+    c->last_wnd = ack->wnd;
+    c->dup_acks = 0;
+    c->in_flight -= (acked < c->in_flight) ? acked : c->in_flight;
+    c->recover -= (acked < c->recover) ? acked : c->recover;
+
+    if (c->in_fast_recovery) {
+        /* full ACK: deflate the window and leave fast recovery */
+        if (c->recover == 0) {
+            c->super.cwnd = c->ssthresh;
+            c->in_fast_recovery = false;
+        }
+        /* partial ACK: the next message is missing as well, resend it */
+        else {
+            c->consts->fr(c);
+            c->super.cwnd = _clamp((acked < cwnd) ? cwnd - acked + c->mss
+                                                  : c->mss);
+        }
+    }
+    else if (cwnd < c->ssthresh) {
+        /* slow start, RFC 5681, equation (2) */
+        c->super.cwnd = _clamp(cwnd + ((acked < c->mss) ? acked : c->mss));
+    }
+    else if (c->methods && c->methods->ca_cwnd_inc) {
+        c->methods->ca_cwnd_inc(c, msg, ack);
+    }
+    else {
+        /* congestion avoidance, RFC 5681, equation (3) */
+        uint32_t inc = ((uint32_t)c->mss * c->mss) / cwnd;
+
+        c->super.cwnd = _clamp(cwnd + ((inc > 0) ? inc : 1));
+    }
+}
+
+static void _snd_report_ecn_ce(congure_snd_t *cong, ztimer_now_t time)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    (void)time;
+    /* RFC 3168, section 6.1.2: react at most once per window of data */
+    if (!c->in_fast_recovery && (c->recover == 0)) {
+        _set_ssthresh(c);
+        c->super.cwnd = c->ssthresh;
+    }
+}
+
+/** @} */
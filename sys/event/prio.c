@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_event_prio
+ * @{
+ *
+ * @file
+ * @brief       Prioritized event queue implementation
+ *
+ * Every level is a circular doubly linked list, `queue->levels[prio]` points
+ * to its oldest event. `event_t::list_node.next` is the next event and is
+ * `NULL` if the event is not queued, just like for regular event queues.
+ * `event_t::prio` is the level a queued event is linked into.
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+
+#include "bitarithm.h"
+#include "event/prio.h"
+#include "irq.h"
+#include "thread_flags.h"
+
+#if IS_USED(MODULE_EVENT_PRIO_STATS)
+#include "ztimer.h"
+#endif
+
+#define LEVELS_MAX  (8 * sizeof(unsigned))
+
+static_assert(CONFIG_EVENT_PRIO_LEVELS <= LEVELS_MAX,
+              "CONFIG_EVENT_PRIO_LEVELS exceeds the bits of the level bitmap");
+
+/* Same as runqueue_bitcache in core/sched.c: with a CLZ instruction, the most
+ * urgent level is the MSB, otherwise the LSB */
+static inline unsigned _bit(unsigned prio)
+{
+#if defined(BITARITHM_HAS_CLZ)
+    return (1U << (LEVELS_MAX - 1)) >> prio;
+#else
+    return 1U << prio;
+#endif
+}
+
+static inline unsigned _first(unsigned bitmap)
+{
+#if defined(BITARITHM_HAS_CLZ)
+    return LEVELS_MAX - 1 - bitarithm_msb(bitmap);
+#else
+    return bitarithm_lsb(bitmap);
+#endif
+}
+
+static inline event_t *_next(event_t *event)
+{
+    return container_of(event->list_node.next, event_t, list_node);
+}
+
+static inline uint32_t _now(void)
+{
+#if IS_USED(MODULE_EVENT_PRIO_STATS)
+    return ztimer_now(ZTIMER_USEC);
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief   Unlink @p event from its level
+ * @pre     IRQs are disabled, @p event is queued in @p queue
+ */
+static void _unlink(event_prio_queue_t *queue, event_t *event)
+{
+    event_t *next = _next(event);
+    bool single = (next == event);
+
+    if (!single) {
+        next->prev = event->prev;
+        event->prev->list_node.next = &next->list_node;
+    }
+    /* only the oldest event of a level is referenced by the queue */
+    unsigned prio = event->prio;
+    if (queue->levels[prio] == event) {
+        if (single) {
+            queue->levels[prio] = NULL;
+            queue->bitmap &= ~_bit(prio);
+        }
+        else {
+            queue->levels[prio] = next;
+        }
+    }
+    event->list_node.next = NULL;
+    event->prev = NULL;
+#if IS_USED(MODULE_EVENT_PRIO_STATS)
+    queue->stats.depth--;
+#endif
+}
+
+void event_prio_post(event_prio_queue_t *queue, event_t *event, unsigned prio)
+{
+    assert(queue && event && (prio < CONFIG_EVENT_PRIO_LEVELS));
+
+    uint32_t now = _now();
+    unsigned state = irq_disable();
+
+    if (!event->list_node.next) {
+        event_t *first = queue->levels[prio];
+
+        if (first) {
+            event_t *last = first->prev;
+            last->list_node.next = &event->list_node;
+            event->prev = last;
+            event->list_node.next = &first->list_node;
+            first->prev = event;
+        }
+        else {
+            event->list_node.next = &event->list_node;
+            event->prev = event;
+            queue->levels[prio] = event;
+            queue->bitmap |= _bit(prio);
+        }
+        event->prio = prio;
+#if IS_USED(MODULE_EVENT_PRIO_STATS)
+        event->posted = now;
+        if (++queue->stats.depth > queue->stats.depth_max) {
+            queue->stats.depth_max = queue->stats.depth;
+        }
+#endif
+    }
+    thread_t *waiter = queue->waiter;
+    irq_restore(state);
+    (void)now;
+
+    if (waiter) {
+        thread_flags_set(waiter, THREAD_FLAG_EVENT);
+    }
+}
+
+void event_prio_cancel(event_prio_queue_t *queue, event_t *event)
+{
+    assert(queue && event);
+
+    unsigned state = irq_disable();
+    if (event->list_node.next) {
+        _unlink(queue, event);
+#if IS_USED(MODULE_EVENT_PRIO_STATS)
+        queue->stats.cancelled++;
+#endif
+    }
+    irq_restore(state);
+}
+
+event_t *event_prio_get(event_prio_queue_t *queue)
+{
+    assert(queue);
+
+    uint32_t now = _now();
+    event_t *result = NULL;
+    unsigned state = irq_disable();
+
+    if (queue->bitmap) {
+        result = queue->levels[_first(queue->bitmap)];
+        _unlink(queue, result);
+#if IS_USED(MODULE_EVENT_PRIO_STATS)
+        uint32_t latency = now - result->posted;
+        queue->stats.dispatched++;
+        queue->stats.latency_sum_us += latency;
+        if (latency > queue->stats.latency_max_us) {
+            queue->stats.latency_max_us = latency;
+        }
+#endif
+    }
+    irq_restore(state);
+    (void)now;
+
+    return result;
+}
+
+event_t *event_prio_wait(event_prio_queue_t *queue)
+{
+    event_t *result;
+
+    while ((result = event_prio_get(queue)) == NULL) {
+        thread_flags_wait_any(THREAD_FLAG_EVENT);
+    }
+
+    return result;
+}
+
+#if IS_USED(MODULE_EVENT_PRIO_STATS)
+void event_prio_stats_get(event_prio_queue_t *queue, event_prio_stats_t *stats)
+{
+    unsigned state = irq_disable();
+    *stats = queue->stats;
+    irq_restore(state);
+}
+
+void event_prio_stats_reset(event_prio_queue_t *queue)
+{
+    unsigned state = irq_disable();
+    uint16_t depth = queue->stats.depth;
+    memset(&queue->stats, 0, sizeof(queue->stats));
+    queue->stats.depth = queue->stats.depth_max = depth;
+    irq_restore(state);
+}
+#endif
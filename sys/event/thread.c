@@ -25,6 +25,7 @@
 #include "thread.h"
 #include "event.h"
 #include "event/thread.h"
+#include "event/thread_pool.h"
 
 struct event_queue_and_size {
     event_queue_t *q;
@@ -98,6 +99,35 @@ static char WORD_ALIGNED _evq_lowest_stack[EVENT_THREAD_LOWEST_STACKSIZE];
 
 event_queue_t event_thread_queues[EVENT_QUEUE_PRIO_NUMOF];
 
+#if IS_USED(MODULE_EVENT_THREAD_POOL)
+#if CONFIG_EVENT_THREAD_POOL_SIZE > 1
+/* the first worker uses _evq_medium_stack */
+static char WORD_ALIGNED _evq_pool_stacks[CONFIG_EVENT_THREAD_POOL_SIZE - 1]
+                                         [EVENT_THREAD_MEDIUM_STACKSIZE];
+#endif
+
+event_thread_pool_t event_thread_pool;
+
+static void _init_pool(event_queue_t *qs, size_t qs_numof)
+{
+    /* bit n of CONFIG_EVENT_THREAD_POOL_ORDERED refers to priority n */
+    uint8_t ordered = CONFIG_EVENT_THREAD_POOL_ORDERED >> (qs - event_thread_queues);
+
+    event_thread_pool_init(&event_thread_pool, qs, qs_numof, ordered);
+    event_thread_pool_add_worker(&event_thread_pool,
+                                 _evq_medium_stack, sizeof(_evq_medium_stack),
+                                 EVENT_THREAD_MEDIUM_PRIO);
+#if CONFIG_EVENT_THREAD_POOL_SIZE > 1
+    for (unsigned i = 0; i < ARRAY_SIZE(_evq_pool_stacks); i++) {
+        event_thread_pool_add_worker(&event_thread_pool,
+                                     _evq_pool_stacks[i],
+                                     sizeof(_evq_pool_stacks[i]),
+                                     EVENT_THREAD_MEDIUM_PRIO);
+    }
+#endif
+}
+#endif
+
 void auto_init_event_thread(void)
 {
     if (IS_USED(MODULE_EVENT_THREAD_HIGHEST)) {
@@ -127,7 +157,11 @@ void auto_init_event_thread(void)
     if (!IS_USED(MODULE_EVENT_THREAD_MEDIUM)) {
         qs_numof++;
     }
+#if IS_USED(MODULE_EVENT_THREAD_POOL)
+    _init_pool(qs, qs_numof);
+#else
     event_thread_init_multi(qs, qs_numof,
                             _evq_medium_stack, sizeof(_evq_medium_stack),
                             EVENT_THREAD_MEDIUM_PRIO);
+#endif
 }
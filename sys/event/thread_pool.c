@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_event_thread_pool
+ * @{
+ *
+ * @file
+ * @brief       Event thread pool implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+
+#include "bitarithm.h"
+#include "event/thread_pool.h"
+#include "irq.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+static_assert(CONFIG_EVENT_THREAD_POOL_WORKERS_MAX <= 8,
+              "CONFIG_EVENT_THREAD_POOL_WORKERS_MAX exceeds 8");
+
+/**
+ * @brief   Direct the notifications of all queues to @p worker
+ * @pre     IRQs are disabled
+ */
+static void _set_waiter(event_thread_pool_t *pool, thread_t *worker)
+{
+    for (unsigned i = 0; i < pool->queues_numof; i++) {
+        pool->queues[i].waiter = worker;
+    }
+}
+
+static inline bool _takeable(event_thread_pool_t *pool, unsigned i)
+{
+    return pool->queues[i].event_list.next &&
+           !(pool->ordered & pool->busy & (1U << i));
+}
+
+/**
+ * @brief   Take the next event of the most important queue that has one and
+ *          that has no event in flight if it is ordered
+ * @pre     IRQs are disabled
+ */
+static event_t *_take(event_thread_pool_t *pool, unsigned *queue)
+{
+    for (unsigned i = 0; i < pool->queues_numof; i++) {
+        if (_takeable(pool, i)) {
+            event_t *event = container_of(
+                clist_lpop(&pool->queues[i].event_list), event_t, list_node);
+            event->list_node.next = NULL;
+            pool->busy |= pool->ordered & (1U << i);
+            *queue = i;
+            return event;
+        }
+    }
+    return NULL;
+}
+
+static bool _pending(event_thread_pool_t *pool)
+{
+    for (unsigned i = 0; i < pool->queues_numof; i++) {
+        if (_takeable(pool, i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void *_worker(void *arg)
+{
+    event_thread_pool_t *pool = arg;
+    thread_t *me = thread_get_active();
+    uint8_t my_bit = 0;
+
+    for (unsigned i = 0; i < pool->workers_numof; i++) {
+        if (pool->workers[i] == me) {
+            my_bit = 1U << i;
+        }
+    }
+    assert(my_bit);
+
+    while (1) {
+        unsigned queue;
+        unsigned state = irq_disable();
+        event_t *event = _take(pool, &queue);
+
+        if (event == NULL) {
+            /* checking the queues and becoming the waiter of all of them
+             * happens atomically, so no notification can be lost */
+            pool->idle |= my_bit;
+            _set_waiter(pool, me);
+            irq_restore(state);
+            thread_flags_wait_any(THREAD_FLAG_EVENT);
+            continue;
+        }
+
+        pool->idle &= ~my_bit;
+        thread_t *helper = NULL;
+        if (pool->idle && (pool->queues[0].waiter == me)) {
+            /* hand the notifications over to an idle worker and let it take
+             * the remaining events right away */
+            helper = pool->workers[bitarithm_lsb(pool->idle)];
+            _set_waiter(pool, helper);
+            if (!_pending(pool)) {
+                helper = NULL;
+            }
+        }
+        irq_restore(state);
+
+        if (helper) {
+            DEBUG("event_thread_pool: %" PRIkernel_pid " wakes %" PRIkernel_pid
+                  "\n", me->pid, helper->pid);
+            thread_flags_set(helper, THREAD_FLAG_EVENT);
+        }
+
+        event->handler(event);
+
+        if (pool->ordered & (1U << queue)) {
+            state = irq_disable();
+            pool->busy &= ~(1U << queue);
+            irq_restore(state);
+        }
+    }
+
+    /* should be never reached */
+    return NULL;
+}
+
+void event_thread_pool_init(event_thread_pool_t *pool, event_queue_t *queues,
+                            size_t queues_numof, uint8_t ordered)
+{
+    assert(pool && queues && queues_numof);
+    assert(queues_numof <= EVENT_THREAD_POOL_QUEUES_MAX);
+
+    memset(pool, 0, sizeof(*pool));
+    event_queues_init_detached(queues, queues_numof);
+    pool->queues = queues;
+    pool->queues_numof = queues_numof;
+    pool->ordered = ordered;
+}
+
+kernel_pid_t event_thread_pool_add_worker(event_thread_pool_t *pool,
+                                          char *stack, size_t stack_size,
+                                          unsigned priority)
+{
+    if (pool->workers_numof >= CONFIG_EVENT_THREAD_POOL_WORKERS_MAX) {
+        return -ENOSPC;
+    }
+
+    /* the worker looks itself up in the pool, so it must not run before it
+     * is added */
+    kernel_pid_t pid = thread_create(stack, stack_size, priority,
+                                     THREAD_CREATE_SLEEPING |
+                                     THREAD_CREATE_STACKTEST,
+                                     _worker, pool, "event");
+    if (pid < 0) {
+        return pid;
+    }
+
+    pool->workers[pool->workers_numof++] = thread_get(pid);
+    thread_wakeup(pid);
+
+    return pid;
+}
@@ -10,6 +10,38 @@
  * @defgroup    sys_benchmark Benchmark
  * @ingroup     sys
  * @brief       Framework for running simple runtime benchmarks
+ *
+ * `BENCHMARK_STATS()` measures a function call statistically:
+ *
+ * 1. the number of calls per sample is doubled until one sample takes at
+ *    least @ref CONFIG_BENCHMARK_SAMPLE_MIN_US,
+ * 2. @ref CONFIG_BENCHMARK_WARMUP samples are taken and thrown away,
+ * 3. @ref CONFIG_BENCHMARK_SAMPLES samples are taken and the time per call of
+ *    each is fed into @ref sys_matstat.
+ *
+ * The result contains the minimum, median, 99th percentile (nearest rank),
+ * maximum, mean and standard deviation of the time per call in nanoseconds.
+ * It is written with @ref test_utils_result_output, so the output format
+ * can be chosen by selecting a `test_utils_result_output_%` module (JSON by
+ * default). `dist/tools/benchmark_compare` compares two JSON outputs, e.g.
+ * against the results of a previous nightly run.
+ *
+ * On Cortex-M3 and up (DWT cycle counter) and on RISC-V (`mcycle`), samples
+ * are timed in CPU cycles. Everywhere else, `ZTIMER_USEC` is used.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * turo_t ctx;
+ *
+ * turo_init(&ctx);
+ * turo_container_open(&ctx);
+ * BENCHMARK_STATS(&ctx, "mutex lock/unlock", _mutex_lockunlock());
+ * turo_container_close(&ctx, 0);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Benchmarks that need untimed preparation for each sample can drive a
+ * @ref benchmark_t themselves using @ref benchmark_now and
+ * @ref benchmark_add_sample.
+ *
  * @{
  *
  * @file
@@ -21,15 +53,72 @@
 #ifndef BENCHMARK_H
 #define BENCHMARK_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "irq.h"
+#include "matstat.h"
+#include "test_utils/result_output.h"
 #include "ztimer.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @defgroup sys_benchmark_conf Benchmark compile configurations
+ * @ingroup config
+ * @{
+ */
+/**
+ * @brief   Number of samples taken by @ref BENCHMARK_STATS
+ */
+#ifndef CONFIG_BENCHMARK_SAMPLES
+#define CONFIG_BENCHMARK_SAMPLES        (50U)
+#endif
+
+/**
+ * @brief   Number of samples taken and discarded before measuring
+ */
+#ifndef CONFIG_BENCHMARK_WARMUP
+#define CONFIG_BENCHMARK_WARMUP         (3U)
+#endif
+
+/**
+ * @brief   Minimum duration of a sample in microseconds
+ *
+ * This keeps the resolution of the timer from dominating the result.
+ */
+#ifndef CONFIG_BENCHMARK_SAMPLE_MIN_US
+#define CONFIG_BENCHMARK_SAMPLE_MIN_US  (1000U)
+#endif
+/** @} */
+
+/**
+ * @brief   State of a statistical benchmark
+ */
+typedef struct {
+    const char *name;           /**< name for labeling the output */
+    matstat_state_t stats;      /**< statistics of the time per call in ns */
+    uint32_t iterations;        /**< calls per sample, 0 before the first */
+    uint32_t start;             /**< time stamp of the start of the sample */
+    uint16_t count;             /**< samples taken, including warm-up */
+    bool calibrated;            /**< true if iterations is final */
+    int32_t samples[CONFIG_BENCHMARK_SAMPLES]; /**< time per call in ns */
+} benchmark_t;
+
+/**
+ * @brief   Result of a statistical benchmark, all times in ns per call
+ */
+typedef struct {
+    int32_t min;                /**< fastest sample */
+    int32_t median;             /**< median sample */
+    int32_t p99;                /**< 99th percentile */
+    int32_t max;                /**< slowest sample */
+    int32_t mean;               /**< mean of all samples */
+    uint32_t stddev;            /**< standard deviation of all samples */
+} benchmark_result_t;
+
 /**
  * @brief   Measure the runtime of a given function call
  *
@@ -37,6 +126,9 @@ extern "C" {
  * using a preprocessor function, as going with a function pointer or similar
  * would influence the measured runtime...
  *
+ * @deprecated  Use @ref BENCHMARK_STATS, which also reports the spread of the
+ *              results
+ *
  * @param[in] name      name for labeling the output
  * @param[in] runs      number of times to run @p func
  * @param[in] func      function call to benchmark
@@ -51,6 +143,27 @@ extern "C" {
         benchmark_print_time(_benchmark_time, runs, name);      \
     }
 
+/**
+ * @brief   Measure the runtime of a given function call statistically and
+ *          write the result to @p ctx
+ *
+ * @param[in] ctx       turo context to write the result to
+ * @param[in] name      name for labeling the output
+ * @param[in] func      function call to benchmark
+ */
+#define BENCHMARK_STATS(ctx, name, func)                        \
+    {                                                           \
+        benchmark_t _benchmark;                                 \
+        uint32_t _benchmark_n;                                  \
+        benchmark_init(&_benchmark, name);                      \
+        while ((_benchmark_n = benchmark_next(&_benchmark))) {  \
+            for (uint32_t i = 0; i < _benchmark_n; i++) {       \
+                func;                                           \
+            }                                                   \
+        }                                                       \
+        benchmark_turo(ctx, &_benchmark);                       \
+    }
+
 /**
  * @brief   Output the given time as well as the time per run on STDIO
  *
@@ -60,6 +173,66 @@ extern "C" {
  */
 void benchmark_print_time(uint32_t time, unsigned long runs, const char *name);
 
+/**
+ * @brief   Initialize a statistical benchmark
+ *
+ * @param[out] bench    benchmark to initialize
+ * @param[in]  name     name to label the output
+ */
+void benchmark_init(benchmark_t *bench, const char *name);
+
+/**
+ * @brief   Finish the current sample and start the next one
+ *
+ * @param[in,out] bench benchmark
+ *
+ * @return  number of calls to run for the next sample
+ * @return  0 if all samples have been taken
+ */
+uint32_t benchmark_next(benchmark_t *bench);
+
+/**
+ * @brief   Get the current time stamp of the benchmark timer
+ *
+ * @return  time stamp in CPU cycles or microseconds, see
+ *          @ref benchmark_ticks_per_sec
+ */
+uint32_t benchmark_now(void);
+
+/**
+ * @brief   Get the frequency of @ref benchmark_now
+ */
+uint32_t benchmark_ticks_per_sec(void);
+
+/**
+ * @brief   Add a sample that was timed by the caller
+ *
+ * Warm-up samples are discarded.
+ *
+ * @param[in,out] bench     benchmark
+ * @param[in]     ticks     duration of the sample, see @ref benchmark_now
+ * @param[in]     calls     number of calls in the sample
+ *
+ * @return  true if all samples have been taken
+ */
+bool benchmark_add_sample(benchmark_t *bench, uint32_t ticks, uint32_t calls);
+
+/**
+ * @brief   Compute the result of a benchmark
+ *
+ * @param[in,out] bench     benchmark, the samples are sorted in place
+ * @param[out]    res       result
+ */
+void benchmark_result(benchmark_t *bench, benchmark_result_t *res);
+
+/**
+ * @brief   Write the result of a benchmark as a dict to @p ctx
+ *
+ * @param[in]     ctx       turo context
+ * @param[in,out] bench     benchmark, see @ref benchmark_result
+ */
+void benchmark_turo(turo_t *ctx, benchmark_t *bench);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_congure_cocoa   CongURE implementation of CoCoA
+ * @ingroup     sys_congure
+ * @brief       Implementation of the CoAP Simple Congestion Control/Advanced
+ *              (CoCoA) retransmission timeout estimator for @ref sys_congure.
+ *
+ * Implements the RTO estimation of
+ * [draft-ietf-core-cocoa-03](https://tools.ietf.org/html/draft-ietf-core-cocoa-03)
+ * for one CoAP endpoint:
+ *
+ * - A strong estimator (K = 4) takes round trip times of exchanges that
+ *   were not retransmitted. A weak estimator (K = 1) takes those of exchanges
+ *   that were retransmitted once or twice, measured from the first
+ *   transmission. Each new estimate is blended into the overall RTO with a
+ *   weight of 1/2 (strong) or 1/4 (weak).
+ * - An overall RTO below 1 s is doubled after 16 RTOs without a new
+ *   estimate, one above 3 s moves halfway to 2 s after 4 RTOs.
+ * - Retransmissions back off by a variable factor, see
+ *   congure_cocoa_backoff().
+ *
+ * CoCoA keeps at most one exchange outstanding (NSTART = 1), so
+ * congure_snd_t::cwnd is always 1. Report acknowledged exchanges to
+ * congure_snd_driver_t::report_msg_acked() with congure_snd_msg_t::send_time
+ * set to the time of the first transmission. Use congure_cocoa_get_rto() for
+ * the initial timeout of a new exchange.
+ *
+ * @{
+ *
+ * @file
+ */
+#ifndef CONGURE_COCOA_H
+#define CONGURE_COCOA_H
+
+#include <stdint.h>
+
+#include "congure.h"
+#include "congure/config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Round trip time estimator
+ */
+typedef struct {
+    uint32_t srtt;      /**< Smoothed round trip time in ms, 0 if no sample */
+    uint32_t rttvar;    /**< Round trip time variation in ms */
+} congure_cocoa_rtt_t;
+
+/**
+ * @brief   State object for CongURE CoCoA
+ *
+ * @extends congure_snd_t
+ */
+typedef struct {
+    congure_snd_t super;            /**< see @ref congure_snd_t */
+    congure_cocoa_rtt_t strong;     /**< Strong estimator */
+    congure_cocoa_rtt_t weak;       /**< Weak estimator */
+    uint32_t rto;                   /**< Overall RTO in ms */
+    ztimer_now_t rto_time;          /**< Time of the last RTO update */
+} congure_cocoa_snd_t;
+
+/**
+ * @brief   Set-up CoCoA state object
+ *
+ * @param[in] c     A CoCoA state object.
+ */
+void congure_cocoa_snd_setup(congure_cocoa_snd_t *c);
+
+/**
+ * @brief   Gets the retransmission timeout for a new exchange
+ *
+ * Ages the overall RTO if it was not updated for a while.
+ *
+ * @param[in] c     A CoCoA state object.
+ * @param[in] now   The current time in milliseconds.
+ *
+ * @return  The retransmission timeout in milliseconds. The caller should
+ *          pick the actual timeout randomly from [RTO, 1.5 * RTO].
+ */
+uint32_t congure_cocoa_get_rto(congure_cocoa_snd_t *c, ztimer_now_t now);
+
+/**
+ * @brief   Calculates the timeout of the next retransmission
+ *
+ * Timeouts below 1 s are tripled, timeouts above 3 s multiplied by 1.5 and
+ * all others doubled, so short timeouts back off fast and long ones do not
+ * grow without need. The result is limited to
+ * @ref CONFIG_CONGURE_COCOA_MAX_RTO_MS.
+ *
+ * @param[in] timeout   The timeout of the previous transmission in
+ *                      milliseconds.
+ *
+ * @return  The timeout of the next retransmission in milliseconds.
+ */
+uint32_t congure_cocoa_backoff(uint32_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONGURE_COCOA_H */
+/** @} */
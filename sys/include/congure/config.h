@@ -24,6 +24,27 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Initial retransmission timeout of @ref sys_congure_cocoa in
+ *          milliseconds
+ *
+ * Used until the first round trip time was measured. The default is the
+ * ACK_TIMEOUT of [RFC 7252](https://tools.ietf.org/html/rfc7252).
+ */
+#ifndef CONFIG_CONGURE_COCOA_INITIAL_RTO_MS
+#define CONFIG_CONGURE_COCOA_INITIAL_RTO_MS     (2000U)
+#endif
+
+/**
+ * @brief   Upper bound for the retransmission timeout of
+ *          @ref sys_congure_cocoa in milliseconds
+ *
+ * Also limits the backoff of congure_cocoa_backoff().
+ */
+#ifndef CONFIG_CONGURE_COCOA_MAX_RTO_MS
+#define CONFIG_CONGURE_COCOA_MAX_RTO_MS         (60000U)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
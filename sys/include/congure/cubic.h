@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_congure_cubic   CongURE implementation of CUBIC
+ * @ingroup     sys_congure
+ * @brief       Implementation of the CUBIC congestion control mechanism for
+ *              @ref sys_congure.
+ *
+ * Implements [RFC 8312](https://tools.ietf.org/html/rfc8312) with
+ * \f$C = 0.4\f$ and \f$\beta_{cubic} = 0.7\f$, including fast convergence and
+ * the TCP-friendly region. Slow start, fast retransmit and fast recovery are
+ * those of @ref sys_congure_reno, so the caller interacts with a CUBIC state
+ * object exactly as with a NewReno state object.
+ *
+ * The congestion window grows with the time since the last loss, taken from
+ * congure_snd_ack_t::recv_time, and is offset by the minimum round trip time
+ * seen. The round trip time is sampled from congure_snd_msg_t::send_time of
+ * acknowledged messages that were not resent. Callers that can not provide
+ * the send time should set it to congure_snd_ack_t::recv_time.
+ *
+ * @{
+ *
+ * @file
+ */
+#ifndef CONGURE_CUBIC_H
+#define CONGURE_CUBIC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "congure/reno.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   State object for CongURE CUBIC
+ *
+ * @extends congure_reno_snd_t
+ */
+typedef struct {
+    congure_reno_snd_t super;       /**< see @ref congure_reno_snd_t */
+    ztimer_now_t epoch_start;       /**< Start of the current epoch */
+    uint32_t k;                     /**< Time in ms to reach w_max again */
+    uint32_t min_rtt;               /**< Minimum round trip time in ms */
+    uint32_t w_est;                 /**< Window of the TCP-friendly region */
+    congure_wnd_size_t w_max;       /**< Window before the last reduction */
+    congure_wnd_size_t origin;      /**< Plateau of the cubic function */
+    bool in_epoch;                  /**< An epoch was started */
+} congure_cubic_snd_t;
+
+/**
+ * @brief   Set-up CUBIC state object
+ *
+ * @param[in] c         A CUBIC state object.
+ * @param[in] consts    The constants to use for @p c. Must not be NULL and
+ *                      congure_reno_snd_consts_t::fr must be set.
+ */
+void congure_cubic_snd_setup(congure_cubic_snd_t *c,
+                             const congure_reno_snd_consts_t *consts);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONGURE_CUBIC_H */
+/** @} */
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_congure_reno    CongURE implementation of TCP NewReno
+ * @ingroup     sys_congure
+ * @brief       Implementation of the TCP NewReno congestion control mechanism
+ *              for @ref sys_congure.
+ *
+ * Implements slow start, congestion avoidance, fast retransmit and fast
+ * recovery as described in [RFC 5681](https://tools.ietf.org/html/rfc5681)
+ * with the NewReno modification of
+ * [RFC 6582](https://tools.ietf.org/html/rfc6582). All sizes are in
+ * caller-defined units, e.g. bytes for TCP.
+ *
+ * The caller reports every ACK with congure_snd_driver_t::report_msg_acked().
+ * The message passed along with it represents the data newly acknowledged by
+ * the ACK, so an ACK that acknowledges no new data is reported with a message
+ * of size 0. Such an ACK is a duplicate ACK if it carries no data
+ * (congure_snd_ack_t::size is 0), is clean (congure_snd_ack_t::clean) and does
+ * not change the window advertised by the previous ACK
+ * (congure_snd_ack_t::wnd). After congure_reno_snd_consts_t::frthresh
+ * duplicate ACKs, congure_reno_snd_consts_t::fr is called to resend the
+ * oldest unacknowledged message.
+ *
+ * The window growth in congestion avoidance and the reduction after a loss
+ * can be replaced by other implementations with
+ * congure_reno_snd_t::methods, see e.g. @ref sys_congure_cubic.
+ *
+ * @{
+ *
+ * @file
+ */
+#ifndef CONGURE_RENO_H
+#define CONGURE_RENO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "congure.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Forward declaration of the state object
+ */
+typedef struct congure_reno_snd congure_reno_snd_t;
+
+/**
+ * @brief   Constants for the NewReno state object, usually provided by the
+ *          caller
+ */
+typedef struct {
+    /**
+     * @brief   Callback to resend the oldest unacknowledged message (fast
+     *          retransmit)
+     *
+     * Called on the duplicate ACK that starts fast recovery and on every
+     * partial ACK during fast recovery.
+     *
+     * @param[in] c The CongURE state object. congure_snd_t::ctx holds the
+     *              context passed to congure_snd_driver_t::init().
+     */
+    void (*fr)(congure_reno_snd_t *c);
+    /**
+     * @brief   Initial sender maximum segment size in caller-defined units
+     *
+     * @see congure_reno_set_mss()
+     */
+    congure_wnd_size_t init_mss;
+    /**
+     * @brief   Number of duplicate ACKs that trigger a fast retransmit
+     */
+    uint8_t frthresh;
+} congure_reno_snd_consts_t;
+
+/**
+ * @brief   Methods to adapt the NewReno state object to other algorithms
+ *
+ * Every method may be NULL to use the NewReno behavior.
+ */
+typedef struct {
+    /**
+     * @brief   Called from congure_snd_driver_t::init() after the NewReno
+     *          state was initialized
+     *
+     * @param[in] c The CongURE state object.
+     */
+    void (*init)(congure_reno_snd_t *c);
+    /**
+     * @brief   Increases the congestion window in congestion avoidance
+     *
+     * Is called for every ACK of new data while not in slow start or fast
+     * recovery. The implementation must not increase congure_snd_t::cwnd
+     * above @ref CONGURE_WND_SIZE_MAX.
+     *
+     * @param[in] c     The CongURE state object.
+     * @param[in] msg   The newly acknowledged data.
+     * @param[in] ack   The received ACK.
+     */
+    void (*ca_cwnd_inc)(congure_reno_snd_t *c, const congure_snd_msg_t *msg,
+                        const congure_snd_ack_t *ack);
+    /**
+     * @brief   Sets congure_reno_snd_t::ssthresh after a loss was detected
+     *
+     * Is called once per window of data for losses, ACK timeouts and CE
+     * signals, before congure_snd_t::cwnd is changed.
+     *
+     * @param[in] c     The CongURE state object.
+     */
+    void (*ssthresh_dec)(congure_reno_snd_t *c);
+} congure_reno_snd_methods_t;
+
+/**
+ * @brief   State object for CongURE NewReno
+ *
+ * @extends congure_snd_t
+ */
+struct congure_reno_snd {
+    congure_snd_t super;                        /**< see @ref congure_snd_t */
+    const congure_reno_snd_consts_t *consts;    /**< Constants */
+    /**
+     * @brief   Methods of an algorithm derived from NewReno. May be NULL.
+     */
+    const congure_reno_snd_methods_t *methods;
+    /**
+     * @brief   Units sent but not yet acknowledged or discarded
+     */
+    uint32_t in_flight;
+    /**
+     * @brief   Units still to be acknowledged before another loss may reduce
+     *          the congestion window
+     *
+     * Set to congure_reno_snd_t::in_flight when a loss is detected. Fast
+     * recovery ends once it reaches 0 (the "recover" variable of RFC 6582).
+     */
+    uint32_t recover;
+    congure_wnd_size_t ssthresh;    /**< Slow start threshold */
+    congure_wnd_size_t mss;         /**< Sender maximum segment size */
+    congure_wnd_size_t last_wnd;    /**< Window advertised by the last ACK */
+    uint8_t dup_acks;               /**< Number of duplicate ACKs in a row */
+    bool in_fast_recovery;          /**< Fast recovery is in progress */
+};
+
+/**
+ * @brief   Set-up NewReno state object
+ *
+ * @param[in] c         A NewReno state object.
+ * @param[in] consts    The constants to use for @p c. Must not be NULL and
+ *                      congure_reno_snd_consts_t::fr must be set.
+ */
+void congure_reno_snd_setup(congure_reno_snd_t *c,
+                            const congure_reno_snd_consts_t *consts);
+
+/**
+ * @brief   Sets the sender maximum segment size
+ *
+ * Call before congure_snd_driver_t::init(), as the initial window depends on
+ * it (see [RFC 5681, section 3.1](https://tools.ietf.org/html/rfc5681#section-3.1)).
+ *
+ * @param[in] c     A NewReno state object.
+ * @param[in] mss   The new sender maximum segment size in caller-defined
+ *                  units.
+ */
+static inline void congure_reno_set_mss(congure_reno_snd_t *c,
+                                        congure_wnd_size_t mss)
+{
+    c->mss = mss;
+}
+
+/**
+ * @brief   Checks if the congestion window of a NewReno state object is in
+ *          slow start
+ *
+ * @param[in] c     A NewReno state object.
+ *
+ * @return  true, if @p c is in slow start.
+ * @return  false, if @p c is in congestion avoidance or fast recovery.
+ */
+static inline bool congure_reno_in_slow_start(const congure_reno_snd_t *c)
+{
+    return !c->in_fast_recovery && (c->super.cwnd < c->ssthresh);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONGURE_RENO_H */
+/** @} */
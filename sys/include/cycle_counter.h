@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_cycle_counter CPU cycle counter
+ * @ingroup     sys
+ * @brief       Access to the CPU cycle counter for time measurements
+ *
+ * On Cortex-M3 and up the DWT cycle counter is used, on RISC-V the `mcycle`
+ * CSR. Both count at the core clock, see @ref coreclk. On all other CPUs,
+ * @ref CYCLE_COUNTER_AVAILABLE is 0 and the functions must not be used.
+ *
+ * @{
+ *
+ * @file
+ * @brief       CPU cycle counter interface
+ */
+
+#ifndef CYCLE_COUNTER_H
+#define CYCLE_COUNTER_H
+
+#include <stdint.h>
+
+#if defined(CPU_CORE_CORTEX_M3) || defined(CPU_CORE_CORTEX_M4) || \
+    defined(CPU_CORE_CORTEX_M4F) || defined(CPU_CORE_CORTEX_M7) || \
+    defined(CPU_CORE_CORTEX_M33)
+#include "clk.h"
+#include "cpu.h"
+/**
+ * @brief   1 if the CPU has a cycle counter, 0 otherwise
+ */
+#define CYCLE_COUNTER_AVAILABLE     1
+#define CYCLE_COUNTER_DWT           1   /**< Cortex-M DWT cycle counter */
+#elif defined(__riscv)
+#include "clk.h"
+#define CYCLE_COUNTER_AVAILABLE     1
+#define CYCLE_COUNTER_DWT           0
+#else
+#define CYCLE_COUNTER_AVAILABLE     0
+#define CYCLE_COUNTER_DWT           0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if CYCLE_COUNTER_AVAILABLE || defined(DOXYGEN)
+/**
+ * @brief   Starts the cycle counter, if it needs to be started
+ *
+ * The counter is not reset, so measurements that are already running are
+ * not disturbed.
+ */
+static inline void cycle_counter_init(void)
+{
+#if CYCLE_COUNTER_DWT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+/**
+ * @brief   Reads the cycle counter
+ *
+ * @return  the current value of the cycle counter, wraps around at 32 bit
+ */
+static inline uint32_t cycle_counter_now(void)
+{
+#if CYCLE_COUNTER_DWT
+    return DWT->CYCCNT;
+#else
+    uint32_t cycles;
+    __asm__ volatile ("csrr %0, mcycle" : "=r"(cycles));
+    return cycles;
+#endif
+}
+
+/**
+ * @brief   Gets the frequency of the cycle counter
+ *
+ * @return  cycles per second
+ */
+static inline uint32_t cycle_counter_freq(void)
+{
+    return coreclk();
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CYCLE_COUNTER_H */
+/** @} */
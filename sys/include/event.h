@@ -147,6 +147,14 @@ typedef void (*event_handler_t)(event_t *);
 struct event {
     clist_node_t list_node;     /**< event queue list entry             */
     event_handler_t handler;    /**< pointer to event handler function  */
+#if IS_USED(MODULE_EVENT_PRIO) || defined(DOXYGEN)
+    event_t *prev;              /**< previous event in a prioritized queue,
+                                     see @ref sys_event_prio        */
+    uint8_t prio;               /**< level in a prioritized queue   */
+#endif
+#if IS_USED(MODULE_EVENT_PRIO_STATS) || defined(DOXYGEN)
+    uint32_t posted;            /**< time stamp of posting in us    */
+#endif
 };
 
 /**
@@ -268,6 +276,7 @@ void event_post(event_queue_t *queue, event_t *event);
  * This will remove a queued event from an event queue.
  *
  * @note    Due to the underlying list implementation, this will run in O(n).
+ *          See @ref sys_event_prio for queues with O(1) cancellation.
  *
  * @param[in]   queue   event queue to remove event from
  * @param[in]   event   event to remove from queue
@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_event_prio Prioritized event queues
+ * @ingroup     sys_event
+ * @brief       Event queue with multiple priority levels, O(1) post, get and
+ *              cancel
+ *
+ * An @ref event_prio_queue_t combines @ref CONFIG_EVENT_PRIO_LEVELS FIFO
+ * lists of events in one queue, like the run queues of the scheduler: a
+ * bitmap of the non-empty levels selects the next event in constant time,
+ * level 0 being the most urgent one. This allows a single thread to serve
+ * e.g. radio, timer and application work without head-of-line blocking and
+ * without polling an array of queues like @ref event_wait_multi does.
+ *
+ * With this module, @ref event_t is doubly linked and remembers its level,
+ * so that @ref event_prio_cancel does not need to search the queue. This
+ * adds a pointer and a byte to every event. Events can still be posted to regular event queues
+ * (@ref event_post) at the same time, but an event can only be queued in one
+ * queue at a time.
+ *
+ * With the module `event_prio_stats`, the queue keeps track of its current
+ * and highest depth and of the latency from posting an event until it is
+ * taken out of the queue, see @ref event_prio_stats_get. This adds a time
+ * stamp to every event.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * enum { PRIO_RADIO, PRIO_TIMER, PRIO_APP };
+ *
+ * static event_prio_queue_t queue;
+ *
+ * int main(void)
+ * {
+ *     event_prio_queue_init(&queue);
+ *     event_prio_loop(&queue);
+ * }
+ *
+ * [...] event_prio_post(&queue, &rx_event, PRIO_RADIO);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Prioritized event queue API
+ */
+
+#ifndef EVENT_PRIO_H
+#define EVENT_PRIO_H
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "event.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup sys_event_prio_conf Prioritized event queue configuration
+ * @ingroup config
+ * @{
+ */
+/**
+ * @brief   Number of priority levels of an @ref event_prio_queue_t
+ *
+ * @note    At most `8 * sizeof(unsigned)` levels are supported.
+ */
+#ifndef CONFIG_EVENT_PRIO_LEVELS
+#define CONFIG_EVENT_PRIO_LEVELS    (4U)
+#endif
+/** @} */
+
+/**
+ * @brief   Statistics of an @ref event_prio_queue_t
+ */
+typedef struct {
+    uint16_t depth;             /**< number of queued events */
+    uint16_t depth_max;         /**< highest number of queued events */
+    uint32_t cancelled;         /**< number of cancelled events */
+    uint32_t dispatched;        /**< number of events taken from the queue */
+    uint32_t latency_max_us;    /**< highest latency from post to get */
+    uint64_t latency_sum_us;    /**< sum of the latencies from post to get */
+} event_prio_stats_t;
+
+/**
+ * @brief   Prioritized event queue
+ */
+typedef struct {
+    event_t *levels[CONFIG_EVENT_PRIO_LEVELS]; /**< first event of each level */
+    unsigned bitmap;            /**< non-empty levels */
+    thread_t *waiter;           /**< thread owning the queue */
+#if IS_USED(MODULE_EVENT_PRIO_STATS) || defined(DOXYGEN)
+    event_prio_stats_t stats;   /**< statistics */
+#endif
+} event_prio_queue_t;
+
+/**
+ * @brief   Initialize a prioritized event queue
+ *
+ * This will set the calling thread as owner of @p queue.
+ *
+ * @param[out]  queue   event queue object to initialize
+ */
+static inline void event_prio_queue_init(event_prio_queue_t *queue)
+{
+    memset(queue, 0, sizeof(*queue));
+    queue->waiter = thread_get_active();
+}
+
+/**
+ * @brief   Initialize a prioritized event queue not binding it to a thread
+ *
+ * @param[out]  queue   event queue object to initialize
+ */
+static inline void event_prio_queue_init_detached(event_prio_queue_t *queue)
+{
+    memset(queue, 0, sizeof(*queue));
+}
+
+/**
+ * @brief   Bind a prioritized event queue to the calling thread
+ *
+ * @pre     (queue->waiter == NULL)
+ *
+ * @param[out]  queue   event queue object to bind to a thread
+ */
+static inline void event_prio_queue_claim(event_prio_queue_t *queue)
+{
+    assert(queue->waiter == NULL);
+    queue->waiter = thread_get_active();
+}
+
+/**
+ * @brief   Queue an event with the given priority
+ *
+ * The event is appended to the list of @p prio in O(1). If the event is
+ * already queued, it is not touched, as with @ref event_post.
+ *
+ * @param[in]   queue   event queue to queue @p event in
+ * @param[in]   event   event to queue
+ * @param[in]   prio    priority level, 0 being the most urgent one
+ *
+ * @pre     @p prio < @ref CONFIG_EVENT_PRIO_LEVELS
+ */
+void event_prio_post(event_prio_queue_t *queue, event_t *event, unsigned prio);
+
+/**
+ * @brief   Cancel a queued event
+ *
+ * This runs in O(1) with respect to the number of queued events. Nothing
+ * happens if @p event is not queued.
+ *
+ * @param[in]   queue   event queue to remove @p event from
+ * @param[in]   event   event to remove
+ */
+void event_prio_cancel(event_prio_queue_t *queue, event_t *event);
+
+/**
+ * @brief   Get the oldest event of the most urgent non-empty level,
+ *          non-blocking
+ *
+ * @param[in]   queue   event queue to get an event from
+ *
+ * @returns     pointer to next event
+ * @returns     NULL if no event is available
+ */
+event_t *event_prio_get(event_prio_queue_t *queue);
+
+/**
+ * @brief   Get the oldest event of the most urgent non-empty level, blocking
+ *
+ * @warning There can only be a single waiter on a queue!
+ *
+ * @param[in]   queue   event queue to get an event from
+ *
+ * @returns     pointer to next event
+ */
+event_t *event_prio_wait(event_prio_queue_t *queue);
+
+/**
+ * @brief   Simple event loop for a prioritized event queue
+ *
+ * @param[in]   queue   event queue to process
+ */
+static inline void event_prio_loop(event_prio_queue_t *queue)
+{
+    event_t *event;
+
+    while ((event = event_prio_wait(queue))) {
+        event->handler(event);
+    }
+}
+
+#if IS_USED(MODULE_EVENT_PRIO_STATS) || defined(DOXYGEN)
+/**
+ * @brief   Get a consistent copy of the statistics of a queue
+ *
+ * @param[in]   queue   event queue
+ * @param[out]  stats   statistics of @p queue
+ */
+void event_prio_stats_get(event_prio_queue_t *queue,
+                          event_prio_stats_t *stats);
+
+/**
+ * @brief   Reset the statistics of a queue, except for the current depth
+ *
+ * @param[in]   queue   event queue
+ */
+void event_prio_stats_reset(event_prio_queue_t *queue);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_PRIO_H */
+/** @} */
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_event_thread_pool Event thread pool
+ * @ingroup     sys_event
+ * @brief       Multiple event handler threads sharing a set of event queues
+ *
+ * An event thread pool lets up to @ref CONFIG_EVENT_THREAD_POOL_WORKERS_MAX
+ * worker threads serve the same array of regular event queues. Events are
+ * posted with @ref event_post as usual. A worker that runs out of work takes
+ * the next event of whatever queue has one, no matter which worker was
+ * notified of it, so one long running handler no longer delays all other
+ * events. As with @ref event_wait_multi, a lower index in the queue array
+ * means a higher priority.
+ *
+ * The queue notifications (@ref event_queue_t::waiter) always go to an idle
+ * worker, if there is one. A worker that takes an event while other events
+ * are pending wakes another idle worker to take them.
+ *
+ * Queues marked as *ordered* have at most one event handled at a time, so
+ * their events are handled one after the other in FIFO order, as with a
+ * single event thread. The events of other queues may be handled
+ * concurrently and, hence, finish out of order.
+ *
+ * @note    RIOT runs threads on one core. Workers of the same priority only
+ *          run concurrently if a handler blocks (e.g. waits for a mutex, a
+ *          bus transfer or a timer) or with the module `sched_round_robin`,
+ *          which time-slices CPU-heavy handlers.
+ *
+ * With the module `event_thread`, `event_thread_pool` replaces the medium
+ * priority event thread by a pool of @ref CONFIG_EVENT_THREAD_POOL_SIZE
+ * workers serving the same queues.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Event thread pool API
+ */
+
+#ifndef EVENT_THREAD_POOL_H
+#define EVENT_THREAD_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "event.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup sys_event_thread_pool_conf Event thread pool configuration
+ * @ingroup config
+ * @{
+ */
+/**
+ * @brief   Maximum number of workers of a pool
+ *
+ * @note    At most 8 workers are supported.
+ */
+#ifndef CONFIG_EVENT_THREAD_POOL_WORKERS_MAX
+#define CONFIG_EVENT_THREAD_POOL_WORKERS_MAX    (4U)
+#endif
+
+/**
+ * @brief   Number of workers of the pool started by `event_thread`
+ */
+#ifndef CONFIG_EVENT_THREAD_POOL_SIZE
+#define CONFIG_EVENT_THREAD_POOL_SIZE           (2U)
+#endif
+
+/**
+ * @brief   Bitmask of the `event_thread` queues that are ordered
+ *
+ * Bit n corresponds to the queue with the priority n, see
+ * @ref EVENT_QUEUE_PRIO_HIGHEST. By default, all queues are ordered, so that
+ * only events of different queues are handled concurrently.
+ */
+#ifndef CONFIG_EVENT_THREAD_POOL_ORDERED
+#define CONFIG_EVENT_THREAD_POOL_ORDERED        (0xffU)
+#endif
+/** @} */
+
+/**
+ * @brief   Maximum number of queues of a pool
+ */
+#define EVENT_THREAD_POOL_QUEUES_MAX    (8U)
+
+/**
+ * @brief   Event thread pool
+ *
+ * @note    The contents of this structure are internal.
+ */
+typedef struct {
+    event_queue_t *queues;      /**< queues served by the pool */
+    thread_t *workers[CONFIG_EVENT_THREAD_POOL_WORKERS_MAX]; /**< workers */
+    uint8_t queues_numof;       /**< number of entries in @p queues */
+    uint8_t workers_numof;      /**< number of workers */
+    uint8_t ordered;            /**< queues handled one event at a time */
+    uint8_t busy;               /**< ordered queues with an event in flight */
+    uint8_t idle;               /**< workers waiting for events */
+} event_thread_pool_t;
+
+/**
+ * @brief   Initialize an event thread pool
+ *
+ * The queues are initialized detached. They will be claimed by the workers.
+ *
+ * @param[out]  pool            pool to initialize
+ * @param[in]   queues          array of the preallocated queue objects
+ * @param[in]   queues_numof    number of elements in @p queues
+ * @param[in]   ordered         bitmask of the queues in @p queues whose
+ *                              events must be handled one at a time
+ *
+ * @pre     @p queues_numof is at most @ref EVENT_THREAD_POOL_QUEUES_MAX
+ */
+void event_thread_pool_init(event_thread_pool_t *pool, event_queue_t *queues,
+                            size_t queues_numof, uint8_t ordered);
+
+/**
+ * @brief   Start a worker thread for an event thread pool
+ *
+ * @param[in,out]   pool        pool to add the worker to
+ * @param[in]       stack       ptr to stack space
+ * @param[in]       stack_size  size of stack
+ * @param[in]       priority    priority to use
+ *
+ * @return  PID of the worker
+ * @return  negative errno of @ref thread_create on error
+ * @return  -ENOSPC if the pool has @ref CONFIG_EVENT_THREAD_POOL_WORKERS_MAX
+ *          workers already
+ */
+kernel_pid_t event_thread_pool_add_worker(event_thread_pool_t *pool,
+                                          char *stack, size_t stack_size,
+                                          unsigned priority);
+
+#if IS_USED(MODULE_EVENT_THREAD) || defined(DOXYGEN)
+/**
+ * @brief   Pool serving the `event_thread` queues, started by `auto_init`
+ */
+extern event_thread_pool_t event_thread_pool;
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_THREAD_POOL_H */
+/** @} */
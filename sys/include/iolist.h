@@ -63,6 +63,22 @@ unsigned iolist_count(const iolist_t *iolist);
  */
 size_t iolist_size(const iolist_t *iolist);
 
+/**
+ * @brief   Copy data into the buffers of an iolist
+ *
+ * Writes @p len bytes from @p buf to @p iolist, starting @p offset bytes
+ * into the list, so a frame can be copied into an iolist in several chunks.
+ *
+ * @param[in]   iolist  iolist to write to
+ * @param[in]   offset  position in @p iolist to start writing at
+ * @param[in]   buf     data to copy
+ * @param[in]   len     number of bytes to copy
+ *
+ * @returns number of bytes copied, less than @p len if @p iolist is full
+ */
+size_t iolist_fill(const iolist_t *iolist, size_t offset,
+                   const void *buf, size_t len);
+
 /** @brief  struct iovec anonymous declaration */
 struct iovec;
 
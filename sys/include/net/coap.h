@@ -36,10 +36,13 @@ extern "C" {
  * @{
  */
 #define COAP_OPT_URI_HOST       (3)
+#define COAP_OPT_ETAG           (4)
 #define COAP_OPT_OBSERVE        (6)
+#define COAP_OPT_URI_PORT       (7)
 #define COAP_OPT_LOCATION_PATH  (8)
 #define COAP_OPT_URI_PATH       (11)
 #define COAP_OPT_CONTENT_FORMAT (12)
+#define COAP_OPT_MAX_AGE        (14)
 #define COAP_OPT_URI_QUERY      (15)
 #define COAP_OPT_ACCEPT         (17)
 #define COAP_OPT_LOCATION_QUERY (20)
@@ -167,6 +170,9 @@ extern "C" {
  * @{
  */
 #define COAP_TOKEN_LENGTH_MAX    (8)
+#define COAP_ETAG_LENGTH_MAX     (8)    /**< maximum length of an ETag */
+#define COAP_MAX_AGE_DEFAULT     (60U)  /**< Max-Age in s if the option is
+                                             missing */
 /** @} */
 
 /**
@@ -29,10 +29,20 @@ extern "C" {
  * @{
  */
 #define DNS_TYPE_A              (1)
+#define DNS_TYPE_SOA            (6)
 #define DNS_TYPE_AAAA           (28)
 #define DNS_CLASS_IN            (1)
 /** @} */
 
+/**
+ * @name    Response codes
+ * @{
+ */
+#define DNS_RCODE_MASK          (0x000fU)   /**< RCODE in dns_hdr_t::flags */
+#define DNS_RCODE_NO_ERROR      (0)         /**< No error */
+#define DNS_RCODE_NAME_ERROR    (3)         /**< Name does not exist */
+/** @} */
+
 /**
  * @name    Field lengths
  * @{
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_dns_cache DNS cache
+ * @ingroup     net_dns
+ * @brief       Cache for the results of DNS queries
+ *
+ * Stores the address a domain name resolved to for the time to live of the
+ * DNS response. A response stating that the name does not exist or has no
+ * address of the requested family is stored as well (negative caching,
+ * [RFC 2308](https://tools.ietf.org/html/rfc2308)), so such a name is not
+ * queried again until the time to live of the negative answer expired.
+ *
+ * Names are stored as a 32 bit hash only, so two names with the same hash
+ * share an entry. If all entries are in use, an expired entry or else the one
+ * that expires first is replaced.
+ *
+ * Enable the cache with the module `dns_cache`, @ref net_sock_dns uses it
+ * then. All functions may be called from different threads.
+ *
+ * @{
+ *
+ * @file
+ * @brief       DNS cache definitions
+ */
+#ifndef NET_DNS_CACHE_H
+#define NET_DNS_CACHE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup net_dns_cache_conf DNS cache configuration
+ * @ingroup  config
+ * @{
+ */
+/**
+ * @brief   Number of entries in the DNS cache
+ */
+#ifndef CONFIG_DNS_CACHE_SIZE
+#define CONFIG_DNS_CACHE_SIZE   (4U)
+#endif
+/** @} */
+
+/**
+ * @brief   Gets the cached result for a domain name
+ *
+ * An address of either family satisfies a query with `AF_UNSPEC`, an IPv6
+ * address is preferred.
+ *
+ * @param[in]  domain_name  The domain name
+ * @param[out] addr_out     The cached address, 4 bytes when @p family is
+ *                          `AF_INET`, 16 bytes otherwise
+ * @param[in]  family       Either `AF_INET`, `AF_INET6` or `AF_UNSPEC`
+ *
+ * @return  Length of the address in @p addr_out
+ * @return  0, if nothing is cached for @p domain_name
+ * @return  -ENOENT, if it is cached that @p domain_name has no address of
+ *          @p family
+ */
+int dns_cache_query(const char *domain_name, void *addr_out, int family);
+
+/**
+ * @brief   Adds the result of a DNS query to the cache
+ *
+ * @param[in] domain_name   The domain name that was queried
+ * @param[in] family        The family of the query, either `AF_INET`,
+ *                          `AF_INET6` or `AF_UNSPEC`
+ * @param[in] addr          The address the name resolved to, NULL for a
+ *                          negative answer
+ * @param[in] addr_len      Length of @p addr, 0 for a negative answer
+ * @param[in] ttl           Time to live of the result in seconds. Nothing is
+ *                          cached for 0.
+ */
+void dns_cache_add(const char *domain_name, int family, const void *addr,
+                   int addr_len, uint32_t ttl);
+
+/**
+ * @brief   Removes all entries from the cache
+ */
+void dns_cache_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_DNS_CACHE_H */
+/** @} */
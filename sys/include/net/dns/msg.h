@@ -99,18 +99,29 @@ size_t dns_msg_compose_query(void *dns_buf, const char *domain_name,
 /**
  * @brief   Parses a DNS response message
  *
+ * The time to live of an address is the smallest TTL of the answer records
+ * up to the address record, so it covers the CNAME records leading to it.
+ * For a response stating that the name does not exist or has no address of
+ * @p family, the time to live is that of the negative answer, taken from the
+ * SOA record in the authority section
+ * ([RFC 2308, section 5](https://tools.ietf.org/html/rfc2308#section-5)),
+ * or 0 if there is none.
+ *
  * @param[in] buf           The message to parse.
  * @param[in] len           Length of @p buf.
  * @param[in] family        The address family used to compose the query for
  *                          this response (see @ref dns_msg_compose_query())
  * @param[out] addr_out     The IP address returned by the response.
+ * @param[out] ttl          The time to live of the result in seconds. May be
+ *                          NULL.
  *
  * @return  Length of the @p addr_out on success.
- * @return  -EBADMSG, when an address corresponding to @p family can not be found
- *          in @p buf.
+ * @return  -ENOENT, when the response states that the name does not exist or
+ *          has no address corresponding to @p family.
+ * @return  -EBADMSG, when @p buf is not a valid response.
  */
 int dns_msg_parse_reply(const uint8_t *buf, size_t len, int family,
-                        void *addr_out);
+                        void *addr_out, uint32_t *ttl);
 
 #ifdef __cplusplus
 }
@@ -53,7 +53,9 @@
  * the path characters (digit and capital precede lower case). Use
  * gcoap_register_listener() at application startup to pass in these resources,
  * wrapped in a gcoap_listener_t. Also see _Server path matching_ in the base
- * [nanocoap](group__net__nanocoap.html) documentation.
+ * [nanocoap](group__net__nanocoap.html) documentation. gcoap relies on this
+ * order to find the resource of a request by binary search, so large resource
+ * trees do not slow down request handling much.
  *
  * gcoap itself defines a resource for `/.well-known/core` discovery, which
  * lists all of the registered paths. See the _Resource list creation_ section
@@ -337,7 +339,35 @@
  *
  * ### Proxy Server Handling
  *
- * Not implemented yet.
+ * With module `gcoap_forward_proxy`, gcoap forwards requests that carry a
+ * `Proxy-Uri` option itself, before they are matched against the registered
+ * resources. The `Proxy-Uri` must be a `coap://` URI with an IP address
+ * literal as host, e.g. `coap://[2001:db8::1]/sensors/temp`. Other URIs are
+ * answered with 5.05 (Proxying Not Supported).
+ *
+ * The proxy sends the request to the origin server with gcoap_req_send(), so
+ * with module `nanocoap_cache` it is a caching proxy. A response from the
+ * cache is piggybacked on the ACK to the client. A response from the origin
+ * server is sent to the client as a separate, non-confirmable response. At
+ * most @ref CONFIG_GCOAP_REQ_WAITING_MAX requests are forwarded at the same
+ * time, further requests are answered with 5.03 (Service Unavailable).
+ * `gcoap_forward_proxy` cannot be used together with `gcoap_dtls`.
+ *
+ * ## Response caching ##
+ *
+ * With module `nanocoap_cache`, gcoap caches the responses to GET requests
+ * sent with gcoap_req_send(), see @ref net_nanocoap_cache. A request for
+ * which a fresh response is cached is not sent. Instead, the response handler
+ * is called with the cached response before gcoap_req_send() returns, with
+ * the Max-Age option reduced to the time the response stays fresh. If the
+ * cached response is stale but has an ETag, the request is sent with that
+ * ETag and a 2.03 (Valid) response is passed to the handler as the cached
+ * 2.05 (Content) response.
+ *
+ * Only requests with a response handler are served from the cache. Requests
+ * that carry an ETag or Observe option themselves bypass the cache. Responses
+ * of the resources gcoap serves are not cached, as only the application
+ * knows when they change.
  *
  * ## DTLS as transport security ##
  *
@@ -355,6 +385,17 @@
  * are available the server destroys the session that has not been used for the
  * longest time after CONFIG_GCOAP_DTLS_MINIMUM_AVAILABLE_SESSIONS_TIMEOUT_USEC.
  *
+ * ## Adaptive retransmission timeouts ##
+ *
+ * By default, a confirmable request is first resent after a random time
+ * between CONFIG_COAP_ACK_TIMEOUT and CONFIG_COAP_ACK_TIMEOUT *
+ * CONFIG_COAP_RANDOM_FACTOR_1000 / 1000 seconds, and every further resend
+ * doubles the timeout. With the module gcoap_cocoa, the initial timeout is
+ * estimated from the round trip times measured for the remote endpoint
+ * instead, and resends back off by a factor that depends on the timeout. See
+ * @ref sys_congure_cocoa for the details. Gcoap keeps the estimation state of
+ * the CONFIG_GCOAP_COCOA_PEERS_NUMOF endpoints used last.
+ *
  * ## Implementation Notes ##
  *
  * ### Waiting for a response ###
@@ -405,6 +446,9 @@
 #include "net/sock/dtls.h"
 #endif
 #include "net/nanocoap.h"
+#if IS_USED(MODULE_NANOCOAP_CACHE)
+#include "net/nanocoap/cache.h"
+#endif
 #include "timex.h"
 
 #ifdef __cplusplus
@@ -626,8 +670,29 @@ extern "C" {
 #define GCOAP_DTLS_EXTRA_STACKSIZE  (0)
 #endif
 
+#if IS_USED(MODULE_NANOCOAP_CACHE)
+/* responses are rebuilt from the cache on the stack */
+#define GCOAP_CACHE_EXTRA_STACKSIZE (CONFIG_NANOCOAP_CACHE_RESPONSE_SIZE \
+                                     + CONFIG_GCOAP_PDU_BUF_SIZE)
+#else
+#define GCOAP_CACHE_EXTRA_STACKSIZE (0)
+#endif
+
+#if IS_USED(MODULE_GCOAP_FORWARD_PROXY)
+/* the forwarded request and the URI parts are built on the stack */
+#define GCOAP_FORWARD_PROXY_EXTRA_STACKSIZE (CONFIG_GCOAP_PDU_BUF_SIZE \
+                                             + CONFIG_SOCK_SCHEME_MAXLEN \
+                                             + 2 * CONFIG_SOCK_HOSTPORT_MAXLEN \
+                                             + 2 * CONFIG_SOCK_URLPATH_MAXLEN \
+                                             + sizeof(coap_pkt_t))
+#else
+#define GCOAP_FORWARD_PROXY_EXTRA_STACKSIZE (0)
+#endif
+
 #define GCOAP_STACK_SIZE (THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE \
-                          + sizeof(coap_pkt_t) + GCOAP_DTLS_EXTRA_STACKSIZE)
+                          + sizeof(coap_pkt_t) + GCOAP_DTLS_EXTRA_STACKSIZE \
+                          + GCOAP_CACHE_EXTRA_STACKSIZE \
+                          + GCOAP_FORWARD_PROXY_EXTRA_STACKSIZE)
 #endif
 /** @} */
 
@@ -639,6 +704,18 @@ extern "C" {
 #define CONFIG_GCOAP_RESEND_BUFS_MAX      (1)
 #endif
 
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Count of remote endpoints the retransmission timeout is estimated
+ *          for with module gcoap_cocoa
+ *
+ * When the state for a new endpoint is needed, the state of the endpoint
+ * with the oldest request is replaced.
+ */
+#ifndef CONFIG_GCOAP_COCOA_PEERS_NUMOF
+#define CONFIG_GCOAP_COCOA_PEERS_NUMOF    (4)
+#endif
+
 /**
  * @name Bitwise positional flags for encoding resource links
  * @anchor COAP_LINK_FLAG_
@@ -768,6 +845,18 @@ struct gcoap_request_memo {
     void *context;                      /**< ptr to user defined context data */
     event_timeout_t resp_evt_tmout;     /**< Limits wait for response */
     event_callback_t resp_tmout_cb;     /**< Callback for response timeout */
+#if IS_USED(MODULE_GCOAP_COCOA) || defined(DOXYGEN)
+    uint32_t send_time;                 /**< Time of the first transmission
+                                             in msec, if confirmable */
+    uint32_t timeout;                   /**< Current retransmission timeout
+                                             in msec, if confirmable */
+#endif
+#if IS_USED(MODULE_NANOCOAP_CACHE) || defined(DOXYGEN)
+    uint8_t cache_key[CONFIG_NANOCOAP_CACHE_KEY_LENGTH];
+                                        /**< Cache key of the request */
+    uint8_t cache_state;                /**< Whether the response is stored
+                                             in or validates the cache */
+#endif
 };
 
 /**
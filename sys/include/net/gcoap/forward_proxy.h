@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gcoap_forward_proxy    Gcoap Forward Proxy
+ * @ingroup     net_gcoap
+ * @brief       Forward proxy implementation for gcoap
+ *
+ * Forwards requests with a `Proxy-Uri` option to the origin server, see
+ * @ref net_gcoap "Proxy Server Handling". Use the module
+ * `gcoap_forward_proxy` to enable it, gcoap calls the functions below itself.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Definitions for the gcoap forward proxy
+ */
+
+#ifndef NET_GCOAP_FORWARD_PROXY_H
+#define NET_GCOAP_FORWARD_PROXY_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "net/gcoap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Initializes the forward proxy
+ */
+void gcoap_forward_proxy_init(void);
+
+/**
+ * @brief   Forwards a request if it carries a `Proxy-Uri` option
+ *
+ * @param[in]  pdu      The request, located in @p buf
+ * @param[out] buf      Buffer for the response to the client
+ * @param[in]  len      Size of @p buf
+ * @param[in]  client   The endpoint of the client
+ *
+ * @return  Length of the response to the client in @p buf
+ * @return  0, if the request was forwarded and the response will be sent
+ *          separately
+ * @return  <0, if the request has no `Proxy-Uri` option and must be handled
+ *          by gcoap itself
+ */
+ssize_t gcoap_forward_proxy_request_process(coap_pkt_t *pdu, uint8_t *buf,
+                                            size_t len,
+                                            const sock_udp_ep_t *client);
+
+/**
+ * @brief   Sends a separate response to a client
+ *
+ * Sets a new message ID in the response.
+ *
+ * @param[in] buf       The response
+ * @param[in] len       Length of the response
+ * @param[in] client    The endpoint of the client
+ *
+ * @return  Number of bytes sent
+ * @return  <=0 on error
+ */
+ssize_t gcoap_forward_proxy_dispatch(uint8_t *buf, size_t len,
+                                     const sock_udp_ep_t *client);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GCOAP_FORWARD_PROXY_H */
+/** @} */
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv6_flowcache IPv6 forwarding flow cache
+ * @ingroup     net_gnrc_ipv6
+ * @brief       Forwards packets of known flows without the IPv6 thread
+ *
+ * When the IPv6 thread forwards a packet, it remembers the outgoing interface
+ * and the link-layer address of the next hop for the flow of the packet,
+ * identified by its source address, destination address and flow label.
+ * Later packets of the same flow are then forwarded by the thread that
+ * received them (the network interface thread or, for 6LoWPAN interfaces, the
+ * 6LoWPAN thread), so they never have to be queued for the IPv6 thread.
+ *
+ * Only packets that need nothing but a decremented hop limit take this path.
+ * Everything else, e.g. packets with hop-by-hop options, packets that reach a
+ * hop limit of 0 or that are too big for the outgoing interface, is left to
+ * the IPv6 thread which also generates the ICMPv6 errors.
+ *
+ * The cache is flushed whenever the NIB changes a route or a neighbor, or an
+ * interface changes its addresses. Entries also expire after
+ * @ref CONFIG_GNRC_IPV6_FLOWCACHE_LIFETIME_MS so the NIB sees every flow every
+ * once in a while. Neighbors that are not known to be reachable are not
+ * cached, so neighbor unreachability detection keeps working.
+ *
+ * @{
+ *
+ * @file
+ * @brief   IPv6 forwarding flow cache definitions
+ */
+#ifndef NET_GNRC_IPV6_FLOWCACHE_H
+#define NET_GNRC_IPV6_FLOWCACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "kernel_defines.h"
+#include "net/gnrc/ipv6/nib/nc.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/pkt.h"
+#include "net/ipv6/hdr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup    net_gnrc_ipv6_flowcache_conf GNRC IPv6 flow cache compile configurations
+ * @ingroup     net_gnrc_ipv6_flowcache
+ * @ingroup     net_gnrc_conf
+ * @{
+ */
+/**
+ * @brief   Number of flows in the cache
+ *
+ * @note    Must be a power of 2.
+ */
+#ifndef CONFIG_GNRC_IPV6_FLOWCACHE_SIZE
+#define CONFIG_GNRC_IPV6_FLOWCACHE_SIZE         (8U)
+#endif
+
+/**
+ * @brief   Time in milliseconds after which a flow is looked up in the NIB
+ *          again
+ */
+#ifndef CONFIG_GNRC_IPV6_FLOWCACHE_LIFETIME_MS
+#define CONFIG_GNRC_IPV6_FLOWCACHE_LIFETIME_MS  (1000U)
+#endif
+/** @} */
+
+/**
+ * @brief   Statistics of the flow cache
+ */
+typedef struct {
+    uint32_t hits;      /**< packets forwarded by the flow cache */
+    uint32_t misses;    /**< packets left to the IPv6 thread */
+    uint32_t flushes;   /**< number of times the cache was flushed */
+} gnrc_ipv6_flowcache_stats_t;
+
+#if IS_USED(MODULE_GNRC_IPV6_FLOWCACHE) || defined(DOXYGEN)
+/**
+ * @brief   Remembers where a forwarded packet was sent to
+ *
+ * Called by the IPv6 thread for every packet it forwards.
+ *
+ * @param[in] hdr   IPv6 header of the forwarded packet
+ * @param[in] netif interface the packet is sent over
+ * @param[in] nce   neighbor cache entry of the next hop
+ */
+void gnrc_ipv6_flowcache_add(const ipv6_hdr_t *hdr, const gnrc_netif_t *netif,
+                             const gnrc_ipv6_nib_nc_t *nce);
+
+/**
+ * @brief   Forwards a received IPv6 packet if its flow is known
+ *
+ * @param[in] pkt   a received IPv6 packet in receive order, i.e. an IPv6 snip
+ *                  followed by a @ref net_gnrc_netif_hdr snip
+ *
+ * @return  true, if @p pkt was consumed by the flow cache
+ * @return  false, if @p pkt is untouched and needs to be handled by the
+ *          IPv6 thread
+ */
+bool gnrc_ipv6_flowcache_forward(gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Removes all flows from the cache
+ *
+ * Called whenever the forwarding decision for a flow might have changed.
+ */
+void gnrc_ipv6_flowcache_flush(void);
+
+/**
+ * @brief   Gets the statistics of the flow cache
+ *
+ * @param[out] stats    the statistics
+ */
+void gnrc_ipv6_flowcache_get_stats(gnrc_ipv6_flowcache_stats_t *stats);
+#else
+static inline void gnrc_ipv6_flowcache_add(const ipv6_hdr_t *hdr,
+                                           const gnrc_netif_t *netif,
+                                           const gnrc_ipv6_nib_nc_t *nce)
+{
+    (void)hdr;
+    (void)netif;
+    (void)nce;
+}
+
+static inline bool gnrc_ipv6_flowcache_forward(gnrc_pktsnip_t *pkt)
+{
+    (void)pkt;
+    return false;
+}
+
+static inline void gnrc_ipv6_flowcache_flush(void)
+{
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_IPV6_FLOWCACHE_H */
+/** @} */
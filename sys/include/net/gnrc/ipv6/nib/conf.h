@@ -228,6 +228,29 @@ extern "C" {
 #ifndef CONFIG_GNRC_IPV6_NIB_MULTIHOP_DAD
 #define CONFIG_GNRC_IPV6_NIB_MULTIHOP_DAD             0
 #endif
+
+/**
+ * @brief   Longest-prefix-match index for off-link entries
+ *
+ * Keeps the off-link entries (forwarding table, prefix list, destination
+ * cache) in a path-compressed binary trie, so the route lookup for every
+ * forwarded packet takes time proportional to the prefix length instead of
+ * @ref CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF. Costs up to two trie nodes of about
+ * 36 bytes per off-link entry. Worth it for routers with many routes.
+ */
+#ifndef CONFIG_GNRC_IPV6_NIB_OFFL_LPM
+#define CONFIG_GNRC_IPV6_NIB_OFFL_LPM                 0
+#endif
+
+/**
+ * @brief   Hash index for on-link entries (neighbor cache)
+ *
+ * Makes looking up a neighbor by its address independent of
+ * @ref CONFIG_GNRC_IPV6_NIB_NUMOF. Costs about three words per entry.
+ */
+#ifndef CONFIG_GNRC_IPV6_NIB_ONL_HASH
+#define CONFIG_GNRC_IPV6_NIB_ONL_HASH                 0
+#endif
 /** @} */
 
 /**
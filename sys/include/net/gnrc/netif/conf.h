@@ -79,6 +79,40 @@ extern "C" {
 #define CONFIG_GNRC_NETIF_PKTQ_TIMER_US       (5000U)
 #endif
 
+/**
+ * @brief       Target sojourn time in microseconds of the CoDel active queue
+ *              management of the packet queue
+ *
+ * When packets of a traffic class stay longer than this in the queue for at
+ * least @ref CONFIG_GNRC_NETIF_PKTQ_CODEL_INTERVAL_US, packets of that class
+ * are dropped on de-queuing at an increasing rate until the sojourn time
+ * falls below the target again. Network control traffic is never dropped.
+ *
+ * The default is larger than the 5ms recommended for CoDel, so a queue of a
+ * few IEEE 802.15.4 frames is not mistaken for a standing queue.
+ *
+ * Set to 0 to deactivate active queue management.
+ *
+ * @see         net_gnrc_netif_pktq
+ * @see         [RFC 8289](https://tools.ietf.org/html/rfc8289)
+ */
+#ifndef CONFIG_GNRC_NETIF_PKTQ_CODEL_TARGET_US
+#define CONFIG_GNRC_NETIF_PKTQ_CODEL_TARGET_US    (20000U)
+#endif
+
+/**
+ * @brief       Interval in microseconds of the CoDel active queue management
+ *              of the packet queue
+ *
+ * Should be in the order of the worst-case round-trip time of the connections
+ * going through the interface.
+ *
+ * @see         CONFIG_GNRC_NETIF_PKTQ_CODEL_TARGET_US
+ */
+#ifndef CONFIG_GNRC_NETIF_PKTQ_CODEL_INTERVAL_US
+#define CONFIG_GNRC_NETIF_PKTQ_CODEL_INTERVAL_US  (200000U)
+#endif
+
 /**
  * @brief   Number of multicast addresses needed for @ref net_gnrc_rpl "RPL".
  *
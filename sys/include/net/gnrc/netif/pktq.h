@@ -10,6 +10,16 @@
  * @defgroup    net_gnrc_netif_pktq Send queue for @ref net_gnrc_netif
  * @ingroup     net_gnrc_netif
  * @brief
+ *
+ * Packets that can't be sent right away are queued per network interface in
+ * one FIFO per traffic class (see @ref gnrc_netif_pktq_class_t), so network
+ * control traffic is not stuck behind bulk data. Standing queues of the other
+ * classes are kept short with CoDel
+ * (see @ref CONFIG_GNRC_NETIF_PKTQ_CODEL_TARGET_US).
+ *
+ * With module `netstats_pktq`, statistics per traffic class are available
+ * via @ref NETOPT_STATS with context @ref NETSTATS_PKTQ.
+ *
  * @{
  *
  * @file
@@ -31,9 +41,31 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Determines the traffic class of a packet
+ *
+ * IPv6 packets, uncompressed or compressed with 6LoWPAN IPHC, are mapped by
+ * their DSCP, ICMPv6 packets are always network control. 6LoWPAN fragments
+ * and packets of other protocols are mapped to
+ * @ref GNRC_NETIF_PKTQ_CLASS_DEFAULT.
+ *
+ * @pre `pkt != NULL`
+ *
+ * @param[in] pkt   A packet, may start with a @ref net_gnrc_netif_hdr.
+ *                  May not be NULL.
+ *
+ * @return  The traffic class of @p pkt
+ */
+gnrc_netif_pktq_class_t gnrc_netif_pktq_classify(const gnrc_pktsnip_t *pkt);
+
 /**
  * @brief   Puts a packet into the packet send queue of a network interface
  *
+ * The packet is appended to the queue of its traffic class
+ * (see @ref gnrc_netif_pktq_classify()). When the pool is depleted, the last
+ * packet of the lowest priority class below the one of @p pkt is dropped to
+ * make room.
+ *
  * @pre `netif != NULL`
  * @pre `pkt != NULL`
  *
@@ -56,6 +88,10 @@ unsigned gnrc_netif_pktq_usage(void);
 /**
  * @brief   Gets a packet from the packet send queue of a network interface
  *
+ * Takes the head of the highest priority traffic class that is not empty.
+ * Packets that exceeded their sojourn time may be dropped on the way (see
+ * @ref CONFIG_GNRC_NETIF_PKTQ_CODEL_TARGET_US).
+ *
  * @pre `netif != NULL`
  *
  * @param[in] netif A network interface. May not be NULL.
@@ -63,26 +99,7 @@ unsigned gnrc_netif_pktq_usage(void);
  * @return  A packet on success
  * @return  NULL when the queue is empty
  */
-static inline gnrc_pktsnip_t *gnrc_netif_pktq_get(gnrc_netif_t *netif)
-{
-#if IS_USED(MODULE_GNRC_NETIF_PKTQ)
-    assert(netif != NULL);
-
-    gnrc_pktsnip_t *pkt = NULL;
-    gnrc_pktqueue_t *entry = gnrc_pktqueue_remove_head(
-        &netif->send_queue.queue
-    );
-
-    if (entry != NULL) {
-        pkt = entry->pkt;
-        entry->pkt = NULL;
-    }
-    return pkt;
-#else   /* IS_USED(MODULE_GNRC_NETIF_PKTQ) */
-    (void)netif;
-    return NULL;
-#endif  /* IS_USED(MODULE_GNRC_NETIF_PKTQ) */
-}
+gnrc_pktsnip_t *gnrc_netif_pktq_get(gnrc_netif_t *netif);
 
 /**
  * @brief   Schedule a dequeue notification to network interface
@@ -103,6 +120,10 @@ void gnrc_netif_pktq_sched_get(gnrc_netif_t *netif);
  * @brief   Pushes a packet back to the head of the packet send queue of a
  *          network interface
  *
+ * The packet is put at the head of the queue of its traffic class. If it is
+ * the packet last returned by @ref gnrc_netif_pktq_get(), it keeps the time
+ * it was originally queued, so retries do not hide its sojourn time.
+ *
  * @pre `netif != NULL`
  * @pre `pkt != NULL`
  *
@@ -130,7 +151,12 @@ static inline bool gnrc_netif_pktq_empty(gnrc_netif_t *netif)
 #if IS_USED(MODULE_GNRC_NETIF_PKTQ)
     assert(netif != NULL);
 
-    return (netif->send_queue.queue == NULL);
+    for (unsigned i = 0; i < GNRC_NETIF_PKTQ_CLASS_NUMOF; i++) {
+        if (netif->send_queue.queue[i] != NULL) {
+            return false;
+        }
+    }
+    return true;
 #else   /* IS_USED(MODULE_GNRC_NETIF_PKTQ) */
     (void)netif;
     return false;
@@ -23,18 +23,71 @@
 #ifndef NET_GNRC_NETIF_PKTQ_TYPE_H
 #define NET_GNRC_NETIF_PKTQ_TYPE_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "kernel_defines.h"
 #include "net/gnrc/pktqueue.h"
+#include "net/netstats.h"
 #include "xtimer.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief   Traffic classes of the packet queue, in order of priority
+ *
+ * Queued packets of a class are only sent when all classes of higher priority
+ * are empty.
+ */
+typedef enum {
+    /**
+     * @brief   Network control, i.e. ICMPv6 (NDP, RPL) and packets with a
+     *          DSCP of CS5 and above (including EF)
+     */
+    GNRC_NETIF_PKTQ_CLASS_CTRL = 0,
+    GNRC_NETIF_PKTQ_CLASS_DEFAULT,      /**< everything else */
+    GNRC_NETIF_PKTQ_CLASS_BULK,         /**< DSCP CS1 and LE (lower effort) */
+    GNRC_NETIF_PKTQ_CLASS_NUMOF,        /**< number of traffic classes */
+} gnrc_netif_pktq_class_t;
+
+/**
+ * @brief   CoDel state of a traffic class
+ *
+ * @see [RFC 8289](https://tools.ietf.org/html/rfc8289)
+ */
+typedef struct {
+    uint32_t first_above_time;  /**< time the sojourn time stays above the
+                                 *   target until, 0 if below target */
+    uint32_t drop_next;         /**< time of the next drop in dropping state */
+    uint16_t count;             /**< packets dropped in dropping state */
+    uint16_t lastcount;         /**< count when dropping state was last left */
+    bool dropping;              /**< in dropping state */
+} gnrc_netif_pktq_codel_t;
+
 /**
  * @brief   A packet queue for @ref net_gnrc_netif with a de-queue timer
  */
 typedef struct {
-    gnrc_pktqueue_t *queue;     /**< the actual packet queue class */
+    /**
+     * @brief   The actual packet queues, one per traffic class
+     */
+    gnrc_pktqueue_t *queue[GNRC_NETIF_PKTQ_CLASS_NUMOF];
+    /**
+     * @brief   CoDel state per traffic class
+     */
+    gnrc_netif_pktq_codel_t codel[GNRC_NETIF_PKTQ_CLASS_NUMOF];
+    gnrc_pktsnip_t *last;       /**< packet last taken from the queue */
+    uint32_t last_enqueued;     /**< time gnrc_netif_pktq_t::last was queued */
+#if IS_USED(MODULE_NETSTATS_PKTQ) || defined(DOXYGEN)
+    /**
+     * @brief   Statistics per traffic class
+     *
+     * @note    Only available with module `netstats_pktq`
+     */
+    netstats_queue_t stats[GNRC_NETIF_PKTQ_CLASS_NUMOF];
+#endif
 #if CONFIG_GNRC_NETIF_PKTQ_TIMER_US >= 0
     msg_t dequeue_msg;          /**< message for gnrc_netif_pktq_t::dequeue_timer to send */
     xtimer_t dequeue_timer;     /**< timer to schedule next sending of
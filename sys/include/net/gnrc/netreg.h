@@ -72,6 +72,31 @@ typedef enum {
 } gnrc_netreg_type_t;
 #endif
 
+/**
+ * @defgroup net_gnrc_netreg_conf GNRC network protocol registry compile configurations
+ * @ingroup net_gnrc_conf
+ * @{
+ */
+/**
+ * @brief   Number of hash buckets per @ref gnrc_nettype_t in the registry
+ *
+ * @details Entries are looked up by gnrc_netreg_entry_t::demux_ctx in a hash
+ *          table per type, so hosts with many open ports do not need to walk
+ *          all registered entries for every packet. Entries with
+ *          @ref GNRC_NETREG_DEMUX_CTX_ALL are kept in a bucket of their own.
+ *          Every bucket costs a pointer per type, i.e. the default takes 36
+ *          bytes per type (including the bucket for
+ *          @ref GNRC_NETREG_DEMUX_CTX_ALL) on 32-bit platforms. Set it to 1
+ *          to keep the registry as small as a single list per type, if only a
+ *          few entries are registered.
+ *
+ * @note    Must be a power of 2.
+ */
+#ifndef CONFIG_GNRC_NETREG_BUCKETS_NUMOF
+#define CONFIG_GNRC_NETREG_BUCKETS_NUMOF    (8U)
+#endif
+/** @} */
+
 /**
  * @brief   Demux context value to get all packets of a certain type.
  *
@@ -348,6 +373,25 @@ gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
  */
 int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx);
 
+/**
+ * @brief   Searches for all entries with given parameters in the registry
+ *
+ * Finds the same entries as gnrc_netreg_lookup() and gnrc_netreg_num()
+ * combined, but in a single lookup. The entries after @p first are retrieved
+ * with gnrc_netreg_getnext().
+ *
+ * @param[in] type      Type of the protocol.
+ * @param[in] demux_ctx The demultiplexing context for the registered thread.
+ *                      See gnrc_netreg_entry_t::demux_ctx.
+ * @param[out] first    The first entry fitting the given parameters. NULL if
+ *                      no entry can be found.
+ *
+ * @return  Number of entries with the same gnrc_netreg_entry_t::type and
+ *          gnrc_netreg_entry_t::demux_ctx as the given parameters.
+ */
+int gnrc_netreg_lookup_all(gnrc_nettype_t type, uint32_t demux_ctx,
+                           gnrc_netreg_entry_t **first);
+
 /**
  * @brief   Returns the next entry after @p entry with the same
  *          gnrc_netreg_entry_t::type and gnrc_netreg_entry_t::demux_ctx as the
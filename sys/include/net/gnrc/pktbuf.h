@@ -63,6 +63,29 @@ extern "C" {
 #ifndef CONFIG_GNRC_PKTBUF_SIZE
 #define CONFIG_GNRC_PKTBUF_SIZE    (6144)
 #endif
+
+/**
+ * @brief   Largest allocation in bytes served from slab pages by module
+ *          `gnrc_pktbuf_segfit`
+ *
+ * @details `gnrc_pktbuf_segfit` serves @ref gnrc_pktsnip_t and other small
+ *          allocations from pages of equally sized slots, so they do not
+ *          fragment the space for payloads. The default fits an IPv6 header.
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SEGFIT_SLAB_SIZE
+#define CONFIG_GNRC_PKTBUF_SEGFIT_SLAB_SIZE     (40)
+#endif
+
+/**
+ * @brief   Maximum number of slab pages of module `gnrc_pktbuf_segfit`
+ *
+ * @details Pages are taken from the packet buffer when needed and given back
+ *          when empty. Small allocations fall back to the payload space when
+ *          all pages are in use.
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SEGFIT_PAGES_NUMOF
+#define CONFIG_GNRC_PKTBUF_SEGFIT_PAGES_NUMOF   (8)
+#endif
 /** @} */
 
 /**
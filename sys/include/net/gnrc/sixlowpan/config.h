@@ -70,14 +70,36 @@ extern "C" {
 #endif  /* defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) */
 #endif
 
+/**
+ * @brief   Memory budget of the reassembly buffer in bytes
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_frag_rb](@ref net_gnrc_sixlowpan_frag_rb) module
+ *
+ * Unless @ref CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE is set, the reassembly
+ * buffer gets as many entries as fit into this budget. An entry is accounted
+ * for with the fragment intervals of a datagram of @ref IPV6_MIN_MTU bytes
+ * (see @ref GNRC_SIXLOWPAN_FRAG_RB_ENTRY_MEM). The datagrams themselves are
+ * reassembled in the @ref net_gnrc_pktbuf and are not part of this budget.
+ */
+#ifndef CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_MEM
+#define CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_MEM        (1024U)
+#endif
+
 /**
  * @brief   Size of the reassembly buffer
  *
  * @note    Only applicable with
  *          [gnrc_sixlowpan_frag_rb](@ref net_gnrc_sixlowpan_frag_rb) module
+ *
+ * Defaults to the number of entries that fit into
+ * @ref CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_MEM, but at least 1. Since the default
+ * depends on the size of the entries, it is only a constant expression, not a
+ * value the preprocessor can evaluate.
  */
 #ifndef CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE
-#define CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE       (4U)
+#define CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE \
+    GNRC_SIXLOWPAN_FRAG_RB_ENTRIES(CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_MEM)
 #endif
 
 /**
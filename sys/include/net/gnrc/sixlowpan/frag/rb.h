@@ -27,6 +27,7 @@
 #include "architecture.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/pkt.h"
+#include "net/ipv6.h"
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
 #include "net/sixlowpan/sfr.h"
 #endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
@@ -115,6 +116,73 @@ typedef struct {
 #endif /* IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) */
 } gnrc_sixlowpan_frag_rb_t;
 
+/**
+ * @brief   Estimated fragment payload size to determine the number of fragment
+ *          intervals per datagram
+ *
+ * Defaults to the MAC payload size minus the fragment header, assuming 64-bit
+ * source and destination addresses and an omitted source PAN ID.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SIZE
+#define GNRC_SIXLOWPAN_FRAG_SIZE            (104 - 5)
+#endif
+
+/**
+ * @brief   Number of fragment intervals reserved for a datagram of
+ *          @ref IPV6_MIN_MTU bytes
+ */
+#define GNRC_SIXLOWPAN_FRAG_RB_INTS_PER_DATAGRAM \
+    ((IPV6_MIN_MTU + GNRC_SIXLOWPAN_FRAG_SIZE - 1) / GNRC_SIXLOWPAN_FRAG_SIZE)
+
+/**
+ * @brief   Memory a reassembly buffer entry accounts for in
+ *          @ref CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_MEM
+ *
+ * The entry itself, its share of the fragment interval pool and its slot in
+ * the hash index.
+ */
+#define GNRC_SIXLOWPAN_FRAG_RB_ENTRY_MEM \
+    (sizeof(gnrc_sixlowpan_frag_rb_t) + \
+     (GNRC_SIXLOWPAN_FRAG_RB_INTS_PER_DATAGRAM * \
+      sizeof(gnrc_sixlowpan_frag_rb_int_t)) + (3 * sizeof(uint8_t)))
+
+/**
+ * @brief   Number of reassembly buffer entries that fit into @p mem bytes, but
+ *          at least 1
+ *
+ * @param[in] mem   A memory budget in bytes
+ */
+#define GNRC_SIXLOWPAN_FRAG_RB_ENTRIES(mem) \
+    (((mem) < GNRC_SIXLOWPAN_FRAG_RB_ENTRY_MEM) \
+     ? 1U : (unsigned)((mem) / GNRC_SIXLOWPAN_FRAG_RB_ENTRY_MEM))
+
+/**
+ * @brief   Hashes the link-layer source address and the tag of a datagram
+ *
+ * Both the reassembly buffer and the virtual reassembly buffer are indexed by
+ * this hash, as every fragment of a datagram carries both.
+ *
+ * @param[in] src       Link-layer source address of the datagram.
+ * @param[in] src_len   Length of @p src.
+ * @param[in] tag       Tag of the datagram.
+ *
+ * @return  The hash of @p src and @p tag
+ */
+static inline uint32_t gnrc_sixlowpan_frag_rb_hash(const uint8_t *src,
+                                                   size_t src_len,
+                                                   unsigned tag)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261U;
+
+    for (size_t i = 0; i < src_len; i++) {
+        hash = (hash ^ src[i]) * 16777619U;
+    }
+    hash = (hash ^ (tag & 0xff)) * 16777619U;
+    hash = (hash ^ ((tag >> 8) & 0xff)) * 16777619U;
+    return hash;
+}
+
 /**
  * @brief   Adds a new fragment to the reassembly buffer. If the packet is
  *          complete, dispatch the packet with the transmit information of
@@ -237,6 +305,13 @@ const gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_array(void);
  */
 void gnrc_sixlowpan_frag_rb_base_rm(gnrc_sixlowpan_frag_rb_base_t *entry);
 
+/**
+ * @brief   Returns the fragment intervals of an entry to the interval pool
+ *
+ * @param[in,out] entry Entry to remove the intervals from
+ */
+void gnrc_sixlowpan_frag_rb_ints_rm(gnrc_sixlowpan_frag_rb_base_t *entry);
+
 /**
  * @brief   Garbage collect reassembly buffer.
  */
@@ -11,6 +11,10 @@
  * @ingroup     net_gnrc
  * @brief       RIOT's TCP implementation for the GNRC network stack.
  *
+ * Congestion control is done by @ref sys_congure. NewReno
+ * (@ref sys_congure_reno) is used by default, use the pseudo-module
+ * `gnrc_tcp_cubic` to use CUBIC (@ref sys_congure_cubic) instead.
+ *
  * @{
  *
  * @file
@@ -214,6 +218,9 @@ int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
  * @pre @p data must not be NULL.
  *
  * @note Blocks until up to @p len bytes were transmitted or an error occurred.
+ *       The data is acknowledged in the background. Up to
+ *       @ref CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE segments are in flight
+ *       before the function blocks for acknowledgments.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
@@ -168,6 +168,41 @@ extern "C" {
 #define CONFIG_GNRC_TCP_PROBE_UPPER_BOUND_MS (60U * MS_PER_SEC)
 #endif
 
+/**
+ * @brief Maximum number of data segments in flight. Default is 2.
+ *
+ * @note Every segment in flight stays in the packet buffer until it is
+ *       acknowledged. Increase the packet buffer size accordingly. A value of
+ *       1 sends one segment per round trip time. Must not exceed 15.
+ */
+#ifndef CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE
+#define CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE (2U)
+#endif
+
+/**
+ * @brief Number of duplicate ACKs that trigger a fast retransmit (see RFC 5681)
+ */
+#ifndef CONFIG_GNRC_TCP_DUP_ACK_THRESHOLD
+#define CONFIG_GNRC_TCP_DUP_ACK_THRESHOLD (3U)
+#endif
+
+/**
+ * @brief Number of gaps in the received data that are tracked. Default is 3.
+ *
+ * @note Segments that arrive out of order are kept in the receive buffer
+ *       until the gap in front of them is filled. Must be between 1 and 4.
+ */
+#ifndef CONFIG_GNRC_TCP_OOO_RANGES
+#define CONFIG_GNRC_TCP_OOO_RANGES (3U)
+#endif
+
+/**
+ * @brief Enable selective acknowledgments (SACK, see RFC 2018). Enabled by default.
+ */
+#ifndef CONFIG_GNRC_TCP_SACK_EN
+#define CONFIG_GNRC_TCP_SACK_EN 1
+#endif
+
 /**
  * @brief Message queue size for TCP API internal messaging
  * @note The number of elements in a message queue must be a power of two.
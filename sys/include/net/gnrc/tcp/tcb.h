@@ -34,10 +34,32 @@
 #include "net/gnrc/ipv6.h"
 #endif
 
+#include "congure/cubic.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Congestion control state of a connection.
+ *
+ * NewReno (@ref sys_congure_reno) by default, CUBIC (@ref sys_congure_cubic)
+ * with module `gnrc_tcp_cubic`.
+ */
+#if defined(MODULE_GNRC_TCP_CUBIC) || defined(DOXYGEN)
+typedef congure_cubic_snd_t gnrc_tcp_congure_t;
+#else
+typedef congure_reno_snd_t gnrc_tcp_congure_t;
+#endif
+
+/**
+ * @brief Range of sequence numbers received out of order.
+ */
+typedef struct {
+    uint32_t left;         /**< First sequence number of the range */
+    uint32_t right;        /**< Sequence number following the range */
+} gnrc_tcp_ooo_range_t;
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
@@ -66,11 +88,25 @@ typedef struct sock_tcp {
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
+    uint32_t rtt_seq;      /**< Sequence number that ends the timed segment */
     uint8_t retries;       /**< Number of retransmissions */
+    uint32_t rtx_start;    /**< Timer value when snd_una last advanced */
+    gnrc_tcp_congure_t cong; /**< Congestion control */
     evtimer_msg_event_t event_retransmit; /**< Retransmission event */
     evtimer_msg_event_t event_timeout;    /**< Timeout event */
     evtimer_mbox_event_t event_misc;      /**< General purpose event */
-    gnrc_pktsnip_t *pkt_retransmit;       /**< Pointer to packet in "retransmit queue" */
+    /**
+     * @brief Retransmission queue, oldest segment first
+     *
+     * Has room for one more segment than data segments may be in flight,
+     * so SYN and FIN can always be queued.
+     */
+    gnrc_pktsnip_t *pkt_retransmit[CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE + 1];
+    uint8_t rtx_num;         /**< Number of segments in the retransmission queue */
+    uint16_t rtx_sacked;     /**< Bitmask of selectively acknowledged segments */
+    gnrc_tcp_ooo_range_t ooo[CONFIG_GNRC_TCP_OOO_RANGES]; /**< Ranges received out of order,
+                                                              most recent first */
+    uint8_t ooo_num;         /**< Number of ranges received out of order */
     mbox_t *mbox;            /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
@@ -1620,6 +1620,32 @@ ssize_t coap_tree_handler(coap_pkt_t *pkt, uint8_t *resp_buf,
                           const coap_resource_t *resources,
                           size_t resources_numof);
 
+/**
+ * @brief   Finds the resource matching a request URI path
+ *
+ * @p resources must be sorted alphabetically by coap_resource_t::path. Except
+ * for a few resources, the lookup uses binary search. Resources with
+ * @ref COAP_MATCH_SUBTREE are found by repeating the search for shorter
+ * prefixes of @p uri, which ends after a few steps for typical resource trees.
+ *
+ * If several resources match, the first one in @p resources wins, just as if
+ * @p resources was searched linearly.
+ *
+ * @param[in]   resources       Array of resources, sorted by path
+ * @param[in]   resources_numof Number of entries in @p resources
+ * @param[in]   uri             Null-terminated URI path of the request
+ * @param[in]   method_flag     Method of the request, see coap_method2flag()
+ * @param[out]  resource        The matching resource
+ *
+ * @return      0 on success
+ * @return      -ENOTSUP if only resources not allowing @p method_flag match
+ * @return      -ENOENT if no resource matches @p uri
+ */
+int coap_find_resource(const coap_resource_t *resources,
+                       size_t resources_numof, const uint8_t *uri,
+                       coap_method_flags_t method_flag,
+                       const coap_resource_t **resource);
+
 /**
  * @brief   Convert message code (request method) into a corresponding bit field
  *
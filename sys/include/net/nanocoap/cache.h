@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_nanocoap_cache Nanocoap-Cache implementation
+ * @ingroup     net_nanocoap
+ * @brief       A cache implementation for nanocoap response messages
+ *
+ * Stores responses to GET requests under a cache key derived from the request
+ * ([RFC 7252, section 5.6](https://tools.ietf.org/html/rfc7252#section-5.6)):
+ * the method and all options that are not marked as NoCacheKey. The ETag and
+ * Observe options are not part of the key either, as the cache validates
+ * entries itself and notifications are not cached.
+ *
+ * A response stays fresh for the time given by its Max-Age option. A stale
+ * response can be validated with its ETag: a 2.03 (Valid) response to a
+ * request carrying that ETag makes it fresh again.
+ *
+ * The cache takes @ref CONFIG_NANOCOAP_CACHE_ENTRIES times
+ * @ref CONFIG_NANOCOAP_CACHE_RESPONSE_SIZE bytes for responses, plus some
+ * bytes per entry for the key and the bookkeeping. Responses that do not fit
+ * into an entry are not cached. If all entries are in use, the least recently
+ * used one is replaced.
+ *
+ * nanocoap_cache_init() must be called before the cache is used, gcoap does
+ * so in gcoap_init(). The cache does not lock itself. Users in different
+ * threads must enclose their calls and any access to entries with
+ * nanocoap_cache_lock() and nanocoap_cache_unlock().
+ *
+ * @{
+ *
+ * @file
+ * @brief       nanocoap-cache API
+ */
+
+#ifndef NET_NANOCOAP_CACHE_H
+#define NET_NANOCOAP_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "clist.h"
+#include "net/nanocoap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup net_nanocoap_cache_conf Nanocoap-Cache compile configurations
+ * @ingroup  net_nanocoap_conf
+ * @{
+ */
+/**
+ * @brief   The number of responses the cache can hold
+ */
+#ifndef CONFIG_NANOCOAP_CACHE_ENTRIES
+#define CONFIG_NANOCOAP_CACHE_ENTRIES       (8)
+#endif
+
+/**
+ * @brief   The maximum size of a cached response in bytes
+ */
+#ifndef CONFIG_NANOCOAP_CACHE_RESPONSE_SIZE
+#define CONFIG_NANOCOAP_CACHE_RESPONSE_SIZE (128)
+#endif
+
+/**
+ * @brief   Length of a cache key in bytes
+ *
+ * The key is a truncated SHA-256 hash of the request.
+ */
+#ifndef CONFIG_NANOCOAP_CACHE_KEY_LENGTH
+#define CONFIG_NANOCOAP_CACHE_KEY_LENGTH    (8)
+#endif
+/** @} */
+
+/**
+ * @brief   Cache entry
+ */
+typedef struct {
+    clist_node_t node;          /**< Node in the list of used or free entries */
+    uint8_t cache_key[CONFIG_NANOCOAP_CACHE_KEY_LENGTH];  /**< Cache key */
+    uint8_t response_buf[CONFIG_NANOCOAP_CACHE_RESPONSE_SIZE];
+                                /**< The cached response */
+    size_t response_len;        /**< Length of the cached response */
+    uint32_t max_age;           /**< Time in ms the response becomes stale */
+} nanocoap_cache_entry_t;
+
+/**
+ * @brief   Cache statistics
+ */
+typedef struct {
+    uint32_t hits;              /**< Lookups that found a fresh response */
+    uint32_t misses;            /**< Lookups that found no or a stale
+                                 *   response */
+    uint32_t validations;       /**< Stale responses made fresh by 2.03 */
+    uint32_t evictions;         /**< Responses replaced to make room */
+} nanocoap_cache_stats_t;
+
+/**
+ * @brief   Initializes the cache, dropping all entries and statistics
+ */
+void nanocoap_cache_init(void);
+
+/**
+ * @brief   Locks the cache against access from other threads
+ */
+void nanocoap_cache_lock(void);
+
+/**
+ * @brief   Unlocks the cache
+ */
+void nanocoap_cache_unlock(void);
+
+/**
+ * @brief   Generates the cache key of a request
+ *
+ * @param[in]  req          The request
+ * @param[in]  ctx          Additional data that distinguishes requests, e.g.
+ *                          the address of the server a client request goes
+ *                          to. May be NULL.
+ * @param[in]  ctx_len      Length of @p ctx
+ * @param[out] cache_key    The cache key, @ref CONFIG_NANOCOAP_CACHE_KEY_LENGTH
+ *                          bytes
+ */
+void nanocoap_cache_key_generate(const coap_pkt_t *req, const void *ctx,
+                                 size_t ctx_len, uint8_t *cache_key);
+
+/**
+ * @brief   Checks if the response to a request may be cached
+ *
+ * @param[in] req   The request
+ *
+ * @return  true, if the request is a GET request
+ */
+static inline bool nanocoap_cache_request_is_cacheable(const coap_pkt_t *req)
+{
+    return coap_get_code_detail(req) == COAP_METHOD_GET;
+}
+
+/**
+ * @brief   Looks up the cache entry for a cache key
+ *
+ * Counts a hit if a fresh entry was found and a miss otherwise. The entry
+ * becomes the most recently used one.
+ *
+ * @param[in] cache_key The cache key
+ * @param[in] now       The current time in ms
+ *
+ * @return  The cache entry, which might be stale
+ * @return  NULL, if there is no entry for @p cache_key
+ */
+nanocoap_cache_entry_t *nanocoap_cache_key_lookup(const uint8_t *cache_key,
+                                                  uint32_t now);
+
+/**
+ * @brief   Updates the cache with the response to a request
+ *
+ * A 2.05 (Content) response is stored, replacing an existing entry for
+ * @p cache_key. A 2.03 (Valid) response makes the existing entry fresh
+ * again. Responses to requests other than GET are not cached.
+ *
+ * @param[in] cache_key     The cache key of the request
+ * @param[in] request_method The method of the request
+ * @param[in] resp          The response
+ * @param[in] resp_len      Length of the response
+ * @param[in] now           The current time in ms
+ *
+ * @return  The updated cache entry
+ * @return  NULL, if the response was not cached
+ */
+nanocoap_cache_entry_t *nanocoap_cache_process(const uint8_t *cache_key,
+                                               unsigned request_method,
+                                               const coap_pkt_t *resp,
+                                               size_t resp_len, uint32_t now);
+
+/**
+ * @brief   Removes an entry from the cache
+ *
+ * @param[in] ce    The cache entry
+ */
+void nanocoap_cache_del(nanocoap_cache_entry_t *ce);
+
+/**
+ * @brief   Checks if a cache entry is stale
+ *
+ * @param[in] ce    The cache entry
+ * @param[in] now   The current time in ms
+ *
+ * @return  true, if the cached response must be validated before use
+ */
+static inline bool nanocoap_cache_entry_is_stale(const nanocoap_cache_entry_t *ce,
+                                                 uint32_t now)
+{
+    return (int32_t)(ce->max_age - now) <= 0;
+}
+
+/**
+ * @brief   Gets the time a cache entry stays fresh
+ *
+ * @param[in] ce    The cache entry
+ * @param[in] now   The current time in ms
+ *
+ * @return  The remaining freshness in s, rounded down, as the Max-Age of a
+ *          response served from the cache
+ */
+uint32_t nanocoap_cache_entry_max_age(const nanocoap_cache_entry_t *ce,
+                                      uint32_t now);
+
+/**
+ * @brief   Gets the ETag of a cached response
+ *
+ * @param[in]  ce   The cache entry
+ * @param[out] etag The ETag, at least @ref COAP_ETAG_LENGTH_MAX bytes
+ *
+ * @return  The length of the ETag
+ * @return  0, if the response has no ETag
+ */
+size_t nanocoap_cache_entry_get_etag(const nanocoap_cache_entry_t *ce,
+                                     uint8_t *etag);
+
+/**
+ * @brief   Gets the cache statistics
+ *
+ * @param[out] stats    The statistics
+ */
+void nanocoap_cache_stats_get(nanocoap_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_NANOCOAP_CACHE_H */
+/** @} */
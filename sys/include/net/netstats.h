@@ -51,6 +51,7 @@ extern "C" {
 #define NETSTATS_LAYER2     (0x01)
 #define NETSTATS_IPV6       (0x02)
 #define NETSTATS_RPL        (0x03)
+#define NETSTATS_PKTQ       (0x04)
 #define NETSTATS_ALL        (0xFF)
 /** @} */
 
@@ -70,6 +71,25 @@ typedef struct {
     uint32_t rx_bytes;          /**< received bytes */
 } netstats_t;
 
+/**
+ * @brief       Statistics of a send queue
+ */
+typedef struct {
+    uint32_t enqueued;          /**< packets put into the queue */
+    uint32_t overflows;         /**< packets rejected because the queue
+                                     was full */
+    uint32_t evicted;           /**< queued packets dropped to make room
+                                     for packets of higher priority */
+    uint32_t aqm_drops;         /**< queued packets dropped by active queue
+                                     management */
+    uint32_t sojourn_avg;       /**< moving average of the time packets
+                                     spent in the queue in µs */
+    uint32_t sojourn_max;       /**< maximum time a packet spent in the
+                                     queue in µs */
+    uint16_t depth;             /**< packets currently in the queue */
+    uint16_t depth_max;         /**< maximum number of packets in the queue */
+} netstats_queue_t;
+
 /**
  * @brief       Stats per peer struct
  */
@@ -27,9 +27,15 @@
 #include <stdint.h>
 #include <unistd.h>
 
+#include "kernel_defines.h"
+
 #include "net/dns/msg.h"
 
 #include "net/sock/udp.h"
+#if IS_USED(MODULE_SOCK_DNS_ASYNC) || defined(DOXYGEN)
+#include "event/callback.h"
+#include "event/timeout.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,13 +49,50 @@ extern "C" {
 #define SOCK_DNS_RETRIES        (2)
 
 #define SOCK_DNS_MAX_NAME_LEN   (CONFIG_DNS_MSG_LEN - sizeof(dns_hdr_t) - 4)
+#define SOCK_DNS_TIMEOUT_MS     (1000U)     /**< timeout for a reply in ms */
 /** @} */
 
+/**
+ * @brief   Callback for the result of a DNS query
+ *
+ * @param[in] res   Length of the address in @p addr on success, or a negative
+ *                  error number as returned by sock_dns_query()
+ * @param[in] addr  The address the name resolved to, NULL on error
+ * @param[in] arg   Argument given on the query
+ */
+typedef void (*sock_dns_cb_t)(int res, const void *addr, void *arg);
+
+/**
+ * @brief   State of a DNS query
+ *
+ * @note    All members are private
+ */
+typedef struct sock_dns_query {
+    struct sock_dns_query *next;        /**< next query in flight, or next
+                                         *   waiting for the same result */
+    struct sock_dns_query *followers;   /**< queries waiting for the result
+                                         *   of this one */
+    const char *domain_name;            /**< the name to resolve */
+    int family;                         /**< the family to resolve for */
+    sock_dns_cb_t cb;                   /**< callback for the result */
+    void *arg;                          /**< argument for @ref cb */
+#if IS_USED(MODULE_SOCK_DNS_ASYNC) || defined(DOXYGEN)
+    sock_udp_t sock;                    /**< sock to the DNS server */
+    event_timeout_t timeout;            /**< timeout for the reply */
+    event_callback_t timeout_ev;        /**< event to (re-)send the query */
+    uint8_t retries;                    /**< remaining retries */
+#endif
+} sock_dns_query_t;
+
 /**
  * @brief Get IP address for DNS name
  *
  * This function will synchronously try to resolve a DNS A or AAAA record by contacting
  * the DNS server specified in the global variable @ref sock_dns_server.
+ * The function is reentrant. If another thread already queries the same name
+ * for the same @p family, it waits for the result of that query instead of
+ * sending its own. With the module `dns_cache`, results are taken from the
+ * @ref net_dns_cache "DNS cache" when present and added to it otherwise.
  *
  * By supplying AF_INET, AF_INET6 or AF_UNSPEC in @p family requesting of A
  * records (IPv4), AAAA records (IPv6) or both can be selected.
@@ -65,10 +108,44 @@ extern "C" {
  * @param[in]   family          Either AF_INET, AF_INET6 or AF_UNSPEC
  *
  * @return      the size of the resolved address on success
+ * @return      -ENOENT, if the name does not exist or has no address of
+ *              @p family
+ * @return      -ETIMEDOUT, if the DNS server did not reply
  * @return      < 0 otherwise
  */
 int sock_dns_query(const char *domain_name, void *addr_out, int family);
 
+#if IS_USED(MODULE_SOCK_DNS_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Get IP address for DNS name asynchronously
+ *
+ * Works like sock_dns_query(), but returns at once and reports the result to
+ * @p cb. The query is sent and the reply handled in the
+ * @ref EVENT_PRIO_MEDIUM event thread. @p cb is called
+ *
+ * - in the calling thread before this function returns, when the result is
+ *   in the DNS cache,
+ * - in the thread that completes the query otherwise. This is the event
+ *   thread, or the thread that called sock_dns_query() when this query waits
+ *   for the result of that call.
+ *
+ * @note    Only available with module `sock_dns_async`.
+ *
+ * @param[out] query        State of the query, must stay valid until @p cb
+ *                          was called
+ * @param[in]  domain_name  DNS name to resolve into address, must stay valid
+ *                          until @p cb was called
+ * @param[in]  family       Either AF_INET, AF_INET6 or AF_UNSPEC
+ * @param[in]  cb           Callback for the result
+ * @param[in]  arg          Argument for @p cb
+ *
+ * @return      0, if @p cb was or will be called with the result
+ * @return      < 0 on error, @p cb will not be called
+ */
+int sock_dns_query_async(sock_dns_query_t *query, const char *domain_name,
+                         int family, sock_dns_cb_t cb, void *arg);
+#endif
+
 /**
  * @brief global DNS server endpoint
  */
@@ -14,6 +14,29 @@
  *              (@ref schedstat_t) for a thread will be updated on every
  *              @ref sched_run().
  *
+ * Besides the accumulated runtime and the number of times a thread was
+ * scheduled, the base module counts voluntary (the thread blocked) and
+ * involuntary (the thread was still runnable, e.g. preempted or yielded)
+ * context switches and tracks the longest uninterrupted run slice.
+ *
+ * The following submodules add more detailed instrumentation:
+ *
+ * - `schedstatistics_latency`: per-thread histogram of ready-to-run latency,
+ *   i.e. the time between a thread becoming runnable (woken up or preempted)
+ *   and actually running again. The histogram has
+ *   @ref CONFIG_SCHEDSTATISTICS_LATENCY_BUCKETS power-of-two buckets.
+ * - `schedstatistics_irq`: per-thread time spent in interrupt service
+ *   routines that interrupted the thread. This requires the CPU to call
+ *   @ref sched_statistics_irq_enter and @ref sched_statistics_irq_exit.
+ * - `schedstatistics_trace`: ring buffer of the last
+ *   @ref CONFIG_SCHEDSTATISTICS_TRACE_SIZE context switches.
+ *
+ * All statistics are written from the scheduler with interrupts disabled.
+ * Threads should use @ref sched_statistics_get and
+ * @ref sched_statistics_trace_read to obtain consistent copies without
+ * disabling interrupts themselves. With the `shell_commands` module, the
+ * `schedstat` shell command prints the statistics as a table or as JSON.
+ *
  * @note        If auto_init is disabled `init_schedstatistics()` needs to be
  *              called as well as xtimer_init().
  * @{
@@ -31,10 +54,43 @@
 
 #include <stdint.h>
 
+#include "sched.h"
+
 #ifdef __cplusplus
  extern "C" {
 #endif
 
+/**
+ * @defgroup schedstatistics_conf Scheduler statistics compile configurations
+ * @ingroup config
+ * @{
+ */
+/**
+ * @brief   Number of buckets in the ready-to-run latency histogram
+ *
+ * Bucket 0 counts latencies below 1 µs, bucket `n` counts latencies in
+ * [2^(n-1), 2^n) µs. The last bucket also counts all longer latencies.
+ */
+#ifndef CONFIG_SCHEDSTATISTICS_LATENCY_BUCKETS
+#define CONFIG_SCHEDSTATISTICS_LATENCY_BUCKETS  (16U)
+#endif
+
+/**
+ * @brief   Number of context switches kept in the trace ring buffer
+ *
+ * @note    Must be a power of 2.
+ */
+#ifndef CONFIG_SCHEDSTATISTICS_TRACE_SIZE
+#define CONFIG_SCHEDSTATISTICS_TRACE_SIZE       (64U)
+#endif
+/** @} */
+
+/**
+ * @brief   Flag in @ref schedstat_trace_t::flags: the previous thread was
+ *          switched out voluntarily (i.e. it blocked)
+ */
+#define SCHEDSTAT_TRACE_VOLUNTARY   (0x01)
+
 /**
  *  Scheduler statistics
  */
@@ -43,8 +99,37 @@ typedef struct {
                                   scheduled to run */
     unsigned int schedules;  /**< How often the thread was scheduled to run */
     uint64_t runtime_us;     /**< The total runtime of this thread in microseconds */
+    uint32_t max_slice_us;   /**< Longest uninterrupted run of this thread in
+                                  microseconds */
+    unsigned int voluntary;  /**< Number of switches away from this thread
+                                  because it blocked */
+    unsigned int involuntary;   /**< Number of switches away from this thread
+                                     while it was still runnable */
+#if IS_USED(MODULE_SCHEDSTATISTICS_LATENCY) || defined(DOXYGEN)
+    uint32_t readysince;     /**< Time stamp the thread became runnable */
+    uint32_t max_latency_us; /**< Longest ready-to-run latency in microseconds */
+    /**
+     * @brief   Histogram of ready-to-run latencies
+     */
+    unsigned int latency[CONFIG_SCHEDSTATISTICS_LATENCY_BUCKETS];
+#endif
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ) || defined(DOXYGEN)
+    uint64_t irq_us;         /**< Time spent in ISRs that interrupted this
+                                  thread in microseconds */
+#endif
 } schedstat_t;
 
+/**
+ * @brief   Context switch trace entry
+ */
+typedef struct {
+    uint32_t time;          /**< Time stamp of the switch in microseconds */
+    kernel_pid_t prev;      /**< Thread switched away from, or
+                                 KERNEL_PID_UNDEF */
+    kernel_pid_t next;      /**< Thread switched to */
+    uint8_t flags;          /**< Flags, see @ref SCHEDSTAT_TRACE_VOLUNTARY */
+} schedstat_trace_t;
+
 /**
  *  Thread statistics table
  */
@@ -56,6 +141,61 @@ extern schedstat_t sched_pidlist[KERNEL_PID_LAST + 1];
  */
 void init_schedstatistics(void);
 
+/**
+ * @brief   Get a consistent copy of the statistics of a thread
+ *
+ * Can be called from thread context at any time without disabling interrupts.
+ *
+ * @param[in]   pid     Thread to get the statistics for. KERNEL_PID_UNDEF
+ *                      gets the time spent sleeping when there is no idle
+ *                      thread.
+ * @param[out]  stat    Copy of the statistics
+ */
+void sched_statistics_get(kernel_pid_t pid, schedstat_t *stat);
+
+/**
+ * @brief   Reset the statistics of all threads
+ */
+void sched_statistics_reset(void);
+
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ) || defined(DOXYGEN)
+/**
+ * @brief   Marks the begin of an interrupt service routine
+ *
+ * To be called by the CPU's interrupt entry code, with interrupts disabled.
+ */
+void sched_statistics_irq_enter(void);
+
+/**
+ * @brief   Marks the end of an interrupt service routine
+ *
+ * To be called by the CPU's interrupt exit code (before a possible context
+ * switch), with interrupts disabled.
+ */
+void sched_statistics_irq_exit(void);
+#endif
+
+#if IS_USED(MODULE_SCHEDSTATISTICS_TRACE) || defined(DOXYGEN)
+/**
+ * @brief   Read context switches from the trace ring buffer
+ *
+ * The ring buffer is read without blocking the scheduler. If the scheduler
+ * overwrote entries that have not been read yet, they are skipped.
+ *
+ * @param[in,out] pos   Sequence number of the next entry to read. Initialize
+ *                      with 0 to read all entries still in the buffer, it is
+ *                      advanced past the last entry returned.
+ * @param[out]  buf     Buffer to copy the entries to
+ * @param[in]   len     Maximum number of entries to copy to @p buf
+ * @param[out]  lost    Number of entries that were overwritten before they
+ *                      could be read, may be NULL
+ *
+ * @return  Number of entries copied to @p buf
+ */
+unsigned sched_statistics_trace_read(uint32_t *pos, schedstat_trace_t *buf,
+                                     unsigned len, uint32_t *lost);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -16,20 +16,30 @@
  * in multi-threaded applications or when ISR's are involved.
  *
  * The `trace()` function takes an arbitrary (user chosen) uint32 value.
- * Calling the function is safe from anywhere (user code, ISR, ...) and safely
- * logs the function call time and user value in a trace buffer.
- *
- * At any point, `trace_dump()` can be used to print the trace buffer.
- *
- * The buffer has a default size of 512 entries, which can be overridden by
- * defining CONFIG_TRACE_BUFSIZE. It can be cleared using `trace_reset()`.
- * The trace buffer works like a ring-buffer. If it is full, it will start
- * overwriting from the beginning.
- *
- * Tracing is made thread safe by disabling interrupts for critical sections.
- *
- * It does incur some overhead (at least a function call, getting the current
- * time, a pair of enable/disable interrupts and a couple of memory accesses).
+ * `trace_event()` additionally takes a typed event ID (see
+ * @ref TRACE_EVENT_ID), so that a host tool can tell events apart and
+ * reconstruct a timeline out of them. Calling these functions is safe from
+ * anywhere (user code, ISR, ...) and logs the current time, the event ID and
+ * the payload in a trace buffer.
+ *
+ * Every thread records into its own buffer of
+ * @ref CONFIG_TRACE_THREAD_BUFSIZE entries, all interrupt service routines
+ * share one buffer of @ref CONFIG_TRACE_ISR_BUFSIZE entries. The thread
+ * buffers have a single writer and the ISR buffer reserves its slots with an
+ * atomic increment, so recording never disables interrupts. All buffers work
+ * like ring-buffers. If one is full, it starts overwriting its oldest
+ * entries; the dumps report the number of overwritten entries.
+ *
+ * On Cortex-M3 and up (DWT cycle counter) and on RISC-V (`mcycle`), the time
+ * stamps are CPU cycles. Everywhere else, `ZTIMER_USEC` is used. The cycle
+ * counter of Cortex-M is enabled by `auto_init`, call `trace_init()` if it is
+ * disabled.
+ *
+ * At any point, `trace_dump()` can be used to print the trace buffers as
+ * text, and `trace_dump_bin()` or `trace_dump_hex()` to export them in the
+ * compact binary format described below. `dist/tools/trace_convert` converts
+ * such a dump into a timeline (e.g. for chrome://tracing or Perfetto).
+ * The buffers can be cleared using `trace_reset()`.
  *
  * Example:
  *
@@ -37,10 +47,32 @@
  * #include "trace.h"
  * ...
  * trace(<user chosen uint32 value);
+ * trace_event(TRACE_EVENT_BEGIN(MY_RX_EVENT), pkt_len);
+ * ...
+ * trace_event(TRACE_EVENT_END(MY_RX_EVENT), 0);
  *
  * trace_dump();
  * ~~~~~~~~~~~~~~~~~~~~~~~~
  *
+ * ### Binary format
+ *
+ * All fields are in the byte order of the device, which the host can tell
+ * from the magic number. A dump starts with a 16 byte header:
+ *
+ * | offset | size | field                                           |
+ * |-------:|-----:|:------------------------------------------------|
+ * |      0 |    4 | magic @ref TRACE_BIN_MAGIC                      |
+ * |      4 |    1 | format version @ref TRACE_BIN_VERSION           |
+ * |      5 |    1 | flags, @ref TRACE_BIN_FLAG_CYCLES               |
+ * |      6 |    2 | size of a record in bytes                       |
+ * |      8 |    4 | time stamp frequency in Hz, 0 if unknown        |
+ * |     12 |    4 | time stamp at the time of the dump              |
+ *
+ * It is followed by an arbitrary number of 12 byte records
+ * (@ref trace_record_t), grouped per context and in chronological order
+ * within each context. Overwritten entries are reported as one record with
+ * the ID @ref TRACE_EVENT_LOST and the number of lost entries as payload.
+ *
  * @{
  *
  * @brief       Execution tracing module API
@@ -53,17 +85,108 @@
 #ifndef TRACE_H
 #define TRACE_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @defgroup sys_trace_conf Trace compile configurations
+ * @ingroup config
+ * @{
+ */
+/**
+ * @brief   Number of entries in the trace buffer of every thread
+ *
+ * @note    Must be a power of 2. The buffers take
+ *          `(MAXTHREADS + 1) * CONFIG_TRACE_THREAD_BUFSIZE * 12` bytes.
+ */
+#ifndef CONFIG_TRACE_THREAD_BUFSIZE
+#define CONFIG_TRACE_THREAD_BUFSIZE     (16U)
+#endif
+
+/**
+ * @brief   Number of entries in the trace buffer shared by all ISRs
+ *
+ * @note    Must be a power of 2.
+ */
+#ifndef CONFIG_TRACE_ISR_BUFSIZE
+#define CONFIG_TRACE_ISR_BUFSIZE        (64U)
+#endif
+/** @} */
+
+/**
+ * @name    Trace event IDs
+ *
+ * The lower 14 bits of an event ID are chosen by the user, the upper two bits
+ * mark an event as the begin or end of a duration.
+ * @{
+ */
+#define TRACE_EVENT_ID(id)      ((uint16_t)(id) & 0x3fffU)  /**< plain event ID */
+#define TRACE_EVENT_BEGIN(id)   (TRACE_EVENT_ID(id) | 0x4000U) /**< begin of @p id */
+#define TRACE_EVENT_END(id)     (TRACE_EVENT_ID(id) | 0x8000U) /**< end of @p id */
+#define TRACE_EVENT_USER        (0x0000U)   /**< ID used by @ref trace */
+#define TRACE_EVENT_LOST        (0x3fffU)   /**< entries were overwritten */
+/** @} */
+
+/**
+ * @brief   Context of records written by interrupt service routines
+ */
+#define TRACE_CTX_ISR           (0xffffU)
+
+/**
+ * @name    Binary dump format
+ * @{
+ */
+#define TRACE_BIN_MAGIC         (0x52545243UL)  /**< "CRTR" on little endian */
+#define TRACE_BIN_VERSION       (1U)    /**< current format version */
+#define TRACE_BIN_FLAG_CYCLES   (0x01U) /**< time stamps are CPU cycles */
+/** @} */
+
+/**
+ * @brief   Record of the binary trace dump
+ */
+typedef struct {
+    uint32_t time;          /**< time stamp */
+    uint32_t payload;       /**< user supplied value */
+    uint16_t id;            /**< event ID */
+    uint16_t ctx;           /**< PID of the thread, or @ref TRACE_CTX_ISR */
+} trace_record_t;
+
+/**
+ * @brief   Output function for @ref trace_dump_bin
+ *
+ * @param[in]   arg     user supplied argument
+ * @param[in]   data    data to write
+ * @param[in]   len     number of bytes in @p data
+ */
+typedef void (*trace_write_cb_t)(void *arg, const void *data, size_t len);
+
+/**
+ * @brief   Initialize the time stamp source
+ *
+ * Called by `auto_init`.
+ */
+void trace_init(void);
+
+/**
+ * @brief   Add typed entry to trace buffer
+ *
+ * Adds the current time, @p id and @p payload to the trace buffer of the
+ * current context without disabling interrupts.
+ *
+ * @param[in]   id      event ID, see @ref TRACE_EVENT_ID
+ * @param[in]   payload user defined value
+ */
+void trace_event(uint16_t id, uint32_t payload);
+
 /**
  * @brief   Add entry to trace buffer
  *
- * Adds the current time (e.g., xtimer_now_usec()) and @p val to the trace
- * buffer.
+ * Adds the current time and @p val to the trace buffer, using the event ID
+ * @ref TRACE_EVENT_USER.
  *
  * The value parameter is not used by the trace module itself. The caller is
  * supposed to provide a meaningful value.
@@ -71,24 +194,44 @@ extern "C" {
  *
  * @param[in]   val     user defined value
  */
-void trace(uint32_t val);
+static inline void trace(uint32_t val)
+{
+    trace_event(TRACE_EVENT_USER, val);
+}
 
 /**
- * @brief   Print the current trace buffer
+ * @brief   Print the current trace buffers
  *
- * Will print the number of the trace log entry, the timestamp (first entry) or
- * relative time since last entry, and the value supplied to the `trace()` call
- * of each entry.
+ * Will print the entries of all contexts merged in chronological order: the
+ * number of the trace log entry, the timestamp (first entry) or relative time
+ * since last entry, the context (PID, or `isr`), the event ID and the value
+ * supplied to the `trace()` or `trace_event()` call of each entry.
  *
  * Example output (after adding two traces, 3us apart, with values 0 and 1):
  *
- *     n=   0 t=  1815312 v=0x00000000
- *     n=   1 t=+       3 v=0x00000001
+ *     n=   0 t=  1815312 c=  1 e=0x0000 v=0x00000000
+ *     n=   1 t=+       3 c=  1 e=0x0000 v=0x00000001
  */
 void trace_dump(void);
 
 /**
- * @brief   Empty the trace buffer
+ * @brief   Write the trace buffers in the binary format
+ *
+ * @param[in]   write   output function, called with chunks of the dump
+ * @param[in]   arg     argument passed to @p write
+ */
+void trace_dump_bin(trace_write_cb_t write, void *arg);
+
+/**
+ * @brief   Print the trace buffers in the binary format as hex to stdout
+ *
+ * The hex lines are enclosed in a `==== trace begin ====` and a
+ * `==== trace end ====` line, so the dump can be cut out of a terminal log.
+ */
+void trace_dump_hex(void);
+
+/**
+ * @brief   Empty the trace buffers
  */
 void trace_reset(void);
 
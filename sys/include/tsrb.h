@@ -14,6 +14,38 @@
  *
  * @attention   Buffer size must be a power of two!
  *
+ * All functions copy at most two contiguous blocks with `memcpy()` instead of
+ * moving single bytes, so bulk transfers are cheap.
+ *
+ * Zero-copy access
+ * ================
+ *
+ * Data can be written to and read from the buffer memory directly:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * uint8_t *dst;
+ * size_t len = tsrb_reserve(&rb, &dst);
+ * len = uart_dma_read(dst, len);          // fill up to len bytes in place
+ * tsrb_commit(&rb, len);
+ *
+ * const uint8_t *src;
+ * len = tsrb_peek_span(&rb, &src);
+ * len = uart_dma_write(src, len);         // send up to len bytes in place
+ * tsrb_drop(&rb, len);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * A span ends at the end of the buffer memory. If less than the requested
+ * amount was returned, call the function again after committing (dropping)
+ * to get the part that wrapped around.
+ *
+ * @warning The producer owns the reserved span until @ref tsrb_commit, the
+ *          consumer owns the peeked span until @ref tsrb_drop. Hence, at most
+ *          one context may write and at most one context may read while a
+ *          span is in use (single producer, single consumer). This is the
+ *          usual setup of an ISR filling and a thread draining the buffer (or
+ *          vice versa). The copying functions can still be used by the
+ *          respective owner in between.
+ *
  * @file
  * @brief       Thread-safe ringbuffer interface definition
  *
@@ -192,6 +224,42 @@ int tsrb_add_one(tsrb_t *rb, uint8_t c);
  */
 int tsrb_add(tsrb_t *rb, const uint8_t *src, size_t n);
 
+/**
+ * @brief       Get the contiguous free space at the write position
+ *
+ * The caller (the producer) may write up to the returned number of bytes to
+ * @p span and then make (a part of) them available for reading with
+ * @ref tsrb_commit.
+ *
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[out]  span    start of the free space
+ * @return      nr of bytes that can be written to @p span, 0 if full
+ */
+size_t tsrb_reserve(tsrb_t *rb, uint8_t **span);
+
+/**
+ * @brief       Make bytes written to a span of @ref tsrb_reserve available
+ *              for reading
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   nr of bytes written, at most the value returned by
+ *                  @ref tsrb_reserve
+ */
+void tsrb_commit(tsrb_t *rb, size_t n);
+
+/**
+ * @brief       Get the contiguous data at the read position, without removing
+ *              it
+ *
+ * The caller (the consumer) may read up to the returned number of bytes from
+ * @p span and then remove (a part of) them with @ref tsrb_drop.
+ *
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[out]  span    start of the data
+ * @return      nr of bytes that can be read from @p span, 0 if empty
+ */
+size_t tsrb_peek_span(tsrb_t *rb, const uint8_t **span);
+
 #ifdef __cplusplus
 }
 #endif
@@ -152,10 +152,43 @@
  * made a constant operation, at the price of another pointer per timer object
  * (for "previous" element).
  *
- * If deemed necessary, the linked list can be exchanged our augmented with
- * another data structure providing better algorithmic guarantees. It remains
- * to be shown whether the increased complexity would lead to better
- * performance for any reasonable amount of active timers.
+ * For applications with many concurrently active timers (e.g., gateways
+ * with hundreds of pending protocol timeouts), the list can be exchanged with
+ * a pairing heap by adding the `ztimer_heap` module. This changes the
+ * implications to:
+ *
+ * - three pointers needed per timer object (sibling, child, parent/previous)
+ * - constant insertion, O(log n) amortized removal of timer objects
+ * - constant get_min()
+ * - timers with the exact same target are not guaranteed to trigger in the
+ *   order they have been set
+ *
+ * With `ztimer_heap`, each timer stores its absolute target (relative to the
+ * clock's base B, modulo 2**32). Timers that became due while the clock base
+ * was advanced are moved to a short FIFO of expired timers, which is drained
+ * before the heap, so extension and checkpointing work exactly as with the
+ * list.
+ *
+ *
+ * ## Timer coalescing
+ *
+ * Many timeouts don't need to trigger at an exact point in time: a
+ * retransmission or a periodic housekeeping task works just as well some
+ * milliseconds later. With the `ztimer_coalesce` module, such timers can be
+ * set with ztimer_set_slack(), which lets them trigger anywhere between
+ * `val` and `val + slack` ticks from now.
+ *
+ * Such a timer is queued at the end of its window, so it only causes an
+ * interrupt of its own if nothing else wakes up the CPU during the window.
+ * Whenever a clock handles its timers, ztimer also triggers the next timers
+ * of ZTIMER_USEC, ZTIMER_MSEC and ZTIMER_SEC whose windows have already
+ * begun. This way, nearby deadlines are merged, no matter which clock they
+ * have been set on, and the CPU wakes up (and handles interrupts) less often.
+ * Only the timer that is due next on each clock is considered, so merging is
+ * best effort.
+ *
+ * ztimer_coalesce_next_wakeup() tells the idle path how long the CPU may
+ * sleep, ztimer_coalesce_stats() how many wakeups actually happened.
  *
  *
  * ## Clock extension
@@ -292,8 +325,15 @@ typedef struct ztimer_clock ztimer_clock_t;
  * @brief   Minimum information for each timer
  */
 struct ztimer_base {
-    ztimer_base_t *next;        /**< next timer in list */
-    uint32_t offset;            /**< offset from last timer in list */
+    ztimer_base_t *next;        /**< next timer in list (or next sibling in
+                                     the heap if ztimer_heap is used) */
+    uint32_t offset;            /**< offset from last timer in list (or
+                                     absolute target if ztimer_heap is used) */
+#if MODULE_ZTIMER_HEAP || DOXYGEN
+    ztimer_base_t *child;       /**< first child in the pairing heap */
+    ztimer_base_t *prev;        /**< parent or previous sibling in the
+                                     pairing heap, NULL if not set */
+#endif
 };
 
 #if MODULE_ZTIMER_NOW64
@@ -312,6 +352,10 @@ typedef struct {
     ztimer_base_t base;             /**< clock list entry */
     void (*callback)(void *arg);    /**< timer callback function pointer */
     void *arg;                      /**< timer callback argument */
+#if MODULE_ZTIMER_COALESCE || DOXYGEN
+    uint32_t slack;                 /**< ticks the timer may trigger early,
+                                         see ztimer_set_slack() */
+#endif
 } ztimer_t;
 
 /**
@@ -346,7 +390,9 @@ typedef struct {
  * @brief   ztimer device structure
  */
 struct ztimer_clock {
-    ztimer_base_t list;             /**< list of active timers              */
+    ztimer_base_t list;             /**< list of active timers (with
+                                         ztimer_heap: expired timers in
+                                         `next`, heap root in `child`)      */
     const ztimer_ops_t *ops;        /**< pointer to methods structure       */
     ztimer_base_t *last;            /**< last timer in queue, for _is_set() */
     uint16_t adjust_set;            /**< will be subtracted on every set()  */
@@ -390,6 +436,65 @@ void ztimer_handler(ztimer_clock_t *clock);
  */
 uint32_t ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val);
 
+#if MODULE_ZTIMER_COALESCE || DOXYGEN
+/**
+ * @brief   Set a timer on a clock, allowing it to trigger late
+ *
+ * @p timer triggers at least @p val and at most @p val + @p slack ticks from
+ * now (plus the usual inaccuracy). Within this window, it is triggered
+ * together with other timers, see @ref sys_ztimer "Timer coalescing".
+ *
+ * Without the module `ztimer_coalesce`, this is the same as
+ * `ztimer_set(clock, timer, val)`.
+ *
+ * @param[in]   clock       ztimer clock to operate on
+ * @param[in]   timer       timer entry to set
+ * @param[in]   val         earliest timer target (relative ticks from now)
+ * @param[in]   slack       ticks the timer may trigger after @p val
+ *
+ * @return The value of @ref ztimer_now() that @p timer was set against
+ */
+uint32_t ztimer_set_slack(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val,
+                          uint32_t slack);
+
+/**
+ * @brief   Wakeup statistics of the `ztimer_coalesce` module
+ */
+typedef struct {
+    uint32_t wakeups;               /**< clock interrupts handled */
+    uint32_t coalesced;             /**< timers triggered before the end of
+                                         their window, without an interrupt
+                                         of their own */
+} ztimer_coalesce_stats_t;
+
+/**
+ * @brief   Get the wakeup statistics since boot
+ *
+ * @param[out]  stats       statistics
+ */
+void ztimer_coalesce_stats(ztimer_coalesce_stats_t *stats);
+
+/**
+ * @brief   Get the time until the next timer of ZTIMER_USEC, ZTIMER_MSEC or
+ *          ZTIMER_SEC has to trigger at the latest
+ *
+ * This is meant for the idle path, e.g. to pick a sleep mode whose wake-up
+ * time fits. Intermediate interrupts of clock extension are not considered.
+ *
+ * @return  microseconds until the next timer, UINT32_MAX if none is set or
+ *          if it is too far in the future
+ */
+uint32_t ztimer_coalesce_next_wakeup(void);
+#else
+static inline uint32_t ztimer_set_slack(ztimer_clock_t *clock,
+                                        ztimer_t *timer, uint32_t val,
+                                        uint32_t slack)
+{
+    (void)slack;
+    return ztimer_set(clock, timer, val);
+}
+#endif
+
 /**
  * @brief   Check if a timer is currently active
  *
@@ -18,6 +18,8 @@
  * @}
  */
 
+#include <stdint.h>
+#include <string.h>
 #include <sys/uio.h>
 
 #include "iolist.h"
@@ -42,6 +44,33 @@ size_t iolist_size(const iolist_t *iolist)
     return result;
 }
 
+size_t iolist_fill(const iolist_t *iolist, size_t offset,
+                   const void *buf, size_t len)
+{
+    const uint8_t *src = buf;
+    size_t copied = 0;
+
+    /* skip the entries before offset */
+    while (iolist && (offset >= iolist->iol_len)) {
+        offset -= iolist->iol_len;
+        iolist = iolist->iol_next;
+    }
+
+    while (iolist && (copied < len)) {
+        size_t chunk = iolist->iol_len - offset;
+
+        if (chunk > len - copied) {
+            chunk = len - copied;
+        }
+        memcpy((uint8_t *)iolist->iol_base + offset, src + copied, chunk);
+        copied += chunk;
+        offset = 0;
+        iolist = iolist->iol_next;
+    }
+
+    return copied;
+}
+
 size_t iolist_to_iovec(const iolist_t *iolist, struct iovec *iov, unsigned *count)
 {
     size_t bytes = 0;
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_dns_cache
+ * @{
+ *
+ * @file
+ * @brief       DNS cache implementation
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "hashes.h"
+#include "mutex.h"
+#include "net/af.h"
+#include "ztimer.h"
+
+#include "net/dns/cache.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+/**
+ * @brief   Largest time to live in s that keeps the expiry time comparable
+ *          with the current time
+ */
+#define DNS_CACHE_TTL_MAX   (INT32_MAX)
+
+/**
+ * @brief   Cache entry
+ */
+typedef struct {
+    uint32_t hash;          /**< hash of the domain name */
+    uint32_t expires;       /**< time the entry expires in s */
+    uint8_t family;         /**< family of the address, or of the query for a
+                             *   negative answer */
+    uint8_t addr_len;       /**< length of addr, 0 for a negative answer */
+    uint8_t addr[16];       /**< the address */
+} _cache_entry_t;
+
+static _cache_entry_t _cache[CONFIG_DNS_CACHE_SIZE];
+static mutex_t _lock = MUTEX_INIT;
+
+static bool _is_expired(const _cache_entry_t *ce, uint32_t now)
+{
+    return (int32_t)(ce->expires - now) <= 0;
+}
+
+/* checks if a new result for a name replaces the cached result ce */
+static bool _supersedes(const _cache_entry_t *ce, int family, int addr_len)
+{
+    if (addr_len == 0) {
+        /* no address for AF_UNSPEC means no address at all */
+        return (family == AF_UNSPEC) || (ce->family == family);
+    }
+    /* an address replaces one of the same family and contradicts negative
+     * answers for its family */
+    return (ce->family == family) ||
+           ((ce->addr_len == 0) && (ce->family == AF_UNSPEC));
+}
+
+static uint32_t _hash(const char *domain_name)
+{
+    return fnv_hash((const uint8_t *)domain_name, strlen(domain_name));
+}
+
+int dns_cache_query(const char *domain_name, void *addr_out, int family)
+{
+    uint32_t hash = _hash(domain_name);
+    const _cache_entry_t *found = NULL;
+    int res = 0;
+
+    mutex_lock(&_lock);
+    uint32_t now = ztimer_now(ZTIMER_SEC);
+    for (unsigned i = 0; i < CONFIG_DNS_CACHE_SIZE; i++) {
+        const _cache_entry_t *ce = &_cache[i];
+
+        if ((ce->hash != hash) || _is_expired(ce, now)) {
+            continue;
+        }
+        if (ce->addr_len == 0) {
+            /* a name without any address has none of family either */
+            if ((ce->family == family) || (ce->family == AF_UNSPEC)) {
+                res = -ENOENT;
+            }
+        }
+        else if ((ce->family == family) || (family == AF_UNSPEC)) {
+            if ((found == NULL) || (ce->family == AF_INET6)) {
+                found = ce;
+            }
+        }
+    }
+    if (found != NULL) {
+        memcpy(addr_out, found->addr, found->addr_len);
+        res = found->addr_len;
+    }
+    mutex_unlock(&_lock);
+    DEBUG("dns_cache: %s (%d) -> %d\n", domain_name, family, res);
+    return res;
+}
+
+void dns_cache_add(const char *domain_name, int family, const void *addr,
+                   int addr_len, uint32_t ttl)
+{
+    uint32_t hash = _hash(domain_name);
+    _cache_entry_t *ce = NULL;
+
+    if ((ttl == 0) || (addr_len < 0) || (addr_len > (int)sizeof(ce->addr))) {
+        return;
+    }
+    if (addr_len > 0) {
+        family = (addr_len == sizeof(ce->addr)) ? AF_INET6 : AF_INET;
+    }
+    if (ttl > DNS_CACHE_TTL_MAX) {
+        ttl = DNS_CACHE_TTL_MAX;
+    }
+
+    mutex_lock(&_lock);
+    uint32_t now = ztimer_now(ZTIMER_SEC);
+    for (unsigned i = 0; i < CONFIG_DNS_CACHE_SIZE; i++) {
+        _cache_entry_t *tmp = &_cache[i];
+
+        if ((tmp->hash == hash) && _supersedes(tmp, family, addr_len)) {
+            /* the older result must not be used any more */
+            tmp->expires = now;
+        }
+        if ((ce == NULL) || _is_expired(tmp, now) ||
+            (!_is_expired(ce, now) &&
+             ((int32_t)(tmp->expires - ce->expires) < 0))) {
+            ce = tmp;
+        }
+    }
+    ce->hash = hash;
+    ce->expires = now + ttl;
+    ce->family = family;
+    ce->addr_len = addr_len;
+    if (addr_len > 0) {
+        memcpy(ce->addr, addr, addr_len);
+    }
+    mutex_unlock(&_lock);
+    DEBUG("dns_cache: added %s (%d) for %" PRIu32 " s\n", domain_name, family,
+          ttl);
+}
+
+void dns_cache_flush(void)
+{
+    mutex_lock(&_lock);
+    memset(_cache, 0, sizeof(_cache));
+    mutex_unlock(&_lock);
+}
+
+/** @} */
@@ -68,6 +68,13 @@ static unsigned _get_short(const uint8_t *buf)
     return _tmp;
 }
 
+static uint32_t _get_long(const uint8_t *buf)
+{
+    uint32_t _tmp;
+    memcpy(&_tmp, buf, 4);
+    return _tmp;
+}
+
 static ssize_t _skip_hostname(const uint8_t *buf, size_t len,
                               const uint8_t *bufpos)
 {
@@ -130,12 +137,57 @@ size_t dns_msg_compose_query(void *dns_buf, const char *domain_name,
     return bufpos - buf;
 }
 
+/* Gets the TTL of a negative answer from the SOA record in the authority
+ * section, see RFC 2308, section 5. Returns 0 if there is none. */
+static uint32_t _negative_ttl(const uint8_t *buf, size_t len,
+                              const uint8_t *bufpos, unsigned nscount)
+{
+    const uint8_t *buflim = buf + len;
+
+    for (unsigned n = 0; n < nscount; n++) {
+        ssize_t tmp = _skip_hostname(buf, len, bufpos);
+        if (tmp < 0) {
+            return 0;
+        }
+        bufpos += tmp;
+        if ((bufpos + RR_TYPE_LENGTH + RR_CLASS_LENGTH +
+             RR_TTL_LENGTH + RR_RDLENGTH_LENGTH) > buflim) {
+            return 0;
+        }
+        uint16_t _type = ntohs(_get_short(bufpos));
+        bufpos += RR_TYPE_LENGTH + RR_CLASS_LENGTH;
+        uint32_t ttl = ntohl(_get_long(bufpos));
+        bufpos += RR_TTL_LENGTH;
+        unsigned rdlen = ntohs(_get_short(bufpos));
+        bufpos += RR_RDLENGTH_LENGTH;
+        if (rdlen > (size_t)(buflim - bufpos)) {
+            return 0;
+        }
+        bufpos += rdlen;
+        if (_type == DNS_TYPE_SOA) {
+            /* MINIMUM is the last field of the SOA record */
+            if (rdlen < RR_TTL_LENGTH) {
+                return 0;
+            }
+            uint32_t minimum = ntohl(_get_long(bufpos - RR_TTL_LENGTH));
+            return (ttl < minimum) ? ttl : minimum;
+        }
+    }
+    return 0;
+}
+
 int dns_msg_parse_reply(const uint8_t *buf, size_t len, int family,
-                        void *addr_out)
+                        void *addr_out, uint32_t *ttl)
 {
     const uint8_t *buflim = buf + len;
     const dns_hdr_t *hdr = (dns_hdr_t *)buf;
     const uint8_t *bufpos = buf + sizeof(*hdr);
+    uint32_t min_ttl = UINT32_MAX;
+    unsigned rcode = ntohs(hdr->flags) & DNS_RCODE_MASK;
+
+    if ((rcode != DNS_RCODE_NO_ERROR) && (rcode != DNS_RCODE_NAME_ERROR)) {
+        return -EBADMSG;
+    }
 
     /* skip all queries that are part of the reply */
     for (unsigned n = 0; n < ntohs(hdr->qdcount); n++) {
@@ -147,6 +199,9 @@ int dns_msg_parse_reply(const uint8_t *buf, size_t len, int family,
         /* skip type and class of query */
         bufpos += (RR_TYPE_LENGTH + RR_CLASS_LENGTH);
     }
+    if (bufpos > buflim) {
+        return -EBADMSG;
+    }
 
     for (unsigned n = 0; n < ntohs(hdr->ancount); n++) {
         ssize_t tmp = _skip_hostname(buf, len, bufpos);
@@ -162,7 +217,11 @@ int dns_msg_parse_reply(const uint8_t *buf, size_t len, int family,
         bufpos += RR_TYPE_LENGTH;
         uint16_t class = ntohs(_get_short(bufpos));
         bufpos += RR_CLASS_LENGTH;
-        bufpos += RR_TTL_LENGTH; /* skip ttl */
+        uint32_t rr_ttl = ntohl(_get_long(bufpos));
+        bufpos += RR_TTL_LENGTH;
+        if (rr_ttl < min_ttl) {
+            min_ttl = rr_ttl;
+        }
 
         unsigned addrlen = ntohs(_get_short(bufpos));
         /* skip unwanted answers */
@@ -175,7 +234,7 @@ int dns_msg_parse_reply(const uint8_t *buf, size_t len, int family,
                 /* buffer wraps around memory space */
                 return -EBADMSG;
             }
-            bufpos += addrlen;
+            bufpos += RR_RDLENGTH_LENGTH + addrlen;
             /* other out-of-bound is checked in `_skip_hostname()` at start of
              * loop */
             continue;
@@ -192,10 +251,17 @@ int dns_msg_parse_reply(const uint8_t *buf, size_t len, int family,
         }
 
         memcpy(addr_out, bufpos, addrlen);
+        if (ttl != NULL) {
+            *ttl = min_ttl;
+        }
         return addrlen;
     }
 
-    return -EBADMSG;
+    /* name error or no data, see RFC 2308, section 2 */
+    if (ttl != NULL) {
+        *ttl = _negative_ttl(buf, len, bufpos, ntohs(hdr->nscount));
+    }
+    return -ENOENT;
 }
 
 /** @} */
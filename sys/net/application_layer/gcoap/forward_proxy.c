@@ -0,0 +1,303 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gcoap_forward_proxy
+ * @{
+ *
+ * @file
+ * @brief       Forward proxy implementation for gcoap
+ *
+ * All functions run in the gcoap thread, so the client slots need no lock.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "net/gcoap/forward_proxy.h"
+#include "net/sock/util.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#if IS_USED(MODULE_GCOAP_DTLS)
+#error "gcoap_forward_proxy can not be used with gcoap_dtls"
+#endif
+
+/**
+ * @brief   Scheme of the URIs the proxy forwards to
+ */
+#define FORWARD_PROXY_SCHEME    "coap://"
+
+/**
+ * @brief   State of a forwarded request
+ */
+typedef struct {
+    bool in_use;                        /**< slot is used */
+    sock_udp_ep_t ep;                   /**< endpoint of the client */
+    uint8_t token[GCOAP_TOKENLEN_MAX];  /**< token of the client request */
+    uint8_t tkl;                        /**< length of token */
+    uint8_t type;                       /**< type of the client request */
+    uint16_t mid;                       /**< message ID of the client request */
+    uint8_t *buf;                       /**< buffer for a response from the
+                                             cache while forwarding, or NULL */
+    size_t len;                         /**< size of buf */
+    size_t resp_len;                    /**< length of the response in buf */
+} _client_t;
+
+static _client_t _clients[CONFIG_GCOAP_REQ_WAITING_MAX];
+
+void gcoap_forward_proxy_init(void)
+{
+    memset(_clients, 0, sizeof(_clients));
+}
+
+static _client_t *_client_alloc(coap_pkt_t *pdu,
+                                const sock_udp_ep_t *client)
+{
+    for (unsigned i = 0; i < CONFIG_GCOAP_REQ_WAITING_MAX; i++) {
+        _client_t *cl = &_clients[i];
+
+        if (!cl->in_use) {
+            cl->in_use = true;
+            cl->ep = *client;
+            cl->tkl = coap_get_token_len(pdu);
+            memcpy(cl->token, pdu->token, cl->tkl);
+            cl->type = coap_get_type(pdu);
+            cl->mid = coap_get_id(pdu);
+            cl->buf = NULL;
+            return cl;
+        }
+    }
+    return NULL;
+}
+
+/* Splits a Proxy-Uri into the endpoint of the origin server and the path */
+static int _parse_uri(const char *uri, size_t uri_len, sock_udp_ep_t *ep,
+                      char *urlpath)
+{
+    char url[CONFIG_SOCK_SCHEME_MAXLEN + CONFIG_SOCK_HOSTPORT_MAXLEN
+             + CONFIG_SOCK_URLPATH_MAXLEN];
+    char hostport[CONFIG_SOCK_HOSTPORT_MAXLEN];
+
+    if (uri_len >= sizeof(url)) {
+        return -EOVERFLOW;
+    }
+    memcpy(url, uri, uri_len);
+    url[uri_len] = '\0';
+    if (strncmp(url, FORWARD_PROXY_SCHEME, strlen(FORWARD_PROXY_SCHEME))) {
+        return -ENOTSUP;
+    }
+    /* only IP address literals, no name resolution */
+    if ((sock_urlsplit(url, hostport, urlpath) < 0)
+        || (sock_udp_str2ep(ep, hostport) < 0)) {
+        return -EINVAL;
+    }
+    if (ep->port == 0) {
+        ep->port = COAP_PORT;
+    }
+    return 0;
+}
+
+static ssize_t _add_uri_opts(coap_pkt_t *pkt, unsigned next_opt_num,
+                             const char *path, const char *query,
+                             unsigned *added)
+{
+    ssize_t res = 0;
+
+    if ((*added < COAP_OPT_URI_PATH) && (next_opt_num > COAP_OPT_URI_PATH)) {
+        res = coap_opt_add_chars(pkt, COAP_OPT_URI_PATH, path, strlen(path),
+                                 '/');
+        *added = COAP_OPT_URI_PATH;
+    }
+    if ((res >= 0) && (*added < COAP_OPT_URI_QUERY)
+        && (next_opt_num > COAP_OPT_URI_QUERY)) {
+        if (query != NULL) {
+            res = coap_opt_add_chars(pkt, COAP_OPT_URI_QUERY, query,
+                                     strlen(query), '&');
+        }
+        *added = COAP_OPT_URI_QUERY;
+    }
+    return res;
+}
+
+/* Builds the request to the origin server in buf */
+static ssize_t _build_request(coap_pkt_t *pdu, char *urlpath,
+                              uint8_t *buf, size_t len)
+{
+    coap_pkt_t pkt;
+    coap_optpos_t opt = { 0, 0 };
+    char *query = strchr(urlpath, '?');
+    unsigned added = 0;
+    uint8_t *value;
+    ssize_t optlen;
+    ssize_t res;
+
+    if (query != NULL) {
+        *query++ = '\0';
+    }
+    if (gcoap_req_init(&pkt, buf, len, coap_get_code_raw(pdu), NULL) < 0) {
+        return -ENOSPC;
+    }
+    if (coap_get_type(pdu) == COAP_TYPE_CON) {
+        coap_hdr_set_type(pkt.hdr, COAP_TYPE_CON);
+    }
+
+    /* options must be added in order, the URI options go in between */
+    for (bool first = true; ; first = false) {
+        optlen = coap_opt_get_next(pdu, &opt, &value, first);
+        if (optlen < 0) {
+            res = _add_uri_opts(&pkt, UINT16_MAX, urlpath, query, &added);
+            if (res < 0) {
+                return res;
+            }
+            break;
+        }
+        switch (opt.opt_num) {
+        case COAP_OPT_URI_HOST:
+        case COAP_OPT_URI_PORT:
+        case COAP_OPT_URI_PATH:
+        case COAP_OPT_URI_QUERY:
+        case COAP_OPT_PROXY_URI:
+        case COAP_OPT_PROXY_SCHEME:
+            continue;
+        default:
+            break;
+        }
+        res = _add_uri_opts(&pkt, opt.opt_num, urlpath, query, &added);
+        if (res >= 0) {
+            res = coap_opt_add_opaque(&pkt, opt.opt_num, value, optlen);
+        }
+        if (res < 0) {
+            return res;
+        }
+    }
+
+    if (pdu->payload_len == 0) {
+        return coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE);
+    }
+    res = coap_opt_finish(&pkt, COAP_OPT_FINISH_PAYLOAD);
+    if ((res < 0)
+        || (coap_payload_put_bytes(&pkt, pdu->payload, pdu->payload_len) < 0)) {
+        return -ENOSPC;
+    }
+    return res + pdu->payload_len;
+}
+
+/*
+ * Builds the response to a client in buf. Takes the code, options and payload
+ * of resp, or only the code if resp is NULL.
+ */
+static ssize_t _build_response(const _client_t *cl, unsigned type, uint16_t mid,
+                               unsigned code, coap_pkt_t *resp,
+                               uint8_t *buf, size_t len)
+{
+    const uint8_t *rest = NULL;
+    size_t rest_len = 0;
+    ssize_t hdr_len;
+
+    if (resp != NULL) {
+        rest = (uint8_t *)resp->hdr + coap_get_total_hdr_len(resp);
+        rest_len = (resp->payload + resp->payload_len) - rest;
+        code = coap_get_code_raw(resp);
+        if ((sizeof(coap_hdr_t) + cl->tkl + rest_len) > len) {
+            DEBUG("gcoap_forward_proxy: response too large\n");
+            code = COAP_CODE_BAD_GATEWAY;
+            rest_len = 0;
+        }
+    }
+    hdr_len = coap_build_hdr((coap_hdr_t *)buf, type, (uint8_t *)cl->token,
+                             cl->tkl, code, mid);
+    if (rest_len > 0) {
+        memcpy(buf + hdr_len, rest, rest_len);
+    }
+    return hdr_len + rest_len;
+}
+
+static void _forward_resp_handler(const gcoap_request_memo_t *memo,
+                                  coap_pkt_t *pdu, const sock_udp_ep_t *remote)
+{
+    (void)remote;
+    _client_t *cl = memo->context;
+    coap_pkt_t *resp = NULL;
+    unsigned code = COAP_CODE_BAD_GATEWAY;
+
+    if (memo->state == GCOAP_MEMO_RESP) {
+        resp = pdu;
+    }
+    else if (memo->state == GCOAP_MEMO_TIMEOUT) {
+        code = COAP_CODE_GATEWAY_TIMEOUT;
+    }
+
+    if (cl->buf != NULL) {
+        /* response from the cache, piggybacked */
+        cl->resp_len = _build_response(cl, (cl->type == COAP_TYPE_CON)
+                                      ? COAP_TYPE_ACK : COAP_TYPE_NON,
+                                  cl->mid, code, resp, cl->buf, cl->len);
+        return;
+    }
+
+    uint8_t buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+    ssize_t len = _build_response(cl, COAP_TYPE_NON, 0, code, resp,
+                                  buf, sizeof(buf));
+
+    if (gcoap_forward_proxy_dispatch(buf, len, &cl->ep) <= 0) {
+        DEBUG("gcoap_forward_proxy: sending response failed\n");
+    }
+    cl->in_use = false;
+}
+
+ssize_t gcoap_forward_proxy_request_process(coap_pkt_t *pdu, uint8_t *buf,
+                                            size_t len,
+                                            const sock_udp_ep_t *client)
+{
+    char *uri;
+    ssize_t uri_len = coap_get_proxy_uri(pdu, &uri);
+    char urlpath[CONFIG_SOCK_URLPATH_MAXLEN];
+    uint8_t req_buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+    sock_udp_ep_t origin;
+    _client_t *cl;
+    ssize_t res;
+
+    if (uri_len < 0) {
+        return -ENOENT;
+    }
+    if (_parse_uri(uri, uri_len, &origin, urlpath) < 0) {
+        DEBUG("gcoap_forward_proxy: unsupported Proxy-Uri\n");
+        return gcoap_response(pdu, buf, len, COAP_CODE_PROXYING_NOT_SUPPORTED);
+    }
+    res = _build_request(pdu, urlpath, req_buf, sizeof(req_buf));
+    if (res < 0) {
+        DEBUG("gcoap_forward_proxy: request does not fit: %d\n", (int)res);
+        return gcoap_response(pdu, buf, len, COAP_CODE_INTERNAL_SERVER_ERROR);
+    }
+    cl = _client_alloc(pdu, client);
+    if (cl == NULL) {
+        DEBUG("gcoap_forward_proxy: no space for client\n");
+        return gcoap_response(pdu, buf, len, COAP_CODE_SERVICE_UNAVAILABLE);
+    }
+
+    /* the request was copied, a response from the cache may go to buf */
+    cl->buf = buf;
+    cl->len = len;
+    cl->resp_len = 0;
+    res = gcoap_req_send(req_buf, res, &origin, _forward_resp_handler, cl);
+    cl->buf = NULL;
+    if (cl->resp_len > 0) {
+        cl->in_use = false;
+        return cl->resp_len;
+    }
+    if (res <= 0) {
+        cl->in_use = false;
+        return gcoap_response(pdu, buf, len, COAP_CODE_BAD_GATEWAY);
+    }
+    return 0;
+}
+
+/** @} */
@@ -40,6 +40,14 @@
 #include "net/dsm.h"
 #endif
 
+#if IS_USED(MODULE_GCOAP_COCOA)
+#include "congure/cocoa.h"
+#endif
+
+#if IS_USED(MODULE_GCOAP_FORWARD_PROXY)
+#include "net/gcoap/forward_proxy.h"
+#endif
+
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
@@ -49,6 +57,12 @@
 /* End of the range to pick a random timeout */
 #define TIMEOUT_RANGE_END (CONFIG_COAP_ACK_TIMEOUT * CONFIG_COAP_RANDOM_FACTOR_1000 / 1000)
 
+/* Values of gcoap_request_memo_t::cache_state */
+#define GCOAP_CACHE_NONE        (0)     /* response is not cached */
+#define GCOAP_CACHE_STORE       (1)     /* response is stored in the cache */
+#define GCOAP_CACHE_VALIDATE    (2)     /* request carries the ETag of a
+                                           stale cache entry */
+
 /* Internal functions */
 static void *_event_loop(void *arg);
 static void _on_sock_udp_evt(sock_udp_t *sock, sock_async_flags_t type, void *arg);
@@ -61,6 +75,13 @@ static ssize_t _tl_authenticate(gcoap_socket_t *sock, const sock_udp_ep_t *remot
                                 uint32_t timeout);
 static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len, void *ctx);
 static void _cease_retransmission(gcoap_request_memo_t *memo);
+#if IS_USED(MODULE_GCOAP_COCOA)
+static void _cocoa_report_ack(gcoap_request_memo_t *memo);
+#endif
+#if IS_USED(MODULE_NANOCOAP_CACHE)
+static void _cache_response(gcoap_request_memo_t *memo, coap_pkt_t *pdu,
+                            uint8_t *buf, size_t buf_len, size_t len);
+#endif
 static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                                                          sock_udp_ep_t *remote);
 static void _expire_request(gcoap_request_memo_t *memo);
@@ -97,6 +118,16 @@ static gcoap_listener_t _default_listener = {
     _request_matcher_default
 };
 
+#if IS_USED(MODULE_GCOAP_COCOA)
+/* Retransmission timeout estimation for a remote endpoint */
+typedef struct {
+    sock_udp_ep_t remote;               /* Remote endpoint; unused if family
+                                           is AF_UNSPEC */
+    congure_cocoa_snd_t cong;           /* RTO estimation state */
+    uint32_t last_used;                 /* Time of the last request in msec */
+} gcoap_cocoa_peer_t;
+#endif
+
 /* Container for the state of gcoap itself */
 typedef struct {
     mutex_t lock;                       /* Shares state attributes safely */
@@ -115,6 +146,10 @@ typedef struct {
                                         /* Buffers for PDU for request resends;
                                            if first byte of an entry is zero,
                                            the entry is available */
+#if IS_USED(MODULE_GCOAP_COCOA)
+    gcoap_cocoa_peer_t cocoa_peers[CONFIG_GCOAP_COCOA_PEERS_NUMOF];
+                                        /* RTO estimation per remote endpoint */
+#endif
 } gcoap_state_t;
 
 static gcoap_state_t _coap_state = {
@@ -382,7 +417,19 @@ static void _process_coap_pdu(gcoap_socket_t *sock, sock_udp_ep_t *remote,
                 /* TBD: Set a Size1 */
                 pdu_len = gcoap_response(&pdu, _listen_buf, sizeof(_listen_buf),
                                          COAP_CODE_REQUEST_ENTITY_TOO_LARGE);
-            } else {
+            }
+#if IS_USED(MODULE_GCOAP_FORWARD_PROXY)
+            else if ((res = gcoap_forward_proxy_request_process(&pdu, _listen_buf,
+                                                                sizeof(_listen_buf),
+                                                                remote)) >= 0) {
+                /* the response from the origin server is sent separately */
+                if ((res == 0) && (coap_get_type(&pdu) == COAP_TYPE_CON)) {
+                    messagelayer_emptyresponse_type = COAP_TYPE_ACK;
+                }
+                pdu_len = res;
+            }
+#endif
+            else {
                 pdu_len = _handle_req(&pdu, _listen_buf, sizeof(_listen_buf), remote);
             }
 
@@ -415,7 +462,18 @@ static void _process_coap_pdu(gcoap_socket_t *sock, sock_udp_ep_t *remote,
                 if (memo->resp_evt_tmout.queue) {
                     event_timeout_clear(&memo->resp_evt_tmout);
                 }
+#if IS_USED(MODULE_GCOAP_COCOA)
+                /* piggybacked response: the request was not ACKed before */
+                if (memo->state == GCOAP_MEMO_RETRANSMIT) {
+                    _cocoa_report_ack(memo);
+                }
+#endif
                 memo->state = truncated ? GCOAP_MEMO_RESP_TRUNC : GCOAP_MEMO_RESP;
+#if IS_USED(MODULE_NANOCOAP_CACHE)
+                if (!truncated && (memo->cache_state != GCOAP_CACHE_NONE)) {
+                    _cache_response(memo, &pdu, buf, sizeof(_listen_buf), len);
+                }
+#endif
                 if (memo->resp_handler) {
                     memo->resp_handler(memo, &pdu, remote);
                 }
@@ -456,6 +514,306 @@ static void _process_coap_pdu(gcoap_socket_t *sock, sock_udp_ep_t *remote,
     }
 }
 
+#if IS_USED(MODULE_GCOAP_COCOA)
+/*
+ * Finds the RTO estimation state for a remote endpoint. If there is none,
+ * the state of an unused slot or of the least recently used endpoint is
+ * initialized for it.
+ *
+ * Must be called with _coap_state.lock held.
+ */
+static congure_cocoa_snd_t *_cocoa_get(const sock_udp_ep_t *remote, uint32_t now)
+{
+    gcoap_cocoa_peer_t *peer = &_coap_state.cocoa_peers[0];
+
+    for (unsigned i = 0; i < CONFIG_GCOAP_COCOA_PEERS_NUMOF; i++) {
+        gcoap_cocoa_peer_t *p = &_coap_state.cocoa_peers[i];
+
+        if (p->remote.family == AF_UNSPEC) {
+            if (peer->remote.family != AF_UNSPEC) {
+                peer = p;
+            }
+        }
+        else if (sock_udp_ep_equal(&p->remote, remote)) {
+            p->last_used = now;
+            return &p->cong;
+        }
+        else if ((peer->remote.family != AF_UNSPEC) &&
+                 ((int32_t)(p->last_used - peer->last_used) < 0)) {
+            peer = p;
+        }
+    }
+    memcpy(&peer->remote, remote, sizeof(sock_udp_ep_t));
+    peer->last_used = now;
+    congure_cocoa_snd_setup(&peer->cong);
+    peer->cong.super.driver->init(&peer->cong.super, NULL);
+    return &peer->cong;
+}
+
+/* Sets the initial retransmission timeout of a confirmable request */
+static uint32_t _cocoa_init_timeout(gcoap_request_memo_t *memo)
+{
+    uint32_t now = ztimer_now(ZTIMER_MSEC);
+    uint32_t rto = congure_cocoa_get_rto(_cocoa_get(&memo->remote_ep, now), now);
+
+    memo->send_time = now;
+#if CONFIG_COAP_RANDOM_FACTOR_1000 > 1000
+    rto = random_uint32_range(rto, (uint32_t)(((uint64_t)rto *
+                                               CONFIG_COAP_RANDOM_FACTOR_1000) / 1000));
+#endif
+    memo->timeout = rto;
+    return rto;
+}
+
+/* Backs off the retransmission timeout of a confirmable request */
+static uint32_t _cocoa_next_timeout(gcoap_request_memo_t *memo)
+{
+#ifndef CONFIG_GCOAP_NO_RETRANS_BACKOFF
+    memo->timeout = congure_cocoa_backoff(memo->timeout);
+#endif
+    return memo->timeout;
+}
+
+/* Reports the ACK or response for a confirmable request */
+static void _cocoa_report_ack(gcoap_request_memo_t *memo)
+{
+    congure_snd_msg_t msg = { 0 };
+    congure_snd_ack_t ack = { 0 };
+    uint32_t now = ztimer_now(ZTIMER_MSEC);
+
+    /* exchanges are counted, not bytes */
+    msg.send_time = memo->send_time;
+    msg.size = 1;
+    msg.resends = CONFIG_COAP_MAX_RETRANSMIT - memo->send_limit;
+    ack.recv_time = now;
+    ack.clean = 1;
+
+    mutex_lock(&_coap_state.lock);
+    congure_cocoa_snd_t *c = _cocoa_get(&memo->remote_ep, now);
+    c->super.driver->report_msg_acked(&c->super, &msg, &ack);
+    mutex_unlock(&_coap_state.lock);
+}
+#endif
+
+#if IS_USED(MODULE_NANOCOAP_CACHE)
+static void _cache_key_generate(const coap_pkt_t *req,
+                                const sock_udp_ep_t *remote,
+                                uint8_t *cache_key)
+{
+    /* responses of different servers must not be mixed up; padding and
+     * unused address bytes must not make up different keys */
+    sock_udp_ep_t ctx;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.family = remote->family;
+    memcpy(&ctx.addr, &remote->addr, (remote->family == AF_INET)
+                                     ? sizeof(ctx.addr.ipv4)
+                                     : sizeof(ctx.addr));
+    ctx.netif = remote->netif;
+    ctx.port = remote->port;
+    nanocoap_cache_key_generate(req, &ctx, sizeof(ctx), cache_key);
+}
+
+/*
+ * Builds the response of a cache entry in buf, which already holds the header
+ * and token the response is sent with. The Max-Age option is set to the time
+ * the entry stays fresh.
+ *
+ * Must be called with the cache locked.
+ */
+static ssize_t _cache_build_resp(const nanocoap_cache_entry_t *ce,
+                                 coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                                 uint32_t now)
+{
+    coap_pkt_t cached;
+    size_t hdr_len = sizeof(coap_hdr_t) + (((coap_hdr_t *)buf)->ver_t_tkl & 0xf);
+    size_t cached_hdr_len;
+    uint8_t *value;
+    ssize_t res;
+
+    /* coap_parse() does not write to the buffer */
+    if (coap_parse(&cached, (uint8_t *)ce->response_buf, ce->response_len) < 0) {
+        return -EINVAL;
+    }
+    cached_hdr_len = coap_get_total_hdr_len(&cached);
+    if ((hdr_len + ce->response_len - cached_hdr_len) > len) {
+        return -ENOSPC;
+    }
+    ((coap_hdr_t *)buf)->code = cached.hdr->code;
+    memcpy(buf + hdr_len, ce->response_buf + cached_hdr_len,
+           ce->response_len - cached_hdr_len);
+    len = hdr_len + ce->response_len - cached_hdr_len;
+    if ((res = coap_parse(pdu, buf, len)) < 0) {
+        return res;
+    }
+
+    res = coap_opt_get_opaque(pdu, COAP_OPT_MAX_AGE, &value);
+    if (res > 0) {
+        uint32_t max_age = nanocoap_cache_entry_max_age(ce, now);
+
+        /* keep the length of the option, saturate what does not fit */
+        if ((res < 4) && (max_age >> (8 * res))) {
+            max_age = UINT32_MAX;
+        }
+        while (res--) {
+            value[res] = max_age & 0xff;
+            max_age >>= 8;
+        }
+    }
+    return len;
+}
+
+/*
+ * Copies a request to buf and adds the ETag option. Returns the length of the
+ * new request, or a negative value if it does not fit.
+ */
+static ssize_t _cache_add_etag(const coap_pkt_t *req, uint8_t *buf, size_t len,
+                               const uint8_t *etag, size_t etag_len)
+{
+    coap_optpos_t opt = { 0, 0 };
+    size_t hdr_len = coap_get_total_hdr_len(req);
+    uint16_t lastonum = 0;
+    uint8_t *pos = buf + hdr_len;
+    uint8_t *end = buf + len;
+    bool etag_added = false;
+    uint8_t *value;
+    ssize_t optlen;
+
+    if (hdr_len > len) {
+        return -ENOSPC;
+    }
+    memcpy(buf, req->hdr, hdr_len);
+    for (bool first = true; ; first = false) {
+        optlen = coap_opt_get_next(req, &opt, &value, first);
+        if (!etag_added && ((optlen < 0) || (opt.opt_num > COAP_OPT_ETAG))) {
+            /* an option takes at most 5 bytes besides the value */
+            if ((size_t)(end - pos) < (5 + etag_len)) {
+                return -ENOSPC;
+            }
+            pos += coap_put_option(pos, lastonum, COAP_OPT_ETAG, etag, etag_len);
+            lastonum = COAP_OPT_ETAG;
+            etag_added = true;
+        }
+        if (optlen < 0) {
+            break;
+        }
+        if ((size_t)(end - pos) < (5 + (size_t)optlen)) {
+            return -ENOSPC;
+        }
+        pos += coap_put_option(pos, lastonum, opt.opt_num, value, optlen);
+        lastonum = opt.opt_num;
+    }
+    if (req->payload_len) {
+        if ((size_t)(end - pos) < (1U + req->payload_len)) {
+            return -ENOSPC;
+        }
+        *pos++ = 0xff;     /* payload marker */
+        memcpy(pos, req->payload, req->payload_len);
+        pos += req->payload_len;
+    }
+    return pos - buf;
+}
+
+/*
+ * Looks up the response to a request in the cache. A fresh response is
+ * passed to the response handler and its length returned. Otherwise, the
+ * memo template is prepared to cache the response and 0 returned. If a stale
+ * response can be validated, *buf and *len are set to a copy of the request
+ * in cache_buf that carries the ETag of the response.
+ */
+static ssize_t _cache_request(gcoap_request_memo_t *memo, const uint8_t **buf,
+                              size_t *len, uint8_t *cache_buf,
+                              size_t cache_buf_len)
+{
+    coap_pkt_t req;
+    coap_pkt_t resp;
+    nanocoap_cache_entry_t *ce;
+    uint8_t etag[COAP_ETAG_LENGTH_MAX];
+    uint8_t *value;
+    size_t etag_len = 0;
+    ssize_t res = 0;
+    uint32_t now;
+
+    memo->cache_state = GCOAP_CACHE_NONE;
+    /* coap_parse() does not write to the buffer */
+    if ((coap_parse(&req, (uint8_t *)*buf, *len) < 0)
+        || !nanocoap_cache_request_is_cacheable(&req)
+        || (coap_opt_get_opaque(&req, COAP_OPT_ETAG, &value) >= 0)
+        || (coap_opt_get_opaque(&req, COAP_OPT_OBSERVE, &value) >= 0)) {
+        return 0;
+    }
+    _cache_key_generate(&req, &memo->remote_ep, memo->cache_key);
+    memo->cache_state = GCOAP_CACHE_STORE;
+
+    nanocoap_cache_lock();
+    now = ztimer_now(ZTIMER_MSEC);
+    ce = nanocoap_cache_key_lookup(memo->cache_key, now);
+    if ((ce != NULL) && !nanocoap_cache_entry_is_stale(ce, now)) {
+        /* answer like a server would */
+        memcpy(cache_buf, req.hdr, coap_get_total_hdr_len(&req));
+        if (coap_get_type(&req) == COAP_TYPE_CON) {
+            coap_hdr_set_type((coap_hdr_t *)cache_buf, COAP_TYPE_ACK);
+        }
+        res = _cache_build_resp(ce, &resp, cache_buf, cache_buf_len, now);
+    }
+    else if (ce != NULL) {
+        etag_len = nanocoap_cache_entry_get_etag(ce, etag);
+    }
+    nanocoap_cache_unlock();
+
+    if (res > 0) {
+        DEBUG("gcoap: response from cache\n");
+        memo->state = GCOAP_MEMO_RESP;
+        memo->resp_handler(memo, &resp, &memo->remote_ep);
+        return res;
+    }
+    if (etag_len > 0) {
+        /* the copy must fit into a resend buffer */
+        if (cache_buf_len > CONFIG_GCOAP_PDU_BUF_SIZE) {
+            cache_buf_len = CONFIG_GCOAP_PDU_BUF_SIZE;
+        }
+        res = _cache_add_etag(&req, cache_buf, cache_buf_len, etag, etag_len);
+        if (res > 0) {
+            DEBUG("gcoap: validating stale response from cache\n");
+            *buf = cache_buf;
+            *len = res;
+            memo->cache_state = GCOAP_CACHE_VALIDATE;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Updates the cache with a response. A 2.03 (Valid) response that validated
+ * a cache entry is replaced in buf by the response of the entry.
+ */
+static void _cache_response(gcoap_request_memo_t *memo, coap_pkt_t *pdu,
+                            uint8_t *buf, size_t buf_len, size_t len)
+{
+    nanocoap_cache_entry_t *ce;
+    uint32_t now;
+
+    if ((coap_get_code_raw(pdu) == COAP_CODE_VALID)
+        && (memo->cache_state != GCOAP_CACHE_VALIDATE)) {
+        /* the application validates its own ETag */
+        return;
+    }
+    nanocoap_cache_lock();
+    now = ztimer_now(ZTIMER_MSEC);
+    ce = nanocoap_cache_process(memo->cache_key, COAP_METHOD_GET, pdu, len, now);
+    if ((ce != NULL) && (coap_get_code_raw(pdu) == COAP_CODE_VALID)) {
+        coap_pkt_t resp;
+
+        /* the header and token of the response are kept */
+        if (_cache_build_resp(ce, &resp, buf, buf_len, now) > 0) {
+            DEBUG("gcoap: response from cache validated\n");
+            *pdu = resp;
+        }
+    }
+    nanocoap_cache_unlock();
+}
+#endif
+
 /* Handles response timeout for a request; resend confirmable if needed. */
 static void _on_resp_timeout(void *arg) {
     gcoap_request_memo_t *memo = (gcoap_request_memo_t *)arg;
@@ -467,6 +825,9 @@ static void _on_resp_timeout(void *arg) {
     /* reduce retries remaining, double timeout and resend */
     else {
         memo->send_limit--;
+#if IS_USED(MODULE_GCOAP_COCOA)
+        uint32_t timeout  = _cocoa_next_timeout(memo);
+#else
 #ifdef CONFIG_GCOAP_NO_RETRANS_BACKOFF
         unsigned i        = 0;
 #else
@@ -476,6 +837,7 @@ static void _on_resp_timeout(void *arg) {
 #if CONFIG_COAP_RANDOM_FACTOR_1000 > 1000
         uint32_t end = ((uint32_t)TIMEOUT_RANGE_END << i) * MS_PER_SEC;
         timeout = random_uint32_range(timeout, end);
+#endif
 #endif
         event_timeout_set(&memo->resp_evt_tmout, timeout);
 
@@ -519,6 +881,11 @@ static void _on_resp_timeout(void *arg) {
  *      send_limit is not GCOAP_SEND_LIMIT_NON.
  */
 static void _cease_retransmission(gcoap_request_memo_t *memo) {
+#if IS_USED(MODULE_GCOAP_COCOA)
+    if (memo->state == GCOAP_MEMO_RETRANSMIT) {
+        _cocoa_report_ack(memo);
+    }
+#endif
     memo->state = GCOAP_MEMO_WAIT;
 }
 
@@ -643,7 +1010,6 @@ static int _request_matcher_default(gcoap_listener_t *listener,
                                     const coap_pkt_t *pdu)
 {
     uint8_t uri[CONFIG_NANOCOAP_URI_MAX];
-    int ret = GCOAP_RESOURCE_NO_PATH;
 
     if (coap_get_uri_path(pdu, uri) <= 0) {
         /* The Uri-Path options are longer than
@@ -655,34 +1021,15 @@ static int _request_matcher_default(gcoap_listener_t *listener,
     coap_method_flags_t method_flag = coap_method2flag(
         coap_get_code_detail(pdu));
 
-    for (size_t i = 0; i < listener->resources_len; i++) {
-        *resource = &listener->resources[i];
-
-        int res = coap_match_path(*resource, uri);
-
-        /* URI mismatch */
-        if (res > 0) {
-            continue;
-        }
-        /* resources expected in alphabetical order */
-        else if (res < 0) {
-            break;
-        }
-
-        /* potential match, check for method */
-        if (! ((*resource)->methods & method_flag)) {
-            /* record wrong method error for next iteration, in case
-             * another resource with the same URI and correct method
-             * exists */
-            ret = GCOAP_RESOURCE_WRONG_METHOD;
-            continue;
-        }
-        else {
-            return GCOAP_RESOURCE_FOUND;
-        }
+    switch (coap_find_resource(listener->resources, listener->resources_len,
+                               uri, method_flag, resource)) {
+    case 0:
+        return GCOAP_RESOURCE_FOUND;
+    case -ENOTSUP:
+        return GCOAP_RESOURCE_WRONG_METHOD;
+    default:
+        return GCOAP_RESOURCE_NO_PATH;
     }
-
-    return ret;
 }
 
 /*
@@ -1040,6 +1387,12 @@ kernel_pid_t gcoap_init(void)
     if (_pid != KERNEL_PID_UNDEF) {
         return -EEXIST;
     }
+#if IS_USED(MODULE_NANOCOAP_CACHE)
+    nanocoap_cache_init();
+#endif
+#if IS_USED(MODULE_GCOAP_FORWARD_PROXY)
+    gcoap_forward_proxy_init();
+#endif
     _pid = thread_create(_msg_stack, sizeof(_msg_stack), THREAD_PRIORITY_MAIN - 1,
                             THREAD_CREATE_STACKTEST, _event_loop, NULL, "coap");
 
@@ -1070,6 +1423,13 @@ void gcoap_register_listener(gcoap_listener_t *listener)
 
     if (!listener->request_matcher) {
         listener->request_matcher = _request_matcher_default;
+#ifdef DEVELHELP
+        /* the default matcher relies on the documented order */
+        for (size_t i = 1; i < listener->resources_len; i++) {
+            assert(strcmp(listener->resources[i - 1].path,
+                          listener->resources[i].path) <= 0);
+        }
+#endif
     }
 }
 
@@ -1121,6 +1481,28 @@ ssize_t gcoap_req_send(const uint8_t *buf, size_t len,
 
     assert(remote != NULL);
 
+#if IS_USED(MODULE_NANOCOAP_CACHE)
+    /* holds a response from the cache or the request to validate one */
+    uint8_t cache_buf[(CONFIG_GCOAP_PDU_BUF_SIZE
+                       > (CONFIG_NANOCOAP_CACHE_RESPONSE_SIZE + GCOAP_TOKENLEN_MAX))
+                      ? CONFIG_GCOAP_PDU_BUF_SIZE
+                      : (CONFIG_NANOCOAP_CACHE_RESPONSE_SIZE + GCOAP_TOKENLEN_MAX)];
+    gcoap_request_memo_t cache_memo = {
+        .resp_handler = resp_handler,
+        .context = context,
+        .remote_ep = *remote,
+        .cache_state = GCOAP_CACHE_NONE,
+    };
+
+    if (resp_handler != NULL) {
+        ssize_t res = _cache_request(&cache_memo, &buf, &len, cache_buf,
+                                     sizeof(cache_buf));
+        if (res > 0) {
+            return res;
+        }
+    }
+#endif
+
     /* Only allocate memory if necessary (i.e. if user is interested in the
      * response or request is confirmable) */
     if ((resp_handler != NULL) || (msg_type == COAP_TYPE_CON)) {
@@ -1142,6 +1524,10 @@ ssize_t gcoap_req_send(const uint8_t *buf, size_t len,
         memo->resp_handler = resp_handler;
         memo->context = context;
         memcpy(&memo->remote_ep, remote, sizeof(sock_udp_ep_t));
+#if IS_USED(MODULE_NANOCOAP_CACHE)
+        memcpy(memo->cache_key, cache_memo.cache_key, sizeof(memo->cache_key));
+        memo->cache_state = cache_memo.cache_state;
+#endif
 
         switch (msg_type) {
         case COAP_TYPE_CON:
@@ -1158,9 +1544,13 @@ ssize_t gcoap_req_send(const uint8_t *buf, size_t len,
             }
             if (memo->msg.data.pdu_buf) {
                 memo->send_limit  = CONFIG_COAP_MAX_RETRANSMIT;
+#if IS_USED(MODULE_GCOAP_COCOA)
+                timeout           = _cocoa_init_timeout(memo);
+#else
                 timeout           = (uint32_t)CONFIG_COAP_ACK_TIMEOUT * MS_PER_SEC;
 #if CONFIG_COAP_RANDOM_FACTOR_1000 > 1000
                 timeout = random_uint32_range(timeout, TIMEOUT_RANGE_END * MS_PER_SEC);
+#endif
 #endif
                 memo->state = GCOAP_MEMO_RETRANSMIT;
             }
@@ -1296,6 +1686,19 @@ size_t gcoap_obs_send(const uint8_t *buf, size_t len,
     }
 }
 
+#if IS_USED(MODULE_GCOAP_FORWARD_PROXY)
+ssize_t gcoap_forward_proxy_dispatch(uint8_t *buf, size_t len,
+                                     const sock_udp_ep_t *client)
+{
+    gcoap_socket_t socket;
+
+    ((coap_hdr_t *)buf)->id =
+        htons((uint16_t)atomic_fetch_add(&_coap_state.next_message_id, 1));
+    _tl_init_coap_socket(&socket);
+    return _tl_send(&socket, buf, len, client);
+}
+#endif
+
 uint8_t gcoap_op_state(void)
 {
     uint8_t count = 0;
@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_nanocoap_cache
+ * @{
+ *
+ * @file
+ * @brief       Implementation of a cache for nanocoap response messages
+ */
+
+#include <string.h>
+
+#include "hashes/sha256.h"
+#include "mutex.h"
+#include "timex.h"
+
+#include "net/nanocoap/cache.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+/**
+ * @brief   Largest Max-Age in s that keeps the expiry time comparable with
+ *          32 bit millisecond time stamps
+ */
+#define NANOCOAP_CACHE_MAX_AGE_MAX  (INT32_MAX / MS_PER_SEC)
+
+static nanocoap_cache_entry_t _cache_entries[CONFIG_NANOCOAP_CACHE_ENTRIES];
+
+/* least recently used entry first */
+static clist_node_t _cache_list;
+static clist_node_t _empty_list;
+static nanocoap_cache_stats_t _stats;
+static mutex_t _lock = MUTEX_INIT;
+
+void nanocoap_cache_init(void)
+{
+    _cache_list.next = NULL;
+    _empty_list.next = NULL;
+    memset(_cache_entries, 0, sizeof(_cache_entries));
+    memset(&_stats, 0, sizeof(_stats));
+    for (unsigned i = 0; i < CONFIG_NANOCOAP_CACHE_ENTRIES; i++) {
+        clist_rpush(&_empty_list, &_cache_entries[i].node);
+    }
+}
+
+void nanocoap_cache_lock(void)
+{
+    mutex_lock(&_lock);
+}
+
+void nanocoap_cache_unlock(void)
+{
+    mutex_unlock(&_lock);
+}
+
+static bool _in_key(unsigned opt_num)
+{
+    /* NoCacheKey options, see RFC 7252, section 5.4.6 */
+    if ((opt_num & 0x1e) == 0x1c) {
+        return false;
+    }
+    return (opt_num != COAP_OPT_ETAG) && (opt_num != COAP_OPT_OBSERVE);
+}
+
+void nanocoap_cache_key_generate(const coap_pkt_t *req, const void *ctx,
+                                 size_t ctx_len, uint8_t *cache_key)
+{
+    sha256_context_t sha;
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    uint8_t code = req->hdr->code;
+    coap_optpos_t opt = { 0, 0 };
+    uint8_t *value;
+    ssize_t len;
+
+    sha256_init(&sha);
+    if (ctx) {
+        sha256_update(&sha, ctx, ctx_len);
+    }
+    sha256_update(&sha, &code, sizeof(code));
+    for (bool first = true;
+         (len = coap_opt_get_next(req, &opt, &value, first)) >= 0;
+         first = false) {
+        if (_in_key(opt.opt_num)) {
+            /* number and length make the encoding of the options unique */
+            uint16_t hdr[2] = { opt.opt_num, len };
+
+            sha256_update(&sha, hdr, sizeof(hdr));
+            sha256_update(&sha, value, len);
+        }
+    }
+    sha256_final(&sha, digest);
+    memcpy(cache_key, digest, CONFIG_NANOCOAP_CACHE_KEY_LENGTH);
+}
+
+static int _cmp_key(clist_node_t *node, void *arg)
+{
+    nanocoap_cache_entry_t *ce = container_of(node, nanocoap_cache_entry_t,
+                                              node);
+
+    return memcmp(ce->cache_key, arg, CONFIG_NANOCOAP_CACHE_KEY_LENGTH) == 0;
+}
+
+static nanocoap_cache_entry_t *_find(const uint8_t *cache_key)
+{
+    clist_node_t *node = clist_foreach(&_cache_list, _cmp_key,
+                                       (void *)cache_key);
+
+    if (node == NULL) {
+        return NULL;
+    }
+    /* most recently used goes last */
+    clist_remove(&_cache_list, node);
+    clist_rpush(&_cache_list, node);
+    return container_of(node, nanocoap_cache_entry_t, node);
+}
+
+nanocoap_cache_entry_t *nanocoap_cache_key_lookup(const uint8_t *cache_key,
+                                                  uint32_t now)
+{
+    nanocoap_cache_entry_t *ce = _find(cache_key);
+
+    if ((ce != NULL) && !nanocoap_cache_entry_is_stale(ce, now)) {
+        _stats.hits++;
+    }
+    else {
+        _stats.misses++;
+    }
+    return ce;
+}
+
+static uint32_t _max_age(const coap_pkt_t *resp, uint32_t now)
+{
+    uint32_t max_age;
+
+    if (coap_opt_get_uint(resp, COAP_OPT_MAX_AGE, &max_age) < 0) {
+        max_age = COAP_MAX_AGE_DEFAULT;
+    }
+    if (max_age > NANOCOAP_CACHE_MAX_AGE_MAX) {
+        max_age = NANOCOAP_CACHE_MAX_AGE_MAX;
+    }
+    return now + max_age * MS_PER_SEC;
+}
+
+nanocoap_cache_entry_t *nanocoap_cache_process(const uint8_t *cache_key,
+                                               unsigned request_method,
+                                               const coap_pkt_t *resp,
+                                               size_t resp_len, uint32_t now)
+{
+    nanocoap_cache_entry_t *ce;
+
+    if (request_method != COAP_METHOD_GET) {
+        return NULL;
+    }
+    ce = _find(cache_key);
+    switch (resp->hdr->code) {
+    case COAP_CODE_CONTENT:
+        if (resp_len > CONFIG_NANOCOAP_CACHE_RESPONSE_SIZE) {
+            DEBUG("nanocoap_cache: response too large (%u bytes)\n",
+                  (unsigned)resp_len);
+            break;
+        }
+        if (ce == NULL) {
+            clist_node_t *node = clist_lpop(&_empty_list);
+
+            if (node == NULL) {
+                node = clist_lpop(&_cache_list);
+                if (node == NULL) {
+                    /* not initialized */
+                    return NULL;
+                }
+                _stats.evictions++;
+            }
+            clist_rpush(&_cache_list, node);
+            ce = container_of(node, nanocoap_cache_entry_t, node);
+            memcpy(ce->cache_key, cache_key, CONFIG_NANOCOAP_CACHE_KEY_LENGTH);
+        }
+        memcpy(ce->response_buf, resp->hdr, resp_len);
+        ce->response_len = resp_len;
+        ce->max_age = _max_age(resp, now);
+        return ce;
+    case COAP_CODE_VALID:
+        if (ce != NULL) {
+            ce->max_age = _max_age(resp, now);
+            _stats.validations++;
+        }
+        return ce;
+    default:
+        break;
+    }
+    /* an older response must not be used any more */
+    if (ce != NULL) {
+        nanocoap_cache_del(ce);
+    }
+    return NULL;
+}
+
+void nanocoap_cache_del(nanocoap_cache_entry_t *ce)
+{
+    clist_remove(&_cache_list, &ce->node);
+    clist_rpush(&_empty_list, &ce->node);
+}
+
+uint32_t nanocoap_cache_entry_max_age(const nanocoap_cache_entry_t *ce,
+                                      uint32_t now)
+{
+    if (nanocoap_cache_entry_is_stale(ce, now)) {
+        return 0;
+    }
+    return (ce->max_age - now) / MS_PER_SEC;
+}
+
+size_t nanocoap_cache_entry_get_etag(const nanocoap_cache_entry_t *ce,
+                                     uint8_t *etag)
+{
+    coap_pkt_t resp;
+    uint8_t *value;
+    ssize_t len;
+
+    /* coap_parse() does not write to the buffer */
+    if (coap_parse(&resp, (uint8_t *)ce->response_buf, ce->response_len) < 0) {
+        return 0;
+    }
+    len = coap_opt_get_opaque(&resp, COAP_OPT_ETAG, &value);
+    if ((len <= 0) || (len > COAP_ETAG_LENGTH_MAX)) {
+        return 0;
+    }
+    memcpy(etag, value, len);
+    return len;
+}
+
+void nanocoap_cache_stats_get(nanocoap_cache_stats_t *stats)
+{
+    *stats = _stats;
+}
+
+/** @} */
@@ -419,25 +419,133 @@ ssize_t coap_tree_handler(coap_pkt_t *pkt, uint8_t *resp_buf,
     }
     DEBUG("nanocoap: URI path: \"%s\"\n", uri);
 
-    for (unsigned i = 0; i < resources_numof; i++) {
-        const coap_resource_t *resource = &resources[i];
-        if (!(resource->methods & method_flag)) {
-            continue;
-        }
+    const coap_resource_t *resource;
+    if (coap_find_resource(resources, resources_numof, uri, method_flag,
+                           &resource) == 0) {
+        return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
+    }
+
+    return coap_build_reply(pkt, COAP_CODE_404, resp_buf, resp_buf_len, 0);
+}
+
+/**
+ * @brief   Resource arrays up to this size are searched linearly, as that is
+ *          faster than the binary search for them
+ */
+#define COAP_FIND_LINEAR_MAX    (32U)
+
+static int _find_linear(const coap_resource_t *resources,
+                        size_t resources_numof, const uint8_t *uri,
+                        coap_method_flags_t method_flag,
+                        const coap_resource_t **resource)
+{
+    int ret = -ENOENT;
+
+    for (size_t i = 0; i < resources_numof; i++) {
+        int res = coap_match_path(&resources[i], (uint8_t *)uri);
 
-        int res = coap_match_path(resource, uri);
         if (res > 0) {
             continue;
         }
         else if (res < 0) {
             break;
         }
+        if (resources[i].methods & method_flag) {
+            *resource = &resources[i];
+            return 0;
+        }
+        ret = -ENOTSUP;
+    }
+    return ret;
+}
+
+/* compares a resource path with the first len characters of uri */
+static int _path_cmp(const char *path, const uint8_t *uri, size_t len)
+{
+    int res = strncmp(path, (const char *)uri, len);
+
+    if (res == 0 && path[len] != '\0') {
+        /* uri is a proper prefix of path */
+        return 1;
+    }
+    return res;
+}
+
+/* number of resources in [0, hi) sorting before or equal to uri[0:len] */
+static size_t _upper_bound(const coap_resource_t *resources, size_t hi,
+                           const uint8_t *uri, size_t len)
+{
+    size_t lo = 0;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if (_path_cmp(resources[mid].path, uri, len) <= 0) {
+            lo = mid + 1;
+        }
         else {
-            return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
+            hi = mid;
         }
     }
+    return lo;
+}
 
-    return coap_build_reply(pkt, COAP_CODE_404, resp_buf, resp_buf_len, 0);
+int coap_find_resource(const coap_resource_t *resources,
+                       size_t resources_numof, const uint8_t *uri,
+                       coap_method_flags_t method_flag,
+                       const coap_resource_t **resource)
+{
+    if (resources_numof <= COAP_FIND_LINEAR_MAX) {
+        return _find_linear(resources, resources_numof, uri, method_flag,
+                            resource);
+    }
+
+    const coap_resource_t *found = NULL;
+    size_t uri_len = strlen((const char *)uri);
+    size_t len = uri_len;
+    size_t hi = resources_numof;
+    int res = -ENOENT;
+
+    /* All candidates are uri itself or prefixes of it and thus sort before
+     * uri. Walk them from the longest to the shortest: the last resource
+     * sorting before uri[0:len] either is such a prefix, or all shorter
+     * prefixes are prefixes of its path as well. Either way len shrinks with
+     * every step. */
+    while ((hi = _upper_bound(resources, hi, uri, len)) > 0) {
+        const char *path = resources[hi - 1].path;
+        size_t common = 0;
+
+        while ((common < len) && (path[common] == (char)uri[common])) {
+            common++;
+        }
+        if (path[common] != '\0') {
+            len = common;
+            hi--;
+            continue;
+        }
+        /* path equals uri[0:common], check all resources with that path */
+        while ((hi > 0) && (strcmp(resources[hi - 1].path, path) == 0)) {
+            const coap_resource_t *r = &resources[--hi];
+
+            if ((common < uri_len) && !(r->methods & COAP_MATCH_SUBTREE)) {
+                continue;
+            }
+            if (r->methods & method_flag) {
+                found = r;
+            }
+            res = -ENOTSUP;
+        }
+        if (common == 0) {
+            break;
+        }
+        len = common - 1;
+    }
+
+    if (found) {
+        *resource = found;
+        return 0;
+    }
+    return res;
 }
 
 ssize_t coap_reply_simple(coap_pkt_t *pkt,
@@ -16,36 +16,149 @@
  */
 
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
+#include "mutex.h"
 #include "net/dns.h"
+#include "net/dns/cache.h"
 #include "net/dns/msg.h"
 #include "net/sock/udp.h"
 #include "net/sock/dns.h"
+#include "timex.h"
+
+#if IS_USED(MODULE_SOCK_DNS_ASYNC)
+#include "event/thread.h"
+#include "net/sock/async/event.h"
+#include "ztimer.h"
+#endif
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
 
 /* min domain name length is 1, so minimum record length is 7 */
 #define DNS_MIN_REPLY_LEN   (unsigned)(sizeof(dns_hdr_t ) + 7)
 
+/* length of the largest address */
+#define DNS_ADDR_LEN_MAX    (16U)
+
+/* context of a synchronous query */
+typedef struct {
+    mutex_t done;
+    void *addr_out;
+    int res;
+} _sync_ctx_t;
+
 /* global DNS server UDP endpoint */
 sock_udp_ep_t sock_dns_server;
 
-int sock_dns_query(const char *domain_name, void *addr_out, int family)
-{
-    static uint8_t dns_buf[CONFIG_DNS_MSG_LEN];
+/* queries in flight, others for the same name wait for their result */
+static sock_dns_query_t *_inflight;
+static mutex_t _inflight_lock = MUTEX_INIT;
 
+static int _check(const char *domain_name)
+{
     if (sock_dns_server.port == 0) {
         return -ECONNREFUSED;
     }
-
     if (strlen(domain_name) > SOCK_DNS_MAX_NAME_LEN) {
         return -ENOSPC;
     }
+    return 0;
+}
+
+static void _query_init(sock_dns_query_t *query, const char *domain_name,
+                        int family, sock_dns_cb_t cb, void *arg)
+{
+    query->next = NULL;
+    query->followers = NULL;
+    query->domain_name = domain_name;
+    query->family = family;
+    query->cb = cb;
+    query->arg = arg;
+}
+
+/*
+ * Either makes query wait for the query in flight for the same name or adds
+ * it to the queries in flight. Returns true in the first case.
+ */
+static bool _join_or_add(sock_dns_query_t *query)
+{
+    for (sock_dns_query_t *q = _inflight; q != NULL; q = q->next) {
+        if ((q->family == query->family) &&
+            (strcmp(q->domain_name, query->domain_name) == 0)) {
+            DEBUG("sock_dns: waiting for query of %s\n", query->domain_name);
+            query->next = q->followers;
+            q->followers = query;
+            return true;
+        }
+    }
+    query->next = _inflight;
+    _inflight = query;
+    return false;
+}
+
+static void _complete(sock_dns_query_t *query, int res, const void *addr,
+                      uint32_t ttl)
+{
+    sock_dns_query_t *followers;
+
+    mutex_lock(&_inflight_lock);
+    for (sock_dns_query_t **q = &_inflight; *q != NULL; q = &(*q)->next) {
+        if (*q == query) {
+            *q = query->next;
+            break;
+        }
+    }
+    followers = query->followers;
+    mutex_unlock(&_inflight_lock);
+
+    if (IS_USED(MODULE_DNS_CACHE) && ((res > 0) || (res == -ENOENT))) {
+        dns_cache_add(query->domain_name, query->family, addr,
+                      (res > 0) ? res : 0, ttl);
+    }
+    if (res <= 0) {
+        addr = NULL;
+    }
+    /* queries may be reused by their callback, so read next first */
+    while (followers != NULL) {
+        sock_dns_query_t *next = followers->next;
+
+        followers->cb(res, addr, followers->arg);
+        followers = next;
+    }
+    query->cb(res, addr, query->arg);
+}
+
+static void _sync_cb(int res, const void *addr, void *arg)
+{
+    _sync_ctx_t *ctx = arg;
 
+    if (res > 0) {
+        memcpy(ctx->addr_out, addr, res);
+    }
+    ctx->res = res;
+    mutex_unlock(&ctx->done);
+}
+
+static int _parse_reply(const uint8_t *buf, ssize_t len, int family,
+                        void *addr_out, uint32_t *ttl)
+{
+    if (len <= (int)DNS_MIN_REPLY_LEN) {
+        return -EBADMSG;
+    }
+    return dns_msg_parse_reply(buf, len, family, addr_out, ttl);
+}
+
+static int _query(const char *domain_name, void *addr_out, int family,
+                  uint32_t *ttl)
+{
+    uint8_t dns_buf[CONFIG_DNS_MSG_LEN];
     sock_udp_t sock_dns;
 
     ssize_t res = sock_udp_create(&sock_dns, NULL, &sock_dns_server, 0);
     if (res) {
-        goto out;
+        return res;
     }
 
     uint16_t id = 0;
@@ -56,21 +169,149 @@ int sock_dns_query(const char *domain_name, void *addr_out, int family)
         if (res <= 0) {
             continue;
         }
-        res = sock_udp_recv(&sock_dns, dns_buf, sizeof(dns_buf), 1000000LU, NULL);
+        res = sock_udp_recv(&sock_dns, dns_buf, sizeof(dns_buf),
+                            SOCK_DNS_TIMEOUT_MS * US_PER_MS, NULL);
         if (res > 0) {
-            if (res > (int)DNS_MIN_REPLY_LEN) {
-                if ((res = dns_msg_parse_reply(dns_buf, res, family,
-                                               addr_out)) > 0) {
-                    goto out;
-                }
-            }
-            else {
-                res = -EBADMSG;
+            res = _parse_reply(dns_buf, res, family, addr_out, ttl);
+            if ((res > 0) || (res == -ENOENT)) {
+                break;
             }
         }
     }
 
-out:
     sock_udp_close(&sock_dns);
     return res;
 }
+
+int sock_dns_query(const char *domain_name, void *addr_out, int family)
+{
+    int res = _check(domain_name);
+
+    if (res < 0) {
+        return res;
+    }
+    if (IS_USED(MODULE_DNS_CACHE) &&
+        (res = dns_cache_query(domain_name, addr_out, family)) != 0) {
+        return res;
+    }
+
+    _sync_ctx_t ctx = { .done = MUTEX_INIT_LOCKED, .addr_out = addr_out };
+    sock_dns_query_t query;
+
+    _query_init(&query, domain_name, family, _sync_cb, &ctx);
+    mutex_lock(&_inflight_lock);
+    if (_join_or_add(&query)) {
+        mutex_unlock(&_inflight_lock);
+        mutex_lock(&ctx.done);
+        return ctx.res;
+    }
+    mutex_unlock(&_inflight_lock);
+
+    uint8_t addr[DNS_ADDR_LEN_MAX];
+    uint32_t ttl = 0;
+
+    res = _query(domain_name, addr, family, &ttl);
+    /* calls _sync_cb() for this query before returning */
+    _complete(&query, res, addr, ttl);
+    return ctx.res;
+}
+
+#if IS_USED(MODULE_SOCK_DNS_ASYNC)
+/* only used in the event thread */
+static uint8_t _async_buf[CONFIG_DNS_MSG_LEN];
+
+static void _async_finish(sock_dns_query_t *query, int res, const void *addr,
+                          uint32_t ttl)
+{
+    event_timeout_clear(&query->timeout);
+    event_cancel(EVENT_PRIO_MEDIUM, &query->timeout_ev.super);
+    event_cancel(EVENT_PRIO_MEDIUM,
+                 &sock_udp_get_async_ctx(&query->sock)->event.super);
+    sock_udp_close(&query->sock);
+    _complete(query, res, addr, ttl);
+}
+
+static void _on_timeout(void *arg)
+{
+    sock_dns_query_t *query = arg;
+
+    if (query->retries == 0) {
+        DEBUG("sock_dns: query of %s timed out\n", query->domain_name);
+        _async_finish(query, -ETIMEDOUT, NULL, 0);
+        return;
+    }
+    query->retries--;
+
+    size_t len = dns_msg_compose_query(_async_buf, query->domain_name, 0,
+                                       query->family);
+
+    /* the timeout also covers a failed send */
+    event_timeout_set(&query->timeout, SOCK_DNS_TIMEOUT_MS);
+    if (sock_udp_send(&query->sock, _async_buf, len, NULL) <= 0) {
+        DEBUG("sock_dns: sending query of %s failed\n", query->domain_name);
+    }
+}
+
+static void _on_recv(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+{
+    sock_dns_query_t *query = arg;
+    uint8_t addr[DNS_ADDR_LEN_MAX];
+    uint32_t ttl = 0;
+    ssize_t res;
+
+    if (!(flags & SOCK_ASYNC_MSG_RECV)) {
+        return;
+    }
+    res = sock_udp_recv(sock, _async_buf, sizeof(_async_buf), 0, NULL);
+    if (res <= 0) {
+        return;
+    }
+    res = _parse_reply(_async_buf, res, query->family, addr, &ttl);
+    if ((res > 0) || (res == -ENOENT)) {
+        _async_finish(query, res, addr, ttl);
+    }
+    /* else wait for another reply until the timeout */
+}
+
+int sock_dns_query_async(sock_dns_query_t *query, const char *domain_name,
+                         int family, sock_dns_cb_t cb, void *arg)
+{
+    int res = _check(domain_name);
+
+    if (res < 0) {
+        return res;
+    }
+    if (IS_USED(MODULE_DNS_CACHE)) {
+        uint8_t addr[DNS_ADDR_LEN_MAX];
+
+        res = dns_cache_query(domain_name, addr, family);
+        if (res != 0) {
+            cb(res, (res > 0) ? addr : NULL, arg);
+            return 0;
+        }
+    }
+
+    _query_init(query, domain_name, family, cb, arg);
+    mutex_lock(&_inflight_lock);
+    if (_join_or_add(query)) {
+        mutex_unlock(&_inflight_lock);
+        return 0;
+    }
+    res = sock_udp_create(&query->sock, NULL, &sock_dns_server, 0);
+    if (res < 0) {
+        _inflight = query->next;
+        mutex_unlock(&_inflight_lock);
+        return res;
+    }
+    mutex_unlock(&_inflight_lock);
+
+    query->retries = SOCK_DNS_RETRIES;
+    event_callback_init(&query->timeout_ev, _on_timeout, query);
+    event_timeout_ztimer_init(&query->timeout, ZTIMER_MSEC, EVENT_PRIO_MEDIUM,
+                              &query->timeout_ev.super);
+    sock_udp_event_init(&query->sock, EVENT_PRIO_MEDIUM, _on_recv, query);
+    /* the query is sent from the event thread */
+    event_post(EVENT_PRIO_MEDIUM, &query->timeout_ev.super);
+    return 0;
+}
+#endif
@@ -85,11 +85,10 @@ static inline int _snd_rcv_mbox(mbox_t *mbox, uint16_t type, gnrc_pktsnip_t *pkt
 int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
                          uint16_t cmd, gnrc_pktsnip_t *pkt)
 {
-    int numof = gnrc_netreg_num(type, demux_ctx);
+    gnrc_netreg_entry_t *sendto;
+    int numof = gnrc_netreg_lookup_all(type, demux_ctx, &sendto);
 
     if (numof != 0) {
-        gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
-
         gnrc_pktbuf_hold(pkt, numof - 1);
 
         while (sendto) {
@@ -18,6 +18,7 @@
 #include <assert.h>
 #include <string.h>
 
+#include "net/ethernet.h"
 #include "net/ethernet/hdr.h"
 #include "net/gnrc.h"
 #include "net/gnrc/netif/ethernet.h"
@@ -167,96 +168,163 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
     return res;
 }
 
-static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
+/* lets the driver write the header to hdr and the payload directly to its
+ * final location in the packet buffer, which is sized by the pending frame */
+static gnrc_pktsnip_t *_recv_loaned(gnrc_netif_t *netif, ethernet_hdr_t *hdr,
+                                    netdev_eth_rx_info_t *rx_info)
 {
     netdev_t *dev = netif->dev;
     gnrc_pktsnip_t *pkt = NULL;
-    netdev_eth_rx_info_t rx_info = { .flags = 0 };
     int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
 
-    if (bytes_expected > 0) {
-        pkt = gnrc_pktbuf_add(NULL, NULL,
-                              bytes_expected,
+    if (bytes_expected <= 0) {
+        return NULL;
+    }
+    if ((size_t)bytes_expected > sizeof(*hdr)) {
+        /* only take what the frame needs, not a full MTU */
+        pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected - sizeof(*hdr),
                               GNRC_NETTYPE_UNDEF);
+    }
+    if (!pkt) {
+        DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
+        /* drop the packet */
+        dev->driver->recv(dev, NULL, bytes_expected, NULL);
+        return NULL;
+    }
 
-        if (!pkt) {
-            DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
+    iolist_t payload = { .iol_base = pkt->data, .iol_len = pkt->size };
+    iolist_t iolist = { .iol_next = &payload, .iol_base = hdr,
+                        .iol_len = sizeof(*hdr) };
+    int nread = dev->driver->recv_iol(dev, &iolist, rx_info);
 
-            /* drop the packet */
-            dev->driver->recv(dev, NULL, bytes_expected, NULL);
+    if (nread < (int)sizeof(*hdr)) {
+        DEBUG("gnrc_netif_ethernet: read error.\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+#ifdef MODULE_NETSTATS_L2
+    netif->stats.rx_count++;
+    netif->stats.rx_bytes += nread;
+#endif
 
-            goto out;
-        }
+    if ((size_t)nread < (sizeof(*hdr) + pkt->size)) {
+        /* shrinks the data in place */
+        gnrc_pktbuf_realloc_data(pkt, nread - sizeof(*hdr));
+    }
+    return pkt;
+}
 
-        int nread = dev->driver->recv(dev, pkt->data, bytes_expected, &rx_info);
-        if (nread <= 0) {
-            DEBUG("gnrc_netif_ethernet: read error.\n");
-            goto safe_out;
-        }
+/* reads the whole frame into the packet buffer and moves the header out */
+static gnrc_pktsnip_t *_recv_copied(gnrc_netif_t *netif, ethernet_hdr_t *hdr,
+                                    netdev_eth_rx_info_t *rx_info)
+{
+    netdev_t *dev = netif->dev;
+    gnrc_pktsnip_t *pkt = NULL;
+    int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
+
+    if (bytes_expected <= 0) {
+        return NULL;
+    }
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected, GNRC_NETTYPE_UNDEF);
+    if (!pkt) {
+        DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
+
+        /* drop the packet */
+        dev->driver->recv(dev, NULL, bytes_expected, NULL);
+
+        return NULL;
+    }
+
+    int nread = dev->driver->recv(dev, pkt->data, bytes_expected, rx_info);
+    if (nread <= 0) {
+        DEBUG("gnrc_netif_ethernet: read error.\n");
+        goto safe_out;
+    }
 #ifdef MODULE_NETSTATS_L2
-        netif->stats.rx_count++;
-        netif->stats.rx_bytes += nread;
+    netif->stats.rx_count++;
+    netif->stats.rx_bytes += nread;
 #endif
 
-        if (nread < bytes_expected) {
-            /* we've got less than the expected packet size,
-             * so free the unused space.*/
+    if (nread < bytes_expected) {
+        /* we've got less than the expected packet size,
+         * so free the unused space.*/
 
-            DEBUG("gnrc_netif_ethernet: reallocating.\n");
-            gnrc_pktbuf_realloc_data(pkt, nread);
-        }
+        DEBUG("gnrc_netif_ethernet: reallocating.\n");
+        gnrc_pktbuf_realloc_data(pkt, nread);
+    }
+
+    /* mark ethernet header */
+    gnrc_pktsnip_t *eth_hdr = gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF);
+    if (!eth_hdr) {
+        DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
+        goto safe_out;
+    }
+
+    memcpy(hdr, eth_hdr->data, sizeof(*hdr));
+    gnrc_pktbuf_remove_snip(pkt, eth_hdr);
+    return pkt;
+
+safe_out:
+    gnrc_pktbuf_release(pkt);
+    return NULL;
+}
+
+static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
+{
+    netdev_t *dev = netif->dev;
+    gnrc_pktsnip_t *pkt;
+    ethernet_hdr_t hdr;
+    netdev_eth_rx_info_t rx_info = { .flags = 0 };
 
-        DEBUG("gnrc_netif_ethernet: received packet from %s of length %d\n",
-              gnrc_netif_addr_to_str(pkt->data, ETHERNET_ADDR_LEN, addr_str),
-              nread);
+    if (dev->driver->recv_iol) {
+        pkt = _recv_loaned(netif, &hdr, &rx_info);
+    }
+    else {
+        pkt = _recv_copied(netif, &hdr, &rx_info);
+    }
+    if (!pkt) {
+        return NULL;
+    }
+
+    DEBUG("gnrc_netif_ethernet: received packet from %s of length %u\n",
+          gnrc_netif_addr_to_str(hdr.src, ETHERNET_ADDR_LEN, addr_str),
+          (unsigned)(sizeof(hdr) + pkt->size));
 #if defined(MODULE_OD) && ENABLE_DEBUG
-        od_hex_dump(pkt->data, nread, OD_WIDTH_DEFAULT);
+    od_hex_dump(&hdr, sizeof(hdr), OD_WIDTH_DEFAULT);
+    od_hex_dump(pkt->data, pkt->size, OD_WIDTH_DEFAULT);
 #endif
-        /* mark ethernet header */
-        gnrc_pktsnip_t *eth_hdr = gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF);
-        if (!eth_hdr) {
-            DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
-            goto safe_out;
-        }
-
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)eth_hdr->data;
 
 #ifdef MODULE_L2FILTER
-        if (!l2filter_pass(dev->filter, hdr->src, ETHERNET_ADDR_LEN)) {
-            DEBUG("gnrc_netif_ethernet: incoming packet filtered by l2filter\n");
-            goto safe_out;
-        }
+    if (!l2filter_pass(dev->filter, hdr.src, ETHERNET_ADDR_LEN)) {
+        DEBUG("gnrc_netif_ethernet: incoming packet filtered by l2filter\n");
+        goto safe_out;
+    }
 #endif
 
-        /* set payload type from ethertype */
-        pkt->type = gnrc_nettype_from_ethertype(byteorder_ntohs(hdr->type));
+    /* set payload type from ethertype */
+    pkt->type = gnrc_nettype_from_ethertype(byteorder_ntohs(hdr.type));
 
-        /* create netif header */
-        gnrc_pktsnip_t *netif_hdr;
-        netif_hdr = gnrc_pktbuf_add(NULL, NULL,
-                                    sizeof(gnrc_netif_hdr_t) + (2 * ETHERNET_ADDR_LEN),
-                                    GNRC_NETTYPE_NETIF);
-
-        if (netif_hdr == NULL) {
-            DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
-            pkt = eth_hdr;
-            goto safe_out;
-        }
+    /* create netif header */
+    gnrc_pktsnip_t *netif_hdr;
+    netif_hdr = gnrc_pktbuf_add(NULL, NULL,
+                                sizeof(gnrc_netif_hdr_t) + (2 * ETHERNET_ADDR_LEN),
+                                GNRC_NETTYPE_NETIF);
 
-        gnrc_netif_hdr_init(netif_hdr->data, ETHERNET_ADDR_LEN, ETHERNET_ADDR_LEN);
-        gnrc_netif_hdr_set_src_addr(netif_hdr->data, hdr->src, ETHERNET_ADDR_LEN);
-        gnrc_netif_hdr_set_dst_addr(netif_hdr->data, hdr->dst, ETHERNET_ADDR_LEN);
-        gnrc_netif_hdr_set_netif(netif_hdr->data, netif);
-        if (rx_info.flags & NETDEV_ETH_RX_INFO_FLAG_TIMESTAMP) {
-            gnrc_netif_hdr_set_timestamp(netif_hdr->data, rx_info.timestamp);
-        }
+    if (netif_hdr == NULL) {
+        DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
+        goto safe_out;
+    }
 
-        gnrc_pktbuf_remove_snip(pkt, eth_hdr);
-        pkt = gnrc_pkt_append(pkt, netif_hdr);
+    gnrc_netif_hdr_init(netif_hdr->data, ETHERNET_ADDR_LEN, ETHERNET_ADDR_LEN);
+    gnrc_netif_hdr_set_src_addr(netif_hdr->data, hdr.src, ETHERNET_ADDR_LEN);
+    gnrc_netif_hdr_set_dst_addr(netif_hdr->data, hdr.dst, ETHERNET_ADDR_LEN);
+    gnrc_netif_hdr_set_netif(netif_hdr->data, netif);
+    if (rx_info.flags & NETDEV_ETH_RX_INFO_FLAG_TIMESTAMP) {
+        gnrc_netif_hdr_set_timestamp(netif_hdr->data, rx_info.timestamp);
     }
 
-out:
-    return pkt;
+    return gnrc_pkt_append(pkt, netif_hdr);
 
 safe_out:
     gnrc_pktbuf_release(pkt);
@@ -25,6 +25,9 @@
 #include "net/ethernet.h"
 #include "net/ipv6.h"
 #include "net/gnrc.h"
+#if IS_USED(MODULE_GNRC_IPV6_FLOWCACHE)
+#include "net/gnrc/ipv6/flowcache.h"
+#endif /* IS_USED(MODULE_GNRC_IPV6_FLOWCACHE) */
 #if IS_USED(MODULE_GNRC_IPV6_NIB)
 #include "net/gnrc/ipv6/nib.h"
 #include "net/gnrc/ipv6.h"
@@ -201,6 +204,14 @@ int gnrc_netif_get_from_netdev(gnrc_netif_t *netif, gnrc_netapi_opt_t *opt)
                     *((netstats_t **)opt->data) = &netif->stats;
                     res = sizeof(&netif->stats);
                     break;
+#endif
+#if IS_USED(MODULE_NETSTATS_PKTQ) && IS_USED(MODULE_GNRC_NETIF_PKTQ)
+                case NETSTATS_PKTQ:
+                    /* one per traffic class, see gnrc_netif_pktq_class_t */
+                    assert(opt->data_len == sizeof(netstats_queue_t *));
+                    *((netstats_queue_t **)opt->data) = netif->send_queue.stats;
+                    res = sizeof(netstats_queue_t *);
+                    break;
 #endif
                 default:
                     /* take from device */
@@ -614,6 +625,10 @@ int gnrc_netif_ipv6_addr_add_internal(gnrc_netif_t *netif,
 #endif /* CONFIG_GNRC_IPV6_NIB_ARSM */
     netif->ipv6.addrs_flags[idx] = flags;
     memcpy(&netif->ipv6.addrs[idx], addr, sizeof(netif->ipv6.addrs[idx]));
+#if IS_USED(MODULE_GNRC_IPV6_FLOWCACHE)
+    /* the address might have been forwarded to so far */
+    gnrc_ipv6_flowcache_flush();
+#endif /* IS_USED(MODULE_GNRC_IPV6_FLOWCACHE) */
 #ifdef MODULE_GNRC_IPV6_NIB
     if (_get_state(netif, idx) == GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID) {
         void *state = NULL;
@@ -677,6 +692,9 @@ void gnrc_netif_ipv6_addr_remove_internal(gnrc_netif_t *netif,
     if (remove_sol_nodes) {
         gnrc_netif_ipv6_group_leave_internal(netif, &sol_nodes);
     }
+#if IS_USED(MODULE_GNRC_IPV6_FLOWCACHE)
+    gnrc_ipv6_flowcache_flush();
+#endif /* IS_USED(MODULE_GNRC_IPV6_FLOWCACHE) */
     gnrc_netif_release(netif);
 }
 
@@ -1951,6 +1969,12 @@ static void *_gnrc_netif_thread(void *args)
 
 static void _pass_on_packet(gnrc_pktsnip_t *pkt)
 {
+#if IS_USED(MODULE_GNRC_IPV6_FLOWCACHE)
+    /* packets of known flows are forwarded right away */
+    if (gnrc_ipv6_flowcache_forward(pkt)) {
+        return;
+    }
+#endif /* IS_USED(MODULE_GNRC_IPV6_FLOWCACHE) */
     /* throw away packet if no one is interested */
     if (!gnrc_netapi_dispatch_receive(pkt->type, GNRC_NETREG_DEMUX_CTX_ALL,
                                       pkt)) {
@@ -90,28 +90,60 @@ static inline bool _already_received(gnrc_netif_t *netif,
 }
 #endif /* MODULE_GNRC_NETIF_DEDUP */
 
+/* reads the frame into the packet buffer, returns its length or a negative
+ * error */
+static int _read_frame(netdev_t *dev, gnrc_pktsnip_t **pkt,
+                       netdev_ieee802154_rx_info_t *rx_info)
+{
+    /* without recv_iol() the size of the frame is needed to allocate the
+     * buffer, with it the driver gets a buffer for any frame right away */
+    int bytes_expected = (dev->driver->recv_iol)
+                       ? (int)IEEE802154_FRAME_LEN_MAX
+                       : dev->driver->recv(dev, NULL, 0, NULL);
+    int nread;
+
+    if (bytes_expected < (int)IEEE802154_MIN_FRAME_LEN) {
+        if (bytes_expected > 0) {
+            DEBUG("_recv_ieee802154: received frame is too short\n");
+            dev->driver->recv(dev, NULL, bytes_expected, NULL);
+        }
+        return -EBADMSG;
+    }
+    *pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected, GNRC_NETTYPE_UNDEF);
+    if (*pkt == NULL) {
+        DEBUG("_recv_ieee802154: cannot allocate pktsnip.\n");
+        /* Discard packet on netdev device */
+        dev->driver->recv(dev, NULL, bytes_expected, NULL);
+        return -ENOBUFS;
+    }
+    if (dev->driver->recv_iol) {
+        iolist_t iolist = { .iol_base = (*pkt)->data, .iol_len = (*pkt)->size };
+
+        nread = dev->driver->recv_iol(dev, &iolist, rx_info);
+    }
+    else {
+        nread = dev->driver->recv(dev, (*pkt)->data, bytes_expected, rx_info);
+    }
+    if (nread < (int)IEEE802154_MIN_FRAME_LEN) {
+        gnrc_pktbuf_release(*pkt);
+        *pkt = NULL;
+        return (nread < 0) ? nread : -EBADMSG;
+    }
+    if (nread < bytes_expected) {
+        /* shrinks the data in place */
+        gnrc_pktbuf_realloc_data(*pkt, nread);
+    }
+    return nread;
+}
+
 static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
 {
     netdev_t *dev = netif->dev;
     netdev_ieee802154_rx_info_t rx_info;
     gnrc_pktsnip_t *pkt = NULL;
-    int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
-
-    if (bytes_expected >= (int)IEEE802154_MIN_FRAME_LEN) {
-        int nread;
+    int nread = _read_frame(dev, &pkt, &rx_info);
 
-        pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected, GNRC_NETTYPE_UNDEF);
-        if (pkt == NULL) {
-            DEBUG("_recv_ieee802154: cannot allocate pktsnip.\n");
-            /* Discard packet on netdev device */
-            dev->driver->recv(dev, NULL, bytes_expected, NULL);
-            return NULL;
-        }
-        nread = dev->driver->recv(dev, pkt->data, bytes_expected, &rx_info);
-        if (nread <= 0) {
-            gnrc_pktbuf_release(pkt);
-            return NULL;
-        }
+    if (nread > 0) {
 #ifdef MODULE_NETSTATS_L2
         netif->stats.rx_count++;
         netif->stats.rx_bytes += nread;
@@ -240,9 +272,6 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
 
         DEBUG("_recv_ieee802154: reallocating MAC payload for upper layer.\n");
         gnrc_pktbuf_realloc_data(pkt, nread);
-    } else if (bytes_expected > 0) {
-        DEBUG("_recv_ieee802154: received frame is too short\n");
-        dev->driver->recv(dev, NULL, bytes_expected, NULL);
     }
 
     return pkt;
@@ -14,54 +14,451 @@
  */
 
 #include <assert.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
 
+#include "irq.h"
+#include "kernel_defines.h"
+#include "net/gnrc/pktbuf.h"
 #include "net/gnrc/pktqueue.h"
 #include "net/gnrc/netif/conf.h"
 #include "net/gnrc/netif/internal.h"
 #include "net/gnrc/netif/pktq.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "xtimer.h"
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
-static gnrc_pktqueue_t _pool[CONFIG_GNRC_NETIF_PKTQ_POOL_SIZE];
+/* DSCPs, see RFC 4594 and RFC 8622 */
+#define DSCP_LE             (0x01)
+#define DSCP_CS1            (0x08)
+#define DSCP_CS5            (0x28)
 
-static gnrc_pktqueue_t *_get_free_entry(void)
+/* 6LoWPAN IPHC traffic class and flow label encodings, see RFC 6282 */
+#define IPHC_TF_ECN_DSCP_FL (0x00)
+#define IPHC_TF_ECN_FL      (0x08)
+#define IPHC_TF_ECN_DSCP    (0x10)
+
+typedef struct {
+    gnrc_pktqueue_t entry;  /**< queue entry, must be the first member */
+    uint32_t enqueued;      /**< time the packet was queued in µs */
+} _entry_t;
+
+static _entry_t _pool[CONFIG_GNRC_NETIF_PKTQ_POOL_SIZE];
+/* entries given back to the pool, linked by gnrc_pktqueue_t::next */
+static gnrc_pktqueue_t *_free;
+/* entries from here on were never used */
+static unsigned _unused;
+static unsigned _usage;
+
+static _entry_t *_alloc(void)
 {
-    for (unsigned i = 0; i < CONFIG_GNRC_NETIF_PKTQ_POOL_SIZE; i++) {
-        if (_pool[i].pkt == NULL) {
-            return &_pool[i];
-        }
+    _entry_t *entry = NULL;
+    /* the pool is shared by all interfaces */
+    unsigned state = irq_disable();
+
+    if (_free != NULL) {
+        entry = container_of(_free, _entry_t, entry);
+        _free = _free->next;
+    }
+    else if (_unused < CONFIG_GNRC_NETIF_PKTQ_POOL_SIZE) {
+        entry = &_pool[_unused++];
+    }
+    if (entry != NULL) {
+        _usage++;
     }
+    irq_restore(state);
+    return entry;
+}
+
+static void _free_entry(_entry_t *entry)
+{
+    unsigned state = irq_disable();
+
+    entry->entry.pkt = NULL;
+    entry->entry.next = _free;
+    _free = &entry->entry;
+    _usage--;
+    irq_restore(state);
+}
+
+static inline uint32_t _now(void)
+{
+    return xtimer_now_usec();
+}
+
+static inline bool _time_reached(uint32_t now, uint32_t time)
+{
+    return (int32_t)(now - time) >= 0;
+}
+
+static inline netstats_queue_t *_stats(gnrc_netif_t *netif, unsigned cls)
+{
+#if IS_USED(MODULE_NETSTATS_PKTQ)
+    return &netif->send_queue.stats[cls];
+#else
+    (void)netif;
+    (void)cls;
     return NULL;
+#endif
 }
 
-unsigned gnrc_netif_pktq_usage(void)
+static void _stats_add(gnrc_netif_t *netif, unsigned cls, bool requeued)
 {
-    unsigned res = 0;
+    netstats_queue_t *stats = _stats(netif, cls);
 
-    for (unsigned i = 0; i < CONFIG_GNRC_NETIF_PKTQ_POOL_SIZE; i++) {
-        if (_pool[i].pkt != NULL) {
-            res++;
+    if (stats == NULL) {
+        return;
+    }
+    if (!requeued) {
+        stats->enqueued++;
+    }
+    if (++stats->depth > stats->depth_max) {
+        stats->depth_max = stats->depth;
+    }
+}
+
+static void _stats_remove(gnrc_netif_t *netif, unsigned cls, uint32_t sojourn)
+{
+    netstats_queue_t *stats = _stats(netif, cls);
+
+    if (stats == NULL) {
+        return;
+    }
+    stats->depth--;
+    /* exponentially weighted moving average with alpha = 1/8 */
+    stats->sojourn_avg = stats->sojourn_avg - (stats->sojourn_avg / 8) +
+                         (sojourn / 8);
+    if (sojourn > stats->sojourn_max) {
+        stats->sojourn_max = sojourn;
+    }
+}
+
+static gnrc_netif_pktq_class_t _class_from_dscp(uint8_t dscp)
+{
+    if (dscp >= DSCP_CS5) {
+        return GNRC_NETIF_PKTQ_CLASS_CTRL;
+    }
+    if ((dscp == DSCP_CS1) || (dscp == DSCP_LE)) {
+        return GNRC_NETIF_PKTQ_CLASS_BULK;
+    }
+    return GNRC_NETIF_PKTQ_CLASS_DEFAULT;
+}
+
+/* IPv6 header in a packet, may not be aligned */
+static gnrc_netif_pktq_class_t _classify_ipv6(const uint8_t *hdr, size_t size)
+{
+    if ((size < sizeof(ipv6_hdr_t)) || ((hdr[0] >> 4) != 6)) {
+        return GNRC_NETIF_PKTQ_CLASS_DEFAULT;
+    }
+    if (hdr[offsetof(ipv6_hdr_t, nh)] == PROTNUM_ICMPV6) {
+        return GNRC_NETIF_PKTQ_CLASS_CTRL;
+    }
+    /* version (4 bit), DSCP (6 bit), ECN (2 bit), ... */
+    return _class_from_dscp(((hdr[0] & 0x0f) << 2) | (hdr[1] >> 6));
+}
+
+static gnrc_netif_pktq_class_t _classify_iphc(const uint8_t *iphc, size_t size)
+{
+    size_t pos = SIXLOWPAN_IPHC_HDR_LEN;
+    uint8_t dscp = 0;
+
+    if (size < SIXLOWPAN_IPHC_HDR_LEN) {
+        return GNRC_NETIF_PKTQ_CLASS_DEFAULT;
+    }
+    if (iphc[1] & SIXLOWPAN_IPHC2_CID_EXT) {
+        pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
+    }
+    switch (iphc[0] & SIXLOWPAN_IPHC1_TF) {
+        case IPHC_TF_ECN_DSCP_FL:
+        case IPHC_TF_ECN_DSCP:
+            /* ECN (2 bit), DSCP (6 bit), [flow label (3 byte)] */
+            if (pos < size) {
+                dscp = iphc[pos] & 0x3f;
+            }
+            pos += ((iphc[0] & SIXLOWPAN_IPHC1_TF) == IPHC_TF_ECN_DSCP) ? 1 : 4;
+            break;
+        case IPHC_TF_ECN_FL:
+            /* DSCP is elided */
+            pos += 3;
+            break;
+        default:
+            break;
+    }
+    /* ICMPv6 is never compressed with NHC, so its next header is inline */
+    if (!(iphc[0] & SIXLOWPAN_IPHC1_NH) && (pos < size) &&
+        (iphc[pos] == PROTNUM_ICMPV6)) {
+        return GNRC_NETIF_PKTQ_CLASS_CTRL;
+    }
+    return _class_from_dscp(dscp);
+}
+
+gnrc_netif_pktq_class_t gnrc_netif_pktq_classify(const gnrc_pktsnip_t *pkt)
+{
+    assert(pkt != NULL);
+
+    if (pkt->type == GNRC_NETTYPE_NETIF) {
+        pkt = pkt->next;
+    }
+    if ((pkt == NULL) || (pkt->size == 0)) {
+        return GNRC_NETIF_PKTQ_CLASS_DEFAULT;
+    }
+#if IS_USED(MODULE_GNRC_NETTYPE_IPV6)
+    if (pkt->type == GNRC_NETTYPE_IPV6) {
+        return _classify_ipv6(pkt->data, pkt->size);
+    }
+#endif
+#if IS_USED(MODULE_GNRC_NETTYPE_SIXLOWPAN)
+    if (pkt->type == GNRC_NETTYPE_SIXLOWPAN) {
+        uint8_t *data = pkt->data;
+
+        if (data[0] == SIXLOWPAN_UNCOMP) {
+            return _classify_ipv6(data + 1, pkt->size - 1);
         }
+        if (sixlowpan_iphc_is(data)) {
+            return _classify_iphc(data, pkt->size);
+        }
+        /* fragments all stay in the default class so they are not reordered,
+         * the compressed header is only in the first one */
     }
-    return res;
+#endif
+    return GNRC_NETIF_PKTQ_CLASS_DEFAULT;
 }
 
-int gnrc_netif_pktq_put(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+/* drop the last packet of the lowest priority class below cls and hand out
+ * its entry */
+static _entry_t *_evict(gnrc_netif_t *netif, unsigned cls)
+{
+    for (unsigned i = GNRC_NETIF_PKTQ_CLASS_NUMOF - 1; i > cls; i--) {
+        gnrc_pktqueue_t *tail = netif->send_queue.queue[i];
+        netstats_queue_t *stats;
+
+        if (tail == NULL) {
+            continue;
+        }
+        while (tail->next != NULL) {
+            tail = tail->next;
+        }
+        gnrc_pktqueue_remove(&netif->send_queue.queue[i], tail);
+        DEBUG("gnrc_netif_pktq: evicting pkt %p of class %u\n",
+              (void *)tail->pkt, i);
+        gnrc_pktbuf_release_error(tail->pkt, ENOBUFS);
+        if ((stats = _stats(netif, i)) != NULL) {
+            stats->depth--;
+            stats->evicted++;
+        }
+        return container_of(tail, _entry_t, entry);
+    }
+    return NULL;
+}
+
+static int _put(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt, bool head)
 {
     assert(netif != NULL);
     assert(pkt != NULL);
 
-    gnrc_pktqueue_t *entry = _get_free_entry();
+    unsigned cls = gnrc_netif_pktq_classify(pkt);
+    _entry_t *entry = _alloc();
 
     if (entry == NULL) {
+        entry = _evict(netif, cls);
+    }
+    if (entry == NULL) {
+        netstats_queue_t *stats = _stats(netif, cls);
+
+        if (stats != NULL) {
+            stats->overflows++;
+        }
         return -1;
     }
-    entry->pkt = pkt;
-    gnrc_pktqueue_add(&netif->send_queue.queue, entry);
+    entry->entry.pkt = pkt;
+    if (head && (pkt == netif->send_queue.last)) {
+        entry->enqueued = netif->send_queue.last_enqueued;
+    }
+    else {
+        entry->enqueued = _now();
+    }
+    if (head) {
+        LL_PREPEND(netif->send_queue.queue[cls], &entry->entry);
+    }
+    else {
+        gnrc_pktqueue_add(&netif->send_queue.queue[cls], &entry->entry);
+    }
+    _stats_add(netif, cls, head);
     return 0;
 }
 
+unsigned gnrc_netif_pktq_usage(void)
+{
+    return _usage;
+}
+
+int gnrc_netif_pktq_put(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    return _put(netif, pkt, false);
+}
+
+static inline bool _aqm(unsigned cls)
+{
+    return (CONFIG_GNRC_NETIF_PKTQ_CODEL_TARGET_US > 0) &&
+           (cls != GNRC_NETIF_PKTQ_CLASS_CTRL);
+}
+
+static uint32_t _isqrt(uint32_t x)
+{
+    uint32_t res = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        }
+        else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+static inline uint32_t _control_law(uint32_t t, uint16_t count)
+{
+    return t + CONFIG_GNRC_NETIF_PKTQ_CODEL_INTERVAL_US / _isqrt(count);
+}
+
+static _entry_t *_dequeue(gnrc_netif_t *netif, unsigned cls, uint32_t now,
+                          bool *ok_to_drop)
+{
+    gnrc_netif_pktq_codel_t *codel = &netif->send_queue.codel[cls];
+    gnrc_pktqueue_t *head = gnrc_pktqueue_remove_head(
+        &netif->send_queue.queue[cls]
+    );
+
+    *ok_to_drop = false;
+    if (head == NULL) {
+        codel->first_above_time = 0;
+        return NULL;
+    }
+
+    _entry_t *entry = container_of(head, _entry_t, entry);
+    uint32_t sojourn = now - entry->enqueued;
+
+    _stats_remove(netif, cls, sojourn);
+    if (!_aqm(cls)) {
+        return entry;
+    }
+    /* no standing queue if this packet was the only one */
+    if ((sojourn < CONFIG_GNRC_NETIF_PKTQ_CODEL_TARGET_US) ||
+        (netif->send_queue.queue[cls] == NULL)) {
+        codel->first_above_time = 0;
+    }
+    else if (codel->first_above_time == 0) {
+        /* 0 marks "below target" */
+        codel->first_above_time = (now + CONFIG_GNRC_NETIF_PKTQ_CODEL_INTERVAL_US) | 1;
+    }
+    else if (_time_reached(now, codel->first_above_time)) {
+        *ok_to_drop = true;
+    }
+    return entry;
+}
+
+static void _drop(gnrc_netif_t *netif, unsigned cls, _entry_t *entry)
+{
+    netstats_queue_t *stats = _stats(netif, cls);
+
+    DEBUG("gnrc_netif_pktq: dropping pkt %p of class %u\n",
+          (void *)entry->entry.pkt, cls);
+    gnrc_pktbuf_release_error(entry->entry.pkt, ENOBUFS);
+    _free_entry(entry);
+    if (stats != NULL) {
+        stats->aqm_drops++;
+    }
+}
+
+/* CoDel dequeue, see RFC 8289, section 5.5 */
+static gnrc_pktsnip_t *_get(gnrc_netif_t *netif, unsigned cls)
+{
+    gnrc_netif_pktq_codel_t *codel = &netif->send_queue.codel[cls];
+    uint32_t now = _now();
+    bool ok_to_drop;
+    _entry_t *entry = _dequeue(netif, cls, now, &ok_to_drop);
+
+    if (codel->dropping) {
+        if (!ok_to_drop) {
+            codel->dropping = false;
+        }
+        while (codel->dropping && _time_reached(now, codel->drop_next)) {
+            _drop(netif, cls, entry);
+            /* saturate, a wrapped count of 0 would divide by zero in
+             * _control_law() */
+            if (codel->count < UINT16_MAX) {
+                codel->count++;
+            }
+            entry = _dequeue(netif, cls, now, &ok_to_drop);
+            if (!ok_to_drop) {
+                codel->dropping = false;
+            }
+            else {
+                codel->drop_next = _control_law(codel->drop_next, codel->count);
+            }
+        }
+    }
+    else if (ok_to_drop) {
+        uint16_t delta = codel->count - codel->lastcount;
+
+        _drop(netif, cls, entry);
+        entry = _dequeue(netif, cls, now, &ok_to_drop);
+        codel->dropping = true;
+        /* start with the drop rate of the last dropping state if it was
+         * left only recently */
+        if ((delta > 1) && ((now - codel->drop_next) <
+                            16 * CONFIG_GNRC_NETIF_PKTQ_CODEL_INTERVAL_US)) {
+            codel->count = delta;
+        }
+        else {
+            codel->count = 1;
+        }
+        codel->drop_next = _control_law(now, codel->count);
+        codel->lastcount = codel->count;
+    }
+    if (entry == NULL) {
+        return NULL;
+    }
+
+    gnrc_pktsnip_t *pkt = entry->entry.pkt;
+
+    /* in case the packet is pushed back */
+    netif->send_queue.last = pkt;
+    netif->send_queue.last_enqueued = entry->enqueued;
+    _free_entry(entry);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_netif_pktq_get(gnrc_netif_t *netif)
+{
+    assert(netif != NULL);
+
+    for (unsigned cls = 0; cls < GNRC_NETIF_PKTQ_CLASS_NUMOF; cls++) {
+        if (netif->send_queue.queue[cls] != NULL) {
+            gnrc_pktsnip_t *pkt = _get(netif, cls);
+
+            /* a class may have been emptied by dropping */
+            if (pkt != NULL) {
+                return pkt;
+            }
+        }
+    }
+    return NULL;
+}
+
 void gnrc_netif_pktq_sched_get(gnrc_netif_t *netif)
 {
 #if CONFIG_GNRC_NETIF_PKTQ_TIMER_US > 0
@@ -91,17 +488,7 @@ void gnrc_netif_pktq_sched_get(gnrc_netif_t *netif)
 
 int gnrc_netif_pktq_push_back(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 {
-    assert(netif != NULL);
-    assert(pkt != NULL);
-
-    gnrc_pktqueue_t *entry = _get_free_entry();
-
-    if (entry == NULL) {
-        return -1;
-    }
-    entry->pkt = pkt;
-    LL_PREPEND(netif->send_queue.queue, entry);
-    return 0;
+    return _put(netif, pkt, true);
 }
 
 /** @} */
@@ -30,13 +30,31 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
-/* The registry as lookup table by gnrc_nettype_t */
-static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+#define _BUCKETS_NUMOF      (CONFIG_GNRC_NETREG_BUCKETS_NUMOF)
+#define _BUCKET_ALL         (_BUCKETS_NUMOF)
+
+static_assert((_BUCKETS_NUMOF > 0) && ((_BUCKETS_NUMOF & (_BUCKETS_NUMOF - 1)) == 0),
+              "CONFIG_GNRC_NETREG_BUCKETS_NUMOF must be a power of 2");
+
+/* The registry as lookup table by gnrc_nettype_t and hash of demux context,
+ * with an additional bucket for GNRC_NETREG_DEMUX_CTX_ALL. Entries with the
+ * same demux context are kept next to each other in their bucket. */
+static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF][_BUCKETS_NUMOF + 1];
+
+static inline unsigned _bucket(uint32_t demux_ctx)
+{
+    if (demux_ctx == GNRC_NETREG_DEMUX_CTX_ALL) {
+        return _BUCKET_ALL;
+    }
+    /* demux contexts are mostly small numbers like ports, so use Fibonacci
+     * hashing to spread consecutive values */
+    return ((demux_ctx * 2654435769U) >> 16) & (_BUCKETS_NUMOF - 1);
+}
 
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -61,7 +79,14 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    gnrc_netreg_entry_t **ptr = &netreg[type][_bucket(entry->demux_ctx)];
+
+    /* prepend to the entries with the same demux context */
+    while ((*ptr != NULL) && ((*ptr)->demux_ctx != entry->demux_ctx)) {
+        ptr = &(*ptr)->next;
+    }
+    entry->next = *ptr;
+    *ptr = entry;
 
     return 0;
 }
@@ -72,54 +97,48 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    LL_DELETE(netreg[type][_bucket(entry->demux_ctx)], entry);
 }
 
-/**
- * @brief   Searches the next entry in the registry that matches given
- *          parameters, start lookup from beginning or given entry.
- *
- * @param[in] from      A registry entry to lookup from or NULL to start fresh
- * @param[in] type      Type of the protocol.
- * @param[in] demux_ctx The demultiplexing context for the registered thread.
- *                      See gnrc_netreg_entry_t::demux_ctx.
- *
- * @return  The first entry fitting the given parameters on success
- * @return  NULL if no entry can be found.
- */
-static gnrc_netreg_entry_t *_netreg_lookup(gnrc_netreg_entry_t *from,
-                                           gnrc_nettype_t type,
-                                           uint32_t demux_ctx)
+gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
 {
     gnrc_netreg_entry_t *res = NULL;
 
-    if (from || !_INVALID_TYPE(type)) {
-        gnrc_netreg_entry_t *head = (from) ? from->next : netreg[type];
-        LL_SEARCH_SCALAR(head, res, demux_ctx, demux_ctx);
+    if (!_INVALID_TYPE(type)) {
+        LL_SEARCH_SCALAR(netreg[type][_bucket(demux_ctx)], res, demux_ctx, demux_ctx);
     }
 
     return res;
 }
 
-gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
-{
-    return _netreg_lookup(NULL, type, demux_ctx);
-}
-
-int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
+int gnrc_netreg_lookup_all(gnrc_nettype_t type, uint32_t demux_ctx,
+                           gnrc_netreg_entry_t **first)
 {
     int num = 0;
-    gnrc_netreg_entry_t *entry = NULL;
 
-    while((entry = _netreg_lookup(entry, type, demux_ctx)) != NULL) {
+    *first = gnrc_netreg_lookup(type, demux_ctx);
+    for (gnrc_netreg_entry_t *entry = *first; entry != NULL;
+         entry = gnrc_netreg_getnext(entry)) {
         num++;
     }
     return num;
 }
 
+int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    gnrc_netreg_entry_t *first;
+
+    return gnrc_netreg_lookup_all(type, demux_ctx, &first);
+}
+
 gnrc_netreg_entry_t *gnrc_netreg_getnext(gnrc_netreg_entry_t *entry)
 {
-    return (entry ? _netreg_lookup(entry, 0, entry->demux_ctx) : NULL);
+    /* entries with the same demux context are adjacent */
+    if ((entry == NULL) || (entry->next == NULL) ||
+        (entry->next->demux_ctx != entry->demux_ctx)) {
+        return NULL;
+    }
+    return entry->next;
 }
 
 int gnrc_netreg_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
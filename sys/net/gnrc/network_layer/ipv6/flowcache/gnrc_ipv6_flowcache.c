@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <string.h>
+
+#include "evtimer.h"
+#include "mutex.h"
+#include "net/gnrc/ipv6/blacklist.h"
+#include "net/gnrc/ipv6/flowcache.h"
+#include "net/gnrc/ipv6/whitelist.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/protnum.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#if (CONFIG_GNRC_IPV6_FLOWCACHE_SIZE & (CONFIG_GNRC_IPV6_FLOWCACHE_SIZE - 1))
+#error "CONFIG_GNRC_IPV6_FLOWCACHE_SIZE must be a power of 2"
+#endif
+
+typedef struct {
+    ipv6_addr_t src;
+    ipv6_addr_t dst;
+    uint32_t fl;                /**< flow label */
+    uint32_t valid_until;       /**< in ms, entry is unused if iface == 0 */
+    kernel_pid_t iface;
+    uint8_t l2addr_len;
+    uint8_t l2addr[CONFIG_GNRC_IPV6_NIB_L2ADDR_MAX_LEN];
+} _flow_t;
+
+static _flow_t _flows[CONFIG_GNRC_IPV6_FLOWCACHE_SIZE];
+static gnrc_ipv6_flowcache_stats_t _stats;
+static mutex_t _lock = MUTEX_INIT;
+
+static _flow_t *_flow(const ipv6_hdr_t *hdr)
+{
+    uint32_t hash = ipv6_hdr_get_fl(hdr);
+
+    for (unsigned i = 0; i < ARRAY_SIZE(hdr->src.u32); i++) {
+        hash ^= hdr->src.u32[i].u32 ^ hdr->dst.u32[i].u32;
+    }
+    /* Fibonacci hashing: the upper bits are mixed best */
+    hash *= 0x9e3779b1;
+    return &_flows[(hash >> 16) & (CONFIG_GNRC_IPV6_FLOWCACHE_SIZE - 1)];
+}
+
+static bool _flow_matches(const _flow_t *flow, const ipv6_hdr_t *hdr)
+{
+    return (flow->iface != KERNEL_PID_UNDEF) &&
+           ((int32_t)(flow->valid_until - evtimer_now_msec()) > 0) &&
+           (flow->fl == ipv6_hdr_get_fl(hdr)) &&
+           ipv6_addr_equal(&flow->dst, &hdr->dst) &&
+           ipv6_addr_equal(&flow->src, &hdr->src);
+}
+
+static bool _lookup(const ipv6_hdr_t *hdr, _flow_t *res)
+{
+    _flow_t *flow = _flow(hdr);
+    bool found;
+
+    mutex_lock(&_lock);
+    found = _flow_matches(flow, hdr);
+    if (found) {
+        *res = *flow;
+        _stats.hits++;
+    }
+    else {
+        _stats.misses++;
+    }
+    mutex_unlock(&_lock);
+    return found;
+}
+
+void gnrc_ipv6_flowcache_add(const ipv6_hdr_t *hdr, const gnrc_netif_t *netif,
+                             const gnrc_ipv6_nib_nc_t *nce)
+{
+    _flow_t *flow = _flow(hdr);
+
+    switch (gnrc_ipv6_nib_nc_get_nud_state(nce)) {
+    case GNRC_IPV6_NIB_NC_INFO_NUD_STATE_UNMANAGED:
+    case GNRC_IPV6_NIB_NC_INFO_NUD_STATE_REACHABLE:
+        break;
+    default:
+        /* keep sending to the IPv6 thread so NUD sees the traffic */
+        return;
+    }
+    mutex_lock(&_lock);
+    flow->src = hdr->src;
+    flow->dst = hdr->dst;
+    flow->fl = ipv6_hdr_get_fl(hdr);
+    flow->valid_until = evtimer_now_msec() +
+                        CONFIG_GNRC_IPV6_FLOWCACHE_LIFETIME_MS;
+    flow->iface = netif->pid;
+    flow->l2addr_len = nce->l2addr_len;
+    memcpy(flow->l2addr, nce->l2addr, nce->l2addr_len);
+    mutex_unlock(&_lock);
+}
+
+static bool _fast_path_applies(gnrc_pktsnip_t *pkt)
+{
+    const ipv6_hdr_t *hdr = pkt->data;
+
+    if ((pkt->type != GNRC_NETTYPE_IPV6) || (pkt->next == NULL) ||
+        (pkt->next->type != GNRC_NETTYPE_NETIF) || (pkt->next->next != NULL) ||
+        (pkt->size <= sizeof(ipv6_hdr_t)) || !ipv6_hdr_is(hdr)) {
+        return false;
+    }
+    /* padding, hop-by-hop options and expiring hop limits are all left to the
+     * IPv6 thread */
+    if ((byteorder_ntohs(hdr->len) != (pkt->size - sizeof(ipv6_hdr_t))) ||
+        (hdr->nh == PROTNUM_IPV6_EXT_HOPOPT) || (hdr->hl <= 1)) {
+        return false;
+    }
+#ifdef MODULE_GNRC_IPV6_WHITELIST
+    if (!gnrc_ipv6_whitelisted(&hdr->src)) {
+        return false;
+    }
+#endif
+#ifdef MODULE_GNRC_IPV6_BLACKLIST
+    if (gnrc_ipv6_blacklisted(&hdr->src)) {
+        return false;
+    }
+#endif
+    return true;
+}
+
+bool gnrc_ipv6_flowcache_forward(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *ipv6, *netif_hdr, *tmp;
+    gnrc_netif_t *netif;
+    _flow_t flow;
+
+    if (!_fast_path_applies(pkt) || !_lookup(pkt->data, &flow)) {
+        return false;
+    }
+    netif = gnrc_netif_get_by_pid(flow.iface);
+    if ((netif == NULL) || (pkt->size > netif->ipv6.mtu)) {
+        return false;
+    }
+#ifdef MODULE_NETSTATS_IPV6
+    {
+        gnrc_netif_t *in = gnrc_netif_hdr_get_netif(pkt->next->data);
+
+        if (in != NULL) {
+            in->ipv6.stats.rx_count++;
+            in->ipv6.stats.rx_bytes += pkt->size;
+        }
+    }
+#endif
+    /* from here on the packet is ours, whatever happens */
+    if ((tmp = gnrc_pktbuf_start_write(pkt)) == NULL) {
+        DEBUG("ipv6 flowcache: unable to get write access to packet\n");
+        gnrc_pktbuf_release(pkt);
+        return true;
+    }
+    pkt = tmp;
+    if ((ipv6 = gnrc_pktbuf_mark(pkt, sizeof(ipv6_hdr_t),
+                                 GNRC_NETTYPE_IPV6)) == NULL) {
+        DEBUG("ipv6 flowcache: unable to mark IPv6 header\n");
+        gnrc_pktbuf_release(pkt);
+        return true;
+    }
+    pkt->type = GNRC_NETTYPE_UNDEF;
+    ((ipv6_hdr_t *)ipv6->data)->hl--;
+    gnrc_pktbuf_remove_snip(pkt, ipv6->next);
+    if ((pkt = gnrc_pktbuf_reverse_snips(pkt)) == NULL) {
+        DEBUG("ipv6 flowcache: unable to reverse packet\n");
+        return true;
+    }
+    netif_hdr = gnrc_netif_hdr_build(NULL, 0, flow.l2addr, flow.l2addr_len);
+    if (netif_hdr == NULL) {
+        DEBUG("ipv6 flowcache: unable to allocate interface header\n");
+        gnrc_pktbuf_release(pkt);
+        return true;
+    }
+    gnrc_netif_hdr_set_netif(netif_hdr->data, netif);
+    pkt = gnrc_pkt_prepend(pkt, netif_hdr);
+#ifdef MODULE_NETSTATS_IPV6
+    netif->ipv6.stats.tx_unicast_count++;
+    netif->ipv6.stats.tx_success++;
+    netif->ipv6.stats.tx_bytes += gnrc_pkt_len(pkt->next);
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN
+    if (gnrc_netif_is_6lo(netif)) {
+        if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_SIXLOWPAN,
+                                       GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
+            DEBUG("ipv6 flowcache: no 6LoWPAN thread found\n");
+            gnrc_pktbuf_release(pkt);
+        }
+        return true;
+    }
+#endif
+    if (gnrc_netif_send(netif, pkt) < 1) {
+        DEBUG("ipv6 flowcache: unable to send packet\n");
+        gnrc_pktbuf_release(pkt);
+    }
+    return true;
+}
+
+void gnrc_ipv6_flowcache_flush(void)
+{
+    mutex_lock(&_lock);
+    for (unsigned i = 0; i < ARRAY_SIZE(_flows); i++) {
+        _flows[i].iface = KERNEL_PID_UNDEF;
+    }
+    _stats.flushes++;
+    mutex_unlock(&_lock);
+}
+
+void gnrc_ipv6_flowcache_get_stats(gnrc_ipv6_flowcache_stats_t *stats)
+{
+    mutex_lock(&_lock);
+    *stats = _stats;
+    mutex_unlock(&_lock);
+}
+
+/** @} */
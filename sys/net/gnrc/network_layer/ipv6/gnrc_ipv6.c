@@ -28,6 +28,7 @@
 #include "thread.h"
 #include "utlist.h"
 
+#include "net/gnrc/ipv6/flowcache.h"
 #include "net/gnrc/ipv6/nib.h"
 #include "net/gnrc/netif/internal.h"
 #include "net/gnrc/ipv6/whitelist.h"
@@ -508,6 +509,10 @@ static void _send_unicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
         }
         DEBUG("ipv6: send unicast over interface %" PRIkernel_pid "\n",
               netif->pid);
+        if (!prep_hdr) {
+            /* forward further packets of this flow without the IPv6 thread */
+            gnrc_ipv6_flowcache_add(ipv6_hdr, netif, &nce);
+        }
         /* and send to interface */
 #ifdef MODULE_NETSTATS_IPV6
         netif->ipv6.stats.tx_unicast_count++;
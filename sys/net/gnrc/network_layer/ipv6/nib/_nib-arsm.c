@@ -18,6 +18,7 @@
 
 #include "evtimer.h"
 #include "net/gnrc/ndp.h"
+#include "net/gnrc/ipv6/flowcache.h"
 #include "net/gnrc/ipv6/nib.h"
 #include "net/gnrc/netif/internal.h"
 #ifdef MODULE_GNRC_SIXLOWPAN_ND
@@ -443,6 +444,7 @@ void _set_nud_state(gnrc_netif_t *netif, _nib_onl_entry_t *nce,
 {
     nce->info &= ~GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK;
     nce->info |= state;
+    gnrc_ipv6_flowcache_flush();
 
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ROUTER)
     gnrc_netif_acquire(netif);
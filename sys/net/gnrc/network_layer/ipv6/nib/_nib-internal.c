@@ -21,6 +21,7 @@
 
 #include "net/gnrc/icmpv6/error.h"
 #include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/flowcache.h"
 #include "net/gnrc/ipv6/nib/conf.h"
 #include "net/gnrc/ipv6/nib/nc.h"
 #include "net/gnrc/ipv6/nib.h"
@@ -28,6 +29,7 @@
 #include "random.h"
 
 #include "_nib-internal.h"
+#include "_nib-lpm.h"
 #include "_nib-router.h"
 
 #define ENABLE_DEBUG 0
@@ -41,6 +43,20 @@ static _nib_onl_entry_t _nodes[CONFIG_GNRC_IPV6_NIB_NUMOF];
 static _nib_offl_entry_t _dsts[CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF];
 static _nib_dr_entry_t _def_routers[CONFIG_GNRC_IPV6_NIB_DEFAULT_ROUTER_NUMOF];
 
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ONL_HASH)
+#if CONFIG_GNRC_IPV6_NIB_NUMOF < UINT8_MAX
+typedef uint8_t _onl_hash_t;
+#else
+typedef uint16_t _onl_hash_t;
+#endif
+/* hash index for _nodes: bucket heads and chain links are indexes into
+ * _nodes plus 1, so 0 means "none" */
+static _onl_hash_t _onl_hash[CONFIG_GNRC_IPV6_NIB_NUMOF];
+static _onl_hash_t _onl_hash_next[CONFIG_GNRC_IPV6_NIB_NUMOF];
+/* bucket a node is currently chained into plus 1 */
+static _onl_hash_t _onl_hash_bucket[CONFIG_GNRC_IPV6_NIB_NUMOF];
+#endif  /* CONFIG_GNRC_IPV6_NIB_ONL_HASH */
+
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C)
 static _nib_abr_entry_t _abrs[CONFIG_GNRC_IPV6_NIB_ABR_NUMOF];
 #endif  /* CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C */
@@ -65,6 +81,14 @@ void _nib_init(void)
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C)
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C */
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ONL_HASH)
+    memset(_onl_hash, 0, sizeof(_onl_hash));
+    memset(_onl_hash_next, 0, sizeof(_onl_hash_next));
+    memset(_onl_hash_bucket, 0, sizeof(_onl_hash_bucket));
+#endif  /* CONFIG_GNRC_IPV6_NIB_ONL_HASH */
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_LPM)
+    _nib_lpm_init();
+#endif  /* CONFIG_GNRC_IPV6_NIB_OFFL_LPM */
 #endif  /* TEST_SUITES */
     evtimer_init_msg(&_nib_evtimer);
     /* TODO: load ABR information from persistent memory */
@@ -80,6 +104,45 @@ void _nib_release(void)
     rmutex_unlock(&_nib_mutex);
 }
 
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ONL_HASH)
+static inline unsigned _onl_hash_idx(const ipv6_addr_t *addr)
+{
+    uint32_t h = addr->u32[0].u32 ^ addr->u32[1].u32 ^
+                 addr->u32[2].u32 ^ addr->u32[3].u32;
+
+    /* Fibonacci hashing, so all bits of the XOR fold count */
+    return ((h * 2654435769U) >> 16) % CONFIG_GNRC_IPV6_NIB_NUMOF;
+}
+
+/* moves node to the bucket of its current address */
+static void _onl_rehash(_nib_onl_entry_t *node)
+{
+    unsigned idx = node - _nodes;
+    unsigned bucket = _onl_hash_idx(&node->ipv6);
+
+    if (_onl_hash_bucket[idx] == (bucket + 1)) {
+        return;
+    }
+    if (_onl_hash_bucket[idx] != 0) {
+        _onl_hash_t *ptr = &_onl_hash[_onl_hash_bucket[idx] - 1];
+
+        while (*ptr != (idx + 1)) {
+            assert(*ptr != 0);
+            ptr = &_onl_hash_next[*ptr - 1];
+        }
+        *ptr = _onl_hash_next[idx];
+    }
+    _onl_hash_next[idx] = _onl_hash[bucket];
+    _onl_hash[bucket] = idx + 1;
+    _onl_hash_bucket[idx] = bucket + 1;
+}
+#else   /* CONFIG_GNRC_IPV6_NIB_ONL_HASH */
+static inline void _onl_rehash(_nib_onl_entry_t *node)
+{
+    (void)node;
+}
+#endif  /* CONFIG_GNRC_IPV6_NIB_ONL_HASH */
+
 static inline bool _addr_equals(const ipv6_addr_t *addr,
                                 const _nib_onl_entry_t *node)
 {
@@ -214,24 +277,50 @@ _nib_onl_entry_t *_nib_onl_iter(const _nib_onl_entry_t *last)
     return NULL;
 }
 
+static inline bool _onl_matches(const _nib_onl_entry_t *node,
+                                const ipv6_addr_t *addr, unsigned iface)
+{
+    return (node->mode != _EMPTY) &&
+           /* either requested or current interface undefined or
+            * interfaces equal */
+           ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
+            (_nib_onl_get_if(node) == iface)) &&
+           ipv6_addr_equal(&node->ipv6, addr);
+}
+
 _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
 {
     assert(addr != NULL);
     DEBUG("nib: Getting on-link node entry (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ONL_HASH)
+    _nib_onl_entry_t *res = NULL;
+
+    /* chain order is arbitrary, but the linear search returns the first
+     * suitable entry in _nodes */
+    for (unsigned i = _onl_hash[_onl_hash_idx(addr)]; i != 0;
+         i = _onl_hash_next[i - 1]) {
+        _nib_onl_entry_t *node = &_nodes[i - 1];
+
+        if (((res == NULL) || (node < res)) &&
+            _onl_matches(node, addr, iface)) {
+            res = node;
+        }
+    }
+    if (res != NULL) {
+        DEBUG("  Found %p\n", (void *)res);
+        return res;
+    }
+#else   /* CONFIG_GNRC_IPV6_NIB_ONL_HASH */
     for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *node = &_nodes[i];
 
-        if ((node->mode != _EMPTY) &&
-            /* either requested or current interface undefined or
-             * interfaces equal */
-            ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
-             (_nib_onl_get_if(node) == iface)) &&
-            ipv6_addr_equal(&node->ipv6, addr)) {
+        if (_onl_matches(node, addr, iface)) {
             DEBUG("  Found %p\n", (void *)node);
             return node;
         }
     }
+#endif  /* CONFIG_GNRC_IPV6_NIB_ONL_HASH */
     DEBUG("  No suitable entry found\n");
     return NULL;
 }
@@ -265,6 +354,7 @@ void _nib_nc_remove(_nib_onl_entry_t *node)
           ipv6_addr_to_str(addr_str, &node->ipv6, sizeof(addr_str)),
           _nib_onl_get_if(node));
     node->mode &= ~(_NC);
+    gnrc_ipv6_flowcache_flush();
     evtimer_del((evtimer_t *)&_nib_evtimer, &node->snd_na.event);
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ARSM)
     evtimer_del((evtimer_t *)&_nib_evtimer, &node->nud_timeout.event);
@@ -376,6 +466,7 @@ _nib_dr_entry_t *_nib_drl_add(const ipv6_addr_t *router_addr, unsigned iface)
 void _nib_drl_remove(_nib_dr_entry_t *nib_dr)
 {
     if (nib_dr->next_hop != NULL) {
+        gnrc_ipv6_flowcache_flush();
         nib_dr->next_hop->mode &= ~(_DRL);
         _nib_onl_clear(nib_dr->next_hop);
         memset(nib_dr, 0, sizeof(_nib_dr_entry_t));
@@ -494,6 +585,8 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
             DEBUG("  %p is an exact match\n", (void *)tmp);
             if (next_hop != NULL) {
                 memcpy(&tmp_node->ipv6, next_hop, sizeof(tmp_node->ipv6));
+                _onl_rehash(tmp_node);
+                gnrc_ipv6_flowcache_flush();
             }
             tmp->next_hop->mode |= _DST;
             return tmp;
@@ -514,6 +607,9 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_LPM)
+        _nib_lpm_add(dst);
+#endif  /* CONFIG_GNRC_IPV6_NIB_OFFL_LPM */
     }
     return dst;
 }
@@ -538,6 +634,7 @@ static inline bool _in_abrs(const _nib_abr_entry_t *abr)
 void _nib_offl_clear(_nib_offl_entry_t *dst)
 {
     if (dst->next_hop != NULL) {
+        gnrc_ipv6_flowcache_flush();
         _nib_offl_entry_t *ptr;
         for (ptr = _dsts; _in_dsts(ptr); ptr++) {
             /* there is another dst pointing to next-hop => only remove dst */
@@ -550,6 +647,9 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
             dst->next_hop->mode &= ~(_DST);
             _nib_onl_clear(dst->next_hop);
         }
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_LPM)
+        _nib_lpm_remove(dst);
+#endif  /* CONFIG_GNRC_IPV6_NIB_OFFL_LPM */
         memset(dst, 0, sizeof(_nib_offl_entry_t));
     }
 }
@@ -575,11 +675,14 @@ bool _nib_offl_is_entry(const _nib_offl_entry_t *entry)
 
 static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 {
+    DEBUG("nib: get match for destination %s from NIB\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_LPM)
+    return _nib_lpm_get_match(dst);
+#else   /* CONFIG_GNRC_IPV6_NIB_OFFL_LPM */
     _nib_offl_entry_t *res = NULL;
     uint8_t best_match = 0;
 
-    DEBUG("nib: get match for destination %s from NIB\n",
-          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
     for (_nib_offl_entry_t *entry = _dsts; _in_dsts(entry); entry++) {
         if (entry->mode != _EMPTY) {
             uint8_t match = ipv6_addr_match_prefix(&entry->pfx, dst);
@@ -600,6 +703,7 @@ static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
         }
     }
     return res;
+#endif  /* CONFIG_GNRC_IPV6_NIB_OFFL_LPM */
 }
 
 void _nib_ft_get(const _nib_offl_entry_t *dst, gnrc_ipv6_nib_ft_t *fte)
@@ -856,10 +960,13 @@ _nib_offl_entry_t *_nib_pl_add(unsigned iface,
 static void _override_node(const ipv6_addr_t *addr, unsigned iface,
                            _nib_onl_entry_t *node)
 {
+    /* new default routers and off-link entries may change routes */
+    gnrc_ipv6_flowcache_flush();
     _nib_onl_clear(node);
     if (addr != NULL) {
         memcpy(&node->ipv6, addr, sizeof(node->ipv6));
     }
+    _onl_rehash(node);
     _nib_onl_set_if(node, iface);
 }
 
@@ -196,7 +196,7 @@ typedef struct {
 /**
  * @brief   Off-link NIB entry
  */
-typedef struct {
+typedef struct _nib_offl_entry {
     _nib_onl_entry_t *next_hop; /**< next hop to destination */
     ipv6_addr_t pfx;            /**< prefix to the destination */
     /**
@@ -218,6 +218,14 @@ typedef struct {
                                      valid (UINT32_MAX means forever) */
     uint32_t pref_until;        /**< timestamp (in ms) until which the prefix
                                      preferred (UINT32_MAX means forever) */
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_LPM) || defined(DOXYGEN)
+    /**
+     * @brief   Next entry with the same prefix in the LPM index
+     *
+     * @note    Only available if @ref CONFIG_GNRC_IPV6_NIB_OFFL_LPM != 0.
+     */
+    struct _nib_offl_entry *lpm_next;
+#endif
 } _nib_offl_entry_t;
 
 /**
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "_nib-lpm.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_LPM)
+
+/**
+ * @brief   Trie node
+ *
+ * A node without entries always has two children, so the trie never holds
+ * more than two nodes per off-link entry.
+ */
+typedef struct _lpm_node {
+    struct _lpm_node *child[2];     /**< children by bit _lpm_node::len */
+    struct _lpm_node *parent;       /**< parent node (NULL for root) */
+    _nib_offl_entry_t *entries;     /**< entries with exactly this prefix */
+    ipv6_addr_t pfx;                /**< prefix (masked to _lpm_node::len) */
+    uint8_t len;                    /**< prefix length */
+} _lpm_node_t;
+
+static _lpm_node_t _pool[2 * CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF];
+static _lpm_node_t *_root;
+static _lpm_node_t *_free;          /* chained by _lpm_node_t::parent */
+static unsigned _pool_used;
+
+static inline unsigned _bit(const ipv6_addr_t *addr, unsigned pos)
+{
+    return (addr->u8[pos >> 3] >> (7 - (pos & 0x7))) & 0x1;
+}
+
+static inline unsigned _min(unsigned a, unsigned b)
+{
+    return (a < b) ? a : b;
+}
+
+static _lpm_node_t *_node_alloc(const ipv6_addr_t *pfx, unsigned len)
+{
+    _lpm_node_t *node;
+
+    if (_free != NULL) {
+        node = _free;
+        _free = node->parent;
+    }
+    else {
+        assert(_pool_used < ARRAY_SIZE(_pool));
+        node = &_pool[_pool_used++];
+    }
+    memset(node, 0, sizeof(*node));
+    ipv6_addr_init_prefix(&node->pfx, pfx, len);
+    node->len = len;
+    return node;
+}
+
+static void _node_free(_lpm_node_t *node)
+{
+    node->parent = _free;
+    _free = node;
+}
+
+/* puts new into the place of old in the trie */
+static void _node_replace(_lpm_node_t *old, _lpm_node_t *new)
+{
+    _lpm_node_t *parent = old->parent;
+
+    if (new != NULL) {
+        new->parent = parent;
+    }
+    if (parent == NULL) {
+        _root = new;
+    }
+    else {
+        parent->child[parent->child[1] == old] = new;
+    }
+}
+
+void _nib_lpm_init(void)
+{
+    _root = NULL;
+    _free = NULL;
+    _pool_used = 0;
+}
+
+void _nib_lpm_add(_nib_offl_entry_t *entry)
+{
+    _lpm_node_t **slot = &_root;
+    _lpm_node_t *parent = NULL, *leaf;
+    unsigned len = entry->pfx_len;
+
+    DEBUG("nib: adding %p to LPM index\n", (void *)entry);
+    while (*slot != NULL) {
+        _lpm_node_t *node = *slot;
+        unsigned common = _min(ipv6_addr_match_prefix(&node->pfx, &entry->pfx),
+                               _min(node->len, len));
+
+        if (common == node->len) {
+            if (node->len == len) {
+                entry->lpm_next = node->entries;
+                node->entries = entry;
+                return;
+            }
+            parent = node;
+            slot = &node->child[_bit(&entry->pfx, node->len)];
+            continue;
+        }
+        /* prefixes diverge above node => insert new node(s) in its place */
+        _lpm_node_t *branch;
+
+        if (common == len) {
+            /* entry's prefix is a prefix of node's prefix */
+            branch = _node_alloc(&entry->pfx, len);
+            branch->entries = entry;
+        }
+        else {
+            branch = _node_alloc(&entry->pfx, common);
+            leaf = _node_alloc(&entry->pfx, len);
+            leaf->entries = entry;
+            leaf->parent = branch;
+            branch->child[_bit(&entry->pfx, common)] = leaf;
+        }
+        entry->lpm_next = NULL;
+        branch->parent = parent;
+        branch->child[_bit(&node->pfx, common)] = node;
+        node->parent = branch;
+        *slot = branch;
+        return;
+    }
+    leaf = _node_alloc(&entry->pfx, len);
+    leaf->entries = entry;
+    leaf->parent = parent;
+    entry->lpm_next = NULL;
+    *slot = leaf;
+}
+
+void _nib_lpm_remove(_nib_offl_entry_t *entry)
+{
+    _lpm_node_t *node = _root;
+
+    DEBUG("nib: removing %p from LPM index\n", (void *)entry);
+    while ((node != NULL) && (node->len < entry->pfx_len)) {
+        node = node->child[_bit(&entry->pfx, node->len)];
+    }
+    assert((node != NULL) && (node->len == entry->pfx_len));
+    for (_nib_offl_entry_t **ptr = &node->entries; *ptr != NULL;
+         ptr = &(*ptr)->lpm_next) {
+        if (*ptr == entry) {
+            *ptr = entry->lpm_next;
+            break;
+        }
+    }
+    entry->lpm_next = NULL;
+    /* remove nodes that neither hold entries nor branch */
+    while ((node != NULL) && (node->entries == NULL) &&
+           ((node->child[0] == NULL) || (node->child[1] == NULL))) {
+        _lpm_node_t *child = (node->child[0] != NULL) ? node->child[0]
+                                                      : node->child[1];
+        _lpm_node_t *parent = node->parent;
+
+        _node_replace(node, child);
+        _node_free(node);
+        if (child != NULL) {
+            /* parent keeps the same number of children */
+            break;
+        }
+        node = parent;
+    }
+}
+
+_nib_offl_entry_t *_nib_lpm_get_match(const ipv6_addr_t *dst)
+{
+    _nib_offl_entry_t *res = NULL;
+    uint8_t best_match = 0;
+
+    for (_lpm_node_t *node = _root; node != NULL;
+         node = node->child[_bit(dst, node->len)]) {
+        uint8_t match = ipv6_addr_match_prefix(&node->pfx, dst);
+
+        if (match < node->len) {
+            break;
+        }
+        /* all entries of a node share its prefix, so they also share the
+         * match length. Break ties the same way the linear search does: by
+         * position in memory */
+        for (_nib_offl_entry_t *entry = node->entries; entry != NULL;
+             entry = entry->lpm_next) {
+            if ((entry->mode != _EMPTY) &&
+                ((match > best_match) ||
+                 ((match == best_match) && (entry < res)))) {
+                res = entry;
+                best_match = match;
+            }
+        }
+        if (node->len == IPV6_ADDR_BIT_LEN) {
+            break;
+        }
+    }
+    return res;
+}
+
+#endif  /* CONFIG_GNRC_IPV6_NIB_OFFL_LPM */
+
+/** @} */
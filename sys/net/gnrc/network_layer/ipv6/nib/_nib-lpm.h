@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_ipv6_nib
+ * @internal
+ * @{
+ *
+ * @file
+ * @brief   Longest-prefix-match index for off-link entries
+ *
+ * The index is a path-compressed binary trie (Patricia trie). Every trie node
+ * stands for a prefix. Nodes either hold the off-link entries with exactly
+ * that prefix or, if they hold none, branch into two children.
+ *
+ * @see     @ref CONFIG_GNRC_IPV6_NIB_OFFL_LPM
+ */
+#ifndef PRIV_NIB_LPM_H
+#define PRIV_NIB_LPM_H
+
+#include <kernel_defines.h>
+
+#include "net/gnrc/ipv6/nib/conf.h"
+#include "net/ipv6/addr.h"
+
+#include "_nib-internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_LPM) || defined(DOXYGEN)
+/**
+ * @brief   Empties the index
+ */
+void _nib_lpm_init(void);
+
+/**
+ * @brief   Adds an off-link entry to the index
+ *
+ * @pre     _nib_offl_entry_t::pfx and _nib_offl_entry_t::pfx_len of @p entry
+ *          are set and @p entry is not in the index.
+ *
+ * @param[in] entry An off-link entry.
+ */
+void _nib_lpm_add(_nib_offl_entry_t *entry);
+
+/**
+ * @brief   Removes an off-link entry from the index
+ *
+ * @pre     @p entry is in the index and its prefix was not changed since
+ *          @ref _nib_lpm_add().
+ *
+ * @param[in] entry An off-link entry.
+ */
+void _nib_lpm_remove(_nib_offl_entry_t *entry);
+
+/**
+ * @brief   Gets the best matching off-link entry for a destination
+ *
+ * The result is the same as of a linear search over all non-empty off-link
+ * entries: of the entries whose prefix covers @p dst, the one whose prefix
+ * shares the most leading bits with @p dst wins. On a tie, the entry that
+ * comes first in memory wins.
+ *
+ * @param[in] dst   A destination address.
+ *
+ * @return  The best matching off-link entry.
+ * @return  NULL, if no entry matches.
+ */
+_nib_offl_entry_t *_nib_lpm_get_match(const ipv6_addr_t *dst);
+#endif  /* CONFIG_GNRC_IPV6_NIB_OFFL_LPM */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRIV_NIB_LPM_H */
+/** @} */
@@ -19,6 +19,7 @@
 #include <stdio.h>
 
 #include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/flowcache.h"
 #include "net/gnrc/netif.h"
 
 #include "net/gnrc/ipv6/nib/nc.h"
@@ -55,6 +56,7 @@ int gnrc_ipv6_nib_nc_set(const ipv6_addr_t *ipv6, unsigned iface,
                     GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK);
     node->info |= (GNRC_IPV6_NIB_NC_INFO_AR_STATE_MANUAL |
                    GNRC_IPV6_NIB_NC_INFO_NUD_STATE_UNMANAGED);
+    gnrc_ipv6_flowcache_flush();
     _nib_release();
     return 0;
 }
@@ -39,30 +39,39 @@
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
-/* estimated fragment payload size to determinate RBUF_INT_SIZE, default to
- * MAC payload size - fragment header. */
-#ifndef GNRC_SIXLOWPAN_FRAG_SIZE
-/* assuming 64-bit source/destination address, source PAN ID omitted */
-#define GNRC_SIXLOWPAN_FRAG_SIZE (104 - 5)
-#endif
-
 #ifndef RBUF_INT_SIZE
-/* same as ((int) ceil((double) N / D)) */
-#define DIV_CEIL(N, D) (((N) + (D) - 1) / (D))
 #if     IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD)
-#define RBUF_INT_SIZE (DIV_CEIL(IPV6_MIN_MTU, GNRC_SIXLOWPAN_FRAG_SIZE) * \
+#define RBUF_INT_SIZE (GNRC_SIXLOWPAN_FRAG_RB_INTS_PER_DATAGRAM * \
                        (CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE + \
                         CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE))
 #else   /* IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD) */
-#define RBUF_INT_SIZE (DIV_CEIL(IPV6_MIN_MTU, GNRC_SIXLOWPAN_FRAG_SIZE) * \
+#define RBUF_INT_SIZE (GNRC_SIXLOWPAN_FRAG_RB_INTS_PER_DATAGRAM * \
                        CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE)
 #endif  /* IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD) */
 #endif
 
+/* entries are referenced as index + 1 in the hash index, so 0 is "none" */
+static_assert(CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE < UINT8_MAX,
+              "CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE too big for hash index");
+
+/* The fragment interval pool: intervals that were never handed out are
+ * rbuf_int[rbuf_int_fresh..], returned intervals are kept in rbuf_int_free
+ * (linked via next, with start and end set to 0) */
 static gnrc_sixlowpan_frag_rb_int_t rbuf_int[RBUF_INT_SIZE];
+static gnrc_sixlowpan_frag_rb_int_t *rbuf_int_free;
+static unsigned rbuf_int_fresh;
 
 static gnrc_sixlowpan_frag_rb_t rbuf[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
 
+/* Hash index of rbuf on (src, tag): one chain per bucket. Removed entries are
+ * only unlinked when their slot is reused, so chains may contain empty
+ * entries and every entry found in a chain needs to be compared in full. */
+static uint8_t rbuf_head[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+static struct {
+    uint8_t next;       /**< next entry in the chain */
+    uint8_t bucket;     /**< bucket + 1 of the chain the entry is in */
+} rbuf_link[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+
 static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
 
 static xtimer_t _gc_timer;
@@ -180,6 +189,44 @@ void gnrc_sixlowpan_frag_rb_rm_by_datagram(const gnrc_netif_hdr_t *netif_hdr,
     }
 }
 
+static inline unsigned _rbuf_bucket(const uint8_t *src, size_t src_len,
+                                    uint16_t tag)
+{
+    return gnrc_sixlowpan_frag_rb_hash(src, src_len, tag) %
+           CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE;
+}
+
+static void _rbuf_unindex(gnrc_sixlowpan_frag_rb_t *e)
+{
+    const unsigned i = e - rbuf;
+    uint8_t *ptr;
+
+    if (rbuf_link[i].bucket == 0) {
+        return;
+    }
+    ptr = &rbuf_head[rbuf_link[i].bucket - 1];
+    while (*ptr != (i + 1)) {
+        assert(*ptr != 0);
+        ptr = &rbuf_link[*ptr - 1].next;
+    }
+    *ptr = rbuf_link[i].next;
+    rbuf_link[i].next = 0;
+    rbuf_link[i].bucket = 0;
+}
+
+/* moves e to the chain of its (src, tag) */
+static void _rbuf_index(gnrc_sixlowpan_frag_rb_t *e)
+{
+    const unsigned i = e - rbuf;
+    const unsigned bucket = _rbuf_bucket(e->super.src, e->super.src_len,
+                                         e->super.tag);
+
+    _rbuf_unindex(e);
+    rbuf_link[i].next = rbuf_head[bucket];
+    rbuf_link[i].bucket = bucket + 1;
+    rbuf_head[bucket] = i + 1;
+}
+
 static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_hdr,
                                                   uint16_t tag)
 {
@@ -189,8 +236,9 @@ static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_
     const uint8_t src_len = netif_hdr->src_l2addr_len;
     const uint8_t dst_len = netif_hdr->dst_l2addr_len;
 
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        gnrc_sixlowpan_frag_rb_t *e = &rbuf[i];
+    for (unsigned i = rbuf_head[_rbuf_bucket(src, src_len, tag)]; i != 0;
+         i = rbuf_link[i - 1].next) {
+        gnrc_sixlowpan_frag_rb_t *e = &rbuf[i - 1];
 
         if ((e->pkt != NULL) && (e->super.tag == tag) &&
             (e->super.src_len == src_len) &&
@@ -490,24 +538,28 @@ static inline bool _rbuf_int_overlap_partially(gnrc_sixlowpan_frag_rb_int_t *i,
 
 static gnrc_sixlowpan_frag_rb_int_t *_rbuf_int_get_free(void)
 {
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
-        }
-    }
+    gnrc_sixlowpan_frag_rb_int_t *res = rbuf_int_free;
 
-    return NULL;
+    if (res != NULL) {
+        rbuf_int_free = res->next;
+        res->next = NULL;
+    }
+    else if (rbuf_int_fresh < RBUF_INT_SIZE) {
+        res = &rbuf_int[rbuf_int_fresh++];
+    }
+    return res;
 }
 
 #ifdef TEST_SUITES
 bool gnrc_sixlowpan_frag_rb_ints_empty(void)
 {
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end > 0) {
-            return false;
-        }
+    unsigned free_ints = RBUF_INT_SIZE - rbuf_int_fresh;
+
+    for (gnrc_sixlowpan_frag_rb_int_t *i = rbuf_int_free; i != NULL;
+         i = i->next) {
+        free_ints++;
     }
-    return true;
+    return (free_ints == RBUF_INT_SIZE);
 }
 #endif  /* TEST_SUITES */
 
@@ -596,8 +648,11 @@ static int _rbuf_get(const void *src, size_t src_len,
     gnrc_sixlowpan_frag_rb_t *res = NULL, *oldest = NULL;
     uint32_t now_usec = xtimer_now_usec();
 
-    for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        /* check first if entry already available */
+    /* check first if entry already available */
+    for (unsigned int j = rbuf_head[_rbuf_bucket(src, src_len, tag)];
+         j != 0; j = rbuf_link[j - 1].next) {
+        const unsigned i = j - 1;
+
         if ((rbuf[i].pkt != NULL) && (rbuf[i].super.tag == tag) &&
             ((IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) &&
               /* not all SFR fragments carry the datagram size, so make 0 a
@@ -630,10 +685,14 @@ static int _rbuf_get(const void *src, size_t src_len,
             _set_rbuf_timeout();
             return i;
         }
+    }
 
+    /* new datagram: look for a free spot */
+    for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
         /* if there is a free spot: remember it */
-        if ((res == NULL) && gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i])) {
+        if (gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i])) {
             res = &(rbuf[i]);
+            break;
         }
 
         /* remember oldest slot */
@@ -718,6 +777,7 @@ static int _rbuf_get(const void *src, size_t src_len,
     res->super.dst_len = dst_len;
     res->super.tag = tag;
     res->super.current_size = 0;
+    _rbuf_index(res);
 #if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
     res->offset_diff = 0U;
     memset(res->received, 0U, sizeof(res->received));
@@ -741,6 +801,8 @@ void gnrc_sixlowpan_frag_rb_reset(void)
 {
     xtimer_remove(&_gc_timer);
     memset(rbuf_int, 0, sizeof(rbuf_int));
+    rbuf_int_free = NULL;
+    rbuf_int_fresh = 0;
     for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
         if ((rbuf[i].pkt != NULL) &&
             (rbuf[i].pkt->users > 0)) {
@@ -748,6 +810,8 @@ void gnrc_sixlowpan_frag_rb_reset(void)
         }
     }
     memset(rbuf, 0, sizeof(rbuf));
+    memset(rbuf_head, 0, sizeof(rbuf_head));
+    memset(rbuf_link, 0, sizeof(rbuf_link));
 }
 
 const gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_array(void)
@@ -756,16 +820,25 @@ const gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_array(void)
 }
 #endif
 
-void gnrc_sixlowpan_frag_rb_base_rm(gnrc_sixlowpan_frag_rb_base_t *entry)
+void gnrc_sixlowpan_frag_rb_ints_rm(gnrc_sixlowpan_frag_rb_base_t *entry)
 {
-    while (entry->ints != NULL) {
+    /* an interval with end == 0 is already back in the pool, e.g. because
+     * the list was shared between a reassembly buffer entry and a VRB entry */
+    while ((entry->ints != NULL) && (entry->ints->end != 0)) {
         gnrc_sixlowpan_frag_rb_int_t *next = entry->ints->next;
 
         entry->ints->start = 0;
         entry->ints->end = 0;
-        entry->ints->next = NULL;
+        entry->ints->next = rbuf_int_free;
+        rbuf_int_free = entry->ints;
         entry->ints = next;
     }
+    entry->ints = NULL;
+}
+
+void gnrc_sixlowpan_frag_rb_base_rm(gnrc_sixlowpan_frag_rb_base_t *entry)
+{
+    gnrc_sixlowpan_frag_rb_ints_rm(entry);
     entry->datagram_size = 0;
 }
 
@@ -426,10 +426,7 @@ int gnrc_sixlowpan_frag_sfr_forward(gnrc_pktsnip_t *pkt,
 
     /* free all intervals associated to the VRB entry, as we don't need them
      * with SFR, so throw them out, to save this resource */
-    while (vrbe->super.ints) {
-        vrbe->super.ints->end = 0U;
-        vrbe->super.ints = vrbe->super.ints->next;
-    }
+    gnrc_sixlowpan_frag_rb_ints_rm(&vrbe->super);
     if (hdrsnip == NULL) {
         DEBUG("6lo sfr: Unable to allocate new rfrag header\n");
         gnrc_pktbuf_release(pkt);
@@ -13,6 +13,8 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <assert.h>
+
 #include "net/ieee802154.h"
 #ifdef MODULE_GNRC_IPV6_NIB
 #include "net/ipv6/addr.h"
@@ -30,7 +32,19 @@
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
+/* entries are referenced as index + 1 in the hash index, so 0 is "none" */
+static_assert(CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE < UINT8_MAX,
+              "CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE too big for hash index");
+
 static gnrc_sixlowpan_frag_vrb_t _vrb[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+/* Hash index of _vrb on (src, tag): one chain per bucket. Removed entries are
+ * only unlinked when their slot is reused, so chains may contain empty
+ * entries */
+static uint8_t _vrb_head[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+static struct {
+    uint8_t next;       /**< next entry in the chain */
+    uint8_t bucket;     /**< bucket + 1 of the chain the entry is in */
+} _vrb_link[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
 #ifdef MODULE_GNRC_IPV6_NIB
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #else   /* MODULE_GNRC_IPV6_NIB */
@@ -46,76 +60,129 @@ static inline bool _equal_index(const gnrc_sixlowpan_frag_vrb_t *vrbe,
             (memcmp(vrbe->super.src, src, src_len) == 0));
 }
 
+static inline unsigned _bucket(const uint8_t *src, size_t src_len,
+                               unsigned tag)
+{
+    return gnrc_sixlowpan_frag_rb_hash(src, src_len, tag) %
+           CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE;
+}
+
+static void _unindex(gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    const unsigned i = vrbe - _vrb;
+    uint8_t *ptr;
+
+    if (_vrb_link[i].bucket == 0) {
+        return;
+    }
+    ptr = &_vrb_head[_vrb_link[i].bucket - 1];
+    while (*ptr != (i + 1)) {
+        assert(*ptr != 0);
+        ptr = &_vrb_link[*ptr - 1].next;
+    }
+    *ptr = _vrb_link[i].next;
+    _vrb_link[i].next = 0;
+    _vrb_link[i].bucket = 0;
+}
+
+/* moves vrbe to the chain of its (src, tag) */
+static void _index(gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    const unsigned i = vrbe - _vrb;
+    const unsigned bucket = _bucket(vrbe->super.src, vrbe->super.src_len,
+                                    vrbe->super.tag);
+
+    _unindex(vrbe);
+    _vrb_link[i].next = _vrb_head[bucket];
+    _vrb_link[i].bucket = bucket + 1;
+    _vrb_head[bucket] = i + 1;
+}
+
+static gnrc_sixlowpan_frag_vrb_t *_lookup(const uint8_t *src, size_t src_len,
+                                          unsigned tag)
+{
+    for (unsigned i = _vrb_head[_bucket(src, src_len, tag)]; i != 0;
+         i = _vrb_link[i - 1].next) {
+        gnrc_sixlowpan_frag_vrb_t *vrbe = &_vrb[i - 1];
+
+        if (_equal_index(vrbe, src, src_len, tag)) {
+            return vrbe;
+        }
+    }
+    return NULL;
+}
+
 gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(
         const gnrc_sixlowpan_frag_rb_base_t *base,
         gnrc_netif_t *out_netif, const uint8_t *out_dst, size_t out_dst_len)
 {
-    gnrc_sixlowpan_frag_vrb_t *vrbe = NULL;
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
 
     assert(base != NULL);
     assert(out_netif != NULL);
     assert(out_dst != NULL);
     assert(out_dst_len > 0);
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
-        gnrc_sixlowpan_frag_vrb_t *ptr = &_vrb[i];
-
-        if (gnrc_sixlowpan_frag_vrb_entry_empty(ptr) ||
-            _equal_index(ptr, base->src, base->src_len, base->tag)) {
-            vrbe = ptr;
-            if (gnrc_sixlowpan_frag_vrb_entry_empty(vrbe)) {
-                vrbe->super = *base;
-                vrbe->out_netif = out_netif;
-                memcpy(vrbe->super.dst, out_dst, out_dst_len);
-                vrbe->out_tag = gnrc_sixlowpan_frag_fb_next_tag();
-                vrbe->super.dst_len = out_dst_len;
-                DEBUG("6lo vrb: creating entry (%s, ",
-                      gnrc_netif_addr_to_str(vrbe->super.src,
-                                             vrbe->super.src_len,
-                                             addr_str));
-                DEBUG("%s, %u, %u) => ",
-                      gnrc_netif_addr_to_str(vrbe->super.dst,
-                                             vrbe->super.dst_len,
-                                             addr_str),
-                      (unsigned)vrbe->super.datagram_size, vrbe->super.tag);
-                DEBUG("(%s, %u)\n",
-                      gnrc_netif_addr_to_str(vrbe->super.dst,
-                                             vrbe->super.dst_len,
-                                             addr_str), vrbe->out_tag);
+    if ((vrbe = _lookup(base->src, base->src_len, base->tag)) == NULL) {
+        for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+            if (gnrc_sixlowpan_frag_vrb_entry_empty(&_vrb[i])) {
+                vrbe = &_vrb[i];
+                break;
             }
-            /* _equal_index() => append intervals of `base`, so they don't get
-             * lost. We use append, so we don't need to change base! */
-            else if (base->ints != NULL) {
-                gnrc_sixlowpan_frag_rb_int_t *tmp = vrbe->super.ints;
-
-                if (tmp != base->ints) {
-                    /* base->ints is not already vrbe->super.ints */
-                    if (tmp != NULL) {
-                        /* iterate before appending and check if `base->ints` is
-                         * not already part of list */
-                        while (tmp->next != NULL) {
-                            if (tmp == base->ints) {
-                                tmp = NULL;
-                                break;
-                            }
-                            tmp = tmp->next;
-                        }
-                        if (tmp != NULL) {
-                            tmp->next = base->ints;
-                        }
-                    }
-                    else {
-                        vrbe->super.ints = base->ints;
-                    }
-                }
-            }
-            break;
         }
     }
-#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
     if (vrbe == NULL) {
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
         gnrc_sixlowpan_frag_stats_get()->vrb_full++;
-    }
 #endif
+        return NULL;
+    }
+    if (gnrc_sixlowpan_frag_vrb_entry_empty(vrbe)) {
+        vrbe->super = *base;
+        vrbe->out_netif = out_netif;
+        memcpy(vrbe->super.dst, out_dst, out_dst_len);
+        vrbe->out_tag = gnrc_sixlowpan_frag_fb_next_tag();
+        vrbe->super.dst_len = out_dst_len;
+        _index(vrbe);
+        DEBUG("6lo vrb: creating entry (%s, ",
+              gnrc_netif_addr_to_str(vrbe->super.src,
+                                     vrbe->super.src_len,
+                                     addr_str));
+        DEBUG("%s, %u, %u) => ",
+              gnrc_netif_addr_to_str(vrbe->super.dst,
+                                     vrbe->super.dst_len,
+                                     addr_str),
+              (unsigned)vrbe->super.datagram_size, vrbe->super.tag);
+        DEBUG("(%s, %u)\n",
+              gnrc_netif_addr_to_str(vrbe->super.dst,
+                                     vrbe->super.dst_len,
+                                     addr_str), vrbe->out_tag);
+    }
+    /* _equal_index() => append intervals of `base`, so they don't get
+     * lost. We use append, so we don't need to change base! */
+    else if (base->ints != NULL) {
+        gnrc_sixlowpan_frag_rb_int_t *tmp = vrbe->super.ints;
+
+        if (tmp != base->ints) {
+            /* base->ints is not already vrbe->super.ints */
+            if (tmp != NULL) {
+                /* iterate before appending and check if `base->ints` is
+                 * not already part of list */
+                while (tmp->next != NULL) {
+                    if (tmp == base->ints) {
+                        tmp = NULL;
+                        break;
+                    }
+                    tmp = tmp->next;
+                }
+                if (tmp != NULL) {
+                    tmp->next = base->ints;
+                }
+            }
+            else {
+                vrbe->super.ints = base->ints;
+            }
+        }
+    }
     return vrbe;
 }
 
@@ -166,18 +233,16 @@ gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_from_route(
 gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(
         const uint8_t *src, size_t src_len, unsigned src_tag)
 {
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+
     DEBUG("6lo vrb: trying to get entry for (%s, %u)\n",
           gnrc_netif_addr_to_str(src, src_len, addr_str), src_tag);
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
-        gnrc_sixlowpan_frag_vrb_t *vrbe = &_vrb[i];
-
-        if (_equal_index(vrbe, src, src_len, src_tag)) {
-            DEBUG("6lo vrb: got VRB to (%s, %u)\n",
-                  gnrc_netif_addr_to_str(vrbe->super.dst,
-                                         vrbe->super.dst_len,
-                                         addr_str), vrbe->out_tag);
-            return vrbe;
-        }
+    if ((vrbe = _lookup(src, src_len, src_tag)) != NULL) {
+        DEBUG("6lo vrb: got VRB to (%s, %u)\n",
+              gnrc_netif_addr_to_str(vrbe->super.dst,
+                                     vrbe->super.dst_len,
+                                     addr_str), vrbe->out_tag);
+        return vrbe;
     }
     DEBUG("6lo vrb: no entry found\n");
     return NULL;
@@ -231,6 +296,8 @@ void gnrc_sixlowpan_frag_vrb_gc(void)
 void gnrc_sixlowpan_frag_vrb_reset(void)
 {
     memset(_vrb, 0, sizeof(_vrb));
+    memset(_vrb_head, 0, sizeof(_vrb_head));
+    memset(_vrb_link, 0, sizeof(_vrb_link));
 }
 #endif
 
@@ -19,6 +19,7 @@
 #include "thread.h"
 #include "utlist.h"
 
+#include "net/gnrc/ipv6/flowcache.h"
 #include "net/gnrc/ipv6/hdr.h"
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
@@ -80,6 +81,10 @@ void gnrc_sixlowpan_dispatch_recv(gnrc_pktsnip_t *pkt, void *context,
 #else   /* MODULE_GNRC_IPV6 */
     /* just assume normal IPv6 traffic */
     type = GNRC_NETTYPE_IPV6;
+    if (gnrc_ipv6_flowcache_forward(pkt)) {
+        DEBUG("6lo: packet forwarded by flow cache\n");
+        return;
+    }
 #endif  /* MODULE_GNRC_IPV6 */
     if (!gnrc_netapi_dispatch_receive(type,
                                       GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
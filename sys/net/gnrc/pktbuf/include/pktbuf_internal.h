@@ -41,9 +41,11 @@ extern "C" {
  */
 extern mutex_t gnrc_pktbuf_mutex;
 
-#if IS_USED(MODULE_GNRC_PKTBUF_STATIC) || DOXYGEN
+#if IS_USED(MODULE_GNRC_PKTBUF_STATIC) || IS_USED(MODULE_GNRC_PKTBUF_SEGFIT) || \
+    DOXYGEN
 /**
- * @brief   The actual static buffer used when module gnrc_pktbuf_static is used
+ * @brief   The actual static buffer used when module gnrc_pktbuf_static or
+ *          gnrc_pktbuf_segfit is used
  *
  * @warning This is an internal buffer and should not be touched by external code
  */
@@ -63,7 +65,7 @@ extern uint8_t *gnrc_pktbuf_static_buf;
  */
 static inline bool gnrc_pktbuf_contains(void *ptr)
 {
-#if IS_USED(MODULE_GNRC_PKTBUF_STATIC)
+#if IS_USED(MODULE_GNRC_PKTBUF_STATIC) || IS_USED(MODULE_GNRC_PKTBUF_SEGFIT)
     return (unsigned)((uint8_t *)ptr - gnrc_pktbuf_static_buf) < CONFIG_GNRC_PKTBUF_SIZE;
 #else
     (void)ptr;
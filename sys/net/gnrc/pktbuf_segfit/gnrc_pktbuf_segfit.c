@@ -0,0 +1,772 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Segregated-fit implementation of @ref net_gnrc_pktbuf
+ *
+ * @see     pktbuf_segfit.h for an overview
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+#include "bitarithm.h"
+#include "bitfield.h"
+#include "mutex.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#include "pktbuf_internal.h"
+#include "pktbuf_segfit.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define GRANULE             GNRC_PKTBUF_SEGFIT_ALIGN
+#define GRANULES_NUMOF      (CONFIG_GNRC_PKTBUF_SIZE / GRANULE)
+#define NONE                (UINT16_MAX)
+
+/* slab classes: one per size in granules up to the slab size */
+#define SNIP_GRANULES       ((sizeof(gnrc_pktsnip_t) + GRANULE - 1) / GRANULE)
+#define SLAB_GRANULES       ((CONFIG_GNRC_PKTBUF_SEGFIT_SLAB_SIZE + GRANULE - 1) / GRANULE)
+#define CLASS_NUMOF         ((SLAB_GRANULES > SNIP_GRANULES) ? SLAB_GRANULES : SNIP_GRANULES)
+#define PAGES_NUMOF         (CONFIG_GNRC_PKTBUF_SEGFIT_PAGES_NUMOF)
+#define SLOTS_NUMOF         (8U)
+
+/* second level: 8 lists per power of two */
+#define SL_LOG2             (3U)
+#define SL_NUMOF            (1U << SL_LOG2)
+
+#define LOG2(x)             (((x) >= 32768) ? 15 : ((x) >= 16384) ? 14 : \
+                             ((x) >= 8192) ? 13 : ((x) >= 4096) ? 12 : \
+                             ((x) >= 2048) ? 11 : ((x) >= 1024) ? 10 : \
+                             ((x) >= 512) ? 9 : ((x) >= 256) ? 8 : \
+                             ((x) >= 128) ? 7 : ((x) >= 64) ? 6 : \
+                             ((x) >= 32) ? 5 : ((x) >= 16) ? 4 : \
+                             ((x) >= 8) ? 3 : ((x) >= 4) ? 2 : \
+                             ((x) >= 2) ? 1 : 0)
+#define FL_NUMOF            ((LOG2(GRANULES_NUMOF) >= SL_LOG2) \
+                             ? (LOG2(GRANULES_NUMOF) - SL_LOG2 + 2) : 1)
+
+static_assert(GRANULES_NUMOF < NONE,
+              "CONFIG_GNRC_PKTBUF_SIZE too large for gnrc_pktbuf_segfit");
+static_assert(SLOTS_NUMOF == 8, "slot bitmap of _page_t needs 8 slots");
+static_assert(PAGES_NUMOF < UINT8_MAX,
+              "CONFIG_GNRC_PKTBUF_SEGFIT_PAGES_NUMOF too large");
+
+/**
+ * @brief   Free block
+ *
+ * Allocated blocks carry no header. The header fits into one granule, so
+ * every leftover of a split can be tracked.
+ */
+typedef struct {
+    uint16_t next;      /**< next free block in the same list */
+    uint16_t prev;      /**< previous free block in the same list */
+    uint16_t size;      /**< size in granules */
+    uint16_t start;     /**< in the last granule of a block: its first granule */
+} _block_t;
+
+/**
+ * @brief   Slab page: a block split into @ref SLOTS_NUMOF slots of one class
+ *
+ * Slots may be freed in parts (see gnrc_pktbuf_mark() and
+ * gnrc_pktbuf_realloc_data()), so the allocated granules are counted per
+ * slot.
+ */
+typedef struct {
+    uint16_t start;                 /**< first granule of the page */
+    uint8_t cls;                    /**< slot size in granules, 0 if unused */
+    uint8_t free;                   /**< bitmap of free slots */
+    uint8_t next;                   /**< next page of the class with free
+                                     *   slots + 1 */
+    uint8_t live[SLOTS_NUMOF];      /**< allocated granules per slot */
+} _page_t;
+
+/* The static buffer needs to be aligned to the granule size, so that its
+ * granules can be casted to `_block_t *` safely */
+static uint64_t _pktbuf_buf[GRANULES_NUMOF];
+uint8_t *gnrc_pktbuf_static_buf = (uint8_t *)_pktbuf_buf;
+
+/* TLSF index: the first level is the power of two of the size, the second
+ * level divides it linearly */
+static uint16_t _fl_bitmap;
+static uint8_t _sl_bitmap[FL_NUMOF];
+static uint16_t _heads[FL_NUMOF][SL_NUMOF];
+/* first and last granules of free blocks, for merging with neighbors */
+static BITFIELD(_starts, GRANULES_NUMOF);
+static BITFIELD(_ends, GRANULES_NUMOF);
+static unsigned _free_granules;
+static unsigned _free_blocks;
+
+/* slabs */
+static _page_t _pages[PAGES_NUMOF];
+/* pages with free slots per class + 1 */
+static uint8_t _partial[CLASS_NUMOF];
+/* granules that belong to pages */
+static BITFIELD(_paged, GRANULES_NUMOF);
+static unsigned _slots_used;
+
+static gnrc_pktbuf_segfit_stats_t _stats;
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_pktbuf_alloc(size_t size);
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+static inline _block_t *_block(unsigned idx)
+{
+    return (_block_t *)&_pktbuf_buf[idx];
+}
+
+static inline void _mapping(unsigned size, unsigned *fl, unsigned *sl)
+{
+    if (size < SL_NUMOF) {
+        *fl = 0;
+        *sl = size;
+    }
+    else {
+        unsigned msb = bitarithm_msb(size);
+
+        *fl = msb - SL_LOG2 + 1;
+        *sl = (size >> (msb - SL_LOG2)) & (SL_NUMOF - 1);
+    }
+}
+
+static void _insert(unsigned idx, unsigned size)
+{
+    _block_t *block = _block(idx);
+    unsigned fl, sl;
+
+    _mapping(size, &fl, &sl);
+    block->size = size;
+    block->prev = NONE;
+    block->next = _heads[fl][sl];
+    if (block->next != NONE) {
+        _block(block->next)->prev = idx;
+    }
+    _heads[fl][sl] = idx;
+    _fl_bitmap |= (1U << fl);
+    _sl_bitmap[fl] |= (1U << sl);
+    /* for a block of one granule, this is the header itself */
+    _block(idx + size - 1)->start = idx;
+    bf_set(_starts, idx);
+    bf_set(_ends, idx + size - 1);
+    _free_granules += size;
+    _free_blocks++;
+}
+
+static void _remove(unsigned idx)
+{
+    _block_t *block = _block(idx);
+    unsigned fl, sl;
+
+    _mapping(block->size, &fl, &sl);
+    if (block->prev != NONE) {
+        _block(block->prev)->next = block->next;
+    }
+    else {
+        _heads[fl][sl] = block->next;
+        if (block->next == NONE) {
+            _sl_bitmap[fl] &= ~(1U << sl);
+            if (_sl_bitmap[fl] == 0) {
+                _fl_bitmap &= ~(1U << fl);
+            }
+        }
+    }
+    if (block->next != NONE) {
+        _block(block->next)->prev = block->prev;
+    }
+    bf_unset(_starts, idx);
+    bf_unset(_ends, idx + block->size - 1);
+    _free_granules -= block->size;
+    _free_blocks--;
+}
+
+static void *_tlsf_alloc(unsigned granules)
+{
+    unsigned fl, sl, size, idx = NONE;
+    unsigned search = granules;
+
+    if (granules > GRANULES_NUMOF) {
+        return NULL;
+    }
+    /* round up to the next list, so every block in it is large enough */
+    if (search >= SL_NUMOF) {
+        search += (1U << (bitarithm_msb(search) - SL_LOG2)) - 1;
+    }
+    _mapping(search, &fl, &sl);
+    if (fl < FL_NUMOF) {
+        unsigned map = _sl_bitmap[fl] & (~0U << sl);
+
+        if (map == 0) {
+            unsigned fl_map = _fl_bitmap & (~0U << (fl + 1));
+
+            if (fl_map != 0) {
+                fl = bitarithm_lsb(fl_map);
+                map = _sl_bitmap[fl];
+            }
+        }
+        if (map != 0) {
+            idx = _heads[fl][bitarithm_lsb(map)];
+        }
+    }
+    if (idx == NONE) {
+        /* the list the size falls into may still hold a large enough block */
+        _mapping(granules, &fl, &sl);
+        for (idx = _heads[fl][sl]; (idx != NONE) && (_block(idx)->size < granules);
+             idx = _block(idx)->next) {}
+        if (idx == NONE) {
+            return NULL;
+        }
+    }
+    size = _block(idx)->size;
+    _remove(idx);
+    if (size > granules) {
+        _insert(idx + granules, size - granules);
+    }
+    return &_pktbuf_buf[idx];
+}
+
+static void _tlsf_free(unsigned idx, unsigned granules)
+{
+    if ((idx > 0) && bf_isset(_ends, idx - 1)) {
+        unsigned prev = _block(idx - 1)->start;
+
+        _remove(prev);
+        granules += idx - prev;
+        idx = prev;
+    }
+    if (((idx + granules) < GRANULES_NUMOF) && bf_isset(_starts, idx + granules)) {
+        unsigned next_size = _block(idx + granules)->size;
+
+        _remove(idx + granules);
+        granules += next_size;
+    }
+    _insert(idx, granules);
+}
+
+static void _mark_paged(const _page_t *page, bool paged)
+{
+    for (unsigned i = 0; i < (page->cls * SLOTS_NUMOF); i++) {
+        if (paged) {
+            bf_set(_paged, page->start + i);
+        }
+        else {
+            bf_unset(_paged, page->start + i);
+        }
+    }
+}
+
+static _page_t *_page_new(unsigned cls)
+{
+    uint64_t *start;
+    unsigned num;
+
+    for (num = 0; (num < PAGES_NUMOF) && (_pages[num].cls != 0); num++) {}
+    if (num == PAGES_NUMOF) {
+        return NULL;
+    }
+    start = _tlsf_alloc(cls * SLOTS_NUMOF);
+    if (start == NULL) {
+        return NULL;
+    }
+    _pages[num].start = start - _pktbuf_buf;
+    _pages[num].cls = cls;
+    _pages[num].free = UINT8_MAX;
+    _pages[num].next = _partial[cls - 1];
+    memset(_pages[num].live, 0, sizeof(_pages[num].live));
+    _partial[cls - 1] = num + 1;
+    _mark_paged(&_pages[num], true);
+    return &_pages[num];
+}
+
+static void *_slab_alloc(unsigned granules)
+{
+    _page_t *page;
+    unsigned slot;
+
+    if ((granules == 0) || (granules > CLASS_NUMOF)) {
+        return NULL;
+    }
+    if (_partial[granules - 1] != 0) {
+        page = &_pages[_partial[granules - 1] - 1];
+    }
+    else if ((page = _page_new(granules)) == NULL) {
+        return NULL;
+    }
+    slot = bitarithm_lsb(page->free);
+    page->free &= ~(1U << slot);
+    page->live[slot] = granules;
+    if (page->free == 0) {
+        /* page is full */
+        _partial[granules - 1] = page->next;
+        page->next = 0;
+    }
+    _slots_used++;
+    return &_pktbuf_buf[page->start + (slot * granules)];
+}
+
+static void _slab_free(unsigned idx, unsigned granules)
+{
+    unsigned num, slot, cls;
+    _page_t *page = NULL;
+
+    /* there are only few pages, so no index is kept for them */
+    for (num = 0; num < PAGES_NUMOF; num++) {
+        page = &_pages[num];
+        if ((page->cls != 0) && (idx >= page->start) &&
+            (idx < (page->start + (page->cls * SLOTS_NUMOF)))) {
+            break;
+        }
+    }
+    assert(num < PAGES_NUMOF);
+    cls = page->cls;
+    slot = (idx - page->start) / cls;
+    assert(page->live[slot] >= granules);
+    page->live[slot] -= granules;
+    if (page->live[slot] != 0) {
+        return;
+    }
+    _slots_used--;
+    if (page->free == 0) {
+        page->next = _partial[cls - 1];
+        _partial[cls - 1] = num + 1;
+    }
+    page->free |= (1U << slot);
+    if (page->free == UINT8_MAX) {
+        /* give empty pages back, so their space can be used for payload */
+        for (uint8_t *ptr = &_partial[cls - 1]; *ptr != 0;
+             ptr = &_pages[*ptr - 1].next) {
+            if (*ptr == (num + 1)) {
+                *ptr = page->next;
+                break;
+            }
+        }
+        _mark_paged(page, false);
+        page->cls = 0;
+        _tlsf_free(page->start, cls * SLOTS_NUMOF);
+    }
+}
+
+void gnrc_pktbuf_init(void)
+{
+    mutex_lock(&gnrc_pktbuf_mutex);
+    _fl_bitmap = 0;
+    memset(_sl_bitmap, 0, sizeof(_sl_bitmap));
+    memset(_heads, 0xff, sizeof(_heads));
+    memset(_starts, 0, sizeof(_starts));
+    memset(_ends, 0, sizeof(_ends));
+    _free_granules = 0;
+    _free_blocks = 0;
+    _insert(0, GRANULES_NUMOF);
+    memset(_pages, 0, sizeof(_pages));
+    memset(_partial, 0, sizeof(_partial));
+    memset(_paged, 0, sizeof(_paged));
+    _slots_used = 0;
+    memset(&_stats, 0, sizeof(_stats));
+    mutex_unlock(&gnrc_pktbuf_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > CONFIG_GNRC_PKTBUF_SIZE) {
+        DEBUG("pktbuf: size (%u) > CONFIG_GNRC_PKTBUF_SIZE (%u)\n",
+              (unsigned)size, CONFIG_GNRC_PKTBUF_SIZE);
+        return NULL;
+    }
+    mutex_lock(&gnrc_pktbuf_mutex);
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&gnrc_pktbuf_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    /* size required for chunk */
+    size_t required_new_size = _align(size);
+    void *new_data_marked;
+
+    mutex_lock(&gnrc_pktbuf_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return NULL;
+    }
+    /* marked data does not end on a granule => move data around to allow
+     * for proper free */
+    if ((pkt->size != size) && (size < required_new_size)) {
+        void *new_data_rest;
+        new_data_marked = _pktbuf_alloc(size);
+        if (new_data_marked == NULL) {
+            DEBUG("pktbuf: could not reallocate marked section.\n");
+            gnrc_pktbuf_free_internal(marked_snip, sizeof(gnrc_pktsnip_t));
+            mutex_unlock(&gnrc_pktbuf_mutex);
+            return NULL;
+        }
+        new_data_rest = _pktbuf_alloc(pkt->size - size);
+        if (new_data_rest == NULL) {
+            DEBUG("pktbuf: could not reallocate remaining section.\n");
+            gnrc_pktbuf_free_internal(marked_snip, sizeof(gnrc_pktsnip_t));
+            gnrc_pktbuf_free_internal(new_data_marked, size);
+            mutex_unlock(&gnrc_pktbuf_mutex);
+            return NULL;
+        }
+        memcpy(new_data_marked, pkt->data, size);
+        memcpy(new_data_rest, ((uint8_t *)pkt->data) + size, pkt->size - size);
+        gnrc_pktbuf_free_internal(pkt->data, pkt->size);
+        marked_snip->data = new_data_marked;
+        pkt->data = new_data_rest;
+    }
+    else {
+        new_data_marked = pkt->data;
+        /* if (pkt->size - size) != 0 take remainder of data, otherwise set NULL */
+        pkt->data = (pkt->size != size) ? (((uint8_t *)pkt->data) + size) :
+                                          NULL;
+    }
+    pkt->size -= size;
+    _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+    pkt->next = marked_snip;
+    mutex_unlock(&gnrc_pktbuf_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    size_t aligned_size = _align(size);
+
+    mutex_lock(&gnrc_pktbuf_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) && gnrc_pktbuf_contains(pkt->data)));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return 0;
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        gnrc_pktbuf_free_internal(pkt->data, pkt->size);
+        pkt->data = NULL;
+    }
+    /* if new size is bigger than old size */
+    else if (size > pkt->size) {    /* new size does not fit */
+        void *new_data = _pktbuf_alloc(size);
+        if (new_data == NULL) {
+            DEBUG("pktbuf: error allocating new data section\n");
+            mutex_unlock(&gnrc_pktbuf_mutex);
+            return ENOMEM;
+        }
+        if (pkt->data != NULL) {            /* if old data exist */
+            memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
+        }
+        gnrc_pktbuf_free_internal(pkt->data, pkt->size);
+        pkt->data = new_data;
+    }
+    else if (_align(pkt->size) > aligned_size) {
+        gnrc_pktbuf_free_internal(((uint8_t *)pkt->data) + aligned_size,
+                     pkt->size - aligned_size);
+    }
+    pkt->size = size;
+    mutex_unlock(&gnrc_pktbuf_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&gnrc_pktbuf_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&gnrc_pktbuf_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&gnrc_pktbuf_mutex);
+    if (pkt == NULL) {
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return new;
+    }
+    mutex_unlock(&gnrc_pktbuf_mutex);
+    return pkt;
+}
+
+static void _get_stats(gnrc_pktbuf_segfit_stats_t *stats)
+{
+    *stats = _stats;
+    stats->free = _free_granules * GRANULE;
+    stats->free_blocks = _free_blocks;
+    stats->largest_free = 0;
+    stats->pages_used = 0;
+    stats->slots_used = _slots_used;
+    for (unsigned i = 0; i < PAGES_NUMOF; i++) {
+        stats->pages_used += (_pages[i].cls != 0);
+    }
+    if (_fl_bitmap != 0) {
+        /* the largest block is in the highest non-empty list */
+        unsigned fl = bitarithm_msb(_fl_bitmap);
+        unsigned sl = bitarithm_msb(_sl_bitmap[fl]);
+
+        for (unsigned idx = _heads[fl][sl]; idx != NONE; idx = _block(idx)->next) {
+            if ((_block(idx)->size * GRANULE) > stats->largest_free) {
+                stats->largest_free = _block(idx)->size * GRANULE;
+            }
+        }
+    }
+}
+
+void gnrc_pktbuf_segfit_get_stats(gnrc_pktbuf_segfit_stats_t *stats)
+{
+    mutex_lock(&gnrc_pktbuf_mutex);
+    _get_stats(stats);
+    mutex_unlock(&gnrc_pktbuf_mutex);
+}
+
+void gnrc_pktbuf_segfit_reset_stats(void)
+{
+    mutex_lock(&gnrc_pktbuf_mutex);
+    _stats.allocs = 0;
+    _stats.failed = 0;
+    _stats.max_used = _stats.used;
+    mutex_unlock(&gnrc_pktbuf_mutex);
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    gnrc_pktbuf_segfit_stats_t stats;
+
+    mutex_lock(&gnrc_pktbuf_mutex);
+    _get_stats(&stats);
+    mutex_unlock(&gnrc_pktbuf_mutex);
+    printf("packet buffer: first byte: %p, last byte: %p (size: %u)\n",
+           (void *)&gnrc_pktbuf_static_buf[0],
+           (void *)&gnrc_pktbuf_static_buf[CONFIG_GNRC_PKTBUF_SIZE],
+           CONFIG_GNRC_PKTBUF_SIZE);
+    printf("  used: %u bytes (max: %u)\n", stats.used, stats.max_used);
+    printf("  slab pages used: %u/%u, slots used: %u\n",
+           stats.pages_used, (unsigned)PAGES_NUMOF, stats.slots_used);
+    printf("  free: %u bytes in %u blocks, largest: %u bytes "
+           "(fragmentation: %u%%)\n", stats.free, stats.free_blocks,
+           stats.largest_free,
+           (stats.free) ? ((stats.free - stats.largest_free) * 100U) / stats.free
+                        : 0);
+    printf("  allocations: %" PRIu32 ", failed: %" PRIu32 "\n",
+           stats.allocs, stats.failed);
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    return (_slots_used == 0) && (_free_granules == GRANULES_NUMOF);
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    unsigned blocks = 0, granules = 0, live = 0, paged = 0, slots = 0;
+
+    /* Invariants of this implementation:
+     *  - a list is non-empty iff its bits in the bitmaps are set
+     *  - every free block is in the list its size maps to, its first and last
+     *    granule are marked, and its footer points to its start
+     *  - no two free blocks are adjacent
+     *  - the counters match the lists
+     *  - a page is in the list of its class iff it has free slots, and a
+     *    slot is free iff none of its granules are allocated
+     */
+    for (unsigned fl = 0; fl < FL_NUMOF; fl++) {
+        if ((_sl_bitmap[fl] != 0) != ((_fl_bitmap & (1U << fl)) != 0)) {
+            return false;
+        }
+        for (unsigned sl = 0; sl < SL_NUMOF; sl++) {
+            unsigned prev = NONE;
+
+            if ((_heads[fl][sl] != NONE) != ((_sl_bitmap[fl] & (1U << sl)) != 0)) {
+                return false;
+            }
+            for (unsigned idx = _heads[fl][sl]; idx != NONE; idx = _block(idx)->next) {
+                _block_t *block = _block(idx);
+                unsigned exp_fl, exp_sl;
+
+                if ((block->size == 0) ||
+                    ((idx + block->size) > GRANULES_NUMOF) ||
+                    (block->prev != prev) || (++blocks > GRANULES_NUMOF)) {
+                    return false;
+                }
+                _mapping(block->size, &exp_fl, &exp_sl);
+                if ((exp_fl != fl) || (exp_sl != sl) ||
+                    !bf_isset(_starts, idx) ||
+                    !bf_isset(_ends, idx + block->size - 1) ||
+                    (_block(idx + block->size - 1)->start != idx)) {
+                    return false;
+                }
+                if (((idx > 0) && bf_isset(_ends, idx - 1)) ||
+                    (((idx + block->size) < GRANULES_NUMOF) &&
+                     bf_isset(_starts, idx + block->size))) {
+                    return false;
+                }
+                granules += block->size;
+                prev = idx;
+            }
+        }
+    }
+    if ((blocks != _free_blocks) || (granules != _free_granules)) {
+        return false;
+    }
+    for (unsigned cls = 1; cls <= CLASS_NUMOF; cls++) {
+        unsigned partial = 0;
+
+        for (unsigned num = _partial[cls - 1]; num != 0; num = _pages[num - 1].next) {
+            if ((num > PAGES_NUMOF) || (_pages[num - 1].cls != cls) ||
+                (_pages[num - 1].free == 0) || (++partial > PAGES_NUMOF)) {
+                return false;
+            }
+        }
+    }
+    for (unsigned num = 0; num < PAGES_NUMOF; num++) {
+        _page_t *page = &_pages[num];
+
+        if (page->cls == 0) {
+            continue;
+        }
+        for (unsigned slot = 0; slot < SLOTS_NUMOF; slot++) {
+            if (((page->free & (1U << slot)) != 0) != (page->live[slot] == 0)) {
+                return false;
+            }
+            live += page->live[slot];
+            slots += (page->live[slot] != 0);
+        }
+        if ((page->free == UINT8_MAX) ||
+            ((page->free == 0) && (page->next != 0))) {
+            return false;
+        }
+        paged += page->cls * SLOTS_NUMOF;
+    }
+    if (slots != _slots_used) {
+        return false;
+    }
+    return _stats.used == ((live + GRANULES_NUMOF - _free_granules - paged) * GRANULE);
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _pktbuf_alloc(size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            gnrc_pktbuf_free_internal(pkt, sizeof(gnrc_pktsnip_t));
+            return NULL;
+        }
+        if (data != NULL) {
+            memcpy(_data, data, size);
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    return pkt;
+}
+
+static void *_pktbuf_alloc(size_t size)
+{
+    unsigned granules = _align(size) / GRANULE;
+    void *ptr = _slab_alloc(granules);
+
+    if (ptr == NULL) {
+        ptr = _tlsf_alloc(granules);
+    }
+    if (ptr == NULL) {
+        DEBUG("pktbuf: no space left in packet buffer\n");
+        _stats.failed++;
+        return NULL;
+    }
+    _stats.allocs++;
+    _stats.used += granules * GRANULE;
+    if (_stats.used > _stats.max_used) {
+        _stats.max_used = _stats.used;
+    }
+    return ptr;
+}
+
+void gnrc_pktbuf_free_internal(void *data, size_t size)
+{
+    unsigned idx, granules;
+
+    if (!gnrc_pktbuf_contains(data) || (size == 0)) {
+        return;
+    }
+    idx = ((uint8_t *)data - gnrc_pktbuf_static_buf) / GRANULE;
+    granules = _align(size) / GRANULE;
+    _stats.used -= granules * GRANULE;
+    if (bf_isset(_paged, idx)) {
+        _slab_free(idx, granules);
+    }
+    else {
+        _tlsf_free(idx, granules);
+    }
+}
+
+/** @} */
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @brief   Internal definitions of the segregated-fit implementation of
+ *          @ref net_gnrc_pktbuf
+ *
+ * The packet buffer arena is managed by a two-level segregated-fit allocator
+ * (TLSF): free blocks are kept in lists by size class, and two levels of
+ * bitmaps find a large enough class in constant time. Freed blocks are merged
+ * with free neighbors in constant time as well.
+ *
+ * Allocations up to @ref CONFIG_GNRC_PKTBUF_SEGFIT_SLAB_SIZE, most notably
+ * @ref gnrc_pktsnip_t, are served from slab pages: blocks of 8 equally sized
+ * slots, one size class per granule. Pages are taken from the TLSF when a
+ * class runs out of slots and are given back when they become empty (see
+ * @ref CONFIG_GNRC_PKTBUF_SEGFIT_PAGES_NUMOF).
+ *
+ * Unlike the first-fit walk of `gnrc_pktbuf_static`, neither allocating nor
+ * freeing depends on the number of free blocks, and long-lived small
+ * allocations do not cut the payload space into pieces.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Definitions of types and statistics for usage in tests
+ */
+#ifndef PKTBUF_SEGFIT_H
+#define PKTBUF_SEGFIT_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Allocation granularity of the packet buffer in bytes
+ */
+#define GNRC_PKTBUF_SEGFIT_ALIGN        (sizeof(uint64_t))
+
+/**
+ * @brief   Statistics of the packet buffer
+ */
+typedef struct {
+    uint32_t allocs;            /**< successful allocations */
+    uint32_t failed;            /**< failed allocations */
+    unsigned used;              /**< bytes currently allocated */
+    unsigned max_used;          /**< maximum of gnrc_pktbuf_segfit_stats_t::used */
+    unsigned free;              /**< free bytes outside of the slabs */
+    unsigned free_blocks;       /**< number of free blocks outside of the slabs */
+    unsigned largest_free;      /**< largest free block outside of the slabs */
+    uint16_t pages_used;        /**< slab pages in use */
+    uint16_t slots_used;        /**< slab slots in use */
+} gnrc_pktbuf_segfit_stats_t;
+
+/**
+ * @brief   Calculates the required space of a number of bytes including
+ *          alignment to @ref GNRC_PKTBUF_SEGFIT_ALIGN
+ */
+static inline size_t _align(size_t size)
+{
+    return (size + GNRC_PKTBUF_SEGFIT_ALIGN - 1) &
+          ~(GNRC_PKTBUF_SEGFIT_ALIGN - 1);
+}
+
+/**
+ * @brief   Gets the statistics of the packet buffer
+ *
+ * Fragmentation of the payload space can be judged by comparing
+ * gnrc_pktbuf_segfit_stats_t::largest_free with
+ * gnrc_pktbuf_segfit_stats_t::free.
+ *
+ * @param[out] stats    The statistics.
+ */
+void gnrc_pktbuf_segfit_get_stats(gnrc_pktbuf_segfit_stats_t *stats);
+
+/**
+ * @brief   Resets the counters in the statistics
+ *
+ * Resets gnrc_pktbuf_segfit_stats_t::allocs,
+ * gnrc_pktbuf_segfit_stats_t::failed, and
+ * gnrc_pktbuf_segfit_stats_t::max_used.
+ */
+void gnrc_pktbuf_segfit_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PKTBUF_SEGFIT_H */
+/** @} */
@@ -705,8 +705,8 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                     MSG_TYPE_USER_SPEC_TIMEOUT, &mbox);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until something was sent. It is acknowledged in the background */
+    while (ret == 0) {
         state = _gnrc_tcp_fsm_get_state(tcb);
 
         /* Check if the connections state is closed. If so, a reset was received */
@@ -746,7 +746,6 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
 
             case MSG_TYPE_USER_SPEC_TIMEOUT:
                 TCP_DEBUG_INFO("Received MSG_TYPE_USER_SPEC_TIMEOUT.");
-                _gnrc_tcp_fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
                 TCP_DEBUG_ERROR("-ETIMEDOUT: User specified timeout expired.");
                 ret = -ETIMEDOUT;
                 break;
@@ -892,7 +891,6 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
 
                 case MSG_TYPE_USER_SPEC_TIMEOUT:
                     TCP_DEBUG_INFO("Received MSG_TYPE_USER_SPEC_TIMEOUT.");
-                    _gnrc_tcp_fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
                     TCP_DEBUG_ERROR("-ETIMEDOUT: User specified timeout expired.");
                     ret = -ETIMEDOUT;
                     break;
@@ -19,6 +19,7 @@
 
 #include <utlist.h>
 #include <errno.h>
+#include <string.h>
 #include "random.h"
 #include "net/af.h"
 #include "net/gnrc.h"
@@ -92,15 +93,106 @@ static uint16_t _get_random_local_port(void)
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     TCP_DEBUG_ENTER;
-    if (tcb->pkt_retransmit != NULL) {
-        _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
-    }
+    _gnrc_tcp_pkt_clear_retransmit(tcb);
     TCP_DEBUG_LEAVE;
     return 0;
 }
 
+/**
+ * @brief Returns the congestion control state of a TCB.
+ *
+ * @param[in] tcb   TCB holding the congestion control state.
+ *
+ * @returns   The CongURE state object of @p tcb.
+ */
+static inline congure_snd_t *_cong(gnrc_tcp_tcb_t *tcb)
+{
+    return (congure_snd_t *)&tcb->cong;
+}
+
+/**
+ * @brief Fast retransmit callback for the congestion control.
+ *
+ * @param[in] c   CongURE state object of the TCB to retransmit from.
+ */
+static void _cong_fr(congure_reno_snd_t *c)
+{
+    _gnrc_tcp_pkt_fast_retransmit(c->super.ctx);
+}
+
+static const congure_reno_snd_consts_t _cong_consts = {
+    .fr = _cong_fr,
+    .init_mss = CONFIG_GNRC_TCP_MSS,
+    .frthresh = CONFIG_GNRC_TCP_DUP_ACK_THRESHOLD,
+};
+
+/**
+ * @brief Initializes the congestion control when a connection is opened.
+ *
+ * Discards the state of a previous connection on the same TCB.
+ *
+ * @param[in,out] tcb   TCB holding the congestion control state.
+ */
+static void _cong_init(gnrc_tcp_tcb_t *tcb)
+{
+#ifdef MODULE_GNRC_TCP_CUBIC
+    congure_cubic_snd_setup(&tcb->cong, &_cong_consts);
+#else
+    congure_reno_snd_setup(&tcb->cong, &_cong_consts);
+#endif
+    _cong(tcb)->driver->init(_cong(tcb), tcb);
+}
+
+/**
+ * @brief Restarts the congestion control once the peers MSS is known.
+ *
+ * @param[in,out] tcb   TCB holding the congestion control state.
+ */
+static void _cong_set_mss(gnrc_tcp_tcb_t *tcb)
+{
+    congure_reno_set_mss((congure_reno_snd_t *)&tcb->cong,
+                         _gnrc_tcp_pkt_get_smss(tcb));
+    _cong(tcb)->driver->init(_cong(tcb), tcb);
+}
+
+/**
+ * @brief Prepares the report of an ACK to the congestion control.
+ *
+ * Must be called before snd_una is advanced and the acknowledged segments are
+ * removed from the retransmission queue.
+ *
+ * @param[in,out] tcb       TCB holding the congestion control state.
+ * @param[in]     seg_ack   Acknowledgment number of the ACK.
+ * @param[in]     seg_wnd   Window advertised by the ACK.
+ * @param[in]     pay_len   Payload length of the ACK.
+ * @param[in]     ctl       Control bits of the ACK.
+ * @param[out]    msg       Newly acknowledged data.
+ * @param[out]    ack       The ACK.
+ */
+static void _cong_prepare_ack(gnrc_tcp_tcb_t *tcb, uint32_t seg_ack,
+                              uint16_t seg_wnd, size_t pay_len, uint16_t ctl,
+                              congure_snd_msg_t *msg, congure_snd_ack_t *ack)
+{
+    uint32_t now = evtimer_now_msec();
+    uint32_t acked = seg_ack - tcb->snd_una;
+
+    memset(msg, 0, sizeof(*msg));
+    memset(ack, 0, sizeof(*ack));
+    /* Provide an RTT sample, if the timed segment was acknowledged */
+    if ((tcb->status & STATUS_RTT_PENDING) && LEQ_32_BIT(tcb->rtt_seq, seg_ack)) {
+        msg->send_time = tcb->rtt_start;
+    }
+    else {
+        msg->send_time = now;
+    }
+    msg->size = (acked < CONGURE_WND_SIZE_MAX) ? acked : CONGURE_WND_SIZE_MAX;
+    ack->recv_time = now;
+    ack->id = seg_ack;
+    ack->size = (pay_len < CONGURE_WND_SIZE_MAX) ? pay_len : CONGURE_WND_SIZE_MAX;
+    ack->wnd = seg_wnd;
+    ack->clean = !(ctl & (MSK_SYN | MSK_FIN));
+}
+
 /**
  * @brief Restarts timewait timer.
  *
@@ -174,8 +266,9 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, _gnrc_tcp_fsm_state_t state)
             break;
 
         case FSM_STATE_LISTEN:
-            /* Clear Accepted Status */
-            tcb->status &= ~(STATUS_ACCEPTED);
+            /* Clear Accepted Status and options of the last connection */
+            tcb->status &= ~(STATUS_ACCEPTED | STATUS_SACK_PERMITTED);
+            tcb->ooo_num = 0;
 
             /* Clear address info */
 #ifdef MODULE_GNRC_IPV6
@@ -220,9 +313,13 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, _gnrc_tcp_fsm_state_t state)
                 LL_PREPEND(list->head, tcb);
             }
             mutex_unlock(&list->lock);
+            /* The SYN might be retransmitted before the peers MSS is known */
+            _cong_init(tcb);
             break;
 
         case FSM_STATE_SYN_RCVD:
+            /* The SYN+ACK might be retransmitted before the peers MSS is known */
+            _cong_init(tcb);
             /* Setup timeout for listening TCBs */
             if (tcb->status & STATUS_LISTENING) {
                 _gnrc_tcp_eventloop_sched(&tcb->event_timeout,
@@ -232,6 +329,11 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, _gnrc_tcp_fsm_state_t state)
             break;
 
         case FSM_STATE_ESTABLISHED:
+            /* Connection is synchronized, the peers MSS is known */
+            if (tcb->state == FSM_STATE_SYN_SENT || tcb->state == FSM_STATE_SYN_RCVD) {
+                _cong_set_mss(tcb);
+            }
+            /* fall through */
         case FSM_STATE_CLOSE_WAIT:
             /* Stop timeout for listening TCBs */
             if (tcb->status & STATUS_LISTENING) {
@@ -274,6 +376,7 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
     }
 
     tcb->rcv_wnd = CONFIG_GNRC_TCP_DEFAULT_WINDOW;
+    tcb->status &= ~STATUS_SACK_PERMITTED;
 
     if (tcb->status & STATUS_LISTENING) {
         /* Passive open, T: CLOSED -> LISTEN */
@@ -317,27 +420,34 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
 static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     TCP_DEBUG_ENTER;
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
-
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
+    uint32_t cwnd = _cong(tcb)->cwnd;
+    uint32_t wnd = (tcb->snd_wnd < cwnd) ? tcb->snd_wnd : cwnd;
+    uint32_t smss = _gnrc_tcp_pkt_get_smss(tcb);
+    size_t sent = 0;
+
+    /* Send segments as long as the window is open and they fit into the retransmit queue */
+    while (sent < len && _gnrc_tcp_pkt_retransmit_free(tcb) > 0 &&
+           LSS_32_BIT(tcb->snd_nxt, tcb->snd_una + wnd)) {
         /* Calculate segment size */
-        payload = (payload < CONFIG_GNRC_TCP_MSS) ? payload : CONFIG_GNRC_TCP_MSS;
-        payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+        size_t payload = (tcb->snd_una + wnd) - tcb->snd_nxt;
+        payload = (payload < smss) ? payload : smss;
+        payload = (payload < len - sent) ? payload : len - sent;
 
-        /* Calculate payload size for this segment */
+        /* Push the last segment of this call */
+        uint16_t ctl = (sent + payload == len) ? MSK_ACK | MSK_PSH : MSK_ACK;
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH,
-                            tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (_gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, ctl, tcb->snd_nxt,
+                                tcb->rcv_nxt, (uint8_t *) buf + sent, payload) < 0) {
+            break;
+        }
         _gnrc_tcp_pkt_setup_retransmit(tcb, out_pkt, false);
         _gnrc_tcp_pkt_send(tcb, out_pkt, seq_con, false);
-        TCP_DEBUG_LEAVE;
-        return payload;
+        _cong(tcb)->driver->report_msg_sent(_cong(tcb), payload);
+        sent += payload;
     }
     TCP_DEBUG_LEAVE;
-    return 0;
+    return sent;
 }
 
 /**
@@ -712,8 +822,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_CLOSING || tcb->state == FSM_STATE_LAST_ACK) {
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
+                    congure_snd_msg_t msg;
+                    congure_snd_ack_t ack;
+
+                    _cong_prepare_ack(tcb, seg_ack, seg_wnd, pay_len, ctl, &msg, &ack);
                     tcb->snd_una = seg_ack;
                     _gnrc_tcp_pkt_acknowledge(tcb, seg_ack);
+                    _cong(tcb)->driver->report_msg_acked(_cong(tcb), &msg, &ack);
+
+                    /* Signal user, there is space for more data */
+                    tcb->status |= STATUS_NOTIFY_USER;
+                }
+                /* Possible duplicate ACK: Segments after a lost one arrived at the peer */
+                else if (seg_ack == tcb->snd_una && tcb->rtx_num > 0) {
+                    congure_snd_msg_t msg;
+                    congure_snd_ack_t ack;
+
+                    _cong_prepare_ack(tcb, seg_ack, seg_wnd, pay_len, ctl, &msg, &ack);
+                    _cong(tcb)->driver->report_msg_acked(_cong(tcb), &msg, &ack);
+                    tcb->status |= STATUS_NOTIFY_USER;
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -738,25 +865,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Additional processing */
                 /* Check additionally if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_num == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_num == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_num == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_num == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         TCP_DEBUG_LEAVE;
                         return 0;
@@ -775,19 +902,13 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Search for begin of payload */
                 snp = gnrc_pktsnip_search_type(in_pkt, GNRC_NETTYPE_UNDEF);
 
-                /* Accept only data that is expected, to be received */
-                if (tcb->rcv_nxt == seg_seq) {
-                    /* Copy contents into receive buffer */
-                    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
-                        tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
-                        snp = snp->next;
-                    }
-                    /* Shrink receive window */
-                    tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+                /* Copy contents into receive buffer, data out of order waits there for the gap */
+                if (_gnrc_tcp_rcvbuf_add(tcb, seg_seq, snp) > 0) {
                     /* Notify owner because new data is available */
                     tcb->status |= STATUS_NOTIFY_USER;
                 }
-                /* Send ACK, if FIN processing sends ACK already */
+                /* Send ACK, if FIN processing sends ACK already. Out of order data
+                 * causes a duplicate ACK that carries the received ranges */
                 /* NOTE: this is the place to add payload piggybagging in the future */
                 if (!(ctl & MSK_FIN)) {
                     _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK,
@@ -803,6 +924,14 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 TCP_DEBUG_LEAVE;
                 return 0;
             }
+            /* Data in front of the FIN is missing: ACK what was received so far */
+            if (LSS_32_BIT(tcb->rcv_nxt, seg_seq + pay_len)) {
+                _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt,
+                                    tcb->rcv_nxt, NULL, 0);
+                _gnrc_tcp_pkt_send(tcb, out_pkt, seq_con, false);
+                TCP_DEBUG_LEAVE;
+                return 0;
+            }
             /* Advance rcv_nxt over FIN bit */
             tcb->rcv_nxt = seg_seq + seg_len;
             _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt,
@@ -813,7 +942,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->rtx_num == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -857,9 +986,32 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     TCP_DEBUG_ENTER;
-    if (tcb->pkt_retransmit != NULL) {
-        _gnrc_tcp_pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _gnrc_tcp_pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    if (tcb->rtx_num > 0) {
+        /* Give up, if nothing was acknowledged for too long */
+        if ((uint32_t)(evtimer_now_msec() - tcb->rtx_start) >=
+            CONFIG_GNRC_TCP_CONNECTION_TIMEOUT_DURATION_MS) {
+            TCP_DEBUG_ERROR("Connection timed out while retransmitting.");
+            _transition_to(tcb, FSM_STATE_CLOSED);
+            TCP_DEBUG_LEAVE;
+            return 0;
+        }
+
+        /* Start over with one segment in flight (see RFC 5681) */
+        congure_snd_msg_t msg = {
+            .send_time = tcb->rtx_start,
+            .size = (congure_wnd_size_t)_gnrc_tcp_pkt_get_seg_len(tcb->pkt_retransmit[0]),
+            .resends = tcb->retries,
+        };
+        msg.super.next = &msg.super;
+        if (_cong(tcb)->driver != NULL) {
+            _cong(tcb)->driver->report_msgs_timeout(_cong(tcb), &msg);
+        }
+
+        /* The peer might have discarded data it selectively acknowledged */
+        tcb->rtx_sacked = 0;
+
+        _gnrc_tcp_pkt_setup_retransmit(tcb, tcb->pkt_retransmit[0], true);
+        _gnrc_tcp_pkt_send(tcb, tcb->pkt_retransmit[0], 0, true);
     }
     else {
         TCP_DEBUG_INFO("Retransmission queue is empty.");
@@ -16,8 +16,10 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  * @}
  */
+#include <string.h>
 #include "include/gnrc_tcp_common.h"
 #include "include/gnrc_tcp_option.h"
+#include "include/gnrc_tcp_pkt.h"
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
@@ -64,6 +66,45 @@ int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                 tcb->mss = (option->value[0] << 8) | option->value[1];
                 break;
 
+            case TCP_OPTION_KIND_SACK_PERM:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length != TCP_OPTION_LENGTH_SACK_PERM) {
+                    TCP_DEBUG_ERROR("Invalid SACK permitted option length.");
+                    TCP_DEBUG_LEAVE;
+                    return -1;
+                }
+                TCP_DEBUG_INFO("SACK permitted option found.");
+                /* Only valid in SYN packets */
+                if (IS_ACTIVE(CONFIG_GNRC_TCP_SACK_EN) &&
+                    (byteorder_ntohs(hdr->off_ctl) & MSK_SYN)) {
+                    tcb->status |= STATUS_SACK_PERMITTED;
+                }
+                break;
+
+            case TCP_OPTION_KIND_SACK:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length < TCP_OPTION_LENGTH_MIN + TCP_OPTION_LENGTH_SACK_BLOCK ||
+                    (option->length - TCP_OPTION_LENGTH_MIN) % TCP_OPTION_LENGTH_SACK_BLOCK) {
+                    TCP_DEBUG_ERROR("Invalid SACK option length.");
+                    TCP_DEBUG_LEAVE;
+                    return -1;
+                }
+                TCP_DEBUG_INFO("SACK option found.");
+                if (tcb->status & STATUS_SACK_PERMITTED) {
+                    for (uint8_t *blk = option->value;
+                         blk < (uint8_t *)option + option->length;
+                         blk += TCP_OPTION_LENGTH_SACK_BLOCK) {
+                        network_uint32_t left;
+                        network_uint32_t right;
+
+                        memcpy(&left, blk, sizeof(left));
+                        memcpy(&right, blk + sizeof(left), sizeof(right));
+                        _gnrc_tcp_pkt_sack(tcb, byteorder_ntohl(left),
+                                           byteorder_ntohl(right));
+                    }
+                }
+                break;
+
             default:
                 if (opt_left >= TCP_OPTION_LENGTH_MIN) {
                     TCP_DEBUG_INFO("Valid, unsupported option found.");
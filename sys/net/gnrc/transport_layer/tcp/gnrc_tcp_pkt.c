@@ -16,6 +16,7 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  * @}
  */
+#include <assert.h>
 #include <string.h>
 #include <utlist.h>
 #include <errno.h>
@@ -36,6 +37,16 @@
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
+/* Kconfig checks the ranges, but the values may also come from CFLAGS */
+static_assert((CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE >= 1) &&
+              (CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE <= 15),
+              "CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE must be between 1 and 15, "
+              "the queue with SYN or FIN must fit into rtx_sacked");
+static_assert((CONFIG_GNRC_TCP_OOO_RANGES >= 1) &&
+              (CONFIG_GNRC_TCP_OOO_RANGES <= 4),
+              "CONFIG_GNRC_TCP_OOO_RANGES must be between 1 and 4, "
+              "more SACK blocks do not fit into the TCP options");
+
 /**
  * @brief Calculates the maximum of two unsigned numbers.
  *
@@ -49,6 +60,53 @@ static inline uint32_t _max(const uint32_t x, const uint32_t y)
   return (x > y) ? x : y;
 }
 
+/**
+ * @brief Extracts the sequence number of a packet built by _gnrc_tcp_pkt_build().
+ *
+ * @param[in] pkt   Packet to get the sequence number from.
+ *
+ * @returns   Sequence number of @p pkt.
+ */
+static uint32_t _get_seq_num(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *snp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_TCP);
+
+    return byteorder_ntohl(((tcp_hdr_t *) snp->data)->seq_num);
+}
+
+/**
+ * @brief Keeps the RTO within its configured bounds.
+ *
+ * @param[in,out] tcb   TCB holding the RTO.
+ */
+static void _bound_rto(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->rto < (int32_t) CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
+    }
+    else if (tcb->rto > (int32_t) CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS;
+    }
+}
+
+/**
+ * @brief Calculates the RTO from the current round trip time estimation.
+ *
+ * @param[in,out] tcb   TCB holding the round trip time estimation.
+ */
+static void _calc_rto(gnrc_tcp_tcb_t *tcb)
+{
+    /* Without measurement: rto is 1 sec (Lower Bound) */
+    if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
+    }
+    else {
+        tcb->rto = tcb->srtt + _max(CONFIG_GNRC_TCP_RTO_GRANULARITY_MS,
+                                    CONFIG_GNRC_TCP_RTO_K * tcb->rtt_var);
+    }
+    _bound_rto(tcb);
+}
+
 int _gnrc_tcp_pkt_build_reset_from_pkt(gnrc_pktsnip_t **out_pkt,
                                        gnrc_pktsnip_t *in_pkt)
 {
@@ -177,9 +235,24 @@ int _gnrc_tcp_pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt,
     tcp_hdr.urgent_ptr = byteorder_htons(0);
 
     /* Calculate option field size. */
+    bool sack_perm = false;
+    uint8_t sack_blocks = 0;
+
     /* Add MSS option if SYN is sent */
     if (ctl & MSK_SYN) {
         offset += 1;
+
+        /* Offer SACK in SYN, accept it in SYN+ACK if the peer offered it */
+        if (IS_ACTIVE(CONFIG_GNRC_TCP_SACK_EN) &&
+            (!(ctl & MSK_ACK) || (tcb->status & STATUS_SACK_PERMITTED))) {
+            sack_perm = true;
+            offset += 1;
+        }
+    }
+    /* Report data received out of order */
+    else if ((ctl & MSK_ACK) && (tcb->status & STATUS_SACK_PERMITTED)) {
+        sack_blocks = tcb->ooo_num;
+        offset += (sack_blocks > 0) ? 1 + 2 * sack_blocks : 0;
     }
     /* Set offset and control bit accordingly */
     tcp_hdr.off_ctl = byteorder_htons(
@@ -206,10 +279,10 @@ int _gnrc_tcp_pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt,
         /* Add options if existing */
         if (TCP_HDR_OFFSET_MIN < offset) {
             uint8_t *opt_ptr = (uint8_t *) tcp_snp->data + sizeof(tcp_hdr);
-            uint8_t opt_left = (offset - TCP_HDR_OFFSET_MIN) * sizeof(network_uint32_t);
 
             /* Init options field with 'End Of List' - option (0) */
-            memset(opt_ptr, TCP_OPTION_KIND_EOL, opt_left);
+            memset(opt_ptr, TCP_OPTION_KIND_EOL,
+                   (offset - TCP_HDR_OFFSET_MIN) * sizeof(network_uint32_t));
 
             /* If SYN flag is set: Add MSS option */
             if (ctl & MSK_SYN) {
@@ -217,8 +290,33 @@ int _gnrc_tcp_pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt,
                     _gnrc_tcp_option_build_mss(CONFIG_GNRC_TCP_MSS));
 
                 memcpy(opt_ptr, &mss_option, sizeof(mss_option));
+                opt_ptr += sizeof(mss_option);
+            }
+            /* Add SACK permitted option */
+            if (sack_perm) {
+                network_uint32_t sack_perm_option = byteorder_htonl(
+                    _gnrc_tcp_option_build_sack_perm());
+
+                memcpy(opt_ptr, &sack_perm_option, sizeof(sack_perm_option));
+                opt_ptr += sizeof(sack_perm_option);
+            }
+            /* Add SACK option, most recently received range first (see RFC 2018) */
+            if (sack_blocks > 0) {
+                network_uint32_t sack_option = byteorder_htonl(
+                    _gnrc_tcp_option_build_sack(sack_blocks));
+
+                memcpy(opt_ptr, &sack_option, sizeof(sack_option));
+                opt_ptr += sizeof(sack_option);
+                for (unsigned i = 0; i < sack_blocks; i++) {
+                    network_uint32_t edge = byteorder_htonl(tcb->ooo[i].left);
+
+                    memcpy(opt_ptr, &edge, sizeof(edge));
+                    opt_ptr += sizeof(edge);
+                    edge = byteorder_htonl(tcb->ooo[i].right);
+                    memcpy(opt_ptr, &edge, sizeof(edge));
+                    opt_ptr += sizeof(edge);
+                }
             }
-            /* Increase opt_ptr and decrease opt_left, if other options are added */
             /* NOTE: Add additional options here */
         }
         *(out_pkt) = tcp_snp;
@@ -285,11 +383,9 @@ int _gnrc_tcp_pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt,
         return -EINVAL;
     }
 
-    /* If this is no retransmission, advance sequence number and measure time */
+    /* If this is no retransmission, advance sequence number */
     if (!retransmit) {
-        tcb->retries = 0;
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = evtimer_now_msec();
     }
     else {
         tcb->retries += 1;
@@ -391,7 +487,7 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
     }
 
     /* Check if retransmit queue is full and pkt is not already in retransmit queue */
-    if (tcb->pkt_retransmit != NULL && tcb->pkt_retransmit != pkt) {
+    if (!retransmit && tcb->rtx_num >= ARRAY_SIZE(tcb->pkt_retransmit)) {
         TCP_DEBUG_ERROR("-ENOMEM: Retransmit queue is full.");
         TCP_DEBUG_LEAVE;
         return -ENOMEM;
@@ -408,22 +504,33 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
         return 0;
     }
 
-    /* Assign pkt and increase users: every send attempt consumes a user */
-    tcb->pkt_retransmit = pkt;
+    /* Increase users: every send attempt consumes a user */
     gnrc_pktbuf_hold(pkt, 1);
 
     /* RTO adjustment */
     if (!retransmit) {
-        /* If this is the first transmission: rto is 1 sec (Lower Bound) */
-        if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
-            tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
+        /* Append pkt to the queue */
+        tcb->pkt_retransmit[tcb->rtx_num++] = pkt;
+
+        /* Time one segment per round trip */
+        if (!(tcb->status & STATUS_RTT_PENDING)) {
+            tcb->status |= STATUS_RTT_PENDING;
+            tcb->rtt_seq = _get_seq_num(pkt) + _gnrc_tcp_pkt_get_seg_len(pkt);
+            tcb->rtt_start = evtimer_now_msec();
         }
-        else {
-            tcb->rto = tcb->srtt + _max(CONFIG_GNRC_TCP_RTO_GRANULARITY_MS,
-                                        CONFIG_GNRC_TCP_RTO_K * tcb->rtt_var);
+
+        /* The timer is running already for the oldest packet in the queue */
+        if (tcb->rtx_num > 1) {
+            TCP_DEBUG_LEAVE;
+            return 0;
         }
+        tcb->rtx_start = evtimer_now_msec();
+        _calc_rto(tcb);
     }
     else {
+        /* The timed segment could be retransmitted (Karns Algorithm) */
+        tcb->status &= ~STATUS_RTT_PENDING;
+
         /* If this is a retransmission: Double the rto (Timer Backoff) */
         tcb->rto *= 2;
 
@@ -433,14 +540,7 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
             tcb->srtt = RTO_UNINITIALIZED;
             tcb->rtt_var = RTO_UNINITIALIZED;
         }
-    }
-
-    /* Perform boundary checks on current RTO before usage */
-    if (tcb->rto < (int32_t) CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS) {
-        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
-    }
-    else if (tcb->rto > (int32_t) CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS) {
-        tcb->rto = CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS;
+        _bound_rto(tcb);
     }
 
     /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
@@ -453,35 +553,45 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
 int _gnrc_tcp_pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
 {
     TCP_DEBUG_ENTER;
-    uint32_t seg = 0;
-    gnrc_pktsnip_t *snp = NULL;
-    tcp_hdr_t *hdr;
+    unsigned acked = 0;
 
     /* Retransmission queue is empty. Nothing to ACK there */
-    if (tcb->pkt_retransmit == NULL) {
+    if (tcb->rtx_num == 0) {
         TCP_DEBUG_ERROR("-ENODATA: No packet to acknowledge.");
         TCP_DEBUG_LEAVE;
         return -ENODATA;
     }
 
-    snp = gnrc_pktsnip_search_type(tcb->pkt_retransmit, GNRC_NETTYPE_TCP);
-    hdr = (tcp_hdr_t *) snp->data;
-
-    /* There must be a packet, waiting to be acknowledged. */
-    seg = byteorder_ntohl(hdr->seq_num) + _gnrc_tcp_pkt_get_seg_len(
-        tcb->pkt_retransmit) - 1;
+    /* Release all packets that were acknowledged completely */
+    while (acked < tcb->rtx_num) {
+        gnrc_pktsnip_t *pkt = tcb->pkt_retransmit[acked];
+        uint32_t seg = _get_seq_num(pkt) + _gnrc_tcp_pkt_get_seg_len(pkt) - 1;
 
-        /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
-    if (LSS_32_BIT(seg, ack)) {
-        _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+        if (!LSS_32_BIT(seg, ack)) {
+            break;
+        }
+        gnrc_pktbuf_release(pkt);
+        acked++;
+    }
+    if (acked == 0) {
+        TCP_DEBUG_LEAVE;
+        return 0;
+    }
+    tcb->rtx_num -= acked;
+    memmove(tcb->pkt_retransmit, &tcb->pkt_retransmit[acked],
+            tcb->rtx_num * sizeof(tcb->pkt_retransmit[0]));
+    tcb->rtx_sacked >>= acked;
+    tcb->rtx_start = evtimer_now_msec();
+    tcb->retries = 0;
 
-        /* Measure round trip time */
+    /* Measure round trip time, if the timed segment was acknowledged */
+    if ((tcb->status & STATUS_RTT_PENDING) && LEQ_32_BIT(tcb->rtt_seq, ack)) {
         int32_t rtt = evtimer_now_msec() - tcb->rtt_start;
 
-        /* Use time only if there was no timer overflow and no retransmission (Karns Algorithm) */
-        if (tcb->retries == 0 && rtt > 0) {
+        tcb->status &= ~STATUS_RTT_PENDING;
+
+        /* Use time only if there was no timer overflow */
+        if (rtt > 0) {
             /* If this is the first sample taken */
             if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
                 tcb->srtt = rtt;
@@ -496,10 +606,66 @@ int _gnrc_tcp_pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
             }
         }
     }
+
+    /* Restart the timer for the oldest packet still in flight (see RFC 6298) */
+    _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
+    if (tcb->rtx_num > 0) {
+        _calc_rto(tcb);
+        _gnrc_tcp_eventloop_sched(&tcb->event_retransmit, tcb->rto,
+                                  MSG_TYPE_RETRANSMISSION, tcb);
+    }
     TCP_DEBUG_LEAVE;
     return 0;
 }
 
+void _gnrc_tcp_pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left,
+                        const uint32_t right)
+{
+    TCP_DEBUG_ENTER;
+    for (unsigned i = 0; i < tcb->rtx_num; i++) {
+        gnrc_pktsnip_t *pkt = tcb->pkt_retransmit[i];
+        uint32_t seq = _get_seq_num(pkt);
+
+        if (LEQ_32_BIT(left, seq) &&
+            LEQ_32_BIT(seq + _gnrc_tcp_pkt_get_seg_len(pkt), right)) {
+            tcb->rtx_sacked |= (1 << i);
+        }
+    }
+    TCP_DEBUG_LEAVE;
+}
+
+int _gnrc_tcp_pkt_fast_retransmit(gnrc_tcp_tcb_t *tcb)
+{
+    TCP_DEBUG_ENTER;
+    for (unsigned i = 0; i < tcb->rtx_num; i++) {
+        if (!(tcb->rtx_sacked & (1 << i))) {
+            /* The timed segment could be retransmitted (Karns Algorithm) */
+            tcb->status &= ~STATUS_RTT_PENDING;
+            gnrc_pktbuf_hold(tcb->pkt_retransmit[i], 1);
+            _gnrc_tcp_pkt_send(tcb, tcb->pkt_retransmit[i], 0, true);
+            TCP_DEBUG_LEAVE;
+            return 0;
+        }
+    }
+    TCP_DEBUG_LEAVE;
+    return -ENODATA;
+}
+
+void _gnrc_tcp_pkt_clear_retransmit(gnrc_tcp_tcb_t *tcb)
+{
+    TCP_DEBUG_ENTER;
+    if (tcb->rtx_num > 0) {
+        _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
+        for (unsigned i = 0; i < tcb->rtx_num; i++) {
+            gnrc_pktbuf_release(tcb->pkt_retransmit[i]);
+        }
+        tcb->rtx_num = 0;
+        tcb->rtx_sacked = 0;
+    }
+    tcb->status &= ~STATUS_RTT_PENDING;
+    TCP_DEBUG_LEAVE;
+}
+
 uint16_t _gnrc_tcp_pkt_calc_csum(const gnrc_pktsnip_t *hdr,
                                  const gnrc_pktsnip_t *pseudo_hdr,
                                  const gnrc_pktsnip_t *payload)
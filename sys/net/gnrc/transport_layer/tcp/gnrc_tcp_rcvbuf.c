@@ -18,6 +18,7 @@
 #include <errno.h>
 #include <mutex.h>
 #include <stdint.h>
+#include <string.h>
 #include "net/gnrc/tcp/config.h"
 #include "include/gnrc_tcp_common.h"
 #include "include/gnrc_tcp_rcvbuf.h"
@@ -109,6 +110,7 @@ int _gnrc_tcp_rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
         }
         else {
             ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, GNRC_TCP_RCV_BUF_SIZE);
+            tcb->ooo_num = 0;
         }
     }
     TCP_DEBUG_LEAVE;
@@ -121,6 +123,147 @@ void _gnrc_tcp_rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
     if (tcb->rcv_buf_raw != NULL) {
         _rcvbuf_free(tcb->rcv_buf_raw);
         tcb->rcv_buf_raw = NULL;
+        tcb->ooo_num = 0;
     }
     TCP_DEBUG_LEAVE;
 }
+
+/**
+ * @brief Copies data into the free space of the receive buffer.
+ *
+ * @param[in,out] rb       Receive buffer.
+ * @param[in]     offset   Offset of the data behind the readable data.
+ * @param[in]     data     Data to copy.
+ * @param[in]     len      Number of bytes to copy.
+ */
+static void _write_at(ringbuffer_t *rb, uint32_t offset, const uint8_t *data,
+                      size_t len)
+{
+    unsigned pos = (rb->start + rb->avail + offset) % rb->size;
+
+    while (len > 0) {
+        size_t chunk = rb->size - pos;
+
+        chunk = (chunk < len) ? chunk : len;
+        memcpy(rb->buf + pos, data, chunk);
+        data += chunk;
+        len -= chunk;
+        pos = 0;
+    }
+}
+
+/**
+ * @brief Adds a range of data received out of order.
+ *
+ * @note Overlapping and adjacent ranges are merged. The range that was added
+ *       last is kept first, so it is reported in the first SACK block
+ *       (see RFC 2018). The oldest range is dropped if there is no space.
+ *
+ * @param[in,out] tcb     TCB holding the ranges.
+ * @param[in]     left    First sequence number of the range.
+ * @param[in]     right   Sequence number following the range.
+ */
+static void _ooo_add(gnrc_tcp_tcb_t *tcb, uint32_t left, uint32_t right)
+{
+    unsigned i = 0;
+
+    while (i < tcb->ooo_num) {
+        gnrc_tcp_ooo_range_t *range = &tcb->ooo[i];
+
+        if (LEQ_32_BIT(range->left, right) && LEQ_32_BIT(left, range->right)) {
+            left = LSS_32_BIT(range->left, left) ? range->left : left;
+            right = LSS_32_BIT(right, range->right) ? range->right : right;
+            tcb->ooo_num--;
+            memmove(range, range + 1, (tcb->ooo_num - i) * sizeof(*range));
+        }
+        else {
+            i++;
+        }
+    }
+    if (tcb->ooo_num == ARRAY_SIZE(tcb->ooo)) {
+        tcb->ooo_num--;
+    }
+    memmove(&tcb->ooo[1], &tcb->ooo[0], tcb->ooo_num * sizeof(tcb->ooo[0]));
+    tcb->ooo[0].left = left;
+    tcb->ooo[0].right = right;
+    tcb->ooo_num++;
+}
+
+/**
+ * @brief Makes ranges readable that became contiguous to the readable data.
+ *
+ * @param[in,out] tcb   TCB holding the ranges.
+ *
+ * @returns   Number of bytes that became readable.
+ */
+static size_t _ooo_merge(gnrc_tcp_tcb_t *tcb)
+{
+    size_t merged = 0;
+    unsigned i = 0;
+
+    while (i < tcb->ooo_num) {
+        gnrc_tcp_ooo_range_t *range = &tcb->ooo[i];
+
+        if (LEQ_32_BIT(range->left, tcb->rcv_nxt)) {
+            if (LSS_32_BIT(tcb->rcv_nxt, range->right)) {
+                uint32_t len = range->right - tcb->rcv_nxt;
+
+                ringbuffer_commit(&tcb->rcv_buf, len);
+                tcb->rcv_nxt += len;
+                merged += len;
+            }
+            tcb->ooo_num--;
+            memmove(range, range + 1, (tcb->ooo_num - i) * sizeof(*range));
+            /* rcv_nxt advanced, ranges before i may fit now */
+            i = 0;
+        }
+        else {
+            i++;
+        }
+    }
+    return merged;
+}
+
+size_t _gnrc_tcp_rcvbuf_add(gnrc_tcp_tcb_t *tcb, uint32_t seq_num,
+                            gnrc_pktsnip_t *payload)
+{
+    TCP_DEBUG_ENTER;
+    ringbuffer_t *rb = &tcb->rcv_buf;
+    uint32_t end = tcb->rcv_nxt + ringbuffer_get_free(rb);
+    uint32_t left = LSS_32_BIT(seq_num, tcb->rcv_nxt) ? tcb->rcv_nxt : seq_num;
+    uint32_t right = left;
+    size_t rcvd = 0;
+
+    /* Copy everything that fits into the receive window to its position,
+     * skipping data that was received before */
+    for (uint32_t seq = seq_num; payload && payload->type == GNRC_NETTYPE_UNDEF;
+         seq += payload->size, payload = payload->next) {
+        uint32_t from = LSS_32_BIT(seq, left) ? left : seq;
+        uint32_t to = seq + payload->size;
+
+        to = LSS_32_BIT(end, to) ? end : to;
+        if (LSS_32_BIT(from, to)) {
+            _write_at(rb, from - tcb->rcv_nxt,
+                      (uint8_t *) payload->data + (from - seq), to - from);
+            right = to;
+        }
+    }
+    if (right == left) {
+        TCP_DEBUG_LEAVE;
+        return 0;
+    }
+
+    /* Data in order is readable right away, everything else waits for the gap */
+    if (left == tcb->rcv_nxt) {
+        ringbuffer_commit(rb, right - left);
+        tcb->rcv_nxt = right;
+        rcvd = right - left;
+    }
+    else {
+        _ooo_add(tcb, left, right);
+    }
+    rcvd += _ooo_merge(tcb);
+    tcb->rcv_wnd = ringbuffer_get_free(rb);
+    TCP_DEBUG_LEAVE;
+    return rcvd;
+}
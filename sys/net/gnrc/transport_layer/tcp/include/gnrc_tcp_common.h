@@ -47,6 +47,8 @@ extern "C" {
 #define STATUS_NOTIFY_USER    (1 << 2) /**< Internal: Status bitmask NOTIFY_USER */
 #define STATUS_ACCEPTED       (1 << 3) /**< Internal: Status bitmask ACCEPTED */
 #define STATUS_LOCKED         (1 << 4) /**< Internal: Status bitmask LOCKED */
+#define STATUS_SACK_PERMITTED (1 << 5) /**< Internal: Status bitmask SACK_PERMITTED */
+#define STATUS_RTT_PENDING    (1 << 6) /**< Internal: Status bitmask RTT_PENDING */
 /** @} */
 
 /**
@@ -101,7 +103,7 @@ extern "C" {
 #define LSS_32_BIT(x, y) (((int32_t) (x)) - ((int32_t) (y)) <  0) /**< Internal: operator < */
 #define LEQ_32_BIT(x, y) (((int32_t) (x)) - ((int32_t) (y)) <= 0) /**< Internal: operator <= */
 #define GRT_32_BIT(x, y) (!LEQ_32_BIT(x, y)) /**< Internal: operator > */
-#define GEQ_32_BIT(x, y) (!LSS_32_BOT(x, y)) /**< Internal: operator >= */
+#define GEQ_32_BIT(x, y) (!LSS_32_BIT(x, y)) /**< Internal: operator >= */
 /** @} */
 
 /**
@@ -42,6 +42,33 @@ static inline uint32_t _gnrc_tcp_option_build_mss(uint16_t mss)
             ((uint32_t) TCP_OPTION_LENGTH_MSS << 16) | mss);
 }
 
+/**
+ * @brief Helper function to build the SACK permitted option, padded with NOPs.
+ *
+ * @returns   SACK permitted option value.
+ */
+static inline uint32_t _gnrc_tcp_option_build_sack_perm(void)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_NOP << 16) |
+            ((uint32_t) TCP_OPTION_KIND_SACK_PERM << 8) | TCP_OPTION_LENGTH_SACK_PERM);
+}
+
+/**
+ * @brief Helper function to build the head of the SACK option, padded with NOPs.
+ *
+ * @param[in] blocks   Number of SACK blocks following the head.
+ *
+ * @returns   Head of the SACK option.
+ */
+static inline uint32_t _gnrc_tcp_option_build_sack(uint8_t blocks)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_NOP << 16) |
+            ((uint32_t) TCP_OPTION_KIND_SACK << 8) |
+            (TCP_OPTION_LENGTH_MIN + blocks * TCP_OPTION_LENGTH_SACK_BLOCK));
+}
+
 /**
  * @brief Helper function to build the combined option and control flag field.
  *
@@ -133,6 +133,62 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
  */
 int _gnrc_tcp_pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack);
 
+/**
+ * @brief Marks packets in the retransmission queue as selectively acknowledged.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     left    First sequence number of the SACK block.
+ * @param[in]     right   Sequence number following the SACK block.
+ */
+void _gnrc_tcp_pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left,
+                        const uint32_t right);
+
+/**
+ * @brief Retransmits the oldest packet that was not selectively acknowledged
+ *        without waiting for the retransmission timer.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ *
+ * @returns   Zero on success.
+ *            -ENODATA if there is nothing to retransmit.
+ */
+int _gnrc_tcp_pkt_fast_retransmit(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Releases all packets in the retransmission queue and stops the
+ *        retransmission timer.
+ *
+ * @param[in,out] tcb   TCB holding the retransmission queue.
+ */
+void _gnrc_tcp_pkt_clear_retransmit(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Gets the number of free entries for data packets in the
+ *        retransmission queue.
+ *
+ * @param[in] tcb   TCB holding the retransmission queue.
+ *
+ * @returns   Number of data packets that can be sent.
+ */
+static inline unsigned _gnrc_tcp_pkt_retransmit_free(const gnrc_tcp_tcb_t *tcb)
+{
+    return (tcb->rtx_num < CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE) ?
+           CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE - tcb->rtx_num : 0;
+}
+
+/**
+ * @brief Gets the size of the largest segment that may be sent to the peer.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Sender maximum segment size in bytes.
+ */
+static inline uint32_t _gnrc_tcp_pkt_get_smss(const gnrc_tcp_tcb_t *tcb)
+{
+    return ((tcb->mss > 0) && (tcb->mss < CONFIG_GNRC_TCP_MSS)) ?
+           tcb->mss : CONFIG_GNRC_TCP_MSS;
+}
+
 /**
  * @brief Calculates checksum over payload, TCP header and network layer header.
  *
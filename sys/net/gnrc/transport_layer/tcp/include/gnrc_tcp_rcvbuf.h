@@ -20,6 +20,7 @@
 #ifndef GNRC_TCP_RCVBUF_H
 #define GNRC_TCP_RCVBUF_H
 
+#include "net/gnrc/pkt.h"
 #include "net/gnrc/tcp/tcb.h"
 
 #ifdef __cplusplus
@@ -48,6 +49,24 @@ int _gnrc_tcp_rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
  */
 void _gnrc_tcp_rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Adds the payload of a received segment to the receive buffer.
+ *
+ * Data starting at tcb->rcv_nxt becomes readable right away, together with
+ * data received before that is contiguous to it now. Data behind a gap is
+ * kept at its position in the receive buffer until the gap is filled. Data
+ * received before and data outside of the receive window are skipped.
+ * tcb->rcv_nxt and tcb->rcv_wnd are updated accordingly.
+ *
+ * @param[in,out] tcb       TCB holding the receive buffer.
+ * @param[in]     seq_num   Sequence number of the segment.
+ * @param[in]     payload   First payload snip of the segment.
+ *
+ * @returns   Number of bytes that became readable.
+ */
+size_t _gnrc_tcp_rcvbuf_add(gnrc_tcp_tcb_t *tcb, uint32_t seq_num,
+                            gnrc_pktsnip_t *payload);
+
 #ifdef __cplusplus
 }
 #endif
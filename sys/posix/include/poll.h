@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup posix_poll     POSIX poll
+ * @ingroup  posix
+ * @brief   Poll and epoll implementation for RIOT
+ *
+ * `poll()` waits for events on a set of file descriptors. Unlike `select()`
+ * it is not limited by `FD_SETSIZE` and also reports if a socket can be
+ * written to or was closed by its peer.
+ *
+ * Readiness of [sockets](@ref posix_sockets) is tracked by the asynchronous
+ * callbacks of @ref net_sock_async, so a sock implementation that supports
+ * them is required. Other file descriptors of @ref sys_vfs, e.g. regular
+ * files, are always ready to be read and written.
+ *
+ * For a large number of file descriptors that are waited on again and again,
+ * use the interest list of `<sys/epoll.h>`, which costs time proportional to
+ * the number of ready file descriptors instead of all of them.
+ *
+ * @see     [The Open Group Base Specification Issue 7]
+ *          (https://pubs.opengroup.org/onlinepubs/9699919799.2018edition/)
+ * @{
+ *
+ * @file
+ * @brief   Poll definitions
+ * @see     [The Open Group Base Specification Issue 7, 2018 edition,
+ *          <poll.h>](https://pubs.opengroup.org/onlinepubs/9699919799.2018edition/basedefs/poll.h.html)
+ */
+
+#ifndef POLL_H
+#define POLL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   @ref core_thread_flags for POSIX poll
+ *
+ * Same as the flag of `select()`, so a socket can wake a thread in either.
+ */
+#define POSIX_POLL_THREAD_FLAG  (1U << 3)
+
+/**
+ * @name    Events of a file descriptor
+ * @{
+ */
+#define POLLIN      (0x0001)    /**< data may be read without blocking */
+#define POLLPRI     (0x0002)    /**< priority data may be read (unused) */
+#define POLLOUT     (0x0004)    /**< data may be written without blocking */
+#define POLLERR     (0x0008)    /**< an error occurred (revents only) */
+#define POLLHUP     (0x0010)    /**< peer closed the connection
+                                 *   (revents only) */
+#define POLLNVAL    (0x0020)    /**< invalid file descriptor (revents only) */
+#define POLLRDNORM  POLLIN      /**< normal data may be read */
+#define POLLWRNORM  POLLOUT     /**< normal data may be written */
+/** @} */
+
+/**
+ * @brief   Type for the number of entries given to `poll()`
+ */
+typedef unsigned int nfds_t;
+
+/**
+ * @brief   File descriptor to poll
+ */
+struct pollfd {
+    int fd;         /**< file descriptor, negative ones are ignored */
+    short events;   /**< requested events */
+    short revents;  /**< returned events */
+};
+
+/**
+ * @brief   Waits for events on a set of file descriptors
+ *
+ * @see [The Open Group Base Specification Issue 7, 2018 edition, poll()]
+ *      (https://pubs.opengroup.org/onlinepubs/9699919799.2018edition/functions/poll.html)
+ *
+ * @param[in,out] fds   The file descriptors and their requested events.
+ *                      Returns the events that occurred in
+ *                      pollfd::revents. `POLLERR`, `POLLHUP` and `POLLNVAL`
+ *                      are always reported.
+ * @param[in] nfds      Number of entries in @p fds
+ * @param[in] timeout   Time to wait in ms, 0 to return immediately and
+ *                      -1 to wait without timeout
+ *
+ * @return  Number of entries in @p fds with pollfd::revents other than 0.
+ * @return  0, if the timeout expired.
+ * @return  -1 on error, errno is set to indicate the error.
+ */
+int poll(struct pollfd fds[], nfds_t nfds, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POLL_H */
+/** @} */
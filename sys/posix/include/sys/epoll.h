@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  posix_poll
+ * @{
+ *
+ * @file
+ * @brief   Interest list for file descriptors like Linux' epoll
+ *
+ * An epoll instance keeps the file descriptors added with epoll_ctl(). When
+ * a socket in it becomes ready, its asynchronous callback puts it on the
+ * ready list of the instance, so epoll_wait() only looks at ready file
+ * descriptors. Level-triggered entries that were reported stay on the ready
+ * list until they are no longer ready, edge-triggered (`EPOLLET`) ones until
+ * they were reported once.
+ *
+ * Only [sockets](@ref posix_sockets) can be added, and each only to one
+ * instance at a time: adding it to a second one fails with `EBUSY`. A file
+ * descriptor must be removed with `EPOLL_CTL_DEL` before it is closed,
+ * otherwise it is dropped from the instance by the next epoll_wait() that
+ * finds it closed.
+ *
+ * @see     [epoll(7)](https://man7.org/linux/man-pages/man7/epoll.7.html)
+ */
+
+#ifndef SYS_EPOLL_H
+#define SYS_EPOLL_H
+
+#include <stdint.h>
+
+#include "poll.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup  config_posix
+ * @{
+ */
+/**
+ * @brief   Maximum number of epoll instances
+ */
+#ifndef CONFIG_POSIX_EPOLL_NUMOF
+#define CONFIG_POSIX_EPOLL_NUMOF    (1U)
+#endif
+
+/**
+ * @brief   Maximum number of file descriptors in all epoll instances
+ */
+#ifndef CONFIG_POSIX_EPOLL_FDS
+#define CONFIG_POSIX_EPOLL_FDS      (8U)
+#endif
+/** @} */
+
+/**
+ * @name    Events of a file descriptor
+ * @{
+ */
+#define EPOLLIN         POLLIN          /**< see `POLLIN` */
+#define EPOLLPRI        POLLPRI         /**< see `POLLPRI` */
+#define EPOLLOUT        POLLOUT         /**< see `POLLOUT` */
+#define EPOLLERR        POLLERR         /**< see `POLLERR` */
+#define EPOLLHUP        POLLHUP         /**< see `POLLHUP` */
+#define EPOLLONESHOT    (1UL << 30)     /**< disable the file descriptor after
+                                         *   it was reported once */
+#define EPOLLET         (1UL << 31)     /**< edge-triggered */
+/** @} */
+
+/**
+ * @name    Operations of epoll_ctl()
+ * @{
+ */
+#define EPOLL_CTL_ADD   (1)     /**< add a file descriptor */
+#define EPOLL_CTL_DEL   (2)     /**< remove a file descriptor */
+#define EPOLL_CTL_MOD   (3)     /**< change the events of a file descriptor */
+/** @} */
+
+/**
+ * @brief   Flag for epoll_create1(), accepted for compatibility only
+ */
+#define EPOLL_CLOEXEC   (0x80000)
+
+/**
+ * @brief   User data of a file descriptor
+ */
+typedef union epoll_data {
+    void *ptr;          /**< pointer */
+    int fd;             /**< file descriptor */
+    uint32_t u32;       /**< 32 bit integer */
+    uint64_t u64;       /**< 64 bit integer */
+} epoll_data_t;
+
+/**
+ * @brief   Event of a file descriptor
+ */
+struct epoll_event {
+    uint32_t events;    /**< events */
+    epoll_data_t data;  /**< user data */
+};
+
+/**
+ * @brief   Creates an epoll instance
+ *
+ * @param[in] flags     0 or `EPOLL_CLOEXEC`
+ *
+ * @return  File descriptor of the instance, close it with `close()`.
+ * @return  -1 on error, errno is set to indicate the error.
+ */
+int epoll_create1(int flags);
+
+/**
+ * @brief   Creates an epoll instance
+ *
+ * @param[in] size      Ignored, but must be greater than 0
+ *
+ * @return  File descriptor of the instance, close it with `close()`.
+ * @return  -1 on error, errno is set to indicate the error.
+ */
+int epoll_create(int size);
+
+/**
+ * @brief   Adds, changes or removes a file descriptor of an epoll instance
+ *
+ * @param[in] epfd      File descriptor of the epoll instance
+ * @param[in] op        `EPOLL_CTL_ADD`, `EPOLL_CTL_MOD` or `EPOLL_CTL_DEL`
+ * @param[in] fd        The file descriptor, must be a socket
+ * @param[in] event     Requested events and the user data to return for
+ *                      @p fd. May be NULL for `EPOLL_CTL_DEL`.
+ *
+ * @return  0 on success.
+ * @return  -1 on error, errno is set to indicate the error.
+ */
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event);
+
+/**
+ * @brief   Waits for events on the file descriptors of an epoll instance
+ *
+ * Only one thread may wait on an epoll instance at a time.
+ *
+ * @param[in] epfd      File descriptor of the epoll instance
+ * @param[out] events   The events that occurred
+ * @param[in] maxevents Maximum number of entries in @p events
+ * @param[in] timeout   Time to wait in ms, 0 to return immediately and
+ *                      -1 to wait without timeout
+ *
+ * @return  Number of entries in @p events.
+ * @return  0, if the timeout expired.
+ * @return  -1 on error, errno is set to indicate the error.
+ */
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents,
+               int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SYS_EPOLL_H */
+/** @} */
@@ -0,0 +1,371 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup posix_poll
+ * @{
+ * @file
+ * @brief   epoll implementation
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <sys/epoll.h>
+
+#include "clist.h"
+#include "irq.h"
+#include "mutex.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+#include "posix_poll_sockets.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+typedef struct epoll_instance _epoll_t;
+
+/**
+ * @brief   File descriptor in an epoll instance
+ *
+ * node, ep and ready are also changed by the event callback of the socket,
+ * so they are only changed with interrupts disabled.
+ */
+typedef struct {
+    clist_node_t node;      /**< entry in the ready list of ep */
+    _epoll_t *ep;           /**< the instance, NULL if the entry is unused */
+    int fd;                 /**< the file descriptor */
+    uint32_t events;        /**< requested events, 0 when disabled */
+    epoll_data_t data;      /**< user data */
+    bool ready;             /**< entry is in the ready list */
+} _epoll_item_t;
+
+/**
+ * @brief   epoll instance
+ */
+struct epoll_instance {
+    clist_node_t ready;     /**< file descriptors that may be ready */
+    thread_t *waiter;       /**< thread in epoll_wait() */
+    bool used;              /**< instance is in use */
+};
+
+static int _epoll_close(vfs_file_t *filp);
+
+static const vfs_file_ops_t _epoll_ops = {
+    .close = _epoll_close,
+};
+
+static _epoll_t _instances[CONFIG_POSIX_EPOLL_NUMOF];
+static _epoll_item_t _items[CONFIG_POSIX_EPOLL_FDS];
+/* protects the entries against concurrent epoll_ctl() and epoll_wait() */
+static mutex_t _lock = MUTEX_INIT;
+
+static _epoll_t *_get_instance(int epfd)
+{
+    const vfs_file_t *filp = vfs_file_get(epfd);
+
+    if ((filp == NULL) || (filp->f_op != &_epoll_ops)) {
+        errno = (filp == NULL) ? EBADF : EINVAL;
+        return NULL;
+    }
+    return filp->private_data.ptr;
+}
+
+static _epoll_item_t *_find(const _epoll_t *ep, int fd)
+{
+    for (unsigned i = 0; i < CONFIG_POSIX_EPOLL_FDS; i++) {
+        if ((_items[i].ep == ep) && (_items[i].fd == fd)) {
+            return &_items[i];
+        }
+    }
+    return NULL;
+}
+
+/* called by the socket on events, possibly in interrupt context */
+static void _notify(void *arg)
+{
+    _epoll_item_t *item = arg;
+    thread_t *waiter = NULL;
+    unsigned state = irq_disable();
+
+    if (item->ep != NULL) {
+        if (!item->ready) {
+            item->ready = true;
+            clist_rpush(&item->ep->ready, &item->node);
+        }
+        waiter = item->ep->waiter;
+    }
+    irq_restore(state);
+    if (waiter != NULL) {
+        thread_flags_set(waiter, POSIX_POLL_THREAD_FLAG);
+    }
+}
+
+static void _item_free(_epoll_item_t *item, bool unwatch)
+{
+    if (unwatch) {
+        posix_socket_watch(item->fd, NULL, NULL);
+    }
+    unsigned state = irq_disable();
+    if (item->ready) {
+        clist_remove(&item->ep->ready, &item->node);
+        item->ready = false;
+    }
+    item->ep = NULL;
+    irq_restore(state);
+}
+
+static int _epoll_close(vfs_file_t *filp)
+{
+    _epoll_t *ep = filp->private_data.ptr;
+
+    mutex_lock(&_lock);
+    for (unsigned i = 0; i < CONFIG_POSIX_EPOLL_FDS; i++) {
+        if (_items[i].ep == ep) {
+            _item_free(&_items[i], true);
+        }
+    }
+    ep->used = false;
+    mutex_unlock(&_lock);
+    return 0;
+}
+
+int epoll_create1(int flags)
+{
+    _epoll_t *ep = NULL;
+    int res;
+
+    if (flags & ~EPOLL_CLOEXEC) {
+        errno = EINVAL;
+        return -1;
+    }
+    mutex_lock(&_lock);
+    for (unsigned i = 0; i < CONFIG_POSIX_EPOLL_NUMOF; i++) {
+        if (!_instances[i].used) {
+            ep = &_instances[i];
+            break;
+        }
+    }
+    if (ep == NULL) {
+        mutex_unlock(&_lock);
+        errno = ENFILE;
+        return -1;
+    }
+    if ((res = vfs_bind(VFS_ANY_FD, O_RDONLY, &_epoll_ops, ep)) < 0) {
+        mutex_unlock(&_lock);
+        errno = -res;
+        return -1;
+    }
+    ep->ready.next = NULL;
+    ep->waiter = NULL;
+    ep->used = true;
+    mutex_unlock(&_lock);
+    return res;
+}
+
+int epoll_create(int size)
+{
+    if (size <= 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    return epoll_create1(0);
+}
+
+static int _add(_epoll_t *ep, int fd, const struct epoll_event *event)
+{
+    _epoll_item_t *item = NULL;
+    int res;
+
+    if (_find(ep, fd) != NULL) {
+        return -EEXIST;
+    }
+    for (unsigned i = 0; i < CONFIG_POSIX_EPOLL_FDS; i++) {
+        if (_items[i].ep == NULL) {
+            item = &_items[i];
+            break;
+        }
+    }
+    if (item == NULL) {
+        return -ENOMEM;
+    }
+    item->fd = fd;
+    item->events = event->events;
+    item->data = event->data;
+    item->ready = false;
+    item->ep = ep;
+    if ((res = posix_socket_watch(fd, _notify, item)) < 0) {
+        item->ep = NULL;
+        return res;
+    }
+    /* let epoll_wait() check if it is ready already */
+    _notify(item);
+    return 0;
+}
+
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event)
+{
+    _epoll_t *ep = _get_instance(epfd);
+    _epoll_item_t *item;
+    int res = 0;
+
+    if (ep == NULL) {
+        return -1;
+    }
+    if (vfs_file_get(fd) == NULL) {
+        errno = EBADF;
+        return -1;
+    }
+    if (!posix_socket_is(fd)) {
+        /* like Linux for files that are always ready */
+        errno = (fd == epfd) ? EINVAL : EPERM;
+        return -1;
+    }
+    if ((op != EPOLL_CTL_DEL) && (event == NULL)) {
+        errno = EFAULT;
+        return -1;
+    }
+    mutex_lock(&_lock);
+    switch (op) {
+        case EPOLL_CTL_ADD:
+            res = _add(ep, fd, event);
+            break;
+        case EPOLL_CTL_MOD:
+            if ((item = _find(ep, fd)) == NULL) {
+                res = -ENOENT;
+                break;
+            }
+            item->events = event->events;
+            item->data = event->data;
+            _notify(item);
+            break;
+        case EPOLL_CTL_DEL:
+            if ((item = _find(ep, fd)) == NULL) {
+                res = -ENOENT;
+                break;
+            }
+            _item_free(item, true);
+            break;
+        default:
+            res = -EINVAL;
+            break;
+    }
+    mutex_unlock(&_lock);
+    if (res < 0) {
+        errno = -res;
+        return -1;
+    }
+    return 0;
+}
+
+/* takes the entries off the ready list that are actually ready */
+static int _collect(_epoll_t *ep, struct epoll_event *events, int maxevents)
+{
+    clist_node_t again = { .next = NULL };
+    clist_node_t *node;
+    unsigned state;
+    int num = 0;
+
+    mutex_lock(&_lock);
+    while (num < maxevents) {
+        state = irq_disable();
+        if ((node = clist_lpop(&ep->ready)) != NULL) {
+            container_of(node, _epoll_item_t, node)->ready = false;
+        }
+        irq_restore(state);
+        if (node == NULL) {
+            break;
+        }
+
+        _epoll_item_t *item = container_of(node, _epoll_item_t, node);
+        unsigned revents = posix_socket_events(item->fd);
+
+        if (revents & POLLNVAL) {
+            DEBUG("epoll: fd %d was closed, dropping it\n", item->fd);
+            _item_free(item, false);
+            continue;
+        }
+        if (item->events == 0) {
+            continue;
+        }
+        revents &= item->events | EPOLLERR | EPOLLHUP;
+        if (revents == 0) {
+            /* wait for the next event of the socket */
+            continue;
+        }
+        events[num].events = revents;
+        events[num].data = item->data;
+        num++;
+        if (item->events & EPOLLONESHOT) {
+            /* until re-armed with EPOLL_CTL_MOD */
+            item->events = 0;
+        }
+        else if (!(item->events & EPOLLET)) {
+            /* level-triggered, check again next time */
+            state = irq_disable();
+            if (!item->ready) {
+                item->ready = true;
+                clist_rpush(&again, node);
+            }
+            irq_restore(state);
+        }
+    }
+    state = irq_disable();
+    while ((node = clist_lpop(&again)) != NULL) {
+        clist_rpush(&ep->ready, node);
+    }
+    irq_restore(state);
+    mutex_unlock(&_lock);
+    return num;
+}
+
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents,
+               int timeout)
+{
+    _epoll_t *ep = _get_instance(epfd);
+    xtimer_t timeout_timer;
+    int num;
+
+    if (ep == NULL) {
+        return -1;
+    }
+    if ((events == NULL) || (maxevents <= 0) ||
+        ((timeout > 0) && ((uint64_t)timeout * US_PER_MS > UINT32_MAX))) {
+        errno = EINVAL;
+        return -1;
+    }
+    /* events from here on wake us up */
+    thread_flags_clear(POSIX_POLL_THREAD_FLAG | THREAD_FLAG_TIMEOUT);
+    ep->waiter = thread_get_active();
+    num = _collect(ep, events, maxevents);
+    if ((num == 0) && (timeout != 0)) {
+        if (timeout > 0) {
+            xtimer_set_timeout_flag(&timeout_timer, timeout * US_PER_MS);
+        }
+        do {
+            thread_flags_t tflags;
+
+            tflags = thread_flags_wait_any(POSIX_POLL_THREAD_FLAG |
+                                           THREAD_FLAG_TIMEOUT);
+            num = _collect(ep, events, maxevents);
+            if (tflags & THREAD_FLAG_TIMEOUT) {
+                break;
+            }
+        } while (num == 0);
+        if (timeout > 0) {
+            xtimer_remove(&timeout_timer);
+        }
+    }
+    ep->waiter = NULL;
+    return num;
+}
+
+/** @} */
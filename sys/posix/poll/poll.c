@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup posix_poll
+ * @{
+ * @file
+ * @brief   poll() implementation
+ */
+
+#include <errno.h>
+#include <poll.h>
+
+#include "thread_flags.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+#include "posix_poll_sockets.h"
+
+static unsigned _events(int fd)
+{
+    if (posix_socket_is(fd)) {
+        return posix_socket_events(fd);
+    }
+    /* other files never block */
+    return (vfs_file_get(fd) != NULL) ? (POLLIN | POLLOUT) : POLLNVAL;
+}
+
+static int _scan(struct pollfd fds[], nfds_t nfds)
+{
+    int ready = 0;
+
+    for (nfds_t i = 0; i < nfds; i++) {
+        if (fds[i].fd < 0) {
+            fds[i].revents = 0;
+            continue;
+        }
+        fds[i].revents = _events(fds[i].fd) &
+                         (fds[i].events | POLLERR | POLLHUP | POLLNVAL);
+        if (fds[i].revents) {
+            ready++;
+        }
+    }
+    return ready;
+}
+
+int poll(struct pollfd fds[], nfds_t nfds, int timeout)
+{
+    xtimer_t timeout_timer;
+    int ready;
+
+    if ((timeout > 0) &&
+        ((uint64_t)timeout * US_PER_MS > UINT32_MAX)) {
+        errno = EINVAL;
+        return -1;
+    }
+    /* events from here on wake us up */
+    thread_flags_clear(POSIX_POLL_THREAD_FLAG | THREAD_FLAG_TIMEOUT);
+    for (nfds_t i = 0; i < nfds; i++) {
+        if ((fds[i].fd >= 0) && posix_socket_is(fds[i].fd)) {
+            posix_socket_select(fds[i].fd);
+        }
+    }
+    ready = _scan(fds, nfds);
+    if ((ready > 0) || (timeout == 0)) {
+        return ready;
+    }
+    if (timeout > 0) {
+        xtimer_set_timeout_flag(&timeout_timer, timeout * US_PER_MS);
+    }
+    do {
+        thread_flags_t tflags = thread_flags_wait_any(POSIX_POLL_THREAD_FLAG |
+                                                      THREAD_FLAG_TIMEOUT);
+
+        ready = _scan(fds, nfds);
+        if (tflags & THREAD_FLAG_TIMEOUT) {
+            break;
+        }
+    } while (ready == 0);
+    if (timeout > 0) {
+        xtimer_remove(&timeout_timer);
+    }
+    return ready;
+}
+
+/** @} */
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup posix_poll
+ * @{
+ * @file
+ * @brief   Readiness of sockets as provided by @ref posix_sockets
+ */
+#ifndef POSIX_POLL_SOCKETS_H
+#define POSIX_POLL_SOCKETS_H
+
+#include <errno.h>
+#include <stdbool.h>
+
+#include <poll.h>
+
+#include "kernel_defines.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if IS_USED(MODULE_POSIX_SOCKETS)
+/**
+ * @brief   Checks if @p fd is a socket whose events can be waited for
+ */
+extern bool posix_socket_is(int fd);
+
+/**
+ * @brief   Makes the calling thread get @ref POSIX_POLL_THREAD_FLAG on events
+ *          of socket @p fd
+ */
+extern int posix_socket_select(int fd);
+
+/**
+ * @brief   Gets the current events of socket @p fd as `POLL*` flags
+ */
+extern unsigned posix_socket_events(int fd);
+
+/**
+ * @brief   Sets a callback for events of socket @p fd, NULL to remove it
+ *
+ * @p cb may be called in interrupt context and when the socket is closed.
+ * A socket has only one callback, it has to be removed before a new one can
+ * be set.
+ *
+ * @return  0 on success
+ * @return  -ENOTSOCK, if @p fd is not a socket
+ * @return  -EBUSY, if @p cb is not NULL and the socket already has a callback
+ * @return  other negative errno, if the socket could not be bound implicitly
+ */
+extern int posix_socket_watch(int fd, void (*cb)(void *), void *arg);
+#else   /* MODULE_POSIX_SOCKETS */
+static inline bool posix_socket_is(int fd)
+{
+    (void)fd;
+    return false;
+}
+
+static inline int posix_socket_select(int fd)
+{
+    (void)fd;
+    return -1;
+}
+
+static inline unsigned posix_socket_events(int fd)
+{
+    (void)fd;
+    return POLLNVAL;
+}
+
+static inline int posix_socket_watch(int fd, void (*cb)(void *), void *arg)
+{
+    (void)fd;
+    (void)cb;
+    (void)arg;
+    return -ENOTSOCK;
+}
+#endif  /* MODULE_POSIX_SOCKETS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POSIX_POLL_SOCKETS_H */
+/** @} */
@@ -43,11 +43,24 @@
 #endif
 #if IS_USED(MODULE_POSIX_SELECT)
 #include <sys/select.h>
+#endif
+#if IS_USED(MODULE_POSIX_POLL)
+#include <poll.h>
 
+#include "irq.h"
+#endif
+#if IS_USED(MODULE_POSIX_SELECT) || IS_USED(MODULE_POSIX_POLL)
 #include "thread.h"
 #include "thread_flags.h"
 #endif
 
+/* poll() and select() wait for the same flag */
+#if IS_USED(MODULE_POSIX_SELECT)
+#define _SELECT_THREAD_FLAG        POSIX_SELECT_THREAD_FLAG
+#elif IS_USED(MODULE_POSIX_POLL)
+#define _SELECT_THREAD_FLAG        POSIX_POLL_THREAD_FLAG
+#endif
+
 /* enough to create sockets both with socket() and accept() */
 #define _ACTUAL_SOCKET_POOL_SIZE   (SOCKET_POOL_SIZE + \
                                     (SOCKET_POOL_SIZE * SOCKET_TCP_QUEUE_SIZE))
@@ -92,9 +105,14 @@ typedef struct {
 #endif
 #if IS_USED(MODULE_SOCK_ASYNC)
     atomic_uint available;
+    bool hup;                   /* peer closed the connection */
 #endif
-#if IS_USED(MODULE_POSIX_SELECT)
+#if IS_USED(MODULE_POSIX_SELECT) || IS_USED(MODULE_POSIX_POLL)
     thread_t *selecting_thread;
+#endif
+#if IS_USED(MODULE_POSIX_POLL)
+    void (*watch_cb)(void *);   /* called on every event, for epoll */
+    void *watch_arg;
 #endif
     sock_tcp_ep_t local;        /* to store bind before connect/listen */
 } socket_t;
@@ -124,9 +142,13 @@ static socket_t *_get_free_socket(void)
         if (_socket_pool[i].domain == AF_UNSPEC) {
 #if IS_USED(MODULE_SOCK_ASYNC)
             atomic_init(&_socket_pool[i].available, 0U);
+            _socket_pool[i].hup = false;
 #endif
-#if IS_USED(MODULE_POSIX_SELECT)
+#if IS_USED(MODULE_POSIX_SELECT) || IS_USED(MODULE_POSIX_POLL)
             _socket_pool[i].selecting_thread = NULL;
+#endif
+#if IS_USED(MODULE_POSIX_POLL)
+            _socket_pool[i].watch_cb = NULL;
 #endif
             return &_socket_pool[i];
         }
@@ -320,6 +342,14 @@ static int socket_close(vfs_file_t *filp)
         }
     }
     mutex_unlock(&_socket_pool_mutex);
+#if IS_USED(MODULE_POSIX_POLL)
+    /* let epoll find out that the socket is gone, before the slot can be
+     * reused by a new socket */
+    if (s->watch_cb != NULL) {
+        s->watch_cb(s->watch_arg);
+        s->watch_cb = NULL;
+    }
+#endif
     s->sock = NULL;
     s->domain = AF_UNSPEC;
     return res;
@@ -368,15 +398,39 @@ static void _async_cb(void *sock, sock_async_flags_t type,
     socket_t *socket = arg;
 
     (void)sock;
-    if (type & SOCK_ASYNC_MSG_RECV) {
+    if (type & SOCK_ASYNC_CONN_FIN) {
+        socket->hup = true;
+    }
+    if (type & (SOCK_ASYNC_MSG_RECV | SOCK_ASYNC_CONN_RECV)) {
         atomic_fetch_add(&socket->available, 1);
-#if IS_USED(MODULE_POSIX_SELECT)
-        if (socket->selecting_thread) {
-            thread_flags_set(socket->selecting_thread,
-                             POSIX_SELECT_THREAD_FLAG);
-        }
+    }
+    if (!(type & (SOCK_ASYNC_MSG_RECV | SOCK_ASYNC_CONN_RECV |
+                  SOCK_ASYNC_CONN_FIN))) {
+        return;
+    }
+#if IS_USED(MODULE_POSIX_SELECT) || IS_USED(MODULE_POSIX_POLL)
+    thread_t *selecting_thread = socket->selecting_thread;
+
+    if (selecting_thread) {
+        thread_flags_set(selecting_thread, _SELECT_THREAD_FLAG);
+    }
 #endif
+#if IS_USED(MODULE_POSIX_POLL)
+    void (*watch_cb)(void *) = socket->watch_cb;
+
+    if (watch_cb != NULL) {
+        watch_cb(socket->watch_arg);
     }
+#endif
+}
+
+/* a datagram or connection was taken off the socket */
+static void _avail_dec(socket_t *s)
+{
+    unsigned avail = atomic_load(&s->available);
+
+    while ((avail > 0) &&
+           !atomic_compare_exchange_weak(&s->available, &avail, avail - 1)) {}
 }
 
 static void _sock_set_cb(socket_t *socket)
@@ -559,6 +613,7 @@ int accept(int socket, struct sockaddr *restrict address,
                 new_s->queue_array_len = 0;
                 new_s->sock = (socket_sock_t *)sock;
 #if IS_USED(MODULE_SOCK_ASYNC)
+                _avail_dec(s);
                 _sock_set_cb(new_s);
 #endif
                 memset(&s->local, 0, sizeof(sock_tcp_ep_t));
@@ -973,10 +1028,13 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
             res = -EOPNOTSUPP;
             break;
     }
-    if ((res >= 0) && (address != NULL) && (address_len != NULL)) {
-#ifdef MODULE_SOCK_ASYNC
-        atomic_fetch_sub(&s->available, 1);
+#if IS_USED(MODULE_SOCK_ASYNC)
+    /* a stream may hold more data if the buffer was filled */
+    if ((res >= 0) && ((s->type != SOCK_STREAM) || ((size_t)res < length))) {
+        _avail_dec(s);
+    }
 #endif
+    if ((res >= 0) && (address != NULL) && (address_len != NULL)) {
         switch (s->type) {
 #ifdef MODULE_SOCK_TCP
             case SOCK_STREAM:
@@ -1183,7 +1241,7 @@ unsigned posix_socket_avail(int fd)
 
 int posix_socket_select(int fd)
 {
-#if IS_USED(MODULE_POSIX_SELECT)
+#if IS_USED(MODULE_POSIX_SELECT) || IS_USED(MODULE_POSIX_POLL)
     socket_t *socket = _get_socket(fd);
 
     if (socket != NULL) {
@@ -1205,6 +1263,62 @@ int posix_socket_select(int fd)
     return -1;
 }
 
+#if IS_USED(MODULE_POSIX_POLL)
+unsigned posix_socket_events(int fd)
+{
+    socket_t *socket = _get_socket(fd);
+    unsigned events = POLLOUT;
+
+    if (socket == NULL) {
+        return POLLNVAL;
+    }
+#ifdef MODULE_SOCK_TCP
+    if ((socket->type == SOCK_STREAM) &&
+        ((socket->sock == NULL) || (socket->queue_array != NULL))) {
+        /* neither connected nor listening or a listening socket */
+        events = 0;
+    }
+#endif
+#if IS_USED(MODULE_SOCK_ASYNC)
+    if (atomic_load(&socket->available) > 0) {
+        events |= POLLIN;
+    }
+    if (socket->hup) {
+        events = POLLIN | POLLHUP;
+    }
+#endif
+    return events;
+}
+
+int posix_socket_watch(int fd, void (*cb)(void *), void *arg)
+{
+    socket_t *socket = _get_socket(fd);
+
+    if (socket == NULL) {
+        return -ENOTSOCK;
+    }
+    if ((cb != NULL) && (socket->sock == NULL) &&
+        (socket->type != SOCK_STREAM)) {
+        int res;
+
+        /* bind implicitly, so events can be received */
+        if ((res = _bind_connect(socket, NULL, 0)) < 0) {
+            return res;
+        }
+    }
+    unsigned state = irq_disable();
+    if ((cb != NULL) && (socket->watch_cb != NULL)) {
+        /* already watched, e.g. by another epoll instance */
+        irq_restore(state);
+        return -EBUSY;
+    }
+    socket->watch_cb = cb;
+    socket->watch_arg = arg;
+    irq_restore(state);
+    return 0;
+}
+#endif
+
 /**
  * @}
  */
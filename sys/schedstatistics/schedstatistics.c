@@ -21,25 +21,142 @@
  * @}
  */
 
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "irq.h"
 #include "sched.h"
 #include "schedstatistics.h"
 #include "thread.h"
 #include "ztimer.h"
 
+#define _BARRIER()  __asm__ volatile ("" : : : "memory")
+
 /**
  * When core_idle_thread is not active, the KERNEL_PID_UNDEF is used to track
  * the idle time
  */
 schedstat_t sched_pidlist[KERNEL_PID_LAST + 1];
 
+/* incremented before and after every update of sched_pidlist, so that readers
+ * in thread context can detect that they have been interrupted by an update */
+static volatile uint32_t _seq;
+
+/* ztimer may not be used before init_schedstatistics() was called */
+static bool _active;
+
+#if IS_USED(MODULE_SCHEDSTATISTICS_LATENCY)
+static bool _ready[KERNEL_PID_LAST + 1];
+#endif
+
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ)
+static uint32_t _irq_start;
+#endif
+
+#if IS_USED(MODULE_SCHEDSTATISTICS_TRACE)
+#define TRACE_MASK  (CONFIG_SCHEDSTATISTICS_TRACE_SIZE - 1)
+
+static_assert((CONFIG_SCHEDSTATISTICS_TRACE_SIZE & TRACE_MASK) == 0,
+              "CONFIG_SCHEDSTATISTICS_TRACE_SIZE must be a power of 2");
+
+static schedstat_trace_t _trace[CONFIG_SCHEDSTATISTICS_TRACE_SIZE];
+static volatile uint32_t _trace_head;
+static kernel_pid_t _trace_prev = KERNEL_PID_UNDEF;
+static uint8_t _trace_flags;
+#endif
+
+static inline void _write_begin(void)
+{
+    _seq++;
+    _BARRIER();
+}
+
+static inline void _write_end(void)
+{
+    _BARRIER();
+    _seq++;
+}
+
+#if IS_USED(MODULE_SCHEDSTATISTICS_LATENCY)
+static void _mark_ready(kernel_pid_t pid, uint32_t now)
+{
+    if (!_ready[pid]) {
+        _ready[pid] = true;
+        sched_pidlist[pid].readysince = now;
+    }
+}
+
+static void _record_latency(kernel_pid_t pid, uint32_t now)
+{
+    schedstat_t *stat = &sched_pidlist[pid];
+
+    if (!_ready[pid]) {
+        return;
+    }
+    _ready[pid] = false;
+
+    uint32_t latency = now - stat->readysince;
+    unsigned bucket = 0;
+
+    /* bucket n holds latencies in [2^(n-1), 2^n) */
+    for (uint32_t tmp = latency;
+         tmp && (bucket < CONFIG_SCHEDSTATISTICS_LATENCY_BUCKETS - 1);
+         tmp >>= 1) {
+        bucket++;
+    }
+    stat->latency[bucket]++;
+    if (latency > stat->max_latency_us) {
+        stat->max_latency_us = latency;
+    }
+}
+
+void sched_wake_callback(kernel_pid_t pid)
+{
+    if (!_active) {
+        return;
+    }
+
+    _write_begin();
+    _mark_ready(pid, ztimer_now(ZTIMER_USEC));
+    _write_end();
+}
+#endif /* MODULE_SCHEDSTATISTICS_LATENCY */
+
 void sched_statistics_cb(kernel_pid_t active_thread, kernel_pid_t next_thread)
 {
     uint32_t now = ztimer_now(ZTIMER_USEC);
 
+    _write_begin();
+
     /* Update active thread stats */
     if (!IS_USED(MODULE_CORE_IDLE_THREAD) || active_thread != KERNEL_PID_UNDEF) {
         schedstat_t *active_stat = &sched_pidlist[active_thread];
-        active_stat->runtime_us += now - active_stat->laststart;
+        uint32_t slice = now - active_stat->laststart;
+        active_stat->runtime_us += slice;
+        if (slice > active_stat->max_slice_us) {
+            active_stat->max_slice_us = slice;
+        }
+    }
+
+    if (active_thread != KERNEL_PID_UNDEF) {
+        thread_t *thread = thread_get(active_thread);
+        bool runnable = thread && (thread->status >= STATUS_ON_RUNQUEUE);
+
+        if (runnable) {
+            sched_pidlist[active_thread].involuntary++;
+#if IS_USED(MODULE_SCHEDSTATISTICS_LATENCY)
+            /* preempted threads are waiting to run again from now on */
+            _mark_ready(active_thread, now);
+#endif
+        }
+        else {
+            sched_pidlist[active_thread].voluntary++;
+        }
+#if IS_USED(MODULE_SCHEDSTATISTICS_TRACE)
+        _trace_prev = active_thread;
+        _trace_flags = runnable ? 0 : SCHEDSTAT_TRACE_VOLUNTARY;
+#endif
     }
 
     /* Update next_thread stats */
@@ -48,7 +165,124 @@ void sched_statistics_cb(kernel_pid_t active_thread, kernel_pid_t next_thread)
         next_stat->laststart = now;
         next_stat->schedules++;
     }
+
+    if (next_thread != KERNEL_PID_UNDEF) {
+#if IS_USED(MODULE_SCHEDSTATISTICS_LATENCY)
+        _record_latency(next_thread, now);
+#endif
+#if IS_USED(MODULE_SCHEDSTATISTICS_TRACE)
+        schedstat_trace_t *entry = &_trace[_trace_head & TRACE_MASK];
+        entry->time = now;
+        entry->prev = _trace_prev;
+        entry->next = next_thread;
+        entry->flags = _trace_flags;
+        _BARRIER();
+        _trace_head++;
+        _trace_prev = KERNEL_PID_UNDEF;
+        _trace_flags = 0;
+#endif
+    }
+
+    _write_end();
+}
+
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ)
+void sched_statistics_irq_enter(void)
+{
+    if (_active) {
+        _irq_start = ztimer_now(ZTIMER_USEC);
+    }
+}
+
+void sched_statistics_irq_exit(void)
+{
+    if (!_active) {
+        return;
+    }
+
+    uint32_t now = ztimer_now(ZTIMER_USEC);
+    kernel_pid_t pid = thread_getpid();
+
+    if ((pid == KERNEL_PID_UNDEF) && IS_USED(MODULE_CORE_IDLE_THREAD)) {
+        return;
+    }
+    _write_begin();
+    sched_pidlist[pid].irq_us += now - _irq_start;
+    _write_end();
+}
+#endif /* MODULE_SCHEDSTATISTICS_IRQ */
+
+void sched_statistics_get(kernel_pid_t pid, schedstat_t *stat)
+{
+    uint32_t seq;
+
+    do {
+        seq = _seq;
+        _BARRIER();
+        *stat = sched_pidlist[pid];
+        _BARRIER();
+    } while ((seq & 1) || (seq != _seq));
+}
+
+void sched_statistics_reset(void)
+{
+    unsigned state = irq_disable();
+    uint32_t now = ztimer_now(ZTIMER_USEC);
+
+    _write_begin();
+    memset(sched_pidlist, 0, sizeof(sched_pidlist));
+    for (unsigned i = 0; i < ARRAY_SIZE(sched_pidlist); i++) {
+        sched_pidlist[i].laststart = now;
+    }
+#if IS_USED(MODULE_SCHEDSTATISTICS_LATENCY)
+    memset(_ready, 0, sizeof(_ready));
+#endif
+    _write_end();
+    irq_restore(state);
+}
+
+#if IS_USED(MODULE_SCHEDSTATISTICS_TRACE)
+unsigned sched_statistics_trace_read(uint32_t *pos, schedstat_trace_t *buf,
+                                     unsigned len, uint32_t *lost)
+{
+    uint32_t head = _trace_head;
+    uint32_t skipped = 0;
+
+    if (head - *pos > CONFIG_SCHEDSTATISTICS_TRACE_SIZE) {
+        skipped = head - CONFIG_SCHEDSTATISTICS_TRACE_SIZE - *pos;
+        *pos += skipped;
+    }
+
+    unsigned n = head - *pos;
+    if (n > len) {
+        n = len;
+    }
+    for (unsigned i = 0; i < n; i++) {
+        buf[i] = _trace[(*pos + i) & TRACE_MASK];
+    }
+    _BARRIER();
+
+    /* drop entries the scheduler overwrote while they were copied */
+    uint32_t oldest = _trace_head - CONFIG_SCHEDSTATISTICS_TRACE_SIZE;
+    if ((int32_t)(oldest - *pos) > 0) {
+        unsigned overwritten = oldest - *pos;
+        if (overwritten > n) {
+            overwritten = n;
+        }
+        memmove(buf, buf + overwritten,
+                (n - overwritten) * sizeof(schedstat_trace_t));
+        n -= overwritten;
+        skipped += overwritten;
+        *pos += overwritten;
+    }
+
+    *pos += n;
+    if (lost) {
+        *lost = skipped;
+    }
+    return n;
 }
+#endif /* MODULE_SCHEDSTATISTICS_TRACE */
 
 void init_schedstatistics(void)
 {
@@ -57,5 +291,6 @@ void init_schedstatistics(void)
     schedstat_t *active_stat = &sched_pidlist[thread_getpid()];
     active_stat->laststart = ztimer_now(ZTIMER_USEC);
     active_stat->schedules = 1;
+    _active = true;
     sched_register_cb(sched_statistics_cb);
 }
@@ -142,6 +142,8 @@ static const char *_netstats_module_to_str(uint8_t module)
             return "Layer 2";
         case NETSTATS_IPV6:
             return "IPv6";
+        case NETSTATS_PKTQ:
+            return "send queue";
         case NETSTATS_ALL:
             return "all";
         default:
@@ -179,6 +181,49 @@ static int _netif_stats(netif_t *iface, unsigned module, bool reset)
     }
     return res;
 }
+
+#if IS_USED(MODULE_NETSTATS_PKTQ) && IS_USED(MODULE_GNRC_NETIF_PKTQ)
+static int _netif_pktq_stats(netif_t *iface, bool reset)
+{
+    static const char *classes[] = { "control", "default", "bulk" };
+    netstats_queue_t *stats;
+    int res = netif_get_opt(iface, NETOPT_STATS, NETSTATS_PKTQ, &stats,
+                            sizeof(&stats));
+
+    if (res < 0) {
+        puts("           Protocol or device doesn't provide statistics.");
+        return res;
+    }
+    if (reset) {
+        for (unsigned i = 0; i < GNRC_NETIF_PKTQ_CLASS_NUMOF; i++) {
+            /* packets still queued are still in the queue */
+            uint16_t depth = stats[i].depth;
+
+            memset(&stats[i], 0, sizeof(stats[i]));
+            stats[i].depth = depth;
+        }
+        printf("Reset statistics for module %s!\n",
+               _netstats_module_to_str(NETSTATS_PKTQ));
+        return 0;
+    }
+    printf("          Statistics for %s\n", _netstats_module_to_str(NETSTATS_PKTQ));
+    for (unsigned i = 0; i < GNRC_NETIF_PKTQ_CLASS_NUMOF; i++) {
+        printf("            %-7s queued %u (now %u, max %u)  overflows %u\n"
+               "                    evicted %u  dropped %u  "
+               "sojourn avg %u us max %u us\n",
+               classes[i],
+               (unsigned) stats[i].enqueued,
+               (unsigned) stats[i].depth,
+               (unsigned) stats[i].depth_max,
+               (unsigned) stats[i].overflows,
+               (unsigned) stats[i].evicted,
+               (unsigned) stats[i].aqm_drops,
+               (unsigned) stats[i].sojourn_avg,
+               (unsigned) stats[i].sojourn_max);
+    }
+    return 0;
+}
+#endif
 #endif /* MODULE_NETSTATS */
 
 static void _link_usage(char *cmd_name)
@@ -273,7 +318,7 @@ static void _del_usage(char *cmd_name)
 #ifdef MODULE_NETSTATS
 static void _stats_usage(char *cmd_name)
 {
-    printf("usage: %s <if_id> stats [l2|ipv6] [reset]\n", cmd_name);
+    printf("usage: %s <if_id> stats [l2|ipv6|pktq] [reset]\n", cmd_name);
     puts("       reset can be only used if the module is specified.");
 }
 #endif
@@ -911,6 +956,9 @@ static void _netif_list(netif_t *iface)
 #endif
 #ifdef MODULE_NETSTATS_IPV6
     _netif_stats(iface, NETSTATS_IPV6, false);
+#endif
+#if IS_USED(MODULE_NETSTATS_PKTQ) && IS_USED(MODULE_GNRC_NETIF_PKTQ)
+    _netif_pktq_stats(iface, false);
 #endif
     puts("");
 }
@@ -1873,6 +1921,9 @@ int _gnrc_netif_config(int argc, char **argv)
             else if (strcmp(argv[3], "ipv6") == 0) {
                 module = NETSTATS_IPV6;
             }
+            else if (strcmp(argv[3], "pktq") == 0) {
+                module = NETSTATS_PKTQ;
+            }
             else {
                 printf("Module %s doesn't exist or does not provide statistics.\n", argv[3]);
 
@@ -1889,6 +1940,11 @@ int _gnrc_netif_config(int argc, char **argv)
             if (module & NETSTATS_IPV6) {
                 _netif_stats(iface, NETSTATS_IPV6, reset);
             }
+#if IS_USED(MODULE_NETSTATS_PKTQ) && IS_USED(MODULE_GNRC_NETIF_PKTQ)
+            if (module & NETSTATS_PKTQ) {
+                _netif_pktq_stats(iface, reset);
+            }
+#endif
 
             return 1;
         }
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command to print scheduler statistics
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "schedstatistics.h"
+#include "thread.h"
+
+static const char *_name(kernel_pid_t pid)
+{
+#ifdef CONFIG_THREAD_NAMES
+    thread_t *thread = thread_get(pid);
+    if (thread) {
+        return thread_get_name(thread);
+    }
+#endif
+    return (pid == KERNEL_PID_UNDEF) ? "sleep" : "-";
+}
+
+static bool _valid(kernel_pid_t pid)
+{
+    if (pid == KERNEL_PID_UNDEF) {
+        return !IS_USED(MODULE_CORE_IDLE_THREAD);
+    }
+    return thread_get(pid) != NULL;
+}
+
+static void _print_table(void)
+{
+    printf("%4s | %-16s | %12s | %8s | %10s | %10s | %10s"
+#if IS_USED(MODULE_SCHEDSTATISTICS_LATENCY)
+           " | %10s"
+#endif
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ)
+           " | %12s"
+#endif
+           "\n", "pid", "name", "runtime_us", "switches", "voluntary",
+           "involunt.", "max_slice"
+#if IS_USED(MODULE_SCHEDSTATISTICS_LATENCY)
+           , "max_lat"
+#endif
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ)
+           , "irq_us"
+#endif
+           );
+
+    for (kernel_pid_t pid = KERNEL_PID_UNDEF; pid <= KERNEL_PID_LAST; pid++) {
+        schedstat_t stat;
+
+        if (!_valid(pid)) {
+            continue;
+        }
+        sched_statistics_get(pid, &stat);
+        printf("%4" PRIkernel_pid " | %-16s | %12" PRIu64 " | %8u | %10u | "
+               "%10u | %10" PRIu32
+#if IS_USED(MODULE_SCHEDSTATISTICS_LATENCY)
+               " | %10" PRIu32
+#endif
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ)
+               " | %12" PRIu64
+#endif
+               "\n", pid, _name(pid), stat.runtime_us, stat.schedules,
+               stat.voluntary, stat.involuntary, stat.max_slice_us
+#if IS_USED(MODULE_SCHEDSTATISTICS_LATENCY)
+               , stat.max_latency_us
+#endif
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ)
+               , stat.irq_us
+#endif
+               );
+    }
+}
+
+static void _print_json(void)
+{
+    const char *sep = "";
+
+    printf("{\"threads\":[");
+    for (kernel_pid_t pid = KERNEL_PID_UNDEF; pid <= KERNEL_PID_LAST; pid++) {
+        schedstat_t stat;
+
+        if (!_valid(pid)) {
+            continue;
+        }
+        sched_statistics_get(pid, &stat);
+        printf("%s{\"pid\":%" PRIkernel_pid ",\"name\":\"%s\","
+               "\"runtime_us\":%" PRIu64 ",\"schedules\":%u,"
+               "\"voluntary\":%u,\"involuntary\":%u,"
+               "\"max_slice_us\":%" PRIu32,
+               sep, pid, _name(pid), stat.runtime_us, stat.schedules,
+               stat.voluntary, stat.involuntary, stat.max_slice_us);
+#if IS_USED(MODULE_SCHEDSTATISTICS_LATENCY)
+        printf(",\"max_latency_us\":%" PRIu32 ",\"latency\":[",
+               stat.max_latency_us);
+        for (unsigned i = 0; i < CONFIG_SCHEDSTATISTICS_LATENCY_BUCKETS; i++) {
+            printf("%s%u", i ? "," : "", stat.latency[i]);
+        }
+        printf("]");
+#endif
+#if IS_USED(MODULE_SCHEDSTATISTICS_IRQ)
+        printf(",\"irq_us\":%" PRIu64, stat.irq_us);
+#endif
+        printf("}");
+        sep = ",";
+    }
+    puts("]}");
+}
+
+#if IS_USED(MODULE_SCHEDSTATISTICS_TRACE)
+static void _print_trace(bool json)
+{
+    static uint32_t pos;
+    schedstat_trace_t buf[8];
+    uint32_t lost, lost_sum = 0;
+    unsigned n;
+    const char *sep = "";
+
+    if (json) {
+        printf("{\"trace\":[");
+    }
+    while ((n = sched_statistics_trace_read(&pos, buf, ARRAY_SIZE(buf), &lost))) {
+        lost_sum += lost;
+        for (unsigned i = 0; i < n; i++) {
+            if (json) {
+                printf("%s{\"time\":%" PRIu32 ",\"prev\":%" PRIkernel_pid
+                       ",\"next\":%" PRIkernel_pid ",\"voluntary\":%s}",
+                       sep, buf[i].time, buf[i].prev, buf[i].next,
+                       (buf[i].flags & SCHEDSTAT_TRACE_VOLUNTARY) ? "true"
+                                                                  : "false");
+                sep = ",";
+            }
+            else {
+                printf("%10" PRIu32 " %3" PRIkernel_pid " -> %3" PRIkernel_pid
+                       " %s\n", buf[i].time, buf[i].prev, buf[i].next,
+                       (buf[i].flags & SCHEDSTAT_TRACE_VOLUNTARY) ? "blocked"
+                                                                  : "preempted");
+            }
+        }
+    }
+    if (json) {
+        printf("],\"lost\":%" PRIu32 "}\n", lost_sum);
+    }
+    else {
+        printf("lost: %" PRIu32 "\n", lost_sum);
+    }
+}
+#endif
+
+static int _usage(const char *cmd)
+{
+    printf("usage: %s [json|reset"
+#if IS_USED(MODULE_SCHEDSTATISTICS_TRACE)
+           "|trace [json]"
+#endif
+           "]\n", cmd);
+    return 1;
+}
+
+int _schedstatistics_handler(int argc, char **argv)
+{
+    if (argc < 2) {
+        _print_table();
+    }
+    else if (strcmp(argv[1], "json") == 0) {
+        _print_json();
+    }
+    else if (strcmp(argv[1], "reset") == 0) {
+        sched_statistics_reset();
+    }
+#if IS_USED(MODULE_SCHEDSTATISTICS_TRACE)
+    else if (strcmp(argv[1], "trace") == 0) {
+        _print_trace((argc > 2) && (strcmp(argv[2], "json") == 0));
+    }
+#endif
+    else {
+        return _usage(argv[0]);
+    }
+    return 0;
+}
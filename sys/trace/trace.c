@@ -20,51 +20,313 @@
  * @}
  */
 
+#include <assert.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdbool.h>
 #include <stdio.h>
 
+#include "cycle_counter.h"
 #include "irq.h"
+#include "sched.h"
+#include "trace.h"
 #include "ztimer.h"
 
-#ifndef CONFIG_TRACE_BUFSIZE
-#define CONFIG_TRACE_BUFSIZE 512
-#endif
+#define _BARRIER()  __asm__ volatile ("" : : : "memory")
+
+#define THREAD_MASK (CONFIG_TRACE_THREAD_BUFSIZE - 1)
+#define ISR_MASK    (CONFIG_TRACE_ISR_BUFSIZE - 1)
+
+static_assert((CONFIG_TRACE_THREAD_BUFSIZE & THREAD_MASK) == 0,
+              "CONFIG_TRACE_THREAD_BUFSIZE must be a power of 2");
+static_assert((CONFIG_TRACE_ISR_BUFSIZE & ISR_MASK) == 0,
+              "CONFIG_TRACE_ISR_BUFSIZE must be a power of 2");
+
+/* index of the ISR buffer in _ctx */
+#define CTX_ISR     (KERNEL_PID_LAST + 1)
+#define CTX_NUMOF   (KERNEL_PID_LAST + 2)
+
+/* lines enclosing the output of trace_dump_hex() */
+#define HEX_BEGIN   "==== trace begin ===="
+#define HEX_END     "==== trace end ===="
 
+/**
+ * A slot is valid if its tag matches the sequence number of the entry that
+ * is expected in it. Writers set the tag to 0 before touching the other
+ * fields, so readers can detect slots that were (re)written while they copied
+ * them.
+ */
 typedef struct {
     uint32_t time;
-    uint32_t val;
+    uint32_t payload;
+    uint16_t id;
+    uint16_t tag;
 } tracebuf_entry_t;
 
-static tracebuf_entry_t tracebuf[CONFIG_TRACE_BUFSIZE];
-static size_t tracebuf_pos;
+typedef struct {
+    uint32_t tail;          /**< sequence number of first entry after reset */
+    uint32_t head;          /**< sequence number of next entry (threads) */
+} tracebuf_ctx_t;
+
+static tracebuf_entry_t _thread_buf[KERNEL_PID_LAST + 1]
+                                   [CONFIG_TRACE_THREAD_BUFSIZE];
+static tracebuf_entry_t _isr_buf[CONFIG_TRACE_ISR_BUFSIZE];
+static tracebuf_ctx_t _ctx[CTX_NUMOF];
+static atomic_uint_least32_t _isr_head = ATOMIC_VAR_INIT(0);
+
+static inline uint16_t _tag(uint32_t seq)
+{
+    return (seq & 0x7fff) | 0x8000;
+}
+
+static inline uint32_t _timestamp(void)
+{
+#if CYCLE_COUNTER_AVAILABLE
+    return cycle_counter_now();
+#else
+    return ztimer_now(ZTIMER_USEC);
+#endif
+}
+
+static uint32_t _timestamp_freq(void)
+{
+#if CYCLE_COUNTER_AVAILABLE
+    return cycle_counter_freq();
+#else
+    return 1000000LU;
+#endif
+}
+
+static inline void _write(tracebuf_entry_t *entry, uint32_t seq, uint16_t id,
+                          uint32_t payload)
+{
+    entry->tag = 0;
+    _BARRIER();
+    entry->time = _timestamp();
+    entry->payload = payload;
+    entry->id = id;
+    _BARRIER();
+    entry->tag = _tag(seq);
+}
+
+void trace_event(uint16_t id, uint32_t payload)
+{
+    if (irq_is_in()) {
+        /* ISRs may nest, reserve the slot atomically */
+        uint32_t seq = atomic_fetch_add(&_isr_head, 1);
+        _write(&_isr_buf[seq & ISR_MASK], seq, id, payload);
+    }
+    else {
+        /* only the running thread writes to its buffer, ISRs interrupting
+         * it use their own */
+        kernel_pid_t pid = thread_getpid();
+        uint32_t seq = _ctx[pid].head;
+        _write(&_thread_buf[pid][seq & THREAD_MASK], seq, id, payload);
+        _BARRIER();
+        _ctx[pid].head = seq + 1;
+    }
+}
+
+static uint32_t _head(unsigned ctx)
+{
+    return (ctx == CTX_ISR) ? atomic_load(&_isr_head) : _ctx[ctx].head;
+}
+
+static unsigned _size(unsigned ctx)
+{
+    return (ctx == CTX_ISR) ? CONFIG_TRACE_ISR_BUFSIZE
+                            : CONFIG_TRACE_THREAD_BUFSIZE;
+}
+
+/**
+ * @brief   Get the sequence number of the oldest entry of @p ctx still in
+ *          the buffer and the number of entries lost since the last reset
+ */
+static uint32_t _first(unsigned ctx, uint32_t *lost)
+{
+    uint32_t head = _head(ctx);
+    uint32_t tail = _ctx[ctx].tail;
+
+    *lost = 0;
+    if (head - tail > _size(ctx)) {
+        *lost = head - tail - _size(ctx);
+        tail = head - _size(ctx);
+    }
+    return tail;
+}
+
+/**
+ * @brief   Copy entry @p seq of @p ctx to @p out
+ *
+ * @return  false if the entry was not (yet or anymore) in the buffer
+ */
+static bool _read(unsigned ctx, uint32_t seq, trace_record_t *out)
+{
+    const volatile tracebuf_entry_t *entry =
+        (ctx == CTX_ISR) ? &_isr_buf[seq & ISR_MASK]
+                         : &_thread_buf[ctx][seq & THREAD_MASK];
+    uint16_t tag = _tag(seq);
+
+    if (entry->tag != tag) {
+        return false;
+    }
+    _BARRIER();
+    out->time = entry->time;
+    out->payload = entry->payload;
+    out->id = entry->id;
+    out->ctx = (ctx == CTX_ISR) ? TRACE_CTX_ISR : ctx;
+    _BARRIER();
+
+    return entry->tag == tag;
+}
 
-void trace(uint32_t val)
+/**
+ * @brief   Advance @p seq to the next valid entry of @p ctx before @p end and
+ *          copy it to @p out
+ *
+ * @return  false if there are no more entries
+ */
+static bool _next(unsigned ctx, uint32_t *seq, uint32_t end,
+                  trace_record_t *out)
 {
-    unsigned state = irq_disable();
+    uint32_t head = _head(ctx);
 
-    tracebuf[tracebuf_pos % CONFIG_TRACE_BUFSIZE] =
-        (tracebuf_entry_t){ .time = ztimer_now(ZTIMER_USEC), .val = val };
-    tracebuf_pos++;
-    irq_restore(state);
+    /* entries overwritten while dumping are skipped */
+    if (head - *seq > _size(ctx)) {
+        *seq = head - _size(ctx);
+    }
+    while ((int32_t)(end - *seq) > 0) {
+        if (_read(ctx, *seq, out)) {
+            return true;
+        }
+        (*seq)++;
+    }
+    return false;
 }
 
 void trace_dump(void)
 {
-    size_t n = tracebuf_pos >
-               CONFIG_TRACE_BUFSIZE ? CONFIG_TRACE_BUFSIZE : tracebuf_pos;
+    uint32_t seq[CTX_NUMOF];
+    uint32_t end[CTX_NUMOF];
+    uint32_t now = _timestamp();
     uint32_t t_last = 0;
+    unsigned long n = 0;
+
+    for (unsigned ctx = 0; ctx < CTX_NUMOF; ctx++) {
+        uint32_t lost;
+        seq[ctx] = _first(ctx, &lost);
+        end[ctx] = _head(ctx);
+        if (lost) {
+            printf("lost %" PRIu32 " entries of context %u\n", lost, ctx);
+        }
+    }
+
+    while (1) {
+        trace_record_t rec, oldest = { 0 };
+        unsigned from = CTX_NUMOF;
+
+        /* merge by age relative to now, robust against timer overflows */
+        for (unsigned ctx = 0; ctx < CTX_NUMOF; ctx++) {
+            if (_next(ctx, &seq[ctx], end[ctx], &rec) &&
+                ((from == CTX_NUMOF) ||
+                 (now - rec.time > now - oldest.time))) {
+                oldest = rec;
+                from = ctx;
+            }
+        }
+        if (from == CTX_NUMOF) {
+            break;
+        }
+        seq[from]++;
+
+        char ctx_str[6] = "isr";
+        if (oldest.ctx != TRACE_CTX_ISR) {
+            snprintf(ctx_str, sizeof(ctx_str), "%3u", (unsigned)oldest.ctx);
+        }
+        printf("n=%4lu t=%s%8" PRIu32 " c=%s e=0x%04x v=0x%08lx\n", n,
+               n ? "+" : " ", oldest.time - t_last, ctx_str,
+               (unsigned)oldest.id, (unsigned long)oldest.payload);
+        t_last = oldest.time;
+        n++;
+    }
+}
+
+void trace_dump_bin(trace_write_cb_t write, void *arg)
+{
+    struct {
+        uint32_t magic;
+        uint8_t version;
+        uint8_t flags;
+        uint16_t record_size;
+        uint32_t freq;
+        uint32_t now;
+    } hdr = {
+        .magic = TRACE_BIN_MAGIC,
+        .version = TRACE_BIN_VERSION,
+        .flags = CYCLE_COUNTER_AVAILABLE ? TRACE_BIN_FLAG_CYCLES : 0,
+        .record_size = sizeof(trace_record_t),
+        .freq = _timestamp_freq(),
+        .now = _timestamp(),
+    };
+
+    write(arg, &hdr, sizeof(hdr));
+
+    for (unsigned ctx = 0; ctx < CTX_NUMOF; ctx++) {
+        trace_record_t rec;
+        uint32_t lost;
+        uint32_t seq = _first(ctx, &lost);
+        uint32_t end = _head(ctx);
+
+        if (lost) {
+            rec = (trace_record_t){
+                .time = 0, .payload = lost, .id = TRACE_EVENT_LOST,
+                .ctx = (ctx == CTX_ISR) ? TRACE_CTX_ISR : ctx,
+            };
+            write(arg, &rec, sizeof(rec));
+        }
+        while (_next(ctx, &seq, end, &rec)) {
+            write(arg, &rec, sizeof(rec));
+            seq++;
+        }
+    }
+}
+
+static void _write_hex(void *arg, const void *data, size_t len)
+{
+    unsigned *col = arg;
+    const uint8_t *bytes = data;
+
+    for (size_t i = 0; i < len; i++) {
+        printf("%02x", bytes[i]);
+        if (++(*col) == 32) {
+            *col = 0;
+            puts("");
+        }
+    }
+}
+
+void trace_dump_hex(void)
+{
+    unsigned col = 0;
 
-    for (size_t i = 0; i < n; i++) {
-        printf("n=%4lu t=%s%8" PRIu32 " v=0x%08lx\n", (unsigned long)i,
-               i ? "+" : " ",
-               tracebuf[i].time - t_last, (unsigned long)tracebuf[i].val);
-        t_last = tracebuf[i].time;
+    puts(HEX_BEGIN);
+    trace_dump_bin(_write_hex, &col);
+    if (col) {
+        puts("");
     }
+    puts(HEX_END);
 }
 
 void trace_reset(void)
 {
-    unsigned state = irq_disable();
+    for (unsigned ctx = 0; ctx < CTX_NUMOF; ctx++) {
+        _ctx[ctx].tail = _head(ctx);
+    }
+}
 
-    tracebuf_pos = 0;
-    irq_restore(state);
+void trace_init(void)
+{
+#if CYCLE_COUNTER_AVAILABLE
+    cycle_counter_init();
+#endif
 }
@@ -17,6 +17,8 @@
  * @}
  */
 
+#include <string.h>
+
 #include "irq.h"
 #include "tsrb.h"
 
@@ -35,6 +37,38 @@ static uint8_t _peek(tsrb_t *rb, unsigned int idx)
     return rb->buf[(rb->reads + idx) & (rb->size - 1)];
 }
 
+static size_t _min(size_t a, size_t b)
+{
+    return (a < b) ? a : b;
+}
+
+/**
+ * @brief   Copy @p n bytes to the write position, in at most two blocks
+ * @pre     @p n does not exceed the free space
+ */
+static void _write(tsrb_t *rb, const uint8_t *src, size_t n)
+{
+    unsigned pos = rb->writes & (rb->size - 1);
+    size_t chunk = _min(n, rb->size - pos);
+
+    memcpy(&rb->buf[pos], src, chunk);
+    memcpy(rb->buf, src + chunk, n - chunk);
+    rb->writes += n;
+}
+
+/**
+ * @brief   Copy @p n bytes from the read position, in at most two blocks
+ * @pre     @p n does not exceed the available data
+ */
+static void _read(const tsrb_t *rb, uint8_t *dst, size_t n)
+{
+    unsigned pos = rb->reads & (rb->size - 1);
+    size_t chunk = _min(n, rb->size - pos);
+
+    memcpy(dst, &rb->buf[pos], chunk);
+    memcpy(dst + chunk, rb->buf, n - chunk);
+}
+
 int tsrb_get_one(tsrb_t *rb)
 {
     int retval = -1;
@@ -59,38 +93,30 @@ int tsrb_peek_one(tsrb_t *rb)
 
 int tsrb_get(tsrb_t *rb, uint8_t *dst, size_t n)
 {
-    size_t tmp = n;
     unsigned irq_state = irq_disable();
-    while (tmp && !tsrb_empty(rb)) {
-        *dst++ = _pop(rb);
-        tmp--;
-    }
+    n = _min(n, rb->writes - rb->reads);
+    _read(rb, dst, n);
+    rb->reads += n;
     irq_restore(irq_state);
-    return (n - tmp);
+    return n;
 }
 
 int tsrb_peek(tsrb_t *rb, uint8_t *dst, size_t n)
 {
-    size_t idx = 0;
     unsigned irq_state = irq_disable();
-    unsigned int avail = tsrb_avail(rb);
-    while (idx < n && idx != avail) {
-        *dst++ = _peek(rb, idx++);
-    }
+    n = _min(n, rb->writes - rb->reads);
+    _read(rb, dst, n);
     irq_restore(irq_state);
-    return idx;
+    return n;
 }
 
 int tsrb_drop(tsrb_t *rb, size_t n)
 {
-    size_t tmp = n;
     unsigned irq_state = irq_disable();
-    while (tmp && !tsrb_empty(rb)) {
-        _pop(rb);
-        tmp--;
-    }
+    n = _min(n, rb->writes - rb->reads);
+    rb->reads += n;
     irq_restore(irq_state);
-    return (n - tmp);
+    return n;
 }
 
 int tsrb_add_one(tsrb_t *rb, uint8_t c)
@@ -107,12 +133,43 @@ int tsrb_add_one(tsrb_t *rb, uint8_t c)
 
 int tsrb_add(tsrb_t *rb, const uint8_t *src, size_t n)
 {
-    size_t tmp = n;
     unsigned irq_state = irq_disable();
-    while (tmp && !tsrb_full(rb)) {
-        _push(rb, *src++);
-        tmp--;
-    }
+    n = _min(n, rb->size - (rb->writes - rb->reads));
+    _write(rb, src, n);
+    irq_restore(irq_state);
+    return n;
+}
+
+size_t tsrb_reserve(tsrb_t *rb, uint8_t **span)
+{
+    /* only the consumer moves reads, which can only increase the free space
+     * returned here */
+    unsigned irq_state = irq_disable();
+    unsigned pos = rb->writes & (rb->size - 1);
+    size_t free = rb->size - (rb->writes - rb->reads);
+    irq_restore(irq_state);
+
+    *span = &rb->buf[pos];
+    return _min(free, rb->size - pos);
+}
+
+void tsrb_commit(tsrb_t *rb, size_t n)
+{
+    unsigned irq_state = irq_disable();
+    assert(n <= rb->size - (rb->writes - rb->reads));
+    rb->writes += n;
     irq_restore(irq_state);
-    return (n - tmp);
+}
+
+size_t tsrb_peek_span(tsrb_t *rb, const uint8_t **span)
+{
+    /* only the producer moves writes, which can only increase the data
+     * returned here */
+    unsigned irq_state = irq_disable();
+    unsigned pos = rb->reads & (rb->size - 1);
+    size_t avail = rb->writes - rb->reads;
+    irq_restore(irq_state);
+
+    *span = &rb->buf[pos];
+    return _min(avail, rb->size - pos);
 }
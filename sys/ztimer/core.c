@@ -28,6 +28,7 @@
 
 #include "kernel_defines.h"
 #include "irq.h"
+#include "time_units.h"
 #ifdef MODULE_PM_LAYERED
 #include "pm_layered.h"
 #endif
@@ -42,7 +43,7 @@ static void _ztimer_update(ztimer_clock_t *clock);
 static void _ztimer_print(const ztimer_clock_t *clock);
 static uint32_t _ztimer_update_head_offset(ztimer_clock_t *clock);
 
-#ifdef MODULE_ZTIMER_EXTEND
+#if defined(MODULE_ZTIMER_EXTEND) || defined(MODULE_ZTIMER_COALESCE)
 static inline uint32_t _min_u32(uint32_t a, uint32_t b)
 {
     return a < b ? a : b;
@@ -51,12 +52,51 @@ static inline uint32_t _min_u32(uint32_t a, uint32_t b)
 
 static unsigned _is_set(const ztimer_clock_t *clock, const ztimer_t *t)
 {
+#ifdef MODULE_ZTIMER_HEAP
+    (void)clock;
+    return t->base.prev != NULL;
+#else
     if (!clock->list.next) {
         return 0;
     }
     else {
         return (t->base.next || &t->base == clock->last);
     }
+#endif
+}
+
+/* returns the timer that will trigger next, or NULL if none is set */
+static inline ztimer_base_t *_first_entry(const ztimer_clock_t *clock)
+{
+#ifdef MODULE_ZTIMER_HEAP
+    /* expired timers (if any) come before anything still in the heap */
+    return clock->list.next ? clock->list.next : clock->list.child;
+#else
+    return clock->list.next;
+#endif
+}
+
+#ifdef MODULE_ZTIMER_HEAP
+/* ticks from the clock's base to the target of heap entry @p entry */
+static inline uint32_t _heap_key(const ztimer_clock_t *clock,
+                                 const ztimer_base_t *entry)
+{
+    return entry->offset - clock->list.offset;
+}
+#endif
+
+/* returns the offset of the next timer relative to the clock's base,
+ * must only be called if _first_entry() != NULL */
+static inline uint32_t _head_offset(const ztimer_clock_t *clock)
+{
+#ifdef MODULE_ZTIMER_HEAP
+    if (clock->list.next) {
+        return 0;
+    }
+    return _heap_key(clock, clock->list.child);
+#else
+    return clock->list.next->offset;
+#endif
 }
 
 unsigned ztimer_is_set(const ztimer_clock_t *clock, const ztimer_t *timer)
@@ -84,7 +124,8 @@ bool ztimer_remove(ztimer_clock_t *clock, ztimer_t *timer)
     return was_removed;
 }
 
-uint32_t ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
+static uint32_t _ztimer_set(ztimer_clock_t *clock, ztimer_t *timer,
+                            uint32_t val, uint32_t slack)
 {
     DEBUG("ztimer_set(): %p: set %p at %" PRIu32 " offset %" PRIu32 "\n",
           (void *)clock, (void *)timer, clock->ops->now(clock), val);
@@ -105,9 +146,16 @@ uint32_t ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
         val = 0;
     }
 
+#ifdef MODULE_ZTIMER_COALESCE
+    /* the window must not begin in the past */
+    timer->slack = _min_u32(slack, val);
+#else
+    (void)slack;
+#endif
+
     timer->base.offset = val;
     _add_entry_to_list(clock, &timer->base);
-    if (clock->list.next == &timer->base) {
+    if (_first_entry(clock) == &timer->base) {
 #ifdef MODULE_ZTIMER_EXTEND
         if (clock->max_value < UINT32_MAX) {
             val = _min_u32(val, clock->max_value >> 1);
@@ -121,6 +169,22 @@ uint32_t ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
     return now;
 }
 
+uint32_t ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
+{
+    return _ztimer_set(clock, timer, val, 0);
+}
+
+#ifdef MODULE_ZTIMER_COALESCE
+uint32_t ztimer_set_slack(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val,
+                          uint32_t slack)
+{
+    /* queue the timer at the end of its window */
+    slack = _min_u32(slack, UINT32_MAX - val);
+    return _ztimer_set(clock, timer, val + slack, slack);
+}
+#endif
+
+#ifndef MODULE_ZTIMER_HEAP
 static void _add_entry_to_list(ztimer_clock_t *clock, ztimer_base_t *entry)
 {
     uint32_t delta_sum = 0;
@@ -159,6 +223,7 @@ static void _add_entry_to_list(ztimer_clock_t *clock, ztimer_base_t *entry)
           entry->offset);
 
 }
+#endif /* !MODULE_ZTIMER_HEAP */
 
 static uint32_t _add_modulo(uint32_t a, uint32_t b, uint32_t mod)
 {
@@ -191,6 +256,7 @@ ztimer_now_t _ztimer_now_extend(ztimer_clock_t *clock)
 }
 #endif /* MODULE_ZTIMER_EXTEND */
 
+#ifndef MODULE_ZTIMER_HEAP
 static uint32_t _ztimer_update_head_offset(ztimer_clock_t *clock)
 {
     uint32_t old_base = clock->list.offset;
@@ -303,13 +369,247 @@ static ztimer_t *_now_next(ztimer_clock_t *clock)
     }
 }
 
+static void _advance_to_head(ztimer_clock_t *clock)
+{
+    clock->list.offset += clock->list.next->offset;
+    clock->list.next->offset = 0;
+}
+#else /* MODULE_ZTIMER_HEAP */
+/*
+ * Pairing heap implementation of the timer queue.
+ *
+ * clock->list.child points to the heap root, every other heap entry is
+ * reachable through the child (leftmost child) and next (right sibling)
+ * pointers. prev points to the parent for leftmost children, to the left
+ * sibling otherwise. Entries that expired while the clock base was moved
+ * forward are kept in FIFO order in clock->list.next (tail in clock->last).
+ * Both the heap root and expired entries use &clock->list as their prev
+ * pointer, so an entry is set iff its prev pointer is non-NULL.
+ */
+static inline bool _is_empty(const ztimer_clock_t *clock)
+{
+    return !clock->list.next && !clock->list.child;
+}
+
+static ztimer_base_t *_heap_meld(const ztimer_clock_t *clock,
+                                 ztimer_base_t *a, ztimer_base_t *b)
+{
+    if (!a) {
+        return b;
+    }
+    if (!b) {
+        return a;
+    }
+    /* on equal targets, keep the left (older) subheap as root */
+    if (_heap_key(clock, b) < _heap_key(clock, a)) {
+        ztimer_base_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    b->prev = a;
+    b->next = a->child;
+    if (b->next) {
+        b->next->prev = b;
+    }
+    a->child = b;
+    return a;
+}
+
+static ztimer_base_t *_heap_merge_pairs(const ztimer_clock_t *clock,
+                                        ztimer_base_t *first)
+{
+    ztimer_base_t *pairs = NULL;
+
+    /* first pass: meld siblings pairwise from left to right, collecting the
+     * results in reverse order */
+    while (first) {
+        ztimer_base_t *a = first;
+        ztimer_base_t *b = a->next;
+
+        first = b ? b->next : NULL;
+        a->next = NULL;
+        if (b) {
+            b->next = NULL;
+        }
+        a = _heap_meld(clock, a, b);
+        a->next = pairs;
+        pairs = a;
+    }
+
+    /* second pass: meld the results from right to left */
+    ztimer_base_t *root = NULL;
+    while (pairs) {
+        ztimer_base_t *p = pairs;
+
+        pairs = p->next;
+        p->next = NULL;
+        root = _heap_meld(clock, root, p);
+    }
+
+    return root;
+}
+
+static void _heap_set_root(ztimer_clock_t *clock, ztimer_base_t *root)
+{
+    clock->list.child = root;
+    if (root) {
+        root->prev = &clock->list;
+        root->next = NULL;
+    }
+}
+
+static ztimer_base_t *_heap_pop(ztimer_clock_t *clock)
+{
+    ztimer_base_t *root = clock->list.child;
+
+    _heap_set_root(clock, _heap_merge_pairs(clock, root->child));
+    root->child = NULL;
+    root->prev = NULL;
+    return root;
+}
+
+static void _add_entry_to_list(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+#ifdef MODULE_PM_LAYERED
+    /* First timer on the clock */
+    if (_is_empty(clock) &&
+        clock->block_pm_mode != ZTIMER_CLOCK_NO_REQUIRED_PM_MODE) {
+        pm_block(clock->block_pm_mode);
+    }
+#endif
+
+    /* the clock base has just been updated to now, store absolute target */
+    entry->offset += clock->list.offset;
+    entry->next = NULL;
+    entry->child = NULL;
+    entry->prev = NULL;
+    _heap_set_root(clock, _heap_meld(clock, clock->list.child, entry));
+    DEBUG("_add_entry_to_list() %p target %" PRIu32 "\n", (void *)entry,
+          entry->offset);
+}
+
+static uint32_t _ztimer_update_head_offset(ztimer_clock_t *clock)
+{
+    uint32_t now = ztimer_now(clock);
+    uint32_t diff = now - clock->list.offset;
+
+    /* move all entries that expired in between to the FIFO of expired
+     * timers, so the targets of the remaining ones stay ahead of the base */
+    while (clock->list.child && (_heap_key(clock, clock->list.child) <= diff)) {
+        ztimer_base_t *entry = _heap_pop(clock);
+
+        DEBUG("clock %p: _ztimer_update_head_offset(): %p expired\n",
+              (void *)clock, (void *)entry);
+        entry->prev = &clock->list;
+        if (clock->last) {
+            clock->last->next = entry;
+        }
+        else {
+            clock->list.next = entry;
+        }
+        clock->last = entry;
+    }
+
+    clock->list.offset = now;
+    return now;
+}
+
+static bool _del_entry_from_list(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    DEBUG("_del_entry_from_list()\n");
+
+    assert(_is_set(clock, (ztimer_t *)entry));
+
+    if (entry == clock->list.child) {
+        _heap_pop(clock);
+    }
+    else if (entry->prev == &clock->list) {
+        /* entry is in the (usually very short) list of expired timers */
+        ztimer_base_t *list = &clock->list;
+        while (list->next != entry) {
+            list = list->next;
+        }
+        list->next = entry->next;
+        if (entry == clock->last) {
+            clock->last = (list == &clock->list) ? NULL : list;
+        }
+        entry->next = NULL;
+        entry->prev = NULL;
+    }
+    else {
+        /* cut the entry's subtree out of the heap... */
+        if (entry->prev->child == entry) {
+            entry->prev->child = entry->next;
+        }
+        else {
+            entry->prev->next = entry->next;
+        }
+        if (entry->next) {
+            entry->next->prev = entry->prev;
+        }
+        /* ...and meld its children back in */
+        ztimer_base_t *sub = _heap_merge_pairs(clock, entry->child);
+        _heap_set_root(clock, _heap_meld(clock, clock->list.child, sub));
+        entry->next = NULL;
+        entry->child = NULL;
+        entry->prev = NULL;
+    }
+
+#ifdef MODULE_PM_LAYERED
+    /* The last timer just got removed from the clock */
+    if (_is_empty(clock) &&
+        clock->block_pm_mode != ZTIMER_CLOCK_NO_REQUIRED_PM_MODE) {
+        pm_unblock(clock->block_pm_mode);
+    }
+#endif
+
+    return true;
+}
+
+static ztimer_t *_now_next(ztimer_clock_t *clock)
+{
+    ztimer_base_t *entry = clock->list.next;
+
+    if (entry) {
+        clock->list.next = entry->next;
+        if (!entry->next) {
+            clock->last = NULL;
+        }
+        entry->next = NULL;
+        entry->prev = NULL;
+    }
+    else if (clock->list.child && (_heap_key(clock, clock->list.child) == 0)) {
+        entry = _heap_pop(clock);
+    }
+    else {
+        return NULL;
+    }
+
+#ifdef MODULE_PM_LAYERED
+    if (_is_empty(clock) &&
+        clock->block_pm_mode != ZTIMER_CLOCK_NO_REQUIRED_PM_MODE) {
+        pm_unblock(clock->block_pm_mode);
+    }
+#endif
+
+    return (ztimer_t *)entry;
+}
+
+static void _advance_to_head(ztimer_clock_t *clock)
+{
+    if (!clock->list.next) {
+        clock->list.offset += _heap_key(clock, clock->list.child);
+    }
+}
+#endif /* MODULE_ZTIMER_HEAP */
+
 static void _ztimer_update(ztimer_clock_t *clock)
 {
 #ifdef MODULE_ZTIMER_EXTEND
     if (clock->max_value < UINT32_MAX) {
-        if (clock->list.next) {
+        if (_first_entry(clock)) {
             clock->ops->set(clock,
-                            _min_u32(clock->list.next->offset,
+                            _min_u32(_head_offset(clock),
                                      clock->max_value >> 1));
         }
         else {
@@ -320,8 +620,8 @@ static void _ztimer_update(ztimer_clock_t *clock)
 #endif
     }
     else {
-        if (clock->list.next) {
-            clock->ops->set(clock, clock->list.next->offset);
+        if (_first_entry(clock)) {
+            clock->ops->set(clock, _head_offset(clock));
         }
         else {
             if (IS_USED(MODULE_ZTIMER_NOW64)) {
@@ -335,7 +635,7 @@ static void _ztimer_update(ztimer_clock_t *clock)
     }
 }
 
-void ztimer_handler(ztimer_clock_t *clock)
+static void _ztimer_handler(ztimer_clock_t *clock)
 {
     DEBUG("ztimer_handler(): %p now=%" PRIu32 "\n", (void *)clock, clock->ops->now(
               clock));
@@ -348,8 +648,8 @@ void ztimer_handler(ztimer_clock_t *clock)
         /* calling now triggers checkpointing */
         uint32_t now = ztimer_now(clock);
 
-        if (clock->list.next) {
-            uint32_t target = clock->list.offset + clock->list.next->offset;
+        if (_first_entry(clock)) {
+            uint32_t target = clock->list.offset + _head_offset(clock);
             int32_t diff = (int32_t)(target - now);
             if (diff > 0) {
                 DEBUG("ztimer_handler(): %p postponing by %" PRIi32 "\n",
@@ -373,15 +673,13 @@ void ztimer_handler(ztimer_clock_t *clock)
     }
 #endif
 
-    if (clock->list.next) {
-        clock->list.offset += clock->list.next->offset;
-        clock->list.next->offset = 0;
+    if (_first_entry(clock)) {
+        _advance_to_head(clock);
 
         ztimer_t *entry = _now_next(clock);
         while (entry) {
-            DEBUG("ztimer_handler(): trigger %p->%p at %" PRIu32 "\n",
-                  (void *)entry, (void *)entry->base.next, clock->ops->now(
-                      clock));
+            DEBUG("ztimer_handler(): trigger %p at %" PRIu32 "\n",
+                  (void *)entry, clock->ops->now(clock));
             entry->callback(entry->arg);
             entry = _now_next(clock);
             if (!entry) {
@@ -404,6 +702,154 @@ void ztimer_handler(ztimer_clock_t *clock)
     }
 }
 
+#ifdef MODULE_ZTIMER_COALESCE
+/* nesting of ztimer_handler(), e.g. a converted clock within its parent */
+static uint8_t _handler_nesting;
+static ztimer_coalesce_stats_t _coalesce_stats;
+
+/**
+ * @brief   Trigger the timers of @p clock whose windows have begun
+ *
+ * Only the head of the queue is looked at, so this is O(1) per timer.
+ */
+static bool _coalesce(ztimer_clock_t *clock)
+{
+    bool triggered = false;
+
+    while (1) {
+        ztimer_t *timer = NULL;
+        unsigned state = irq_disable();
+
+        if (_first_entry(clock)) {
+            _ztimer_update_head_offset(clock);
+            ztimer_t *head = (ztimer_t *)_first_entry(clock);
+            if (_head_offset(clock) <= head->slack) {
+                if (_head_offset(clock) > 0) {
+                    _coalesce_stats.coalesced++;
+                }
+                _del_entry_from_list(clock, &head->base);
+                timer = head;
+            }
+        }
+
+        if (!timer) {
+            if (triggered) {
+                /* the alarm was set for a timer that is gone now */
+                _ztimer_update(clock);
+            }
+            irq_restore(state);
+            return triggered;
+        }
+        irq_restore(state);
+
+        DEBUG("ztimer_handler(): coalesce %p on %p\n", (void *)timer,
+              (void *)clock);
+        timer->callback(timer->arg);
+        triggered = true;
+    }
+}
+
+static bool _coalesce_all(void)
+{
+    bool triggered = false;
+
+#ifdef MODULE_ZTIMER_USEC
+    triggered |= _coalesce(ZTIMER_USEC);
+#endif
+#ifdef MODULE_ZTIMER_MSEC
+    triggered |= _coalesce(ZTIMER_MSEC);
+#endif
+#ifdef MODULE_ZTIMER_SEC
+    triggered |= _coalesce(ZTIMER_SEC);
+#endif
+
+    return triggered;
+}
+
+void ztimer_handler(ztimer_clock_t *clock)
+{
+    if (_handler_nesting++ == 0) {
+        _coalesce_stats.wakeups++;
+    }
+
+    _ztimer_handler(clock);
+
+    /* the CPU is awake anyway, so handle everything that may trigger now */
+    bool triggered = _coalesce(clock);
+    if (--_handler_nesting == 0) {
+        triggered |= _coalesce_all();
+    }
+    if (triggered && !irq_is_in()) {
+        thread_yield_higher();
+    }
+}
+
+void ztimer_coalesce_stats(ztimer_coalesce_stats_t *stats)
+{
+    unsigned state = irq_disable();
+    *stats = _coalesce_stats;
+    irq_restore(state);
+}
+
+/* microseconds until the alarm of @p clock, whose ticks are @p us_per_tick */
+static uint32_t _next_wakeup(ztimer_clock_t *clock, uint32_t us_per_tick)
+{
+    uint32_t ticks = UINT32_MAX;
+    unsigned state = irq_disable();
+
+    if (_first_entry(clock)) {
+        _ztimer_update_head_offset(clock);
+        ticks = _head_offset(clock);
+    }
+    irq_restore(state);
+
+    if (ticks > UINT32_MAX / us_per_tick) {
+        return UINT32_MAX;
+    }
+    return ticks * us_per_tick;
+}
+
+uint32_t ztimer_coalesce_next_wakeup(void)
+{
+    uint32_t next = UINT32_MAX;
+
+#ifdef MODULE_ZTIMER_USEC
+    next = _min_u32(next, _next_wakeup(ZTIMER_USEC, 1));
+#endif
+#ifdef MODULE_ZTIMER_MSEC
+    next = _min_u32(next, _next_wakeup(ZTIMER_MSEC, US_PER_MS));
+#endif
+#ifdef MODULE_ZTIMER_SEC
+    next = _min_u32(next, _next_wakeup(ZTIMER_SEC, US_PER_SEC));
+#endif
+
+    return next;
+}
+#else
+void ztimer_handler(ztimer_clock_t *clock)
+{
+    _ztimer_handler(clock);
+}
+#endif /* MODULE_ZTIMER_COALESCE */
+
+#ifdef MODULE_ZTIMER_HEAP
+static void _ztimer_print(const ztimer_clock_t *clock)
+{
+    const ztimer_base_t *entry = clock->list.next;
+
+    printf("0x%08x:%" PRIu32 " expired:", (unsigned)&clock->list,
+           clock->list.offset);
+    for (; entry; entry = entry->next) {
+        printf(" 0x%08x", (unsigned)entry);
+    }
+    entry = clock->list.child;
+    if (entry) {
+        printf(" heap: 0x%08x:%" PRIu32 "(%" PRIu32 ")", (unsigned)entry,
+               _heap_key(clock, entry), entry->offset);
+    }
+    puts("");
+}
+#else
 static void _ztimer_print(const ztimer_clock_t *clock)
 {
     const ztimer_base_t *entry = &clock->list;
@@ -419,3 +865,4 @@ static void _ztimer_print(const ztimer_clock_t *clock)
     } while ((entry = entry->next));
     puts("");
 }
+#endif /* MODULE_ZTIMER_HEAP */
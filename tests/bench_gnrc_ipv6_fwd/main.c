@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the time a router needs to forward an IPv6 packet
+ *              between two Ethernet interfaces, with and without the flow
+ *              cache
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "iolist.h"
+#include "kernel_defines.h"
+#include "mutex.h"
+#include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/gnrc/ipv6/flowcache.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev/eth.h"
+#include "net/protnum.h"
+#include "test_utils/expect.h"
+#include "test_utils/result_output.h"
+
+#ifndef PAYLOAD_LEN
+#define PAYLOAD_LEN         (256U)
+#endif
+
+#define HOP_LIMIT           (64U)
+#define FRAME_LEN           (sizeof(ethernet_hdr_t) + sizeof(ipv6_hdr_t) + \
+                             PAYLOAD_LEN)
+
+typedef struct {
+    netdev_t netdev;
+    uint8_t addr[ETHERNET_ADDR_LEN];
+} mock_dev_t;
+
+static const ipv6_addr_t _src = { {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01
+    } };
+static const ipv6_addr_t _dst = { {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x02, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01
+    } };
+static const ipv6_addr_t _next_hop = { {
+        0xfe, 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02
+    } };
+static const uint8_t _next_hop_l2addr[] = { 0x02, 0, 0, 0, 0, 0x22 };
+
+static uint8_t _frame[FRAME_LEN];
+static mutex_t _forwarded = MUTEX_INIT_LOCKED;
+static uint32_t _fl;
+
+static char _stack_in[THREAD_STACKSIZE_DEFAULT];
+static char _stack_out[THREAD_STACKSIZE_DEFAULT];
+static gnrc_netif_t _netif_in;
+static gnrc_netif_t _netif_out;
+
+static int _init(netdev_t *netdev)
+{
+    (void)netdev;
+    return 0;
+}
+
+/* the only interrupt is the one raised by _forward() */
+static void _isr(netdev_t *netdev)
+{
+    netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+}
+
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    (void)netdev;
+    (void)info;
+    if (buf == NULL) {
+        return FRAME_LEN;
+    }
+    if (len < FRAME_LEN) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, _frame, FRAME_LEN);
+    return FRAME_LEN;
+}
+
+static int _get(netdev_t *netdev, netopt_t opt, void *value, size_t max_len)
+{
+    mock_dev_t *dev = container_of(netdev, mock_dev_t, netdev);
+
+    if (opt == NETOPT_ADDRESS) {
+        if (max_len < sizeof(dev->addr)) {
+            return -EOVERFLOW;
+        }
+        memcpy(value, dev->addr, sizeof(dev->addr));
+        return sizeof(dev->addr);
+    }
+    return netdev_eth_get(netdev, opt, value, max_len);
+}
+
+static int _set(netdev_t *netdev, netopt_t opt, const void *value,
+                size_t value_len)
+{
+    return netdev_eth_set(netdev, opt, value, value_len);
+}
+
+/* needs to know which device it is sending with */
+static int _send(netdev_t *netdev, const iolist_t *iolist);
+
+static const netdev_driver_t _driver = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = _set,
+};
+
+static mock_dev_t _dev_in = {
+    .netdev = { .driver = &_driver },
+    .addr = { 0x02, 0, 0, 0, 0, 0x01 },
+};
+static mock_dev_t _dev_out = {
+    .netdev = { .driver = &_driver },
+    .addr = { 0x02, 0, 0, 0, 0, 0x02 },
+};
+
+static int _send(netdev_t *netdev, const iolist_t *iolist)
+{
+    const ethernet_hdr_t *eth = iolist->iol_base;
+    const ipv6_hdr_t *hdr;
+
+    /* ignore everything the router sends on its own */
+    if ((netdev != &_dev_out.netdev) ||
+        (byteorder_ntohs(eth->type) != ETHERTYPE_IPV6) ||
+        (iolist->iol_next == NULL)) {
+        return iolist_size(iolist);
+    }
+    hdr = iolist->iol_next->iol_base;
+    if ((hdr->nh != PROTNUM_UDP) || !ipv6_addr_equal(&hdr->dst, &_dst)) {
+        return iolist_size(iolist);
+    }
+    expect(memcmp(eth->dst, _next_hop_l2addr, sizeof(eth->dst)) == 0);
+    expect(hdr->hl == (HOP_LIMIT - 1));
+    expect(iolist_size(iolist) == FRAME_LEN);
+    mutex_unlock(&_forwarded);
+    return iolist_size(iolist);
+}
+
+static void _forward(uint32_t fl)
+{
+    ipv6_hdr_set_fl((ipv6_hdr_t *)(_frame + sizeof(ethernet_hdr_t)), fl);
+    _dev_in.netdev.event_callback(&_dev_in.netdev, NETDEV_EVENT_ISR);
+    mutex_lock(&_forwarded);
+}
+
+static void _init_frame(void)
+{
+    ethernet_hdr_t *eth = (ethernet_hdr_t *)_frame;
+    ipv6_hdr_t *hdr = (ipv6_hdr_t *)(eth + 1);
+
+    memcpy(eth->dst, _dev_in.addr, sizeof(eth->dst));
+    memset(eth->src, 0x42, sizeof(eth->src));
+    eth->type = byteorder_htons(ETHERTYPE_IPV6);
+    ipv6_hdr_set_version(hdr);
+    hdr->len = byteorder_htons(PAYLOAD_LEN);
+    hdr->nh = PROTNUM_UDP;
+    hdr->hl = HOP_LIMIT;
+    hdr->src = _src;
+    hdr->dst = _dst;
+    memset(hdr + 1, 0xaa, PAYLOAD_LEN);
+}
+
+static void _print_stats(turo_t *ctx, const char *name,
+                         const gnrc_ipv6_flowcache_stats_t *before)
+{
+    gnrc_ipv6_flowcache_stats_t after;
+
+    gnrc_ipv6_flowcache_get_stats(&after);
+    turo_dict_open(ctx);
+    turo_dict_key(ctx, "name");
+    turo_string(ctx, name);
+    turo_dict_key(ctx, "hits");
+    turo_u32(ctx, after.hits - before->hits);
+    turo_dict_key(ctx, "misses");
+    turo_u32(ctx, after.misses - before->misses);
+    turo_dict_close(ctx);
+}
+
+int main(void)
+{
+    gnrc_ipv6_flowcache_stats_t stats;
+
+    _init_frame();
+    gnrc_netif_ethernet_create(&_netif_in, _stack_in, sizeof(_stack_in),
+                               GNRC_NETIF_PRIO, "in", &_dev_in.netdev);
+    gnrc_netif_ethernet_create(&_netif_out, _stack_out, sizeof(_stack_out),
+                               GNRC_NETIF_PRIO, "out", &_dev_out.netdev);
+    expect(gnrc_ipv6_nib_nc_set(&_next_hop, _netif_out.pid, _next_hop_l2addr,
+                                sizeof(_next_hop_l2addr)) == 0);
+    expect(gnrc_ipv6_nib_ft_add(&_dst, 64, &_next_hop, _netif_out.pid,
+                                0) == 0);
+
+    turo_t ctx;
+
+    turo_init(&ctx);
+    turo_container_open(&ctx);
+    /* a new flow label for every packet: every packet misses the cache */
+    gnrc_ipv6_flowcache_get_stats(&stats);
+    BENCHMARK_STATS(&ctx, "IPv6 thread", _forward(++_fl & 0xfffff));
+    _print_stats(&ctx, "IPv6 thread", &stats);
+    /* a flow label not used before: only the first packet and those after
+     * the flow expired miss the cache */
+    gnrc_ipv6_flowcache_get_stats(&stats);
+    BENCHMARK_STATS(&ctx, "flow cache", _forward(0));
+    _print_stats(&ctx, "flow cache", &stats);
+    turo_container_close(&ctx, 0);
+
+    return 0;
+}
@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import json
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"(\[.*\])\r\n")
+    res = json.loads(child.match.group(1))
+    assert res[-1] == {"exit_status": 0}
+    timings = [r for r in res[:-1] if "min_ns" in r]
+    stats = {r["name"]: r for r in res[:-1] if "hits" in r}
+    assert [r["name"] for r in timings] == ["IPv6 thread", "flow cache"]
+    for r in timings:
+        assert 0 < r["min_ns"] <= r["median_ns"] <= r["max_ns"]
+    # a new flow for every packet is always left to the IPv6 thread
+    assert stats["IPv6 thread"]["hits"] == 0
+    assert stats["IPv6 thread"]["misses"] > 0
+    # a single flow is forwarded by the receiving interface
+    assert stats["flow cache"]["hits"] > stats["flow cache"]["misses"]
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
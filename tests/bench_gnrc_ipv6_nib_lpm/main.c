@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the time to look up the route for a destination with
+ *              many routes in the forwarding table
+ *
+ * @}
+ */
+
+#include "benchmark.h"
+#include "byteorder.h"
+#include "net/gnrc/ipv6/nib/ft.h"
+#include "net/ipv6/addr.h"
+#include "test_utils/expect.h"
+#include "test_utils/result_output.h"
+
+#define ROUTES_MAX          (256U)
+#define IFACE               (6U)
+#define NEXT_HOPS_NUMOF     (4U)
+
+static unsigned _numof;
+static unsigned _next;
+
+/* 2001:db8:i::/48 to 2001:db8:i:xxxx::/64, so no route covers another */
+static void _route(unsigned i, ipv6_addr_t *pfx, unsigned *pfx_len)
+{
+    ipv6_addr_set_unspecified(pfx);
+    pfx->u16[0] = byteorder_htons(0x2001);
+    pfx->u16[1] = byteorder_htons(0x0db8);
+    pfx->u16[2] = byteorder_htons(i);
+    *pfx_len = 48 + (i % 17);
+    pfx->u16[3] = byteorder_htons((uint16_t)((0xffff << (64 - *pfx_len)) &
+                                             (i * 0x9e37)));
+}
+
+static void _add_routes(unsigned numof)
+{
+    for (; _numof < numof; _numof++) {
+        ipv6_addr_t pfx, next_hop;
+        unsigned pfx_len;
+
+        _route(_numof, &pfx, &pfx_len);
+        ipv6_addr_set_link_local_prefix(&next_hop);
+        ipv6_addr_set_iid(&next_hop, 1 + (_numof % NEXT_HOPS_NUMOF));
+        expect(gnrc_ipv6_nib_ft_add(&pfx, pfx_len, &next_hop, IFACE, 0) == 0);
+    }
+    _next = 0;
+}
+
+static void _lookup(void)
+{
+    gnrc_ipv6_nib_ft_t fte;
+    ipv6_addr_t dst;
+    unsigned pfx_len;
+
+    _route(_next, &dst, &pfx_len);
+    dst.u64[1].u64 = _next;
+    /* the same route lookup gnrc_ipv6_nib_get_next_hop_l2addr() does */
+    expect(gnrc_ipv6_nib_ft_get(&dst, NULL, &fte) == 0);
+    expect(fte.dst_len == pfx_len);
+    /* a different route than the last one, but every one in turn */
+    _next = (_next + 7) % _numof;
+}
+
+int main(void)
+{
+    turo_t ctx;
+
+    turo_init(&ctx);
+    turo_container_open(&ctx);
+    _add_routes(16);
+    BENCHMARK_STATS(&ctx, "16 routes", _lookup());
+    _add_routes(64);
+    BENCHMARK_STATS(&ctx, "64 routes", _lookup());
+    _add_routes(ROUTES_MAX);
+    BENCHMARK_STATS(&ctx, "256 routes", _lookup());
+    turo_container_close(&ctx, 0);
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the time to look up the subscribers of a packet with
+ *              many registered demultiplexing contexts
+ *
+ * @}
+ */
+
+#include "benchmark.h"
+#include "kernel_defines.h"
+#include "msg.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/nettype.h"
+#include "test_utils/expect.h"
+#include "test_utils/result_output.h"
+#include "thread.h"
+
+#define ENTRIES_MAX         (256U)
+#define DEMUX_CTX_BASE      (49152U)    /**< e.g. the ephemeral UDP ports */
+
+static gnrc_netreg_entry_t _entries[ENTRIES_MAX];
+static msg_t _msg_queue[4];
+static unsigned _numof;
+static unsigned _next;
+
+static void _register(unsigned numof)
+{
+    gnrc_netreg_init();
+    for (unsigned i = 0; i < numof; i++) {
+        gnrc_netreg_entry_init_pid(&_entries[i], DEMUX_CTX_BASE + i,
+                                   thread_getpid());
+        expect(gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &_entries[i]) == 0);
+    }
+    _numof = numof;
+    _next = 0;
+}
+
+static void _lookup(void)
+{
+    gnrc_netreg_entry_t *entry;
+
+    /* the same demultiplexing gnrc_netapi_dispatch() does */
+    expect(gnrc_netreg_lookup_all(GNRC_NETTYPE_UNDEF, DEMUX_CTX_BASE + _next,
+                                  &entry) == 1);
+    for (; entry != NULL; entry = gnrc_netreg_getnext(entry)) {}
+    /* a different context than the last one, but every one in turn */
+    _next = (_next + 7) % _numof;
+}
+
+int main(void)
+{
+    turo_t ctx;
+
+    /* entries are registered for this thread, which needs a queue for that */
+    msg_init_queue(_msg_queue, ARRAY_SIZE(_msg_queue));
+    turo_init(&ctx);
+    turo_container_open(&ctx);
+    _register(1);
+    BENCHMARK_STATS(&ctx, "1 entry", _lookup());
+    _register(32);
+    BENCHMARK_STATS(&ctx, "32 entries", _lookup());
+    _register(ENTRIES_MAX);
+    BENCHMARK_STATS(&ctx, "256 entries", _lookup());
+    turo_container_close(&ctx, 0);
+
+    return 0;
+}
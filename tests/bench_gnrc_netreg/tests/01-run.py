@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import json
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"(\[.*\])\r\n")
+    res = json.loads(child.match.group(1))
+    assert res[-1] == {"exit_status": 0}
+    assert [r["name"] for r in res[:-1]] == \
+        ["1 entry", "32 entries", "256 entries"]
+    for r in res[:-1]:
+        assert 0 < r["min_ns"] <= r["median_ns"] <= r["max_ns"]
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
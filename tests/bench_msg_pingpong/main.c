@@ -11,33 +11,34 @@
  * @{
  *
  * @file
- * @brief       Measure messages send per second
+ * @brief       Measure the time needed to send a message to another thread,
+ *              one by one and in batches
  *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  *
  * @}
  */
 
-#include <stdint.h>
-#include <stdatomic.h>
 #include <stdio.h>
-#include "macros/units.h"
-#include "thread.h"
-#include "clk.h"
 
+#include "benchmark.h"
+#include "kernel_defines.h"
 #include "msg.h"
-#include "xtimer.h"
+#include "test_utils/expect.h"
+#include "test_utils/result_output.h"
+#include "thread.h"
 
-#ifndef TEST_DURATION_US
-#define TEST_DURATION_US    (1000000U)
+#ifndef MSGS_PER_SAMPLE
+#define MSGS_PER_SAMPLE     (256U)
 #endif
 
+#define BATCH_MAX           (16U)
+
 static char _stack[THREAD_STACKSIZE_MAIN];
+static char _batch_stack[THREAD_STACKSIZE_MAIN];
 
-static void _timer_callback(void *flag)
-{
-    atomic_flag_clear(flag);
-}
+/* batch sizes to measure the per message cost of msg_send_batch() for */
+static const unsigned _batch_sizes[] = { 1, 4, 16 };
 
 static void *_second_thread(void *arg)
 {
@@ -51,6 +52,45 @@ static void *_second_thread(void *arg)
     return NULL;
 }
 
+static void *_batch_thread(void *arg)
+{
+    (void)arg;
+
+    msg_t queue[BATCH_MAX];
+    msg_init_queue(queue, ARRAY_SIZE(queue));
+
+    while (1) {
+        msg_t test[BATCH_MAX];
+        msg_receive_batch(test, ARRAY_SIZE(test));
+    }
+
+    return NULL;
+}
+
+static void _bench_batch(turo_t *ctx, kernel_pid_t other, unsigned size)
+{
+    char name[40];
+    benchmark_t bench;
+    msg_t test[BATCH_MAX];
+
+    snprintf(name, sizeof(name), "msg_send_batch() pingpong, %u msgs", size);
+    benchmark_init(&bench, name);
+
+    do {
+        uint32_t before = benchmark_now();
+        for (unsigned n = 0; n < MSGS_PER_SAMPLE / size; n++) {
+            int res = msg_send_batch(test, size, other);
+            expect(res == (int)size);
+        }
+        uint32_t diff = benchmark_now() - before;
+        if (benchmark_add_sample(&bench, diff, MSGS_PER_SAMPLE)) {
+            break;
+        }
+    } while (1);
+
+    benchmark_turo(ctx, &bench);
+}
+
 int main(void)
 {
     puts("main starting");
@@ -62,28 +102,24 @@ int main(void)
                                        _second_thread,
                                        NULL,
                                        "second_thread");
+    kernel_pid_t batch = thread_create(_batch_stack,
+                                       sizeof(_batch_stack),
+                                       (THREAD_PRIORITY_MAIN - 1),
+                                       THREAD_CREATE_STACKTEST,
+                                       _batch_thread,
+                                       NULL,
+                                       "batch_thread");
 
-    atomic_flag flag = ATOMIC_FLAG_INIT;
-    uint32_t n = 0;
-
-    xtimer_t timer = {
-        .callback = _timer_callback,
-        .arg = &flag,
-    };
-
-    atomic_flag_test_and_set(&flag);
-    xtimer_set(&timer, TEST_DURATION_US);
+    turo_t ctx;
+    msg_t test;
 
-    while (atomic_flag_test_and_set(&flag)) {
-        msg_t test;
-        msg_send(&test, other);
-        n++;
+    turo_init(&ctx);
+    turo_container_open(&ctx);
+    BENCHMARK_STATS(&ctx, "msg_send() pingpong", msg_send(&test, other));
+    for (unsigned i = 0; i < ARRAY_SIZE(_batch_sizes); i++) {
+        _bench_batch(&ctx, batch, _batch_sizes[i]);
     }
-
-    printf("{ \"result\" : %"PRIu32, n);
-    printf(", \"ticks\" : %"PRIu32,
-           (uint32_t)((TEST_DURATION_US/US_PER_MS) * (coreclk()/KHZ(1)))/n);
-    puts(" }");
+    turo_container_close(&ctx, 0);
 
     return 0;
 }
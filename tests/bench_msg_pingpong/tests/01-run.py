@@ -7,12 +7,20 @@
 # General Public License v2.1. See the file LICENSE in the top level
 # directory for more details.
 
+import json
 import sys
 from testrunner import run
 
 
 def testfunc(child):
-    child.expect(r"{ \"result\" : \d+(, \"ticks\" : \d+)? }")
+    child.expect(r"(\[.*\])\r\n")
+    res = json.loads(child.match.group(1))
+    assert res[-1] == {"exit_status": 0}
+    names = ["msg_send() pingpong"] + \
+        ["msg_send_batch() pingpong, {} msgs".format(n) for n in (1, 4, 16)]
+    assert [r["name"] for r in res[:-1]] == names
+    for r in res[:-1]:
+        assert 0 < r["min_ns"] <= r["median_ns"] <= r["max_ns"]
 
 
 if __name__ == "__main__":
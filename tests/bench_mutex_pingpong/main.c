@@ -20,27 +20,14 @@
 
 #include <stdio.h>
 
-#include "macros/units.h"
-#include "clk.h"
+#include "benchmark.h"
 #include "mutex.h"
+#include "test_utils/result_output.h"
 #include "thread.h"
-#include "xtimer.h"
 
-#ifndef TEST_DURATION
-#define TEST_DURATION       (1000000U)
-#endif
-
-volatile unsigned _flag = 0;
 static char _stack[THREAD_STACKSIZE_MAIN];
 static mutex_t _mutex = MUTEX_INIT;
 
-static void _timer_callback(void*arg)
-{
-    (void)arg;
-
-    _flag = 1;
-}
-
 static void *_second_thread(void *arg)
 {
     (void)arg;
@@ -68,21 +55,12 @@ int main(void)
     mutex_lock(&_mutex);
     thread_yield_higher();
 
-    xtimer_t timer;
-    timer.callback = _timer_callback;
-
-    uint32_t n = 0;
-
-    xtimer_set(&timer, TEST_DURATION);
-    while(!_flag) {
-        mutex_unlock(&_mutex);
-        n++;
-    }
+    turo_t ctx;
 
-    printf("{ \"result\" : %"PRIu32, n);
-    printf(", \"ticks\" : %"PRIu32,
-           (uint32_t)((TEST_DURATION/US_PER_MS) * (coreclk()/KHZ(1)))/n);
-    puts(" }");
+    turo_init(&ctx);
+    turo_container_open(&ctx);
+    BENCHMARK_STATS(&ctx, "mutex_unlock() pingpong", mutex_unlock(&_mutex));
+    turo_container_close(&ctx, 0);
 
     return 0;
 }
@@ -7,12 +7,17 @@
 # General Public License v2.1. See the file LICENSE in the top level
 # directory for more details.
 
+import json
 import sys
 from testrunner import run
 
 
 def testfunc(child):
-    child.expect(r"{ \"result\" : \d+(, \"ticks\" : \d+)? }")
+    child.expect(r"(\[.*\])\r\n")
+    res = json.loads(child.match.group(1))
+    assert res[-1] == {"exit_status": 0}
+    assert res[0]["name"] == "mutex_unlock() pingpong"
+    assert 0 < res[0]["min_ns"] <= res[0]["median_ns"] <= res[0]["max_ns"]
 
 
 if __name__ == "__main__":
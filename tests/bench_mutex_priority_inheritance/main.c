@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Worst-case mutex wake latency of a high priority thread
+ *              under contention
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "mutex.h"
+#include "test_utils/result_output.h"
+#include "thread.h"
+#include "ztimer.h"
+
+/* time main spends in its critical section, in us */
+#define CRITICAL_US     (1000U)
+/* time the medium priority thread keeps the CPU busy, in us */
+#define HOG_US          (10U * CRITICAL_US)
+
+static char _stack_high[THREAD_STACKSIZE_DEFAULT];
+static char _stack_mid[THREAD_STACKSIZE_DEFAULT];
+static char _stack_nested[THREAD_STACKSIZE_DEFAULT];
+
+static kernel_pid_t _pid_high;
+static kernel_pid_t _pid_mid;
+static kernel_pid_t _pid_nested;
+
+/* locked by main */
+static mutex_t _outer = MUTEX_INIT;
+/* locked by the nested thread while waiting for _outer */
+static mutex_t _inner = MUTEX_INIT;
+/* mutex the high priority thread waits for in the current scenario */
+static mutex_t *_wanted;
+
+static uint32_t _latency;
+
+static void *_high(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        uint32_t start = benchmark_now();
+        mutex_lock(_wanted);
+        _latency = benchmark_now() - start;
+        mutex_unlock(_wanted);
+        thread_sleep();
+    }
+
+    return NULL;
+}
+
+static void *_mid(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        /* not touching any mutex, but starving all lower priority threads */
+        ztimer_spin(ZTIMER_USEC, HOG_US);
+        thread_sleep();
+    }
+
+    return NULL;
+}
+
+static void *_nested(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        mutex_lock(&_inner);
+        mutex_lock(&_outer);
+        mutex_unlock(&_inner);
+        mutex_unlock(&_outer);
+        thread_sleep();
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief   Measure the time the high priority thread waits for @p wanted
+ *
+ * main (lowest priority) holds `_outer` for @ref CRITICAL_US, the high
+ * priority thread blocks on @p wanted and the medium priority thread becomes
+ * runnable. With @p nested, the high priority thread waits for `_inner`,
+ * held by a thread that in turn waits for `_outer`.
+ */
+static void _bench(turo_t *ctx, const char *name, bool nested)
+{
+    benchmark_t bench;
+    bool done = false;
+
+    _wanted = nested ? &_inner : &_outer;
+    benchmark_init(&bench, name);
+    while (!done) {
+        mutex_lock(&_outer);
+        if (nested) {
+            /* locks _inner and blocks on _outer */
+            thread_wakeup(_pid_nested);
+        }
+        /* blocks on _wanted */
+        thread_wakeup(_pid_high);
+        /* preempts main, unless main inherited a higher priority */
+        thread_wakeup(_pid_mid);
+        ztimer_spin(ZTIMER_USEC, CRITICAL_US);
+        mutex_unlock(&_outer);
+        /* only continues when all other threads sleep again */
+        done = benchmark_add_sample(&bench, _latency, 1);
+    }
+    benchmark_turo(ctx, &bench);
+}
+
+int main(void)
+{
+    printf("priority inheritance: %s\n",
+           IS_USED(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) ? "yes" : "no");
+    printf("critical section: %uus, medium priority busy: %uus\n",
+           CRITICAL_US, HOG_US);
+
+    _pid_high = thread_create(_stack_high, sizeof(_stack_high),
+                              THREAD_PRIORITY_MAIN - 3,
+                              THREAD_CREATE_SLEEPING | THREAD_CREATE_STACKTEST,
+                              _high, NULL, "high");
+    _pid_mid = thread_create(_stack_mid, sizeof(_stack_mid),
+                             THREAD_PRIORITY_MAIN - 2,
+                             THREAD_CREATE_SLEEPING | THREAD_CREATE_STACKTEST,
+                             _mid, NULL, "mid");
+    _pid_nested = thread_create(_stack_nested, sizeof(_stack_nested),
+                                THREAD_PRIORITY_MAIN - 1,
+                                THREAD_CREATE_SLEEPING | THREAD_CREATE_STACKTEST,
+                                _nested, NULL, "nested");
+
+    turo_t ctx;
+
+    turo_init(&ctx);
+    turo_container_open(&ctx);
+    _bench(&ctx, "mutex_lock() wake latency, direct", false);
+    _bench(&ctx, "mutex_lock() wake latency, nested", true);
+    turo_container_close(&ctx, 0);
+
+    return 0;
+}
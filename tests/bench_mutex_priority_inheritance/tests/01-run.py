@@ -0,0 +1,37 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import json
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"priority inheritance: (yes|no)\r\n")
+    pi = child.match.group(1) == "yes"
+    child.expect(r"critical section: (\d+)us, medium priority busy: (\d+)us\r\n")
+    critical_ns = int(child.match.group(1)) * 1000
+    hog_ns = int(child.match.group(2)) * 1000
+    child.expect(r"(\[.*\])\r\n")
+    res = json.loads(child.match.group(1))
+    assert res[-1] == {"exit_status": 0}
+    assert [r["name"] for r in res[:-1]] == [
+        "mutex_lock() wake latency, direct",
+        "mutex_lock() wake latency, nested",
+    ]
+    for r in res[:-1]:
+        assert critical_ns <= r["min_ns"] <= r["median_ns"] <= r["max_ns"]
+        if pi:
+            # the medium priority thread must never delay the high priority one
+            assert r["max_ns"] < hog_ns, r
+        else:
+            assert r["min_ns"] >= hog_ns, r
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
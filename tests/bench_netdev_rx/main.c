@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the Ethernet receive path with and without buffers
+ *              lent to the driver
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "iolist.h"
+#include "kernel_defines.h"
+#include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/netdev/eth.h"
+#include "test_utils/expect.h"
+#include "test_utils/result_output.h"
+
+#ifndef PAYLOAD_LEN
+#define PAYLOAD_LEN         (1024U)
+#endif
+
+#define FRAME_LEN           (sizeof(ethernet_hdr_t) + PAYLOAD_LEN)
+
+typedef struct {
+    netdev_t netdev;
+    uint8_t *payload_at;    /**< where the payload of the last frame went */
+    uint32_t frames;        /**< frames received */
+    uint32_t copies;        /**< copies of these frames */
+    uint32_t bytes;         /**< bytes copied for these frames */
+} bench_dev_t;
+
+static const uint8_t _addr[ETHERNET_ADDR_LEN] = { 0x02, 0, 0, 0, 0, 0x01 };
+static uint8_t _frame[FRAME_LEN];
+
+static char _stack_copy[THREAD_STACKSIZE_DEFAULT];
+static char _stack_loan[THREAD_STACKSIZE_DEFAULT];
+static gnrc_netif_t _netif_copy;
+static gnrc_netif_t _netif_loan;
+
+static void _count_copy(bench_dev_t *dev, size_t len)
+{
+    dev->copies++;
+    dev->bytes += len;
+}
+
+static int _init(netdev_t *netdev)
+{
+    (void)netdev;
+    return 0;
+}
+
+static void _isr(netdev_t *netdev)
+{
+    (void)netdev;
+}
+
+static int _send(netdev_t *netdev, const iolist_t *iolist)
+{
+    (void)netdev;
+    return iolist_size(iolist);
+}
+
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    bench_dev_t *dev = container_of(netdev, bench_dev_t, netdev);
+
+    (void)info;
+    if (buf == NULL) {
+        return FRAME_LEN;
+    }
+    if (len < FRAME_LEN) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, _frame, FRAME_LEN);
+    _count_copy(dev, FRAME_LEN);
+    dev->payload_at = (uint8_t *)buf + sizeof(ethernet_hdr_t);
+
+    return FRAME_LEN;
+}
+
+static int _recv_iol(netdev_t *netdev, const iolist_t *iolist, void *info)
+{
+    bench_dev_t *dev = container_of(netdev, bench_dev_t, netdev);
+    size_t offset = sizeof(ethernet_hdr_t);
+
+    (void)info;
+    if (iolist_fill(iolist, 0, _frame, FRAME_LEN) < FRAME_LEN) {
+        return -ENOBUFS;
+    }
+    _count_copy(dev, FRAME_LEN);
+
+    /* find the buffer the payload was written to */
+    while (offset >= iolist->iol_len) {
+        offset -= iolist->iol_len;
+        iolist = iolist->iol_next;
+    }
+    dev->payload_at = (uint8_t *)iolist->iol_base + offset;
+
+    return FRAME_LEN;
+}
+
+static int _get(netdev_t *netdev, netopt_t opt, void *value, size_t max_len)
+{
+    if (opt == NETOPT_ADDRESS) {
+        if (max_len < sizeof(_addr)) {
+            return -EOVERFLOW;
+        }
+        memcpy(value, _addr, sizeof(_addr));
+        return sizeof(_addr);
+    }
+    return netdev_eth_get(netdev, opt, value, max_len);
+}
+
+static int _set(netdev_t *netdev, netopt_t opt, const void *value,
+                size_t value_len)
+{
+    return netdev_eth_set(netdev, opt, value, value_len);
+}
+
+static const netdev_driver_t _driver_copy = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = _set,
+};
+
+static const netdev_driver_t _driver_loan = {
+    .send = _send,
+    .recv = _recv,
+    .recv_iol = _recv_iol,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = _set,
+};
+
+static bench_dev_t _dev_copy = { .netdev = { .driver = &_driver_copy } };
+static bench_dev_t _dev_loan = { .netdev = { .driver = &_driver_loan } };
+
+static void _recv_frame(gnrc_netif_t *netif)
+{
+    bench_dev_t *dev = container_of(netif->dev, bench_dev_t, netdev);
+    gnrc_pktsnip_t *pkt = netif->ops->recv(netif);
+
+    expect(pkt != NULL);
+    expect(pkt->size == PAYLOAD_LEN);
+    if (pkt->data != dev->payload_at) {
+        /* the stack moved the payload out of the buffer the driver used */
+        _count_copy(dev, pkt->size);
+    }
+    dev->frames++;
+    gnrc_pktbuf_release(pkt);
+}
+
+static void _print_copies(turo_t *ctx, const char *name, bench_dev_t *dev)
+{
+    turo_dict_open(ctx);
+    turo_dict_key(ctx, "name");
+    turo_string(ctx, name);
+    turo_dict_key(ctx, "copies");
+    turo_u32(ctx, dev->copies / dev->frames);
+    turo_dict_key(ctx, "bytes");
+    turo_u32(ctx, dev->bytes / dev->frames);
+    turo_dict_close(ctx);
+}
+
+int main(void)
+{
+    ethernet_hdr_t *hdr = (ethernet_hdr_t *)_frame;
+
+    memcpy(hdr->dst, _addr, sizeof(_addr));
+    memset(hdr->src, 0x42, sizeof(hdr->src));
+    hdr->type = byteorder_htons(ETHERTYPE_UNKNOWN);
+    memset(hdr + 1, 0xaa, PAYLOAD_LEN);
+
+    gnrc_netif_ethernet_create(&_netif_copy, _stack_copy, sizeof(_stack_copy),
+                               GNRC_NETIF_PRIO, "copy", &_dev_copy.netdev);
+    gnrc_netif_ethernet_create(&_netif_loan, _stack_loan, sizeof(_stack_loan),
+                               GNRC_NETIF_PRIO, "loan", &_dev_loan.netdev);
+
+    turo_t ctx;
+
+    turo_init(&ctx);
+    turo_container_open(&ctx);
+    BENCHMARK_STATS(&ctx, "recv() copy", _recv_frame(&_netif_copy));
+    BENCHMARK_STATS(&ctx, "recv_iol() loan", _recv_frame(&_netif_loan));
+    _print_copies(&ctx, "recv() copy", &_dev_copy);
+    _print_copies(&ctx, "recv_iol() loan", &_dev_loan);
+    turo_container_close(&ctx, 0);
+
+    return 0;
+}
@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import json
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"(\[.*\])\r\n")
+    res = json.loads(child.match.group(1))
+    assert res[-1] == {"exit_status": 0}
+    timings = [r for r in res[:-1] if "min_ns" in r]
+    copies = {r["name"]: r for r in res[:-1] if "copies" in r}
+    assert [r["name"] for r in timings] == ["recv() copy", "recv_iol() loan"]
+    for r in timings:
+        assert 0 < r["min_ns"] <= r["median_ns"] <= r["max_ns"]
+    # the legacy path moves the payload out of the frame, loaning does not
+    assert copies["recv() copy"]["copies"] == 2
+    assert copies["recv_iol() loan"]["copies"] == 1
+    assert copies["recv_iol() loan"]["bytes"] < copies["recv() copy"]["bytes"]
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput of the byte ringbuffers tsrb and ringbuffer
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "ringbuffer.h"
+#include "test_utils/result_output.h"
+#include "tsrb.h"
+
+#define BUF_SIZE        (512U)
+#define XFER_MAX        (256U)
+
+static uint8_t _tsrb_mem[BUF_SIZE];
+static char _rb_mem[BUF_SIZE];
+static tsrb_t _tsrb = TSRB_INIT(_tsrb_mem);
+static ringbuffer_t _rb = RINGBUFFER_INIT(_rb_mem);
+
+static uint8_t _src[XFER_MAX];
+static uint8_t _dst[XFER_MAX];
+
+static const unsigned _lens[] = { 1, 16, 256 };
+
+static void _tsrb_bulk(unsigned len)
+{
+    tsrb_add(&_tsrb, _src, len);
+    tsrb_get(&_tsrb, _dst, len);
+}
+
+static void _tsrb_bytewise(unsigned len)
+{
+    for (unsigned i = 0; i < len; i++) {
+        tsrb_add_one(&_tsrb, _src[i]);
+    }
+    for (unsigned i = 0; i < len; i++) {
+        _dst[i] = tsrb_get_one(&_tsrb);
+    }
+}
+
+static void _rb_bulk(unsigned len)
+{
+    ringbuffer_add(&_rb, (char *)_src, len);
+    ringbuffer_get(&_rb, (char *)_dst, len);
+}
+
+static void _rb_bytewise(unsigned len)
+{
+    for (unsigned i = 0; i < len; i++) {
+        ringbuffer_add_one(&_rb, _src[i]);
+    }
+    for (unsigned i = 0; i < len; i++) {
+        _dst[i] = ringbuffer_get_one(&_rb);
+    }
+}
+
+static void _measure(turo_t *ctx, const char *name, void (*xfer)(unsigned))
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_lens); i++) {
+        benchmark_t bench;
+        benchmark_result_t res;
+        uint32_t n;
+
+        benchmark_init(&bench, name);
+        while ((n = benchmark_next(&bench))) {
+            for (uint32_t j = 0; j < n; j++) {
+                xfer(_lens[i]);
+            }
+        }
+        benchmark_result(&bench, &res);
+
+        turo_dict_open(ctx);
+        turo_dict_key(ctx, "bytes");
+        turo_u32(ctx, _lens[i]);
+        turo_dict_key(ctx, "bytes_per_sec");
+        turo_u64(ctx, (uint64_t)_lens[i] * 1000000000LU /
+                      (res.median > 0 ? (uint32_t)res.median : 1));
+        turo_dict_key(ctx, "stats");
+        benchmark_turo(ctx, &bench);
+        turo_dict_close(ctx);
+    }
+}
+
+int main(void)
+{
+    turo_t ctx;
+
+    for (unsigned i = 0; i < XFER_MAX; i++) {
+        _src[i] = i;
+    }
+    /* have the transfers cross the end of the buffer memory now and then */
+    tsrb_add_one(&_tsrb, 0);
+    tsrb_get_one(&_tsrb);
+    ringbuffer_add_one(&_rb, 0);
+    ringbuffer_get_one(&_rb);
+
+    puts("add and get n bytes:");
+    turo_init(&ctx);
+    turo_container_open(&ctx);
+    _measure(&ctx, "tsrb", _tsrb_bulk);
+    _measure(&ctx, "tsrb bytewise", _tsrb_bytewise);
+    _measure(&ctx, "ringbuffer", _rb_bulk);
+    _measure(&ctx, "ringbuffer bytewise", _rb_bytewise);
+    turo_container_close(&ctx, 0);
+
+    return 0;
+}
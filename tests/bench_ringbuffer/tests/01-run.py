@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import json
+import sys
+from testrunner import run
+
+
+NAMES = ["tsrb", "tsrb bytewise", "ringbuffer", "ringbuffer bytewise"]
+LENS = [1, 16, 256]
+
+
+def testfunc(child):
+    child.expect_exact("add and get n bytes:")
+    child.expect(r"(\[.*\])\r\n")
+    res = json.loads(child.match.group(1))
+    assert res[-1] == {"exit_status": 0}
+    res = res[:-1]
+    assert [(r["stats"]["name"], r["bytes"]) for r in res] == \
+        [(name, n) for name in NAMES for n in LENS]
+
+    rate = {}
+    for r in res:
+        assert r["bytes_per_sec"] > 0, r
+        rate[(r["stats"]["name"], r["bytes"])] = r["bytes_per_sec"]
+        print("{:<20} {:>4} bytes: {:>12} bytes/s".format(
+            r["stats"]["name"], r["bytes"], r["bytes_per_sec"]))
+
+    # large transfers must benefit from copying blocks
+    for name in ["tsrb", "ringbuffer"]:
+        assert rate[(name, 256)] > rate[(name + " bytewise", 256)]
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
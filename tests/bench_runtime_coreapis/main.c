@@ -22,13 +22,10 @@
 
 #include "mutex.h"
 #include "benchmark.h"
+#include "test_utils/result_output.h"
 #include "thread.h"
 #include "thread_flags.h"
 
-#ifndef BENCH_RUNS
-#define BENCH_RUNS          (1000UL * 1000UL)
-#endif
-
 static mutex_t _lock;
 static thread_t *t;
 static thread_flags_t _flag = 0x0001;
@@ -60,23 +57,25 @@ static void _flag_waitone(void)
 
 int main(void)
 {
+    turo_t ctx;
+
     puts("Runtime of Selected Core API functions\n");
 
     t = thread_get_active();
 
-    BENCHMARK_FUNC("nop loop", BENCH_RUNS, __asm__ volatile ("nop"));
-    puts("");
-    BENCHMARK_FUNC("mutex_init()", BENCH_RUNS, mutex_init(&_lock));
-    BENCHMARK_FUNC("mutex lock/unlock", BENCH_RUNS, _mutex_lockunlock());
-    puts("");
-    BENCHMARK_FUNC("thread_flags_set()", BENCH_RUNS, thread_flags_set(t, _flag));
-    BENCHMARK_FUNC("thread_flags_clear()", BENCH_RUNS, thread_flags_clear(_flag));
-    BENCHMARK_FUNC("thread flags set/wait any", BENCH_RUNS, _flag_waitany());
-    BENCHMARK_FUNC("thread flags set/wait all", BENCH_RUNS, _flag_waitall());
-    BENCHMARK_FUNC("thread flags set/wait one", BENCH_RUNS, _flag_waitone());
-    puts("");
-    BENCHMARK_FUNC("msg_try_receive()", BENCH_RUNS, msg_try_receive(&_msg));
-    BENCHMARK_FUNC("msg_avail()", BENCH_RUNS, msg_avail());
+    turo_init(&ctx);
+    turo_container_open(&ctx);
+    BENCHMARK_STATS(&ctx, "nop loop", __asm__ volatile ("nop"));
+    BENCHMARK_STATS(&ctx, "mutex_init()", mutex_init(&_lock));
+    BENCHMARK_STATS(&ctx, "mutex lock/unlock", _mutex_lockunlock());
+    BENCHMARK_STATS(&ctx, "thread_flags_set()", thread_flags_set(t, _flag));
+    BENCHMARK_STATS(&ctx, "thread_flags_clear()", thread_flags_clear(_flag));
+    BENCHMARK_STATS(&ctx, "thread flags set/wait any", _flag_waitany());
+    BENCHMARK_STATS(&ctx, "thread flags set/wait all", _flag_waitall());
+    BENCHMARK_STATS(&ctx, "thread flags set/wait one", _flag_waitone());
+    BENCHMARK_STATS(&ctx, "msg_try_receive()", msg_try_receive(&_msg));
+    BENCHMARK_STATS(&ctx, "msg_avail()", msg_avail());
+    turo_container_close(&ctx, 0);
 
     puts("\n[SUCCESS]");
     return 0;
@@ -6,27 +6,45 @@
 # General Public License v2.1. See the file LICENSE in the top level
 # directory for more details.
 
+import json
 import sys
 from testrunner import run
 
 
 # The default timeout is not enough for this test on some of the slower boards
-TIMEOUT = 30
-BENCHMARK_REGEXP = r"\s+{func}:\s+\d+us\s+---\s+\d*\.*\d+us per call\s+---\s+\d+ calls per sec"
+TIMEOUT = 60
+BENCHMARKS = [
+    "nop loop",
+    "mutex_init()",
+    "mutex lock/unlock",
+    "thread_flags_set()",
+    "thread_flags_clear()",
+    "thread flags set/wait any",
+    "thread flags set/wait all",
+    "thread flags set/wait one",
+    "msg_try_receive()",
+    "msg_avail()",
+]
+
+
+def check_benchmarks(results, names):
+    """Check the output of BENCHMARK_STATS() for the given benchmarks"""
+    assert results[-1] == {"exit_status": 0}
+    results = results[:-1]
+    assert [res["name"] for res in results] == names
+    for res in results:
+        assert res["samples"] > 0
+        assert 0 <= res["min_ns"] <= res["median_ns"] <= res["p99_ns"] \
+            <= res["max_ns"]
+        assert res["min_ns"] <= res["mean_ns"] <= res["max_ns"]
+        print("{name:>30}: median {median_ns:9} ns  p99 {p99_ns:9} ns  "
+              "stddev {stddev_ns:9} ns".format(**res))
 
 
 def testfunc(child):
     child.expect_exact('Runtime of Selected Core API functions')
-    child.expect(BENCHMARK_REGEXP.format(func="nop loop"))
-    child.expect(BENCHMARK_REGEXP.format(func=r"mutex_init\(\)"))
-    child.expect(BENCHMARK_REGEXP.format(func="mutex lock/unlock"), timeout=TIMEOUT)
-    child.expect(BENCHMARK_REGEXP.format(func=r"thread_flags_set\(\)"))
-    child.expect(BENCHMARK_REGEXP.format(func=r"thread_flags_clear\(\)"))
-    child.expect(BENCHMARK_REGEXP.format(func="thread flags set/wait any"), timeout=TIMEOUT)
-    child.expect(BENCHMARK_REGEXP.format(func="thread flags set/wait all"), timeout=TIMEOUT)
-    child.expect(BENCHMARK_REGEXP.format(func="thread flags set/wait one"), timeout=TIMEOUT)
-    child.expect(BENCHMARK_REGEXP.format(func=r"msg_try_receive\(\)"), timeout=TIMEOUT)
-    child.expect(BENCHMARK_REGEXP.format(func=r"msg_avail\(\)"))
+    child.expect(r"(\[.*\])\r\n", timeout=TIMEOUT)
+    check_benchmarks(json.loads(child.match.group(1)), BENCHMARKS)
     child.expect_exact('[SUCCESS]')
 
 
@@ -20,7 +20,10 @@
 
 #include <stdio.h>
 
+#include "benchmark.h"
+#include "kernel_defines.h"
 #include "test_utils/expect.h"
+#include "test_utils/result_output.h"
 
 #include "msg.h"
 #include "thread.h"
@@ -35,7 +38,7 @@
 #endif
 
 #ifndef REPEAT
-#define REPEAT   (1000U)
+#define REPEAT   (100U)
 #endif
 
 #ifndef BASE
@@ -47,6 +50,11 @@
 #endif
 
 static ztimer_t _timers[NUMOF_TIMERS];
+static ztimer_t _probe;
+static turo_t _ctx;
+
+/* numbers of pending timers to measure single arm / cancel latency against */
+static const unsigned _pending[] = { 10, 100, 1000 };
 
 /* This variable is set by any timer that actually triggers.  As the test is
  * only testing set/remove/now operations, timers are not supposed to trigger.
@@ -57,16 +65,39 @@ static unsigned _triggers;
 /*
  * The test assumes that first, middle and last will always end up in at the
  * same index within the timer queue.  In order to compensate for the time that
- * previous operations take themselves, the interval is corrected. The
- * variables "start" and "_base" are used for that.
+ * previous operations take themselves, the interval is corrected before every
+ * sample. The variables "_start" and "_base" are used for that.
  */
 uint32_t _base;
+static uint32_t _start;
+
+/* benchmark @p func like BENCHMARK_STATS(), correcting _base for every
+ * sample */
+#define BENCH(name, func)                                           \
+    {                                                               \
+        benchmark_t bench;                                          \
+        uint32_t n;                                                 \
+        benchmark_init(&bench, name);                               \
+        while ((n = benchmark_next(&bench))) {                      \
+            _update_base();                                         \
+            for (uint32_t i = 0; i < n; i++) {                      \
+                func;                                               \
+            }                                                       \
+        }                                                           \
+        benchmark_turo(&_ctx, &bench);                              \
+        expect(!_triggers);                                         \
+    }
 
 static void _callback(void *arg) {
     unsigned *triggers = arg;
     *triggers += 1;
 }
 
+static void _update_base(void)
+{
+    _base = BASE - (ztimer_now(ZTIMER_USEC) - _start);
+}
+
 /* returns the interval for timer 'n' that has to be set in order to insert it
  * into position n */
 static uint32_t _timer_val(unsigned n)
@@ -86,209 +117,187 @@ static void _timer_remove(unsigned n)
     ztimer_remove(ZTIMER, &_timers[n]);
 }
 
-static void _print_result(const char *desc, unsigned n, uint32_t total)
+static void _set_all(void)
 {
-    printf("%30s %8"PRIu32" / %u = %"PRIu32"\n", desc, total, n, total/n);
+    _update_base();
+    for (unsigned n = 0; n < NUMOF_TIMERS; n++) {
+        _timer_set(n);
+    }
 }
 
-int main(void)
+static void _remove_all(void)
 {
-    puts("ztimer benchmark application.\n");
-
-    unsigned n;
-    uint32_t before, diff, start;
-
-    /* initializing timer structs */
-    for (unsigned int n = 0; n < NUMOF_TIMERS; n++) {
-        _timers[n].callback = _callback;
-        _timers[n].arg = &_triggers;
-    }
-
-    start = ztimer_now(ZTIMER_USEC);
-
-    /*
-     * test setting one set timer REPEAT times
-     *
-     */
-    _base = BASE;
-    before = ztimer_now(ZTIMER_USEC);
-    for (n = 0; n < REPEAT; n++) {
-        _timer_set(0);
+    for (unsigned n = 0; n < NUMOF_TIMERS; n++) {
+        _timer_remove(NUMOF_TIMERS - n - 1);
     }
+}
 
-    diff = ztimer_now(ZTIMER_USEC) - before;
-
-    _print_result("set() one", REPEAT, diff);
+/* set NUMOF_TIMERS timers with increasing targets, each sample starts with
+ * an empty list */
+static void _bench_set_many(void)
+{
+    benchmark_t bench;
+
+    benchmark_init(&bench, "set() many increasing target");
+    do {
+        _remove_all();
+        _update_base();
+        uint32_t before = benchmark_now();
+        for (unsigned n = 0; n < NUMOF_TIMERS; n++) {
+            _timer_set(n);
+        }
+        uint32_t diff = benchmark_now() - before;
+        if (benchmark_add_sample(&bench, diff, NUMOF_TIMERS)) {
+            break;
+        }
+    } while (1);
+    benchmark_turo(&_ctx, &bench);
     expect(!_triggers);
+}
 
-    /*
-     * test removing one unset timer REPEAT times
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    for (n = 0; n < REPEAT; n++) {
-        _timer_remove(0);
-    }
-
-    diff = ztimer_now(ZTIMER_USEC) - before;
-
-    _print_result("remove() one", REPEAT, diff);
+/* remove NUMOF_TIMERS timers (latest first), each sample starts with a full
+ * list */
+static void _bench_remove_many(void)
+{
+    benchmark_t bench;
+
+    benchmark_init(&bench, "remove() many decreasing");
+    do {
+        _set_all();
+        uint32_t before = benchmark_now();
+        _remove_all();
+        uint32_t diff = benchmark_now() - before;
+        if (benchmark_add_sample(&bench, diff, NUMOF_TIMERS)) {
+            break;
+        }
+    } while (1);
+    benchmark_turo(&_ctx, &bench);
     expect(!_triggers);
+}
 
-    /*
-     * test setting / removing one timer REPEAT times
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    _base = BASE  - (before - start);
-    for (n = 0; n < REPEAT; n++) {
-        _timer_set(0);
-        _timer_remove(0);
-    }
-
-    diff = ztimer_now(ZTIMER_USEC) - before;
+/* arm and cancel one probe timer in the middle of @p pending other timers,
+ * measuring both operations individually */
+static void _bench_pending(unsigned pending)
+{
+    char desc_arm[32], desc_cancel[32];
+    benchmark_t arm, cancel;
+    bool done;
 
-    _print_result("set() + remove() one", REPEAT, diff);
-    expect(!_triggers);
+    snprintf(desc_arm, sizeof(desc_arm), "arm (%u pending)", pending);
+    snprintf(desc_cancel, sizeof(desc_cancel), "cancel (%u pending)", pending);
+    benchmark_init(&arm, desc_arm);
+    benchmark_init(&cancel, desc_cancel);
 
-    /*
-     * test setting NUMOF_TIMERS timers with increasing targets
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    _base = BASE  - (before - start);
-    for (unsigned int n = 0; n < NUMOF_TIMERS; n++) {
+    _update_base();
+    for (unsigned n = 0; n < pending; n++) {
         _timer_set(n);
     }
 
-    diff = ztimer_now(ZTIMER_USEC) - before;
-
-    _print_result("set() many increasing target", NUMOF_TIMERS, diff);
-    expect(!_triggers);
+    do {
+        uint32_t before, overhead = 0, t_arm = 0, t_cancel = 0;
 
-    /*
-     * test re-setting first timer REPEAT times
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    _base = BASE  - (before - start);
-    for (n = 0; n < REPEAT; n++) {
-        _timer_set(0);
-    }
+        /* measure the cost of reading the benchmark timer itself */
+        for (unsigned n = 0; n < REPEAT; n++) {
+            before = benchmark_now();
+            overhead += benchmark_now() - before;
+        }
 
-    diff = ztimer_now(ZTIMER_USEC) - before;
+        for (unsigned n = 0; n < REPEAT; n++) {
+            uint32_t val = _timer_val(pending / 2) + 1;
 
-    _print_result("re-set()  first", REPEAT, diff);
-    expect(!_triggers);
+            before = benchmark_now();
+            ztimer_set(ZTIMER, &_probe, val);
+            t_arm += benchmark_now() - before;
 
-    /*
-     * test setting middle timer REPEAT times
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    _base = BASE  - (before - start);
-    for (n = 0; n < REPEAT; n++) {
-        _timer_set(NUMOF_TIMERS/2);
-    }
+            before = benchmark_now();
+            ztimer_remove(ZTIMER, &_probe);
+            t_cancel += benchmark_now() - before;
+        }
 
-    diff = ztimer_now(ZTIMER_USEC) - before;
+        t_arm = (t_arm > overhead) ? t_arm - overhead : 0;
+        t_cancel = (t_cancel > overhead) ? t_cancel - overhead : 0;
+        done = benchmark_add_sample(&arm, t_arm, REPEAT);
+        done |= benchmark_add_sample(&cancel, t_cancel, REPEAT);
+    } while (!done);
 
-    _print_result("re-set() middle", REPEAT, diff);
-    expect(!_triggers);
+    benchmark_turo(&_ctx, &arm);
+    benchmark_turo(&_ctx, &cancel);
 
-    /*
-     * test setting last timer REPEAT times
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    _base = BASE  - (before - start);
-    for (n = 0; n < REPEAT; n++) {
-        _timer_set(NUMOF_TIMERS - 1);
+    for (unsigned n = 0; n < pending; n++) {
+        _timer_remove(n);
     }
-
-    diff = ztimer_now(ZTIMER_USEC) - before;
-
-    _print_result("re-set()   last", REPEAT, diff);
     expect(!_triggers);
+}
 
-    /*
-     * test removing / setting first timer REPEAT times
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    _base = BASE  - (before - start);
-    for (n = 0; n < REPEAT; n++) {
-        _timer_remove(0);
-        _timer_set(0);
+int main(void)
+{
+    puts("ztimer benchmark application.\n");
+
+    /* initializing timer structs */
+    for (unsigned int n = 0; n < NUMOF_TIMERS; n++) {
+        _timers[n].callback = _callback;
+        _timers[n].arg = &_triggers;
     }
+    _probe.callback = _callback;
+    _probe.arg = &_triggers;
 
-    diff = ztimer_now(ZTIMER_USEC) - before;
+    _start = ztimer_now(ZTIMER_USEC);
 
-    _print_result("remove() + set()  first", REPEAT, diff);
-    expect(!_triggers);
+    turo_init(&_ctx);
+    turo_container_open(&_ctx);
 
-    /*
-     * test removing / setting middle timer REPEAT times
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    _base = BASE  - (before - start);
-    for (n = 0; n < REPEAT; n++) {
-        _timer_remove(NUMOF_TIMERS/2);
-        _timer_set(NUMOF_TIMERS/2);
-    }
+    /* setting one set timer, all but the first set() remove it implicitly */
+    BENCH("set() one", _timer_set(0));
 
-    diff = ztimer_now(ZTIMER_USEC) - before;
+    /* removing one unset timer */
+    BENCH("remove() one", _timer_remove(0));
 
-    _print_result("remove() + set() middle", REPEAT, diff);
-    expect(!_triggers);
+    /* setting / removing one timer */
+    BENCH("set() + remove() one", { _timer_set(0); _timer_remove(0); });
 
-    /*
-     * test removing / setting last timer REPEAT times
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    _base = BASE  - (before - start);
-    for (n = 0; n < REPEAT; n++) {
-        _timer_remove(NUMOF_TIMERS - 1);
-        _timer_set(NUMOF_TIMERS - 1);
-    }
+    /* setting NUMOF_TIMERS timers with increasing targets */
+    _bench_set_many();
 
-    diff = ztimer_now(ZTIMER_USEC) - before;
+    /* re-setting first, middle and last timer of a full list */
+    _set_all();
+    BENCH("re-set()  first", _timer_set(0));
+    BENCH("re-set() middle", _timer_set(NUMOF_TIMERS / 2));
+    BENCH("re-set()   last", _timer_set(NUMOF_TIMERS - 1));
 
-    _print_result("remove() + set()   last", REPEAT, diff);
-    expect(!_triggers);
+    /* removing / setting first, middle and last timer of a full list */
+    BENCH("remove() + set()  first",
+          { _timer_remove(0); _timer_set(0); });
+    BENCH("remove() + set() middle",
+          { _timer_remove(NUMOF_TIMERS / 2); _timer_set(NUMOF_TIMERS / 2); });
+    BENCH("remove() + set()   last",
+          { _timer_remove(NUMOF_TIMERS - 1); _timer_set(NUMOF_TIMERS - 1); });
 
-    /*
-     * test removing NUMOF_TIMERS timers (latest first)
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    for (n = 0; n < NUMOF_TIMERS; n++) {
-        _timer_remove(NUMOF_TIMERS - n - 1);
-    }
+    /* removing NUMOF_TIMERS timers (latest first) */
+    _bench_remove_many();
 
-    diff = ztimer_now(ZTIMER_USEC) - before;
+    /* ztimer_now() */
+    BENCH("ztimer_now()", ztimer_now(ZTIMER));
 
-    _print_result("remove() many decreasing", NUMOF_TIMERS, diff);
-    expect(!_triggers);
+    turo_dict_open(&_ctx);
+    turo_dict_key(&_ctx, "name");
+    turo_string(&_ctx, "sizeof(ztimer_t)");
+    turo_dict_key(&_ctx, "bytes");
+    turo_u32(&_ctx, sizeof(ztimer_t));
+    turo_dict_close(&_ctx);
 
     /*
-     * test ztimer_now()
+     * test arming / cancelling one timer with increasing numbers of pending
+     * timers
      *
      */
-    before = ztimer_now(ZTIMER_USEC);
-    n = REPEAT;
-    while (n--) {
-        ztimer_now(ZTIMER);
+    for (unsigned i = 0; i < ARRAY_SIZE(_pending); i++) {
+        if (_pending[i] > NUMOF_TIMERS) {
+            break;
+        }
+        _bench_pending(_pending[i]);
     }
 
-    diff = ztimer_now(ZTIMER_USEC) - before;
-
-    _print_result("ztimer_now()", REPEAT, diff);
-    expect(!_triggers);
-
-    _print_result("sizeof(ztimer_t)", NUMOF_TIMERS, sizeof(_timers));
+    turo_container_close(&_ctx, 0);
 
     puts("done.");
 
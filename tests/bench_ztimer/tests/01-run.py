@@ -6,16 +6,45 @@
 # General Public License v2.1. See the file LICENSE in the top level
 # directory for more details.
 
+import json
 import sys
 from testrunner import run
 
+BENCHMARKS = [
+    "set() one",
+    "remove() one",
+    "set() + remove() one",
+    "set() many increasing target",
+    "re-set()  first",
+    "re-set() middle",
+    "re-set()   last",
+    "remove() + set()  first",
+    "remove() + set() middle",
+    "remove() + set()   last",
+    "remove() many decreasing",
+    "ztimer_now()",
+]
+
 
 def testfunc(child):
     child.expect_exact("ztimer benchmark application.\r\n")
-    for i in range(13):
-        child.expect(r"\s+[\w() _\+]+\s+\d+ / \d+ = \d+\r\n")
+    child.expect(r"(\[.*\])\r\n", timeout=120)
+    res = json.loads(child.match.group(1))
+    assert res[-1] == {"exit_status": 0}
+    names = [r["name"] for r in res[:-1]]
+    assert names[:len(BENCHMARKS)] == BENCHMARKS
+    assert names[len(BENCHMARKS)] == "sizeof(ztimer_t)"
+
+    # arm / cancel latency, only for pending timer counts fitting NUMOF_TIMERS
+    pending = names[len(BENCHMARKS) + 1:]
+    assert len(pending) % 2 == 0
+    for arm, cancel in zip(pending[::2], pending[1::2]):
+        assert arm.startswith("arm (") and cancel.startswith("cancel (")
 
-    child.expect_exact("done.\r\n")
+    for r in res[:-1]:
+        if "median_ns" in r:
+            assert r["min_ns"] <= r["median_ns"] <= r["p99_ns"] <= r["max_ns"]
+    child.expect_exact("done.")
 
 
 if __name__ == "__main__":
@@ -0,0 +1,428 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Deterministic simulation of the CongURE implementations over a
+ *          lossy link
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "congure/cocoa.h"
+#include "congure/cubic.h"
+#include "congure/reno.h"
+
+#ifndef SIM_BYTES
+#define SIM_BYTES       (500000U)   /**< bytes to transfer per bulk run */
+#endif
+#ifndef SIM_EXCHANGES
+#define SIM_EXCHANGES   (200U)      /**< CoAP exchanges per run */
+#endif
+
+#define SIM_MSS         (1000U)     /**< segment size in bytes */
+#define SIM_SEGS        ((SIM_BYTES + SIM_MSS - 1) / SIM_MSS)
+#define SIM_RATE        (250U)      /**< bottleneck rate in bytes per ms */
+#define SIM_DELAY       (50U)       /**< one-way delay in ms */
+#define SIM_QUEUE       (32U * SIM_MSS) /**< bottleneck queue in bytes */
+#define SIM_FLIGHT_MAX  (128U)      /**< segments on the link at most */
+#define SIM_RTO_MIN     (200U)      /**< lower bound of the TCP RTO in ms */
+#define SIM_RTO_MAX     (60000U)    /**< upper bound of the TCP RTO in ms */
+#define SIM_TIME_MAX    (3600000U)  /**< abort runs longer than an hour */
+
+#define COAP_DELAY_MIN  (100U)      /**< CoAP one-way delay in ms, min */
+#define COAP_DELAY_VAR  (200U)      /**< CoAP one-way delay in ms, variance */
+#define COAP_MAX_RETRANSMIT (4U)
+
+/* segment or ACK on the way */
+typedef struct {
+    uint32_t arrive;
+    uint32_t seq;
+} sim_pkt_t;
+
+typedef struct {
+    sim_pkt_t pkts[SIM_FLIGHT_MAX];
+    unsigned head;
+    unsigned num;
+} sim_fifo_t;
+
+typedef union {
+    congure_reno_snd_t reno;
+    congure_cubic_snd_t cubic;
+} sim_cong_t;
+
+/* state of one bulk transfer */
+typedef struct {
+    sim_cong_t cong;
+    sim_fifo_t fwd;                 /* data segments to the receiver */
+    sim_fifo_t rev;                 /* ACKs to the sender */
+    uint32_t now;
+    uint32_t busy_until;            /* bottleneck busy with queued segments */
+    uint32_t rand;
+    unsigned loss;                  /* random loss in 1/1000 */
+    /* sender */
+    uint32_t snd_una;
+    uint32_t snd_nxt;
+    uint32_t snd_max;               /* highest segment sent + 1 */
+    uint32_t rtx_expire;
+    bool rtx_running;
+    uint8_t retries;
+    uint32_t rto;
+    uint32_t srtt;
+    uint32_t rttvar;
+    uint32_t rtt_seq;
+    uint32_t rtt_start;
+    bool rtt_pending;
+    uint32_t sent;
+    uint32_t retransmissions;
+    uint32_t drops;
+    /* receiver */
+    uint8_t received[(SIM_SEGS + 7) / 8];
+    uint32_t rcv_nxt;
+} sim_t;
+
+static sim_t _sim;
+
+static uint32_t _rand(uint32_t *state)
+{
+    /* xorshift32 */
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static void _fifo_push(sim_fifo_t *fifo, uint32_t arrive, uint32_t seq)
+{
+    if (fifo->num < SIM_FLIGHT_MAX) {
+        sim_pkt_t *pkt = &fifo->pkts[(fifo->head + fifo->num) % SIM_FLIGHT_MAX];
+
+        pkt->arrive = arrive;
+        pkt->seq = seq;
+        fifo->num++;
+    }
+}
+
+static sim_pkt_t *_fifo_peek(sim_fifo_t *fifo)
+{
+    return (fifo->num > 0) ? &fifo->pkts[fifo->head] : NULL;
+}
+
+static void _fifo_pop(sim_fifo_t *fifo)
+{
+    fifo->head = (fifo->head + 1) % SIM_FLIGHT_MAX;
+    fifo->num--;
+}
+
+static congure_snd_t *_cong(sim_t *sim)
+{
+    return &sim->cong.reno.super;
+}
+
+/* puts a segment onto the link: random loss, then the drop-tail queue */
+static void _transmit(sim_t *sim, uint32_t seq)
+{
+    uint32_t start = (sim->busy_until > sim->now) ? sim->busy_until : sim->now;
+
+    sim->sent++;
+    if (seq < sim->snd_max) {
+        sim->retransmissions++;
+    }
+    else {
+        sim->snd_max = seq + 1;
+    }
+    if ((_rand(&sim->rand) % 1000) < sim->loss) {
+        sim->drops++;
+        return;
+    }
+    if ((start - sim->now) * SIM_RATE + SIM_MSS > SIM_QUEUE) {
+        sim->drops++;
+        return;
+    }
+    sim->busy_until = start + SIM_MSS / SIM_RATE;
+    _fifo_push(&sim->fwd, sim->busy_until + SIM_DELAY, seq);
+}
+
+static void _fr(congure_reno_snd_t *c)
+{
+    sim_t *sim = c->super.ctx;
+
+    /* Karn's algorithm */
+    sim->rtt_pending = false;
+    _transmit(sim, sim->snd_una);
+}
+
+static const congure_reno_snd_consts_t _consts = {
+    .fr = _fr,
+    .init_mss = SIM_MSS,
+    .frthresh = 3,
+};
+
+static void _rtt_sample(sim_t *sim, uint32_t rtt)
+{
+    /* RFC 6298 */
+    if (sim->srtt == 0) {
+        sim->srtt = rtt;
+        sim->rttvar = rtt / 2;
+    }
+    else {
+        uint32_t diff = (sim->srtt > rtt) ? sim->srtt - rtt : rtt - sim->srtt;
+
+        sim->rttvar = (3 * sim->rttvar + diff) / 4;
+        sim->srtt = (7 * sim->srtt + rtt) / 8;
+    }
+    sim->rto = sim->srtt + 4 * sim->rttvar;
+    if (sim->rto < SIM_RTO_MIN) {
+        sim->rto = SIM_RTO_MIN;
+    }
+}
+
+static void _send(sim_t *sim)
+{
+    congure_snd_t *c = _cong(sim);
+
+    while ((sim->snd_nxt < SIM_SEGS) &&
+           (((sim->snd_nxt - sim->snd_una) + 1) * SIM_MSS <= c->cwnd)) {
+        if (!sim->rtt_pending && (sim->snd_nxt >= sim->snd_max)) {
+            sim->rtt_pending = true;
+            sim->rtt_seq = sim->snd_nxt;
+            sim->rtt_start = sim->now;
+        }
+        _transmit(sim, sim->snd_nxt++);
+        c->driver->report_msg_sent(c, SIM_MSS);
+        if (!sim->rtx_running) {
+            sim->rtx_running = true;
+            sim->rtx_expire = sim->now + sim->rto;
+        }
+    }
+}
+
+static void _recv_segment(sim_t *sim, uint32_t seq)
+{
+    sim->received[seq / 8] |= 1 << (seq % 8);
+    while ((sim->rcv_nxt < SIM_SEGS) &&
+           (sim->received[sim->rcv_nxt / 8] & (1 << (sim->rcv_nxt % 8)))) {
+        sim->rcv_nxt++;
+    }
+    /* every segment is ACKed right away */
+    _fifo_push(&sim->rev, sim->now + SIM_DELAY, sim->rcv_nxt);
+}
+
+static void _recv_ack(sim_t *sim, uint32_t ack_seq)
+{
+    congure_snd_t *c = _cong(sim);
+    congure_snd_msg_t msg = { .send_time = sim->now };
+    congure_snd_ack_t ack = {
+        .recv_time = sim->now,
+        .id = ack_seq,
+        .wnd = CONGURE_WND_SIZE_MAX,
+        .clean = 1,
+    };
+
+    if (ack_seq > sim->snd_una) {
+        if (sim->rtt_pending && (ack_seq > sim->rtt_seq)) {
+            sim->rtt_pending = false;
+            msg.send_time = sim->rtt_start;
+            _rtt_sample(sim, sim->now - sim->rtt_start);
+        }
+        msg.size = (ack_seq - sim->snd_una) * SIM_MSS;
+        sim->snd_una = ack_seq;
+        if (sim->snd_nxt < sim->snd_una) {
+            sim->snd_nxt = sim->snd_una;
+        }
+        sim->retries = 0;
+        sim->rtx_running = (sim->snd_una < sim->snd_max);
+        sim->rtx_expire = sim->now + sim->rto;
+        c->driver->report_msg_acked(c, &msg, &ack);
+    }
+    else if ((ack_seq == sim->snd_una) && (sim->snd_una < sim->snd_nxt)) {
+        c->driver->report_msg_acked(c, &msg, &ack);
+    }
+}
+
+static void _timeout(sim_t *sim)
+{
+    congure_snd_t *c = _cong(sim);
+    congure_snd_msg_t msg = {
+        .send_time = sim->now,
+        .size = SIM_MSS,
+        .resends = sim->retries,
+    };
+
+    msg.super.next = &msg.super;
+    c->driver->report_msgs_timeout(c, &msg);
+    /* go back to the oldest unacknowledged segment */
+    c->driver->report_msg_discarded(c, (sim->snd_nxt - sim->snd_una) * SIM_MSS);
+    sim->snd_nxt = sim->snd_una;
+    sim->rtt_pending = false;
+    sim->retries++;
+    sim->rto = (2 * sim->rto < SIM_RTO_MAX) ? 2 * sim->rto : SIM_RTO_MAX;
+    sim->rtx_running = false;
+}
+
+static int _run_bulk(const char *name, bool cubic, unsigned loss)
+{
+    sim_t *sim = &_sim;
+    congure_snd_t *c = _cong(sim);
+
+    memset(sim, 0, sizeof(*sim));
+    sim->rand = 0x52494f54;
+    sim->loss = loss;
+    sim->rto = 1000;
+    if (cubic) {
+        congure_cubic_snd_setup(&sim->cong.cubic, &_consts);
+    }
+    else {
+        congure_reno_snd_setup(&sim->cong.reno, &_consts);
+    }
+    c->driver->init(c, sim);
+
+    _send(sim);
+    while ((sim->snd_una < SIM_SEGS) && (sim->now < SIM_TIME_MAX)) {
+        sim_pkt_t *seg = _fifo_peek(&sim->fwd);
+        sim_pkt_t *ack = _fifo_peek(&sim->rev);
+        uint32_t next = sim->rtx_running ? sim->rtx_expire : UINT32_MAX;
+
+        if (seg && (seg->arrive < next)) {
+            next = seg->arrive;
+        }
+        if (ack && (ack->arrive < next)) {
+            next = ack->arrive;
+        }
+        if (next == UINT32_MAX) {
+            break;
+        }
+        sim->now = next;
+        while ((seg = _fifo_peek(&sim->fwd)) && (seg->arrive == sim->now)) {
+            _recv_segment(sim, seg->seq);
+            _fifo_pop(&sim->fwd);
+        }
+        while ((ack = _fifo_peek(&sim->rev)) && (ack->arrive == sim->now)) {
+            _recv_ack(sim, ack->seq);
+            _fifo_pop(&sim->rev);
+        }
+        if (sim->rtx_running && (sim->rtx_expire == sim->now)) {
+            _timeout(sim);
+        }
+        _send(sim);
+    }
+    if (sim->snd_una < SIM_SEGS) {
+        printf("%s loss %u.%u%%: FAILED after %" PRIu32 " ms\n", name,
+               loss / 10, loss % 10, sim->now);
+        return 1;
+    }
+    /* bytes * 8 / ms = kbit/s */
+    printf("%s loss %u.%u%%: %u bytes in %" PRIu32 " ms, goodput %" PRIu32
+           " kbit/s, %" PRIu32 " retransmissions, %" PRIu32 " drops\n",
+           name, loss / 10, loss % 10, SIM_SEGS * SIM_MSS, sim->now,
+           (uint32_t)(((uint64_t)SIM_SEGS * SIM_MSS * 8) / sim->now),
+           sim->retransmissions, sim->drops);
+    return 0;
+}
+
+static uint32_t _coap_delay(uint32_t *rand)
+{
+    return COAP_DELAY_MIN + (_rand(rand) % COAP_DELAY_VAR);
+}
+
+static int _run_coap(const char *name, bool cocoa, unsigned loss)
+{
+    congure_cocoa_snd_t c;
+    uint32_t rand = 0x434f4150;
+    uint32_t now = 0;
+    uint32_t retransmissions = 0;
+    unsigned failed = 0;
+
+    congure_cocoa_snd_setup(&c);
+    c.super.driver->init(&c.super, NULL);
+    for (unsigned i = 0; i < SIM_EXCHANGES; i++) {
+        uint32_t start = now;
+        uint32_t send = now;
+        uint32_t done = UINT32_MAX;
+        uint32_t timeout;
+        unsigned resends;
+
+        if (cocoa) {
+            timeout = congure_cocoa_get_rto(&c, now);
+        }
+        else {
+            timeout = 2000;
+        }
+        /* ACK_RANDOM_FACTOR of 1.5 */
+        timeout += _rand(&rand) % (timeout / 2 + 1);
+        for (resends = 0; resends <= COAP_MAX_RETRANSMIT; resends++) {
+            bool lost = ((_rand(&rand) % 1000) < loss) |
+                        ((_rand(&rand) % 1000) < loss);
+            uint32_t rtt = _coap_delay(&rand) + _coap_delay(&rand);
+
+            if (!lost && (send + rtt < done)) {
+                done = send + rtt;
+            }
+            if (done <= send + timeout) {
+                break;
+            }
+            if (resends < COAP_MAX_RETRANSMIT) {
+                retransmissions++;
+            }
+            send += timeout;
+            timeout = (cocoa) ? congure_cocoa_backoff(timeout) : 2 * timeout;
+        }
+        if (resends > COAP_MAX_RETRANSMIT) {
+            /* the last transmission timed out */
+            failed++;
+            now = send;
+            continue;
+        }
+        if (cocoa) {
+            congure_snd_msg_t msg = {
+                .send_time = start,
+                .size = 1,
+                .resends = resends,
+            };
+            congure_snd_ack_t ack = { .recv_time = done, .clean = 1 };
+
+            c.super.driver->report_msg_acked(&c.super, &msg, &ack);
+        }
+        now = done;
+    }
+    printf("%s loss %u.%u%%: %u exchanges in %" PRIu32 " ms, %" PRIu32
+           " retransmissions, %u failed\n", name, loss / 10, loss % 10,
+           SIM_EXCHANGES, now, retransmissions, failed);
+    return 0;
+}
+
+int main(void)
+{
+    static const unsigned losses[] = { 0, 10, 30 };
+    int res = 0;
+
+    puts("CongURE simulation");
+    printf("link: %u kbit/s, %u ms RTT, %u bytes queue\n",
+           SIM_RATE * 8, 2 * SIM_DELAY, SIM_QUEUE);
+    for (unsigned i = 0; i < sizeof(losses) / sizeof(losses[0]); i++) {
+        res |= _run_bulk("reno", false, losses[i]);
+        res |= _run_bulk("cubic", true, losses[i]);
+    }
+    printf("coap: %u-%u ms RTT\n", 2 * COAP_DELAY_MIN,
+           2 * (COAP_DELAY_MIN + COAP_DELAY_VAR));
+    for (unsigned i = 0; i < sizeof(losses) / sizeof(losses[0]); i++) {
+        res |= _run_coap("coap-default", false, 100 * i);
+        res |= _run_coap("coap-cocoa", true, 100 * i);
+    }
+    puts((res == 0) ? "SUCCESS" : "FAILURE");
+    return 0;
+}
@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+LOSSES = ("0.0", "1.0", "3.0")
+COAP_LOSSES = ("0.0", "10.0", "20.0")
+
+
+def expect_bulk(child, name, loss):
+    child.expect(r"{} loss {}%: (\d+) bytes in (\d+) ms, goodput (\d+) kbit/s, "
+                 r"(\d+) retransmissions, (\d+) drops\r\n".format(name, loss))
+    goodput = int(child.match.group(3))
+    assert goodput > 0
+    return goodput, int(child.match.group(4))
+
+
+def expect_coap(child, name, loss):
+    child.expect(r"{} loss {}%: (\d+) exchanges in (\d+) ms, "
+                 r"(\d+) retransmissions, (\d+) failed\r\n".format(name, loss))
+    return int(child.match.group(2)), int(child.match.group(3))
+
+
+def testfunc(child):
+    child.expect_exact("CongURE simulation")
+    child.expect(r"link: (\d+) kbit/s, \d+ ms RTT, \d+ bytes queue\r\n")
+    link = int(child.match.group(1))
+    for loss in LOSSES:
+        for name in ("reno", "cubic"):
+            goodput, _ = expect_bulk(child, name, loss)
+            assert goodput <= link
+    child.expect(r"coap: \d+-\d+ ms RTT\r\n")
+    for loss in COAP_LOSSES:
+        default_time, _ = expect_coap(child, "coap-default", loss)
+        cocoa_time, _ = expect_coap(child, "coap-cocoa", loss)
+        # a measured RTO must not be worse than the static one
+        assert cocoa_time <= default_time
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
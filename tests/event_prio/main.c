@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Prioritized event queue test application
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "event/prio.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+
+#define EVENTS_NUMOF    (8U)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+
+static event_prio_queue_t _queue;
+static event_t _events[EVENTS_NUMOF];
+
+static unsigned _order[EVENTS_NUMOF];
+static unsigned _handled;
+
+static void _handler(event_t *event)
+{
+    _order[_handled++] = event - _events;
+}
+
+static void _init(void)
+{
+    event_prio_queue_init(&_queue);
+    for (unsigned i = 0; i < EVENTS_NUMOF; i++) {
+        _events[i] = (event_t){ .handler = _handler };
+    }
+    _handled = 0;
+}
+
+static void _drain(void)
+{
+    event_t *event;
+
+    while ((event = event_prio_get(&_queue))) {
+        event->handler(event);
+    }
+}
+
+static void _test_order(void)
+{
+    static const unsigned prio[EVENTS_NUMOF] = { 3, 0, 2, 0, 1, 3, 1, 0 };
+    static const unsigned expected[EVENTS_NUMOF] = { 1, 3, 7, 4, 6, 2, 0, 5 };
+
+    _init();
+    expect(event_prio_get(&_queue) == NULL);
+    for (unsigned i = 0; i < EVENTS_NUMOF; i++) {
+        event_prio_post(&_queue, &_events[i], prio[i]);
+    }
+    /* posting a queued event has no effect, not even with another priority */
+    event_prio_post(&_queue, &_events[0], 0);
+    _drain();
+    expect(_handled == EVENTS_NUMOF);
+    for (unsigned i = 0; i < EVENTS_NUMOF; i++) {
+        expect(_order[i] == expected[i]);
+    }
+    puts("order: OK");
+}
+
+static void _test_cancel(void)
+{
+    _init();
+    /* level 0: 0 1 2, level 1: 3, level 2: 4 5 */
+    event_prio_post(&_queue, &_events[0], 0);
+    event_prio_post(&_queue, &_events[1], 0);
+    event_prio_post(&_queue, &_events[2], 0);
+    event_prio_post(&_queue, &_events[3], 1);
+    event_prio_post(&_queue, &_events[4], 2);
+    event_prio_post(&_queue, &_events[5], 2);
+
+    /* middle, only, first and last event of a level */
+    event_prio_cancel(&_queue, &_events[1]);
+    event_prio_cancel(&_queue, &_events[3]);
+    event_prio_cancel(&_queue, &_events[4]);
+    event_prio_cancel(&_queue, &_events[2]);
+    /* not queued */
+    event_prio_cancel(&_queue, &_events[3]);
+    event_prio_cancel(&_queue, &_events[6]);
+
+    _drain();
+    expect(_handled == 2);
+    expect(_order[0] == 0);
+    expect(_order[1] == 5);
+
+    /* cancelled events can be posted again */
+    event_prio_post(&_queue, &_events[3], 3);
+    event_prio_post(&_queue, &_events[1], 2);
+    _drain();
+    expect(_handled == 4);
+    expect(_order[2] == 1);
+    expect(_order[3] == 3);
+    puts("cancel: OK");
+}
+
+static void _test_stats(void)
+{
+    event_prio_stats_t stats;
+
+    _init();
+    for (unsigned i = 0; i < 5; i++) {
+        event_prio_post(&_queue, &_events[i], i % CONFIG_EVENT_PRIO_LEVELS);
+    }
+    event_prio_cancel(&_queue, &_events[2]);
+    event_prio_get(&_queue);
+
+    event_prio_stats_get(&_queue, &stats);
+    expect(stats.depth == 3);
+    expect(stats.depth_max == 5);
+    expect(stats.cancelled == 1);
+    expect(stats.dispatched == 1);
+
+    event_prio_stats_reset(&_queue);
+    event_prio_stats_get(&_queue, &stats);
+    expect(stats.depth == 3);
+    expect(stats.depth_max == 3);
+    expect(stats.dispatched == 0);
+
+    _drain();
+    event_prio_stats_get(&_queue, &stats);
+    expect(stats.depth == 0);
+    expect(stats.dispatched == 3);
+    expect(stats.latency_max_us >= stats.latency_sum_us / stats.dispatched);
+    puts("stats: OK");
+}
+
+static void *_loop(void *arg)
+{
+    (void)arg;
+
+    event_prio_queue_claim(&_queue);
+    event_prio_loop(&_queue);
+
+    return NULL;
+}
+
+static void _test_thread(void)
+{
+    _init();
+    event_prio_queue_init_detached(&_queue);
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _loop, NULL, "event_prio");
+
+    /* the event thread preempts main on every post */
+    event_prio_post(&_queue, &_events[0], 2);
+    event_prio_post(&_queue, &_events[1], 0);
+    expect(_handled == 2);
+    expect(_order[0] == 0);
+    expect(_order[1] == 1);
+    puts("thread: OK");
+}
+
+int main(void)
+{
+    _test_order();
+    _test_cancel();
+    _test_stats();
+    _test_thread();
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
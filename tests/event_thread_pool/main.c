@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Event thread pool test application
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "event/thread.h"
+#include "event/thread_pool.h"
+#include "mutex.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+#include "ztimer.h"
+
+#define WORKERS_NUMOF   (3U)
+#define EVENTS_NUMOF    (3U)
+#define HANDLER_MS      (10U)
+
+enum {
+    QUEUE_UNORDERED,
+    QUEUE_ORDERED,
+    QUEUE_NUMOF,
+};
+
+static char _stacks[WORKERS_NUMOF][THREAD_STACKSIZE_DEFAULT];
+
+static event_thread_pool_t _pool;
+static event_queue_t _queues[QUEUE_NUMOF];
+
+static mutex_t _gate = MUTEX_INIT_LOCKED;
+static bool _gate_passed;
+
+static unsigned _in_flight;
+static unsigned _in_flight_max;
+static unsigned _handled;
+
+static void _block_handler(event_t *event)
+{
+    (void)event;
+    /* only returns if another worker handles _open */
+    mutex_lock(&_gate);
+    _gate_passed = true;
+}
+
+static void _open_handler(event_t *event)
+{
+    (void)event;
+    mutex_unlock(&_gate);
+}
+
+static event_t _block = { .handler = _block_handler };
+static event_t _open = { .handler = _open_handler };
+
+typedef struct {
+    event_t super;
+    unsigned num;
+} numbered_event_t;
+
+static void _slow_handler(event_t *event)
+{
+    numbered_event_t *e = container_of(event, numbered_event_t, super);
+
+    if (++_in_flight > _in_flight_max) {
+        _in_flight_max = _in_flight;
+    }
+    /* events of the same queue are taken in order */
+    expect(e->num == _handled++);
+    /* lets the other workers run */
+    ztimer_sleep(ZTIMER_MSEC, HANDLER_MS);
+    _in_flight--;
+}
+
+static numbered_event_t _events[EVENTS_NUMOF];
+
+static void _run_slow(unsigned queue)
+{
+    _in_flight = 0;
+    _in_flight_max = 0;
+    _handled = 0;
+    for (unsigned i = 0; i < EVENTS_NUMOF; i++) {
+        _events[i] = (numbered_event_t){
+            .super.handler = _slow_handler, .num = i
+        };
+        event_post(&_queues[queue], &_events[i].super);
+    }
+    ztimer_sleep(ZTIMER_MSEC, 2 * EVENTS_NUMOF * HANDLER_MS);
+    expect(_handled == EVENTS_NUMOF);
+    expect(_in_flight == 0);
+}
+
+static void _handler_shared(event_t *event)
+{
+    (void)event;
+    _handled++;
+}
+
+static event_t _shared = { .handler = _handler_shared };
+
+int main(void)
+{
+    event_thread_pool_init(&_pool, _queues, QUEUE_NUMOF,
+                           1U << QUEUE_ORDERED);
+    for (unsigned i = 0; i < WORKERS_NUMOF; i++) {
+        expect(event_thread_pool_add_worker(&_pool, _stacks[i],
+                                            sizeof(_stacks[i]),
+                                            THREAD_PRIORITY_MAIN - 1) > 0);
+    }
+
+    /* a single event thread would dead-lock here */
+    event_post(&_queues[QUEUE_UNORDERED], &_block);
+    event_post(&_queues[QUEUE_UNORDERED], &_open);
+    expect(_gate_passed);
+    puts("blocking handler: OK");
+
+    _run_slow(QUEUE_UNORDERED);
+    expect(_in_flight_max == WORKERS_NUMOF);
+    puts("unordered queue: OK");
+
+    _run_slow(QUEUE_ORDERED);
+    expect(_in_flight_max == 1);
+    puts("ordered queue: OK");
+
+    /* the pool started by auto_init serves the event_thread queues */
+    _handled = 0;
+    event_post(EVENT_PRIO_HIGHEST, &_shared);
+    expect(_handled == 1);
+    puts("event_thread: OK");
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
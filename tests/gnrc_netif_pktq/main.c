@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Sends a bulk flow and a latency-sensitive flow over a slow
+ *              mock link through the packet queue of a network interface
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "iolist.h"
+#include "net/ethernet.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netif/pktq.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev/eth.h"
+#include "net/protnum.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#define LINK_US             (1000U)     /**< time to transmit a frame */
+#define ROUND_US            (2000U)     /**< time between two rounds */
+#define ROUNDS              (500U)
+#define BULK_PER_ROUND      (2U)        /**< bulk packets per round */
+#define DRAIN_US            (200U * US_PER_MS)
+
+enum {
+    FLOW_CTRL,      /**< ICMPv6, one packet per round */
+    FLOW_BULK,      /**< unmarked UDP, BULK_PER_ROUND packets per round */
+    FLOW_NUMOF,
+};
+
+typedef struct {
+    uint32_t created;
+    uint8_t flow;
+} test_payload_t;
+
+typedef struct {
+    uint32_t sent;
+    uint32_t transmitted;
+    uint32_t latency_sum;
+    uint32_t latency_max;
+} flow_t;
+
+static const char *_flow_names[] = { "control", "bulk" };
+static flow_t _flows[FLOW_NUMOF];
+static uint32_t _last_tx;
+
+static const uint8_t _addr[ETHERNET_ADDR_LEN] = { 0x02, 0, 0, 0, 0, 0x01 };
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static gnrc_netif_t _netif;
+
+static int _init(netdev_t *netdev)
+{
+    (void)netdev;
+    return 0;
+}
+
+static void _isr(netdev_t *netdev)
+{
+    (void)netdev;
+}
+
+/* a link that can transmit one frame every LINK_US */
+static int _send(netdev_t *netdev, const iolist_t *iolist)
+{
+    uint32_t now = ztimer_now(ZTIMER_USEC);
+    test_payload_t payload;
+
+    (void)netdev;
+    if ((now - _last_tx) < LINK_US) {
+        return -EBUSY;
+    }
+    _last_tx = now;
+
+    /* Ethernet header -> IPv6 header -> payload */
+    const iolist_t *data = iolist->iol_next->iol_next;
+
+    memcpy(&payload, data->iol_base, sizeof(payload));
+
+    flow_t *flow = &_flows[payload.flow];
+    uint32_t latency = now - payload.created;
+
+    flow->transmitted++;
+    flow->latency_sum += latency;
+    if (latency > flow->latency_max) {
+        flow->latency_max = latency;
+    }
+    return iolist_size(iolist);
+}
+
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    (void)netdev;
+    (void)buf;
+    (void)len;
+    (void)info;
+    return 0;
+}
+
+static int _get(netdev_t *netdev, netopt_t opt, void *value, size_t max_len)
+{
+    if (opt == NETOPT_ADDRESS) {
+        if (max_len < sizeof(_addr)) {
+            return -EOVERFLOW;
+        }
+        memcpy(value, _addr, sizeof(_addr));
+        return sizeof(_addr);
+    }
+    return netdev_eth_get(netdev, opt, value, max_len);
+}
+
+static int _set(netdev_t *netdev, netopt_t opt, const void *value,
+                size_t value_len)
+{
+    return netdev_eth_set(netdev, opt, value, value_len);
+}
+
+static const netdev_driver_t _driver = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = _set,
+};
+
+static netdev_t _dev = { .driver = &_driver };
+
+static void _send_pkt(unsigned flow)
+{
+    test_payload_t payload = {
+        .created = ztimer_now(ZTIMER_USEC),
+        .flow = flow,
+    };
+    ipv6_hdr_t hdr = { 0 };
+    gnrc_pktsnip_t *pkt, *netif;
+
+    ipv6_hdr_set_version(&hdr);
+    hdr.nh = (flow == FLOW_CTRL) ? PROTNUM_ICMPV6 : PROTNUM_UDP;
+    pkt = gnrc_pktbuf_add(NULL, &payload, sizeof(payload), GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return;
+    }
+    pkt = gnrc_pktbuf_add(pkt, &hdr, sizeof(hdr), GNRC_NETTYPE_IPV6);
+    if (pkt == NULL) {
+        return;
+    }
+    netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->flags |= GNRC_NETIF_HDR_FLAGS_BROADCAST;
+    netif->next = pkt;
+    _flows[flow].sent++;
+    if (gnrc_netapi_send(_netif.pid, netif) < 1) {
+        gnrc_pktbuf_release(netif);
+    }
+}
+
+int main(void)
+{
+    netstats_queue_t *stats;
+    bool success = true;
+
+    gnrc_netif_ethernet_create(&_netif, _stack, sizeof(_stack),
+                               GNRC_NETIF_PRIO, "mock", &_dev);
+
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        _send_pkt(FLOW_CTRL);
+        for (unsigned j = 0; j < BULK_PER_ROUND; j++) {
+            _send_pkt(FLOW_BULK);
+        }
+        ztimer_sleep(ZTIMER_USEC, ROUND_US);
+    }
+    ztimer_sleep(ZTIMER_USEC, DRAIN_US);
+
+    for (unsigned i = 0; i < FLOW_NUMOF; i++) {
+        flow_t *flow = &_flows[i];
+
+        printf("%-7s sent %u transmitted %u latency avg %u us max %u us\n",
+               _flow_names[i], (unsigned)flow->sent,
+               (unsigned)flow->transmitted,
+               (unsigned)(flow->transmitted
+                          ? flow->latency_sum / flow->transmitted : 0),
+               (unsigned)flow->latency_max);
+    }
+    if (netif_get_opt(&_netif.netif, NETOPT_STATS, NETSTATS_PKTQ, &stats,
+                      sizeof(&stats)) < 0) {
+        puts("FAILURE: no statistics");
+        return 1;
+    }
+    for (unsigned i = 0; i < GNRC_NETIF_PKTQ_CLASS_NUMOF; i++) {
+        printf("class %u: queued %u max depth %u overflows %u evicted %u "
+               "dropped %u sojourn max %u us\n", i,
+               (unsigned)stats[i].enqueued, (unsigned)stats[i].depth_max,
+               (unsigned)stats[i].overflows, (unsigned)stats[i].evicted,
+               (unsigned)stats[i].aqm_drops, (unsigned)stats[i].sojourn_max);
+    }
+
+    /* control traffic is never dropped and overtakes the bulk traffic */
+    if (_flows[FLOW_CTRL].transmitted != _flows[FLOW_CTRL].sent) {
+        puts("control packets were lost");
+        success = false;
+    }
+    if (_flows[FLOW_CTRL].latency_max * _flows[FLOW_BULK].transmitted >=
+        _flows[FLOW_BULK].latency_sum) {
+        puts("control packets waited as long as bulk packets");
+        success = false;
+    }
+    /* the overloaded bulk queue is kept short by CoDel */
+    if (stats[GNRC_NETIF_PKTQ_CLASS_DEFAULT].aqm_drops == 0) {
+        puts("no bulk packets were dropped by CoDel");
+        success = false;
+    }
+    if (!gnrc_netif_pktq_empty(&_netif) || !gnrc_pktbuf_is_empty()) {
+        puts("packets were leaked");
+        success = false;
+    }
+    puts(success ? "SUCCESS" : "FAILURE");
+
+    return 0;
+}
@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"control sent (\d+) transmitted (\d+) latency avg \d+ us max (\d+) us")
+    assert child.match.group(1) == child.match.group(2)
+    child.expect(r"bulk    sent (\d+) transmitted (\d+) latency avg (\d+) us")
+    assert int(child.match.group(2)) < int(child.match.group(1))
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=10))
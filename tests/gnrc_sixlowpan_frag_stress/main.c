@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Reassembles many interleaved fragmented datagrams from
+ *              different sources at once
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bitfield.h"
+#include "kernel_defines.h"
+#include "msg.h"
+#include "net/ieee802154.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag/rb.h"
+#include "net/gnrc/sixlowpan/frag/stats.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define SOURCES             (8U)
+#define TAGS                (4U)        /**< datagrams per source */
+#define DATAGRAMS           (SOURCES * TAGS)
+#define FRAG_PAYLOAD        (64U)       /**< datagram bytes per fragment */
+#define FRAGS               (3U)        /**< fragments per datagram */
+#define DATAGRAM_SIZE       (FRAGS * FRAG_PAYLOAD)
+#define TAG_INITIAL         (0x1000)
+#define RECEIVE_TIMEOUT     (100U)
+
+static const uint8_t _dst[] = { 0x02, 0, 0, 0, 0, 0, 0, 0x01 };
+static struct {
+    gnrc_netif_hdr_t hdr;
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];
+    uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];
+} _netif_hdr;
+static uint8_t _datagram[DATAGRAM_SIZE];
+static BITFIELD(_received, DATAGRAMS);
+static msg_t _msg_queue[4];
+
+static void _src(unsigned d, uint8_t *src)
+{
+    memset(src, 0, IEEE802154_LONG_ADDRESS_LEN);
+    src[0] = 0x02;
+    src[IEEE802154_LONG_ADDRESS_LEN - 1] = 0x10 + (d % SOURCES);
+}
+
+static uint16_t _tag(unsigned d)
+{
+    return TAG_INITIAL + (d / SOURCES);
+}
+
+static void _build_datagram(unsigned d)
+{
+    ipv6_hdr_t *hdr = (ipv6_hdr_t *)_datagram;
+
+    memset(hdr, 0, sizeof(*hdr));
+    ipv6_hdr_set_version(hdr);
+    hdr->len = byteorder_htons(DATAGRAM_SIZE - sizeof(ipv6_hdr_t));
+    hdr->nh = PROTNUM_IPV6_NONXT;
+    hdr->hl = 64;
+    for (unsigned i = sizeof(*hdr); i < DATAGRAM_SIZE; i++) {
+        _datagram[i] = d + i;
+    }
+}
+
+static gnrc_sixlowpan_frag_rb_t *_add_fragment(unsigned d, unsigned frag)
+{
+    uint8_t buf[sizeof(sixlowpan_frag_n_t) + FRAG_PAYLOAD];
+    const size_t offset = frag * FRAG_PAYLOAD;
+    size_t size;
+    gnrc_pktsnip_t *pkt;
+
+    _build_datagram(d);
+    _src(d, _netif_hdr.src);
+    gnrc_netif_hdr_set_src_addr(&_netif_hdr.hdr, _netif_hdr.src,
+                                sizeof(_netif_hdr.src));
+    if (frag == 0) {
+        sixlowpan_frag_t *hdr = (sixlowpan_frag_t *)buf;
+
+        hdr->disp_size = byteorder_htons((SIXLOWPAN_FRAG_1_DISP << 8) |
+                                         DATAGRAM_SIZE);
+        hdr->tag = byteorder_htons(_tag(d));
+        /* uncompressed IPv6 */
+        buf[sizeof(*hdr)] = SIXLOWPAN_UNCOMP;
+        memcpy(&buf[sizeof(*hdr) + 1], _datagram, FRAG_PAYLOAD);
+        size = sizeof(*hdr) + 1 + FRAG_PAYLOAD;
+    }
+    else {
+        sixlowpan_frag_n_t *hdr = (sixlowpan_frag_n_t *)buf;
+
+        hdr->disp_size = byteorder_htons((SIXLOWPAN_FRAG_N_DISP << 8) |
+                                         DATAGRAM_SIZE);
+        hdr->tag = byteorder_htons(_tag(d));
+        hdr->offset = offset / 8;
+        memcpy(&buf[sizeof(*hdr)], &_datagram[offset], FRAG_PAYLOAD);
+        size = sizeof(*hdr) + FRAG_PAYLOAD;
+    }
+    pkt = gnrc_pktbuf_add(NULL, buf, size, GNRC_NETTYPE_SIXLOWPAN);
+    if (pkt == NULL) {
+        puts("unable to allocate fragment");
+        return NULL;
+    }
+    /* pkt is released by gnrc_sixlowpan_frag_rb_add() */
+    return gnrc_sixlowpan_frag_rb_add(&_netif_hdr.hdr, pkt, offset, 0);
+}
+
+static bool _check_datagram(gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *netif_hdr = pkt->next->data;
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];
+    unsigned d;
+
+    if ((pkt->size != DATAGRAM_SIZE) ||
+        (netif_hdr->src_l2addr_len != sizeof(src))) {
+        return false;
+    }
+    /* the first payload byte identifies the datagram */
+    d = (uint8_t)(((uint8_t *)pkt->data)[sizeof(ipv6_hdr_t)] -
+                  sizeof(ipv6_hdr_t));
+    if (d >= DATAGRAMS) {
+        return false;
+    }
+    _src(d, src);
+    _build_datagram(d);
+    if ((memcmp(gnrc_netif_hdr_get_src_addr(netif_hdr), src,
+                sizeof(src)) != 0) ||
+        (memcmp(pkt->data, _datagram, DATAGRAM_SIZE) != 0) ||
+        bf_isset(_received, d)) {
+        return false;
+    }
+    bf_set(_received, d);
+    return true;
+}
+
+static unsigned _receive_datagrams(void)
+{
+    unsigned received = 0;
+    msg_t msg;
+
+    while (xtimer_msg_receive_timeout(&msg, RECEIVE_TIMEOUT) >= 0) {
+        if (msg.type != GNRC_NETAPI_MSG_TYPE_RCV) {
+            /* e.g. garbage collection of the reassembly buffer */
+            continue;
+        }
+        if (_check_datagram(msg.content.ptr)) {
+            received++;
+        }
+        else {
+            puts("unexpected datagram");
+        }
+        gnrc_pktbuf_release(msg.content.ptr);
+    }
+    return received;
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t reg = GNRC_NETREG_ENTRY_INIT_PID(
+            GNRC_NETREG_DEMUX_CTX_ALL,
+            thread_getpid()
+        );
+    gnrc_sixlowpan_frag_stats_t *stats = gnrc_sixlowpan_frag_stats_get();
+    unsigned received = 0;
+    bool success = true;
+
+    msg_init_queue(_msg_queue, ARRAY_SIZE(_msg_queue));
+    gnrc_netif_hdr_init(&_netif_hdr.hdr, sizeof(_netif_hdr.src),
+                        sizeof(_netif_hdr.dst));
+    gnrc_netif_hdr_set_dst_addr(&_netif_hdr.hdr, _dst, sizeof(_dst));
+    gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &reg);
+    printf("reassembly buffer entries: %u\n",
+           (unsigned)CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE);
+
+    /* the last fragments of all datagrams first, then the first fragments,
+     * then the ones in between, so all datagrams are in reassembly at once */
+    static const unsigned order[FRAGS] = { FRAGS - 1, 0, 1 };
+
+    for (unsigned i = 0; i < FRAGS; i++) {
+        for (unsigned d = 0; d < DATAGRAMS; d++) {
+            gnrc_sixlowpan_frag_rb_t *rbuf = _add_fragment(d, order[i]);
+
+            if (rbuf == NULL) {
+                printf("fragment %u of datagram %u was dropped\n", order[i],
+                       d);
+                success = false;
+            }
+            else if (gnrc_sixlowpan_frag_rb_dispatch_when_complete(
+                        rbuf, &_netif_hdr.hdr) > 0) {
+                received += _receive_datagrams();
+            }
+        }
+    }
+    gnrc_netreg_unregister(GNRC_NETTYPE_UNDEF, &reg);
+
+    printf("reassembled %u of %u datagrams, reassembly buffer full %u times\n",
+           received, DATAGRAMS, stats->rbuf_full);
+    if ((received != DATAGRAMS) || (stats->rbuf_full > 0)) {
+        success = false;
+    }
+    if (!gnrc_pktbuf_is_empty() || !gnrc_sixlowpan_frag_rb_ints_empty()) {
+        puts("packets or fragment intervals were leaked");
+        success = false;
+    }
+    puts(success ? "SUCCESS" : "FAILURE");
+
+    return 0;
+}
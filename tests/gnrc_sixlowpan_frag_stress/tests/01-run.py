@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"reassembly buffer entries: (\d+)")
+    assert int(child.match.group(1)) >= 32
+    child.expect(r"reassembled (\d+) of (\d+) datagrams, reassembly buffer "
+                 r"full (\d+) times")
+    assert child.match.group(1) == child.match.group(2)
+    assert int(child.match.group(3)) == 0
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
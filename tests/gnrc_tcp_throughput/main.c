@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Measures the throughput of a bulk transfer with GNRC TCP
+ *
+ * One instance receives with `tput_recv`, the other one sends with
+ * `tput_send`. The transferred data follows a pattern, so the receiver can
+ * verify it.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "msg.h"
+#include "net/af.h"
+#include "net/gnrc/tcp.h"
+#include "shell.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#define MAIN_QUEUE_SIZE     (8)
+#define CHUNK_SIZE          (2048)
+#define TIMEOUT_MS          (10000)
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static gnrc_tcp_tcb_t _tcb;
+static gnrc_tcp_tcb_queue_t _queue = GNRC_TCP_TCB_QUEUE_INIT;
+static uint8_t _buf[CHUNK_SIZE];
+
+static uint8_t _pattern(uint32_t pos)
+{
+    return (uint8_t)(pos + (pos >> 8) + (pos >> 16));
+}
+
+static void _print_result(const char *cmd, uint32_t bytes, uint32_t usec)
+{
+    usec = (usec > 0) ? usec : 1;
+    printf("%s: %" PRIu32 " bytes in %" PRIu32 " ms (%" PRIu32 " kbit/s)\n",
+           cmd, bytes, (uint32_t)(usec / US_PER_MS),
+           (uint32_t)(((uint64_t)bytes * 8 * MS_PER_SEC) / usec));
+}
+
+static int _recv_cmd(int argc, char **argv)
+{
+    gnrc_tcp_tcb_t *conn;
+    gnrc_tcp_ep_t local;
+    uint32_t rcvd = 0;
+    uint32_t errors = 0;
+    uint32_t start = 0;
+    ssize_t res;
+
+    if (argc < 2) {
+        printf("usage: %s <port>\n", argv[0]);
+        return 1;
+    }
+    gnrc_tcp_ep_init(&local, AF_INET6, NULL, 0, atoi(argv[1]), 0);
+    gnrc_tcp_tcb_init(&_tcb);
+    if ((res = gnrc_tcp_listen(&_queue, &_tcb, 1, &local)) < 0) {
+        printf("%s: listen failed: %d\n", argv[0], (int)res);
+        return 1;
+    }
+    puts("tput_recv: listening");
+    if ((res = gnrc_tcp_accept(&_queue, &conn, GNRC_TCP_NO_TIMEOUT)) < 0) {
+        printf("%s: accept failed: %d\n", argv[0], (int)res);
+        gnrc_tcp_stop_listen(&_queue);
+        return 1;
+    }
+    /* Receive until the sender closes the connection */
+    while ((res = gnrc_tcp_recv(conn, _buf, sizeof(_buf), TIMEOUT_MS)) > 0) {
+        if (rcvd == 0) {
+            start = ztimer_now(ZTIMER_USEC);
+        }
+        for (ssize_t i = 0; i < res; i++) {
+            if (_buf[i] != _pattern(rcvd + i)) {
+                errors++;
+            }
+        }
+        rcvd += res;
+    }
+    _print_result(argv[0], rcvd, ztimer_now(ZTIMER_USEC) - start);
+    printf("%s: %" PRIu32 " corrupted bytes\n", argv[0], errors);
+    gnrc_tcp_close(conn);
+    gnrc_tcp_stop_listen(&_queue);
+    return (res == 0 && errors == 0) ? 0 : 1;
+}
+
+static int _send_cmd(int argc, char **argv)
+{
+    gnrc_tcp_ep_t remote;
+    uint32_t len;
+    uint32_t sent = 0;
+    uint32_t start;
+    ssize_t res = 0;
+
+    if (argc < 3) {
+        printf("usage: %s <[addr%%netif]:port> <bytes>\n", argv[0]);
+        return 1;
+    }
+    if (gnrc_tcp_ep_from_str(&remote, argv[1]) < 0) {
+        printf("%s: invalid endpoint\n", argv[0]);
+        return 1;
+    }
+    len = strtoul(argv[2], NULL, 10);
+    gnrc_tcp_tcb_init(&_tcb);
+    if ((res = gnrc_tcp_open(&_tcb, &remote, 0)) < 0) {
+        printf("%s: open failed: %d\n", argv[0], (int)res);
+        return 1;
+    }
+    start = ztimer_now(ZTIMER_USEC);
+    while (sent < len) {
+        uint32_t chunk = ((len - sent) < sizeof(_buf)) ? len - sent : sizeof(_buf);
+
+        for (uint32_t i = 0; i < chunk; i++) {
+            _buf[i] = _pattern(sent + i);
+        }
+        /* Send the whole chunk before the buffer is refilled */
+        for (uint32_t done = 0; done < chunk; done += res) {
+            res = gnrc_tcp_send(&_tcb, _buf + done, chunk - done, TIMEOUT_MS);
+            if (res <= 0) {
+                printf("%s: send failed: %d\n", argv[0], (int)res);
+                gnrc_tcp_abort(&_tcb);
+                return 1;
+            }
+        }
+        sent += chunk;
+    }
+    /* The last segments may still be in flight, the receiver measures the
+     * whole transfer */
+    _print_result(argv[0], sent, ztimer_now(ZTIMER_USEC) - start);
+    gnrc_tcp_close(&_tcb);
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "tput_recv", "receive data until the peer closes", _recv_cmd },
+    { "tput_send", "send a number of bytes to a peer", _send_cmd },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    printf("RIOT GNRC TCP throughput test (%u segments in flight)\n",
+           CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE);
+
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
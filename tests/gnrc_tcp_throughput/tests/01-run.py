@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Bulk transfer between two native instances connected via tap devices
+
+Both instances need to be on the same bridge, e.g. tap0 and tap1 as created by
+`dist/tools/tapsetup/tapsetup`.
+"""
+
+import os
+import sys
+
+import pexpect
+
+MAKE = os.environ.get('MAKE', 'make')
+APP = os.path.normpath(os.path.join(os.path.dirname(__file__), '..'))
+TAPS = os.environ.get('TAPS', 'tap0 tap1').split()
+BYTES = int(os.environ.get('BYTES', 256 * 1024))
+PORT = 4242
+
+
+def spawn(tap):
+    env = os.environ.copy()
+    env['PORT'] = tap
+    child = pexpect.spawnu(MAKE, ['-C', APP, 'term'], env=env, timeout=30,
+                           logfile=sys.stdout)
+    child.expect(r'segments in flight\)')
+    return child
+
+
+def get_link_local(child):
+    child.sendline('ifconfig')
+    child.expect(r'Iface\s+(\d+)\s')
+    netif = child.match.group(1)
+    child.expect(r'inet6 addr: (fe80:[0-9a-f:]+)\s')
+    return '{}%{}'.format(child.match.group(1), netif)
+
+
+def main():
+    receiver = spawn(TAPS[0])
+    sender = spawn(TAPS[1])
+    try:
+        addr = get_link_local(receiver)
+        receiver.sendline('tput_recv {}'.format(PORT))
+        receiver.expect_exact('tput_recv: listening')
+
+        sender.sendline('tput_send [{}]:{} {}'.format(addr, PORT, BYTES))
+        sender.expect(r'tput_send: {} bytes in \d+ ms'.format(BYTES))
+        receiver.expect(r'tput_recv: {} bytes in (\d+) ms \((\d+) kbit/s\)'
+                        .format(BYTES))
+        kbits = int(receiver.match.group(2))
+        receiver.expect_exact('tput_recv: 0 corrupted bytes')
+    finally:
+        receiver.close()
+        sender.close()
+    print('\nThroughput: {} kbit/s'.format(kbits))
+    print('SUCCESS')
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for poll() and epoll with many UDP sockets served by one
+ *              thread
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+
+#include "msg.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+
+#define TEST_PORT           (10000U)
+
+static char _sender_stack[THREAD_STACKSIZE_DEFAULT];
+static kernel_pid_t _sender_pid;
+static int _fds[NUMOF_SOCKETS];
+
+/* sends its index to every socket i for which i % msg.content.value == 0,
+ * starting with the last one */
+static void *_sender(void *arg)
+{
+    sock_udp_ep_t remote = { .family = AF_INET6 };
+    msg_t msg;
+
+    (void)arg;
+    memcpy(remote.addr.ipv6, &ipv6_addr_loopback, sizeof(remote.addr.ipv6));
+    while (1) {
+        msg_receive(&msg);
+        for (int i = NUMOF_SOCKETS - 1; i >= 0; i--) {
+            uint8_t idx = i;
+
+            if ((i % msg.content.value) != 0) {
+                continue;
+            }
+            remote.port = TEST_PORT + i;
+            expect(sock_udp_send(NULL, &idx, sizeof(idx), &remote) > 0);
+        }
+    }
+    return NULL;
+}
+
+static void _send(unsigned every)
+{
+    msg_t msg = { .content = { .value = every } };
+
+    msg_send(&msg, _sender_pid);
+}
+
+static void _recv(unsigned i)
+{
+    uint8_t idx;
+
+    expect(recv(_fds[i], &idx, sizeof(idx), 0) == sizeof(idx));
+    expect(idx == i);
+}
+
+static void _test_epoll(int epfd)
+{
+    struct epoll_event events[NUMOF_SOCKETS / 4];
+    unsigned received = 0;
+    int num;
+
+    _send(1);
+    while (received < NUMOF_SOCKETS) {
+        num = epoll_wait(epfd, events, ARRAY_SIZE(events), 1000);
+        expect(num > 0);
+        for (int j = 0; j < num; j++) {
+            expect(events[j].events == EPOLLIN);
+            _recv(events[j].data.u32);
+            received++;
+        }
+    }
+    /* all data was read, so nothing is ready any more */
+    expect(epoll_wait(epfd, events, ARRAY_SIZE(events), 0) == 0);
+    printf("epoll: %u of %u sockets ready\n", received, NUMOF_SOCKETS);
+
+    /* edge-triggered sockets are reported once */
+    for (unsigned i = 0; i < NUMOF_SOCKETS; i++) {
+        struct epoll_event event = { .events = EPOLLIN | EPOLLET,
+                                     .data = { .u32 = i } };
+
+        expect(epoll_ctl(epfd, EPOLL_CTL_MOD, _fds[i], &event) == 0);
+    }
+    _send(NUMOF_SOCKETS);
+    expect(epoll_wait(epfd, events, ARRAY_SIZE(events), 1000) == 1);
+    expect(events[0].data.u32 == 0);
+    expect(epoll_wait(epfd, events, ARRAY_SIZE(events), 10) == 0);
+    _recv(0);
+    puts("epoll: edge-triggered");
+}
+
+static void _test_poll(void)
+{
+    struct pollfd fds[NUMOF_SOCKETS];
+    unsigned received = 0;
+    int num;
+
+    for (unsigned i = 0; i < NUMOF_SOCKETS; i++) {
+        fds[i].fd = _fds[i];
+        fds[i].events = POLLIN;
+    }
+    expect(poll(fds, NUMOF_SOCKETS, 10) == 0);
+    _send(2);
+    while (received < NUMOF_SOCKETS / 2) {
+        num = poll(fds, NUMOF_SOCKETS, 1000);
+        expect(num > 0);
+        for (unsigned i = 0; i < NUMOF_SOCKETS; i++) {
+            if (fds[i].revents) {
+                expect(fds[i].revents == POLLIN);
+                expect((i % 2) == 0);
+                _recv(i);
+                received++;
+                num--;
+            }
+        }
+        expect(num == 0);
+    }
+    fds[0].events = POLLOUT;
+    expect(poll(fds, NUMOF_SOCKETS, 0) == 1);
+    expect(fds[0].revents == POLLOUT);
+    printf("poll: %u of %u sockets ready\n", received, NUMOF_SOCKETS);
+}
+
+int main(void)
+{
+    int epfd;
+
+    _sender_pid = thread_create(_sender_stack, sizeof(_sender_stack),
+                                THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                                _sender, NULL, "sender");
+    expect((epfd = epoll_create1(0)) >= 0);
+    for (unsigned i = 0; i < NUMOF_SOCKETS; i++) {
+        struct sockaddr_in6 addr = { .sin6_family = AF_INET6,
+                                     .sin6_addr = IN6ADDR_ANY_INIT,
+                                     .sin6_port = htons(TEST_PORT + i) };
+        struct epoll_event event = { .events = EPOLLIN,
+                                     .data = { .u32 = i } };
+
+        expect((_fds[i] = socket(AF_INET6, SOCK_DGRAM, 0)) >= 0);
+        expect(bind(_fds[i], (struct sockaddr *)&addr, sizeof(addr)) == 0);
+        expect(epoll_ctl(epfd, EPOLL_CTL_ADD, _fds[i], &event) == 0);
+    }
+    /* a socket can only be added once */
+    struct epoll_event event = { .events = EPOLLIN };
+
+    expect(epoll_ctl(epfd, EPOLL_CTL_ADD, _fds[0], &event) < 0);
+    /* ... and only to one instance */
+    int epfd2;
+
+    expect((epfd2 = epoll_create1(0)) >= 0);
+    expect((epoll_ctl(epfd2, EPOLL_CTL_ADD, _fds[0], &event) < 0) &&
+           (errno == EBUSY));
+    close(epfd2);
+
+    _test_epoll(epfd);
+    for (unsigned i = 0; i < NUMOF_SOCKETS; i++) {
+        expect(epoll_ctl(epfd, EPOLL_CTL_DEL, _fds[i], NULL) == 0);
+    }
+    close(epfd);
+    _test_poll();
+
+    for (unsigned i = 0; i < NUMOF_SOCKETS; i++) {
+        close(_fds[i]);
+    }
+    puts("SUCCESS");
+    return 0;
+}
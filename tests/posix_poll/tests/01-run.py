@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"epoll: (\d+) of (\d+) sockets ready")
+    assert child.match.group(1) == child.match.group(2)
+    child.expect_exact("epoll: edge-triggered")
+    child.expect(r"poll: (\d+) of (\d+) sockets ready")
+    assert int(child.match.group(1)) == int(child.match.group(2)) // 2
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
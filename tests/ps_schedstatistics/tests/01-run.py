@@ -57,10 +57,25 @@ def _check_ps(child):
     child.expect_exact('>')
 
 
+def _check_schedstat(child):
+    child.sendline('schedstat')
+    child.expect(r' pid \| name\s+\| +runtime_us \| switches \| +voluntary')
+    for pid in range(1, 8):
+        child.expect(r'\s+{} \| \w+\s+\| +\d+ \| +\d+ \|'.format(pid))
+    child.expect_exact('>')
+    child.sendline('schedstat json')
+    child.expect(r'\{"threads":\[\{"pid":1,"name":"idle",.*"latency":\[[\d,]+\]\}.*\]\}')
+    child.expect_exact('>')
+    child.sendline('schedstat trace json')
+    child.expect(r'\{"trace":\[.*\],"lost":\d+\}')
+    child.expect_exact('>')
+
+
 def testfunc(child):
     _check_startup(child)
     _check_help(child)
     _check_ps(child)
+    _check_schedstat(child)
 
 
 if __name__ == "__main__":
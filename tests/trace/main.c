@@ -22,7 +22,31 @@
  * @}
  */
 
+#include <stdio.h>
+
+#include "thread.h"
 #include "trace.h"
+#include "ztimer.h"
+
+#define EVENT_THREAD    (1U)
+#define EVENT_ISR       (2U)
+#define EVENT_OVERFLOW  (3U)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+
+static void *_thread(void *arg)
+{
+    (void)arg;
+    trace_event(TRACE_EVENT_BEGIN(EVENT_THREAD), 42);
+    trace_event(TRACE_EVENT_END(EVENT_THREAD), 43);
+    return NULL;
+}
+
+static void _isr_cb(void *arg)
+{
+    (void)arg;
+    trace_event(TRACE_EVENT_ID(EVENT_ISR), 0xabcd);
+}
 
 int main(void)
 {
@@ -31,5 +55,20 @@ int main(void)
 
     trace_dump();
 
+    trace_reset();
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1, 0,
+                  _thread, NULL, "tracer");
+
+    ztimer_t timer = { .callback = _isr_cb };
+    ztimer_set(ZTIMER_USEC, &timer, 100);
+    ztimer_sleep(ZTIMER_USEC, 1000);
+
+    /* overflow the buffer of the main thread (8 entries in this test) */
+    for (unsigned i = 0; i < 10; i++) {
+        trace_event(TRACE_EVENT_ID(EVENT_OVERFLOW), i);
+    }
+
+    trace_dump_hex();
+
     return 0;
 }
@@ -1,12 +1,30 @@
 #!/usr/bin/env python3
 
+import os
 import sys
 from testrunner import run
 
+sys.path.append(os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                             "..", "..", "..", "dist", "tools", "trace_convert"))
+import trace_convert  # noqa: E402
+
 
 def testfunc(child):
-    child.expect(r"n=   0 t=\ +\d+ v=0x00000000\r\n")
-    child.expect(r"n=   1 t=\+\ +\d+ v=0x00000001\r\n")
+    child.expect(r"n=   0 t=\ +\d+ c=\ +\d+ e=0x0000 v=0x00000000\r\n")
+    child.expect(r"n=   1 t=\+\ +\d+ c=\ +\d+ e=0x0000 v=0x00000001\r\n")
+
+    child.expect_exact(trace_convert.HEX_END)
+    dump = trace_convert.parse_hex(child.before.splitlines())
+
+    events = [(e.ctx, e.id, e.payload) for e in dump.records]
+    thread = [(ctx, i, p) for (ctx, i, p) in events if i & 0xc000]
+    assert [(i, p) for (_, i, p) in thread] == [(0x4001, 42), (0x8001, 43)]
+    assert (trace_convert.CTX_ISR, 0x0002, 0xabcd) in events
+
+    main_ctx = [ctx for (ctx, i, _) in events if i == 0x0003][0]
+    overflow = [p for (ctx, i, p) in events if ctx == main_ctx and i == 0x0003]
+    assert overflow == list(range(2, 10))
+    assert (main_ctx, trace_convert.EVENT_LOST, 2) in events
 
 
 if __name__ == "__main__":
@@ -16,6 +16,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <string.h>
+
 #include "thread.h"
 #include "ringbuffer.h"
 #include "mutex.h"
@@ -152,12 +154,72 @@ static void tests_core_ringbuffer_remove_underflow(void)
     TEST_ASSERT_EQUAL_INT(1, ringbuffer_empty(&buf));
 }
 
+static void tests_core_ringbuffer_add_get_wrap(void)
+{
+    char mem[5];
+    char out[6];
+    ringbuffer_t buf;
+    ringbuffer_init(&buf, mem, sizeof(mem));
+
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_add(&buf, "abc", 3));
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_remove(&buf, 2));
+    /* wraps around the end of mem, only four more fit */
+    TEST_ASSERT_EQUAL_INT(4, ringbuffer_add(&buf, "defgh", 5));
+    TEST_ASSERT_EQUAL_INT(1, ringbuffer_full(&buf));
+    TEST_ASSERT_EQUAL_INT(5, ringbuffer_get(&buf, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, "cdefg", 5));
+    TEST_ASSERT_EQUAL_INT(1, ringbuffer_empty(&buf));
+}
+
+static void tests_core_ringbuffer_spans(void)
+{
+    char mem[5];
+    char *span;
+    const char *data;
+    ringbuffer_t buf;
+    ringbuffer_init(&buf, mem, sizeof(mem));
+
+    TEST_ASSERT_EQUAL_INT(0, ringbuffer_peek_span(&buf, &data));
+    TEST_ASSERT_EQUAL_INT(5, ringbuffer_reserve(&buf, &span));
+    TEST_ASSERT(span == mem);
+    memcpy(span, "abc", 3);
+    ringbuffer_commit(&buf, 3);
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_peek_span(&buf, &data));
+    TEST_ASSERT(data == mem);
+    ringbuffer_remove(&buf, 2);
+
+    /* free space: two elements at the end, two at the start */
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_reserve(&buf, &span));
+    TEST_ASSERT(span == &mem[3]);
+    memcpy(span, "de", 2);
+    ringbuffer_commit(&buf, 2);
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_reserve(&buf, &span));
+    TEST_ASSERT(span == mem);
+    memcpy(span, "fg", 2);
+    ringbuffer_commit(&buf, 2);
+    TEST_ASSERT_EQUAL_INT(0, ringbuffer_reserve(&buf, &span));
+
+    /* data: "cde" at the end, "fg" at the start */
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_peek_span(&buf, &data));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, "cde", 3));
+    ringbuffer_remove(&buf, 3);
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_peek_span(&buf, &data));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, "fg", 2));
+    ringbuffer_remove(&buf, 2);
+
+    /* an empty buffer offers all of its memory again */
+    TEST_ASSERT_EQUAL_INT(5, ringbuffer_reserve(&buf, &span));
+    TEST_ASSERT(span == mem);
+}
+
 Test *tests_core_ringbuffer_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(tests_core_ringbuffer),
         new_TestFixture(tests_core_ringbuffer_remove),
         new_TestFixture(tests_core_ringbuffer_remove_underflow),
+        new_TestFixture(tests_core_ringbuffer_add_get_wrap),
+        new_TestFixture(tests_core_ringbuffer_spans),
     };
 
     EMB_UNIT_TESTCALLER(ringbuffer_tests, NULL, NULL, fixtures);
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/af.h"
+#include "net/dns/cache.h"
+#include "net/dns/msg.h"
+#include "ztimer.h"
+
+#include "tests-dns.h"
+
+#define _QUERY  7, 'e', 'x', 'a', 'm', 'p', 'l', 'e', 3, 'o', 'r', 'g', 0
+
+static const uint8_t _addr6[] = {
+    0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01
+};
+static const uint8_t _addr4[] = { 10, 0, 0, 1 };
+
+/* CNAME example.org -> www.example.org (TTL 300),
+ * AAAA www.example.org (TTL 600) */
+static const uint8_t _reply_cname[] = {
+    0x00, 0x00, 0x81, 0x80, 0x00, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,
+    _QUERY, 0x00, 0x1c, 0x00, 0x01,
+    0xc0, 0x0c, 0x00, 0x05, 0x00, 0x01, 0x00, 0x00, 0x01, 0x2c, 0x00, 0x06,
+    3, 'w', 'w', 'w', 0xc0, 0x0c,
+    0xc0, 0x29, 0x00, 0x1c, 0x00, 0x01, 0x00, 0x00, 0x02, 0x58, 0x00, 0x10,
+    0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01,
+};
+
+/* NXDOMAIN with SOA of org (TTL 3600, MINIMUM 900) */
+static const uint8_t _reply_nxdomain[] = {
+    0x00, 0x00, 0x81, 0x83, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+    _QUERY, 0x00, 0x01, 0x00, 0x01,
+    0xc0, 0x14, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00, 0x0e, 0x10, 0x00, 0x16,
+    0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x03,
+    0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x03, 0x84,
+};
+
+/* SERVFAIL */
+static const uint8_t _reply_servfail[] = {
+    0x00, 0x00, 0x81, 0x82, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    _QUERY, 0x00, 0x01, 0x00, 0x01,
+};
+
+static void set_up(void)
+{
+    dns_cache_flush();
+}
+
+static void test_dns_msg_parse_reply__ttl(void)
+{
+    uint8_t addr[16];
+    uint32_t ttl = 0;
+
+    TEST_ASSERT_EQUAL_INT(sizeof(_addr6),
+                          dns_msg_parse_reply(_reply_cname,
+                                              sizeof(_reply_cname), AF_INET6,
+                                              addr, &ttl));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(addr, _addr6, sizeof(_addr6)));
+    /* the TTL of the CNAME record applies */
+    TEST_ASSERT_EQUAL_INT(300, ttl);
+    /* both records are skipped without an A record */
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          dns_msg_parse_reply(_reply_cname,
+                                              sizeof(_reply_cname), AF_INET,
+                                              addr, &ttl));
+    TEST_ASSERT_EQUAL_INT(0, ttl);
+    TEST_ASSERT_EQUAL_INT(-EBADMSG,
+                          dns_msg_parse_reply(_reply_cname,
+                                              sizeof(_reply_cname) - 1,
+                                              AF_INET6, addr, NULL));
+}
+
+static void test_dns_msg_parse_reply__negative(void)
+{
+    uint8_t addr[16];
+    uint32_t ttl = 0;
+
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          dns_msg_parse_reply(_reply_nxdomain,
+                                              sizeof(_reply_nxdomain),
+                                              AF_INET, addr, &ttl));
+    TEST_ASSERT_EQUAL_INT(900, ttl);
+    TEST_ASSERT_EQUAL_INT(-EBADMSG,
+                          dns_msg_parse_reply(_reply_servfail,
+                                              sizeof(_reply_servfail),
+                                              AF_INET, addr, &ttl));
+}
+
+static void test_dns_cache__query(void)
+{
+    uint8_t addr[16];
+
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query("example.org", addr, AF_UNSPEC));
+    dns_cache_add("example.org", AF_INET, _addr4, sizeof(_addr4), 60);
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query("example.org", addr, AF_INET6));
+    TEST_ASSERT_EQUAL_INT(sizeof(_addr4),
+                          dns_cache_query("example.org", addr, AF_UNSPEC));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(addr, _addr4, sizeof(_addr4)));
+
+    /* IPv6 is preferred */
+    dns_cache_add("example.org", AF_UNSPEC, _addr6, sizeof(_addr6), 60);
+    TEST_ASSERT_EQUAL_INT(sizeof(_addr6),
+                          dns_cache_query("example.org", addr, AF_UNSPEC));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(addr, _addr6, sizeof(_addr6)));
+    TEST_ASSERT_EQUAL_INT(sizeof(_addr4),
+                          dns_cache_query("example.org", addr, AF_INET));
+
+    /* nothing is cached without TTL */
+    dns_cache_add("example.com", AF_INET, _addr4, sizeof(_addr4), 0);
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query("example.com", addr, AF_INET));
+}
+
+static void test_dns_cache__negative(void)
+{
+    uint8_t addr[16];
+
+    dns_cache_add("example.org", AF_INET, NULL, 0, 60);
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          dns_cache_query("example.org", addr, AF_INET));
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query("example.org", addr, AF_INET6));
+
+    /* no address at all */
+    dns_cache_add("example.org", AF_UNSPEC, NULL, 0, 60);
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          dns_cache_query("example.org", addr, AF_INET6));
+
+    /* an address replaces the negative answers */
+    dns_cache_add("example.org", AF_INET, _addr4, sizeof(_addr4), 60);
+    TEST_ASSERT_EQUAL_INT(sizeof(_addr4),
+                          dns_cache_query("example.org", addr, AF_INET));
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query("example.org", addr, AF_INET6));
+}
+
+static void test_dns_cache__expiry(void)
+{
+    uint8_t addr[16];
+
+    dns_cache_add("example.org", AF_INET, _addr4, sizeof(_addr4), 1);
+    dns_cache_add("example.com", AF_INET, _addr4, sizeof(_addr4), 60);
+    TEST_ASSERT_EQUAL_INT(sizeof(_addr4),
+                          dns_cache_query("example.org", addr, AF_INET));
+    ztimer_sleep(ZTIMER_MSEC, 1100);
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query("example.org", addr, AF_INET));
+    TEST_ASSERT_EQUAL_INT(sizeof(_addr4),
+                          dns_cache_query("example.com", addr, AF_INET));
+}
+
+static void test_dns_cache__replace(void)
+{
+    uint8_t addr[16];
+    char name[] = "a.org";
+
+    for (unsigned i = 0; i < CONFIG_DNS_CACHE_SIZE; i++) {
+        name[0] = 'a' + i;
+        dns_cache_add(name, AF_INET, _addr4, sizeof(_addr4), 60 - i);
+    }
+    /* the entry that expires first goes */
+    name[0] = 'a' + CONFIG_DNS_CACHE_SIZE;
+    dns_cache_add(name, AF_INET, _addr4, sizeof(_addr4), 60);
+    for (unsigned i = 0; i <= CONFIG_DNS_CACHE_SIZE; i++) {
+        name[0] = 'a' + i;
+        TEST_ASSERT_EQUAL_INT((i == CONFIG_DNS_CACHE_SIZE - 1)
+                              ? 0 : (int)sizeof(_addr4),
+                              dns_cache_query(name, addr, AF_INET));
+    }
+}
+
+Test *tests_dns_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_dns_msg_parse_reply__ttl),
+        new_TestFixture(test_dns_msg_parse_reply__negative),
+        new_TestFixture(test_dns_cache__query),
+        new_TestFixture(test_dns_cache__negative),
+        new_TestFixture(test_dns_cache__expiry),
+        new_TestFixture(test_dns_cache__replace),
+    };
+
+    EMB_UNIT_TESTCALLER(dns_tests, set_up, NULL, fixtures);
+
+    return (Test *)&dns_tests;
+}
+
+void tests_dns(void)
+{
+    TESTS_RUN(tests_dns_tests());
+}
+/** @} */
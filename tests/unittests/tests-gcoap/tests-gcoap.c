@@ -12,12 +12,15 @@
  * @file
  */
 #include <errno.h>
+#include <inttypes.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 
 #include "embUnit.h"
 
 #include "net/gcoap.h"
+#include "ztimer.h"
 
 #include "unittests-constants.h"
 #include "tests-gcoap.h"
@@ -385,6 +388,298 @@ static void test_gcoap__server_get_resource_list(void)
     TEST_ASSERT_EQUAL_STRING(resource_list_str, (char *)res);
 }
 
+/*
+ * Resource lookup with exact and subtree paths, several resources per path
+ * and methods that do not match.
+ */
+static void test_gcoap__server_find_resource(void)
+{
+    static const coap_resource_t tree[] = {
+        { .path = "/a", .methods = COAP_GET },
+        { .path = "/a", .methods = COAP_PUT },
+        { .path = "/a/", .methods = COAP_GET | COAP_MATCH_SUBTREE },
+        { .path = "/a/b", .methods = COAP_POST },
+        { .path = "/fw", .methods = COAP_PUT | COAP_MATCH_SUBTREE },
+        { .path = "/fw/x/y", .methods = COAP_GET },
+        { .path = "/z", .methods = COAP_GET },
+    };
+    const coap_resource_t *r;
+
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(tree, ARRAY_SIZE(tree),
+                                                (uint8_t *)"/a", COAP_PUT, &r));
+    TEST_ASSERT(r == &tree[1]);
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP, coap_find_resource(tree, ARRAY_SIZE(tree),
+                                                       (uint8_t *)"/a",
+                                                       COAP_POST, &r));
+    /* subtree sorts first and wins */
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(tree, ARRAY_SIZE(tree),
+                                                (uint8_t *)"/a/b", COAP_GET,
+                                                &r));
+    TEST_ASSERT(r == &tree[2]);
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(tree, ARRAY_SIZE(tree),
+                                                (uint8_t *)"/a/b", COAP_POST,
+                                                &r));
+    TEST_ASSERT(r == &tree[3]);
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(tree, ARRAY_SIZE(tree),
+                                                (uint8_t *)"/a/c/d", COAP_GET,
+                                                &r));
+    TEST_ASSERT(r == &tree[2]);
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(tree, ARRAY_SIZE(tree),
+                                                (uint8_t *)"/fwupdate",
+                                                COAP_PUT, &r));
+    TEST_ASSERT(r == &tree[4]);
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP, coap_find_resource(tree, ARRAY_SIZE(tree),
+                                                       (uint8_t *)"/fw/x",
+                                                       COAP_GET, &r));
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(tree, ARRAY_SIZE(tree),
+                                                (uint8_t *)"/fw/x/y", COAP_GET,
+                                                &r));
+    TEST_ASSERT(r == &tree[5]);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_find_resource(tree, ARRAY_SIZE(tree),
+                                                      (uint8_t *)"/b",
+                                                      COAP_GET, &r));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_find_resource(tree, ARRAY_SIZE(tree),
+                                                      (uint8_t *)"/", COAP_GET,
+                                                      &r));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_find_resource(tree, 0, (uint8_t *)"/a",
+                                                      COAP_GET, &r));
+}
+
+/* the first matching resource of a full linear scan */
+static int _find_reference(const coap_resource_t *resources, size_t numof,
+                           const char *uri, coap_method_flags_t method_flag,
+                           const coap_resource_t **resource)
+{
+    int ret = -ENOENT;
+
+    for (size_t i = 0; i < numof; i++) {
+        if (coap_match_path(&resources[i], (uint8_t *)uri) != 0) {
+            continue;
+        }
+        if (resources[i].methods & method_flag) {
+            *resource = &resources[i];
+            return 0;
+        }
+        ret = -ENOTSUP;
+    }
+    return ret;
+}
+
+/*
+ * Resource lookup in a tree too large for the linear search, with subtree
+ * resources, paths that are prefixes of their siblings, wrong methods and
+ * missing paths.
+ * Expected result: the same results as a full linear scan
+ */
+static void test_gcoap__server_find_resource__binary(void)
+{
+    static const coap_resource_t tree[] = {
+        { .path = "/0", .methods = COAP_GET },
+        { .path = "/0/0", .methods = COAP_GET | COAP_PUT },
+        { .path = "/1", .methods = COAP_GET },
+        { .path = "/1/0", .methods = COAP_GET | COAP_PUT },
+        { .path = "/2", .methods = COAP_GET },
+        { .path = "/2/0", .methods = COAP_GET | COAP_PUT },
+        { .path = "/3", .methods = COAP_GET },
+        { .path = "/3/0", .methods = COAP_GET | COAP_PUT },
+        { .path = "/4", .methods = COAP_GET },
+        { .path = "/4/0", .methods = COAP_GET | COAP_PUT },
+        { .path = "/5", .methods = COAP_GET },
+        { .path = "/5/0", .methods = COAP_GET | COAP_PUT },
+        { .path = "/6", .methods = COAP_GET },
+        { .path = "/6/0", .methods = COAP_GET | COAP_PUT },
+        { .path = "/7", .methods = COAP_GET },
+        { .path = "/7/0", .methods = COAP_GET | COAP_PUT },
+        { .path = "/8", .methods = COAP_GET },
+        { .path = "/8/0", .methods = COAP_GET | COAP_PUT },
+        { .path = "/9", .methods = COAP_GET },
+        { .path = "/9/0", .methods = COAP_GET | COAP_PUT },
+        { .path = "/a", .methods = COAP_GET },
+        { .path = "/a", .methods = COAP_PUT },
+        { .path = "/a/", .methods = COAP_GET | COAP_MATCH_SUBTREE },
+        { .path = "/a/b", .methods = COAP_POST },
+        { .path = "/a/bc", .methods = COAP_GET },
+        { .path = "/fw", .methods = COAP_PUT | COAP_MATCH_SUBTREE },
+        { .path = "/fw/x/y", .methods = COAP_GET },
+        { .path = "/fwd", .methods = COAP_GET },
+        { .path = "/sensor", .methods = COAP_GET },
+        { .path = "/sensor/", .methods = COAP_POST | COAP_MATCH_SUBTREE },
+        { .path = "/sensor/temp", .methods = COAP_GET },
+        { .path = "/sensor/temperature", .methods = COAP_GET },
+        { .path = "/sensors", .methods = COAP_GET },
+        { .path = "/z", .methods = COAP_GET },
+        { .path = "/z/", .methods = COAP_DELETE | COAP_MATCH_SUBTREE },
+    };
+    static const char *uris[] = {
+        "", "/", "/0", "/0/", "/0/0", "/0/00", "/5/0", "/9/0/1", "/90",
+        "/a", "/a/", "/a/b", "/a/bc", "/a/bcd", "/a/c/d", "/b",
+        "/f", "/fw", "/fw/", "/fw/x", "/fw/x/y", "/fw/x/y/z", "/fwd", "/fwupdate",
+        "/sensor", "/sensor/", "/sensor/hum", "/sensor/temp",
+        "/sensor/tempe", "/sensor/temperature", "/sensors", "/sensorsx",
+        "/y", "/z", "/z/", "/z/1", "/zz",
+    };
+    static const coap_method_flags_t methods[] = {
+        COAP_GET, COAP_POST, COAP_PUT, COAP_DELETE,
+    };
+    const coap_resource_t *r, *expected;
+
+    TEST_ASSERT(ARRAY_SIZE(tree) > 32);
+    /* subtree resources match */
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(tree, ARRAY_SIZE(tree),
+                                                (uint8_t *)"/sensor/hum",
+                                                COAP_POST, &r));
+    TEST_ASSERT_EQUAL_STRING("/sensor/", r->path);
+    /* a path that is a prefix of a sibling only matches itself */
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(tree, ARRAY_SIZE(tree),
+                                                (uint8_t *)"/sensor/temp",
+                                                COAP_GET, &r));
+    TEST_ASSERT_EQUAL_STRING("/sensor/temp", r->path);
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP, coap_find_resource(tree, ARRAY_SIZE(tree),
+                                                       (uint8_t *)"/sensor/tempe",
+                                                       COAP_GET, &r));
+    /* wrong method (4.05) vs missing path (4.04) */
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP, coap_find_resource(tree, ARRAY_SIZE(tree),
+                                                       (uint8_t *)"/sensors",
+                                                       COAP_POST, &r));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_find_resource(tree, ARRAY_SIZE(tree),
+                                                      (uint8_t *)"/sensorx",
+                                                      COAP_GET, &r));
+
+    for (unsigned i = 0; i < ARRAY_SIZE(uris); i++) {
+        for (unsigned j = 0; j < ARRAY_SIZE(methods); j++) {
+            int res = _find_reference(tree, ARRAY_SIZE(tree), uris[i],
+                                      methods[j], &expected);
+
+            r = NULL;
+            TEST_ASSERT_EQUAL_INT(res, coap_find_resource(tree, ARRAY_SIZE(tree),
+                                                          (uint8_t *)uris[i],
+                                                          methods[j], &r));
+            if (res == 0) {
+                TEST_ASSERT(r == expected);
+            }
+        }
+    }
+}
+
+#define BENCH_RESOURCES_MAX (500U)
+#define BENCH_REQS          (8U)
+#define BENCH_LOOKUPS       (2000U)
+
+static coap_resource_t bench_resources[BENCH_RESOURCES_MAX];
+static char bench_paths[BENCH_RESOURCES_MAX][sizeof("/00/0/0")];
+
+/* what the default request matcher of gcoap does */
+static int _indexed_matcher(gcoap_listener_t *listener,
+                            const coap_resource_t **resource,
+                            const coap_pkt_t *pdu)
+{
+    uint8_t uri[CONFIG_NANOCOAP_URI_MAX];
+
+    if (coap_get_uri_path(pdu, uri) <= 0) {
+        return GCOAP_RESOURCE_NO_PATH;
+    }
+    coap_method_flags_t method_flag = coap_method2flag(
+        coap_get_code_detail(pdu));
+
+    if (coap_find_resource(listener->resources, listener->resources_len, uri,
+                           method_flag, resource) == 0) {
+        return GCOAP_RESOURCE_FOUND;
+    }
+    return GCOAP_RESOURCE_NO_PATH;
+}
+
+/* the linear search gcoap used before the resource lookup was indexed */
+static int _linear_matcher(gcoap_listener_t *listener,
+                           const coap_resource_t **resource,
+                           const coap_pkt_t *pdu)
+{
+    uint8_t uri[CONFIG_NANOCOAP_URI_MAX];
+
+    if (coap_get_uri_path(pdu, uri) <= 0) {
+        return GCOAP_RESOURCE_NO_PATH;
+    }
+    coap_method_flags_t method_flag = coap_method2flag(
+        coap_get_code_detail(pdu));
+
+    for (size_t i = 0; i < listener->resources_len; i++) {
+        int res = coap_match_path(&listener->resources[i], uri);
+
+        if (res < 0) {
+            break;
+        }
+        if ((res == 0) && (listener->resources[i].methods & method_flag)) {
+            *resource = &listener->resources[i];
+            return GCOAP_RESOURCE_FOUND;
+        }
+    }
+    return GCOAP_RESOURCE_NO_PATH;
+}
+
+static void _bench_lookups(gcoap_request_matcher_t matcher,
+                           gcoap_listener_t *listener, coap_pkt_t *reqs,
+                           uint32_t *ns)
+{
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+    unsigned found = 0;
+
+    for (unsigned i = 0; i < BENCH_LOOKUPS; i++) {
+        const coap_resource_t *resource = NULL;
+        coap_pkt_t *pdu = &reqs[i % BENCH_REQS];
+
+        if ((matcher(listener, &resource, pdu) == GCOAP_RESOURCE_FOUND) &&
+            (resource < &listener->resources[listener->resources_len])) {
+            found++;
+        }
+    }
+    start = ztimer_now(ZTIMER_USEC) - start;
+    TEST_ASSERT_EQUAL_INT(BENCH_LOOKUPS, found);
+    /* averaged over all lookups, the microsecond resolution is enough */
+    *ns = (uint32_t)(((uint64_t)start * 1000) / BENCH_LOOKUPS);
+}
+
+/*
+ * Looks up requests spread over listeners with 10, 100 and 500 resources
+ * with LwM2M style paths. The listeners are not registered, so other tests
+ * do not see them.
+ *
+ * Expected result: every request finds its resource; prints the time per
+ * lookup for coap_find_resource() and for a linear search
+ */
+static void test_gcoap__server_lookup_benchmark(void)
+{
+    static const unsigned sizes[] = { 10, 100, BENCH_RESOURCES_MAX };
+    static uint8_t bufs[BENCH_REQS][CONFIG_GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t reqs[BENCH_REQS];
+
+    for (unsigned i = 0; i < BENCH_RESOURCES_MAX; i++) {
+        snprintf(bench_paths[i], sizeof(bench_paths[i]), "/%02u/0/%u",
+                 i / 10, i % 10);
+        bench_resources[i].path = bench_paths[i];
+        bench_resources[i].methods = COAP_GET;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(sizes); i++) {
+        gcoap_listener_t bench_listener = {
+            .resources     = bench_resources,
+            .resources_len = sizes[i],
+        };
+        uint32_t indexed, linear;
+
+        for (unsigned j = 0; j < BENCH_REQS; j++) {
+            /* spread over the whole tree, the last one is the worst case */
+            unsigned k = ((j + 1) * sizes[i]) / BENCH_REQS - 1;
+
+            TEST_ASSERT(gcoap_req_init(&reqs[j], bufs[j], sizeof(bufs[j]),
+                                       COAP_METHOD_GET, bench_paths[k]) == 0);
+        }
+        _bench_lookups(_indexed_matcher, &bench_listener, reqs, &indexed);
+        _bench_lookups(_linear_matcher, &bench_listener, reqs, &linear);
+        printf("\ngcoap lookup: %3u resources: %" PRIu32 " ns/request "
+               "(linear: %" PRIu32 " ns/request)", sizes[i], indexed, linear);
+    }
+    puts("");
+}
+
 Test *tests_gcoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -398,7 +693,10 @@ Test *tests_gcoap_tests(void)
         new_TestFixture(test_gcoap__server_get_resp),
         new_TestFixture(test_gcoap__server_con_req),
         new_TestFixture(test_gcoap__server_con_resp),
-        new_TestFixture(test_gcoap__server_get_resource_list)
+        new_TestFixture(test_gcoap__server_get_resource_list),
+        new_TestFixture(test_gcoap__server_find_resource),
+        new_TestFixture(test_gcoap__server_find_resource__binary),
+        new_TestFixture(test_gcoap__server_lookup_benchmark),
     };
 
     EMB_UNIT_TESTCALLER(gcoap_tests, NULL, NULL, fixtures);
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Tests the route lookup against a linear search
+ *
+ * The same tests run with and without @ref CONFIG_GNRC_IPV6_NIB_OFFL_LPM,
+ * build with `TESTS_NIB_LPM=0` for the linear search. The lookup times for
+ * large route tables are measured by tests/bench_gnrc_ipv6_nib_lpm.
+ */
+
+#include <errno.h>
+
+#include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/ipv6/nib/ft.h"
+
+#include "_nib-internal.h"
+
+#include "tests-gnrc_ipv6_nib.h"
+
+#define LINK_LOCAL_PREFIX   { 0xfe, 0x80, 0, 0, 0, 0, 0, 0 }
+#define GLOBAL_PREFIX       { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0 }
+#define IFACE               (6)
+#define NEXT_HOPS_NUMOF     (4)
+#define ROUNDS              (1000U)
+
+static uint32_t _rand_state;
+
+/* deterministic, so runs with and without the index are comparable */
+static uint32_t _rand(void)
+{
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+static void set_up(void)
+{
+    evtimer_event_t *tmp;
+
+    for (evtimer_event_t *ptr = _nib_evtimer.events;
+         (ptr != NULL) && (tmp = (ptr->next), 1);
+         ptr = tmp) {
+        evtimer_del((evtimer_t *)(&_nib_evtimer), ptr);
+    }
+    _nib_init();
+    _rand_state = 0x2f6b4e1d;
+}
+
+/* few distinct bits below 2001:db8::/32, so prefixes overlap a lot */
+static void _rand_addr(ipv6_addr_t *addr)
+{
+    static const ipv6_addr_t global = { .u64 = { { .u8 = GLOBAL_PREFIX } } };
+    uint32_t r = _rand();
+
+    *addr = global;
+    addr->u8[4] = r & 0x13;
+    addr->u8[5] = (r >> 8) & 0xc0;
+    addr->u8[6] = (r >> 16) & 0x3;
+    addr->u8[7] = (r >> 24) & 0x81;
+    addr->u32[3].u32 = _rand();
+}
+
+static void _rand_route(ipv6_addr_t *pfx, unsigned *pfx_len,
+                        unsigned min_len, ipv6_addr_t *next_hop)
+{
+    static const ipv6_addr_t link_local = { .u64 = { { .u8 = LINK_LOCAL_PREFIX } } };
+
+    _rand_addr(pfx);
+    *pfx_len = min_len + (_rand() % (65 - min_len));
+    *next_hop = link_local;
+    next_hop->u8[15] = 1 + (_rand() % NEXT_HOPS_NUMOF);
+}
+
+/* the route lookup as it is done without the LPM index */
+static _nib_offl_entry_t *_linear_match(const ipv6_addr_t *dst)
+{
+    _nib_offl_entry_t *res = NULL;
+    uint8_t best_match = 0;
+
+    for (_nib_offl_entry_t *entry = _nib_offl_iter(NULL); entry != NULL;
+         entry = _nib_offl_iter(entry)) {
+        uint8_t match = ipv6_addr_match_prefix(&entry->pfx, dst);
+
+        if ((match > best_match) && (match >= entry->pfx_len)) {
+            res = entry;
+            best_match = match;
+        }
+    }
+    return res;
+}
+
+static void _check_lookup(const ipv6_addr_t *dst)
+{
+    gnrc_ipv6_nib_ft_t fte;
+    _nib_offl_entry_t *exp = _linear_match(dst);
+    int res = gnrc_ipv6_nib_ft_get(dst, NULL, &fte);
+
+    if (exp == NULL) {
+        TEST_ASSERT_EQUAL_INT(-ENETUNREACH, res);
+        return;
+    }
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_EQUAL_INT(exp->pfx_len, fte.dst_len);
+    TEST_ASSERT(ipv6_addr_equal(&exp->pfx, &fte.dst));
+    TEST_ASSERT(ipv6_addr_equal(&exp->next_hop->ipv6, &fte.next_hop));
+}
+
+/*
+ * Randomly adds and removes routes and looks up random destinations after
+ * each change.
+ * Expected result: gnrc_ipv6_nib_ft_get() always returns the route the linear
+ * search finds
+ */
+static void test_nib_lpm__linear_equivalence(void)
+{
+    _nib_offl_entry_t *routes[CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF] = { NULL };
+
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        unsigned idx = _rand() % ARRAY_SIZE(routes);
+        ipv6_addr_t addr;
+
+        if (routes[idx] != NULL) {
+            _nib_ft_remove(routes[idx]);
+            routes[idx] = NULL;
+        }
+        else {
+            ipv6_addr_t next_hop;
+            unsigned pfx_len;
+
+            _rand_route(&addr, &pfx_len, 16, &next_hop);
+            /* duplicates of existing routes are fine, they are just not
+             * tracked */
+            routes[idx] = _nib_ft_add(&next_hop, IFACE, &addr, pfx_len);
+            for (unsigned i = 0; i < ARRAY_SIZE(routes); i++) {
+                if ((i != idx) && (routes[i] == routes[idx])) {
+                    routes[idx] = NULL;
+                    break;
+                }
+            }
+        }
+        for (unsigned i = 0; i < 4; i++) {
+            _rand_addr(&addr);
+            _check_lookup(&addr);
+        }
+    }
+}
+
+Test *tests_gnrc_ipv6_nib_lpm_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_nib_lpm__linear_equivalence),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, NULL,
+                        fixtures);
+
+    return (Test *)&tests;
+}
@@ -13,15 +13,59 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <string.h>
+
 #include "embUnit.h"
+#include "xtimer.h"
 
 #include "net/gnrc/netif/conf.h"
+#include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/netif/pktq.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
 
 #include "tests-gnrc_netif_pktq.h"
 
+#define DSCP_CS1    (0x08)
+#define DSCP_EF     (0x2e)
+
 gnrc_netif_t _netif;
 
+typedef struct {
+    gnrc_pktsnip_t netif;
+    gnrc_pktsnip_t ipv6;
+    gnrc_netif_hdr_t netif_hdr;
+    ipv6_hdr_t ipv6_hdr;
+} _ipv6_pkt_t;
+
+/* netif header -> IPv6 header with the given next header and DSCP */
+static gnrc_pktsnip_t *_init_pkt(_ipv6_pkt_t *pkt, uint8_t nh, uint8_t dscp)
+{
+    memset(pkt, 0, sizeof(*pkt));
+    ipv6_hdr_set_version(&pkt->ipv6_hdr);
+    ipv6_hdr_set_tc_dscp(&pkt->ipv6_hdr, dscp);
+    pkt->ipv6_hdr.nh = nh;
+    pkt->netif.type = GNRC_NETTYPE_NETIF;
+    pkt->netif.data = &pkt->netif_hdr;
+    pkt->netif.size = sizeof(pkt->netif_hdr);
+    pkt->netif.next = &pkt->ipv6;
+    pkt->ipv6.type = GNRC_NETTYPE_IPV6;
+    pkt->ipv6.data = &pkt->ipv6_hdr;
+    pkt->ipv6.size = sizeof(pkt->ipv6_hdr);
+    return &pkt->netif;
+}
+
+static gnrc_pktsnip_t *_alloc_pkt(uint8_t dscp)
+{
+    ipv6_hdr_t hdr = { 0 };
+
+    ipv6_hdr_set_version(&hdr);
+    ipv6_hdr_set_tc_dscp(&hdr, dscp);
+    hdr.nh = PROTNUM_UDP;
+    return gnrc_pktbuf_add(NULL, &hdr, sizeof(hdr), GNRC_NETTYPE_IPV6);
+}
+
 static void set_up(void)
 {
     while (gnrc_netif_pktq_get(&_netif)) { }
@@ -39,7 +83,7 @@ static void test_pktq_usage__empty(void)
 
 static void test_pktq_put__full(void)
 {
-    gnrc_pktsnip_t pkt;
+    gnrc_pktsnip_t pkt = { 0 };
 
     for (unsigned i = 0; i < CONFIG_GNRC_NETIF_PKTQ_POOL_SIZE; i++) {
         TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif, &pkt));
@@ -51,7 +95,7 @@ static void test_pktq_put__full(void)
 
 static void test_pktq_put_get1(void)
 {
-    gnrc_pktsnip_t pkt_in, *pkt_out;
+    gnrc_pktsnip_t pkt_in = { 0 }, *pkt_out;
 
     TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif, &pkt_in));
     TEST_ASSERT_EQUAL_INT(1, gnrc_netif_pktq_usage());
@@ -62,7 +106,7 @@ static void test_pktq_put_get1(void)
 
 static void test_pktq_put_get3(void)
 {
-    gnrc_pktsnip_t pkt_in[3];
+    gnrc_pktsnip_t pkt_in[3] = { 0 };
 
     for (unsigned i = 0; i < 3; i++) {
         TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif, &pkt_in[i]));
@@ -79,7 +123,7 @@ static void test_pktq_put_get3(void)
 
 static void test_pktq_push_back__full(void)
 {
-    gnrc_pktsnip_t pkt;
+    gnrc_pktsnip_t pkt = { 0 };
 
     for (unsigned i = 0; i < CONFIG_GNRC_NETIF_PKTQ_POOL_SIZE; i++) {
         TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif, &pkt));
@@ -91,7 +135,7 @@ static void test_pktq_push_back__full(void)
 
 static void test_pktq_push_back_get1(void)
 {
-    gnrc_pktsnip_t pkt_in, *pkt_out;
+    gnrc_pktsnip_t pkt_in = { 0 }, *pkt_out;
 
     TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_push_back(&_netif, &pkt_in));
     TEST_ASSERT_EQUAL_INT(1, gnrc_netif_pktq_usage());
@@ -102,7 +146,7 @@ static void test_pktq_push_back_get1(void)
 
 static void test_pktq_push_back_get3(void)
 {
-    gnrc_pktsnip_t pkt_in[3];
+    gnrc_pktsnip_t pkt_in[3] = { 0 };
 
     for (unsigned i = 0; i < 3; i++) {
         TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_push_back(&_netif, &pkt_in[i]));
@@ -119,7 +163,7 @@ static void test_pktq_push_back_get3(void)
 
 static void test_pktq_empty(void)
 {
-    gnrc_pktsnip_t pkt_in;
+    gnrc_pktsnip_t pkt_in = { 0 };
 
     TEST_ASSERT(gnrc_netif_pktq_empty(&_netif));
     TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif, &pkt_in));
@@ -132,6 +176,189 @@ static void test_pktq_empty(void)
     TEST_ASSERT(gnrc_netif_pktq_empty(&_netif));
 }
 
+static void test_pktq_classify__undef(void)
+{
+    gnrc_pktsnip_t pkt = { 0 };
+
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_PKTQ_CLASS_DEFAULT,
+                          gnrc_netif_pktq_classify(&pkt));
+}
+
+static void test_pktq_classify__ipv6(void)
+{
+    _ipv6_pkt_t pkt;
+
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_PKTQ_CLASS_DEFAULT,
+                          gnrc_netif_pktq_classify(_init_pkt(&pkt, PROTNUM_UDP, 0)));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_PKTQ_CLASS_BULK,
+                          gnrc_netif_pktq_classify(_init_pkt(&pkt, PROTNUM_UDP,
+                                                             DSCP_CS1)));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_PKTQ_CLASS_CTRL,
+                          gnrc_netif_pktq_classify(_init_pkt(&pkt, PROTNUM_UDP,
+                                                             DSCP_EF)));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_PKTQ_CLASS_CTRL,
+                          gnrc_netif_pktq_classify(_init_pkt(&pkt, PROTNUM_ICMPV6,
+                                                             DSCP_CS1)));
+    /* works without netif header as well */
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_PKTQ_CLASS_CTRL,
+                          gnrc_netif_pktq_classify(&pkt.ipv6));
+}
+
+static void test_pktq_classify__iphc(void)
+{
+    static const struct {
+        uint8_t data[8];
+        uint8_t len;
+        uint8_t cls;
+    } frames[] = {
+        /* TF elided, NH compressed */
+        { { 0x7c, 0x00 }, 2, GNRC_NETIF_PKTQ_CLASS_DEFAULT },
+        /* TF elided, NH inline: ICMPv6 */
+        { { 0x78, 0x00, PROTNUM_ICMPV6 }, 3, GNRC_NETIF_PKTQ_CLASS_CTRL },
+        /* CID, TF elided, NH inline: ICMPv6 */
+        { { 0x78, 0x80, 0x00, PROTNUM_ICMPV6 }, 4, GNRC_NETIF_PKTQ_CLASS_CTRL },
+        /* ECN + DSCP inline: CS1, NH inline: UDP */
+        { { 0x70, 0x00, DSCP_CS1, PROTNUM_UDP }, 4, GNRC_NETIF_PKTQ_CLASS_BULK },
+        /* ECN + DSCP + flow label inline: EF, NH inline: UDP */
+        { { 0x60, 0x00, DSCP_EF, 0x00, 0x00, 0x00, PROTNUM_UDP }, 7,
+          GNRC_NETIF_PKTQ_CLASS_CTRL },
+        /* ECN + flow label inline, NH compressed */
+        { { 0x6c, 0x00, 0x00, 0x00, 0x00 }, 5, GNRC_NETIF_PKTQ_CLASS_DEFAULT },
+        /* first fragment */
+        { { 0xc0, 0x50, 0x00, 0x01, 0x78, 0x00, PROTNUM_ICMPV6 }, 7,
+          GNRC_NETIF_PKTQ_CLASS_DEFAULT },
+    };
+
+    for (unsigned i = 0; i < ARRAY_SIZE(frames); i++) {
+        gnrc_pktsnip_t pkt = {
+            .type = GNRC_NETTYPE_SIXLOWPAN,
+            .data = (void *)frames[i].data,
+            .size = frames[i].len,
+        };
+
+        TEST_ASSERT_EQUAL_INT(frames[i].cls, gnrc_netif_pktq_classify(&pkt));
+    }
+}
+
+static void test_pktq_put_get__classes(void)
+{
+    _ipv6_pkt_t bulk, def, ctrl[2];
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif,
+                                                 _init_pkt(&bulk, PROTNUM_UDP,
+                                                           DSCP_CS1)));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif,
+                                                 _init_pkt(&ctrl[0], PROTNUM_UDP,
+                                                           DSCP_EF)));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif,
+                                                 _init_pkt(&def, PROTNUM_UDP, 0)));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif,
+                                                 _init_pkt(&ctrl[1], PROTNUM_ICMPV6,
+                                                           0)));
+    TEST_ASSERT_EQUAL_INT(4, gnrc_netif_pktq_usage());
+
+    /* control first, then default, then bulk, FIFO within a class */
+    TEST_ASSERT(&ctrl[0].netif == gnrc_netif_pktq_get(&_netif));
+    TEST_ASSERT(&ctrl[1].netif == gnrc_netif_pktq_get(&_netif));
+    TEST_ASSERT(&def.netif == gnrc_netif_pktq_get(&_netif));
+    TEST_ASSERT(&bulk.netif == gnrc_netif_pktq_get(&_netif));
+    TEST_ASSERT_NULL(gnrc_netif_pktq_get(&_netif));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_usage());
+}
+
+static void test_pktq_push_back__class(void)
+{
+    gnrc_pktsnip_t pkt_in[2] = { 0 };
+    _ipv6_pkt_t ctrl;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif, &pkt_in[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif,
+                                                 _init_pkt(&ctrl, PROTNUM_ICMPV6,
+                                                           0)));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_push_back(&_netif, &pkt_in[1]));
+    /* pushed back to the head of its class, not of the whole queue */
+    TEST_ASSERT(&ctrl.netif == gnrc_netif_pktq_get(&_netif));
+    TEST_ASSERT(&pkt_in[1] == gnrc_netif_pktq_get(&_netif));
+    TEST_ASSERT(&pkt_in[0] == gnrc_netif_pktq_get(&_netif));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_usage());
+}
+
+static void test_pktq_put__evict(void)
+{
+    gnrc_pktsnip_t *bulk[CONFIG_GNRC_NETIF_PKTQ_POOL_SIZE];
+    _ipv6_pkt_t ctrl;
+
+    gnrc_pktbuf_init();
+    for (unsigned i = 0; i < CONFIG_GNRC_NETIF_PKTQ_POOL_SIZE; i++) {
+        bulk[i] = _alloc_pkt(DSCP_CS1);
+        TEST_ASSERT_NOT_NULL(bulk[i]);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif, bulk[i]));
+    }
+    /* no room for more bulk traffic */
+    TEST_ASSERT_EQUAL_INT(-1, gnrc_netif_pktq_put(&_netif, bulk[0]));
+    /* but for packets of higher priority */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif,
+                                                 _init_pkt(&ctrl, PROTNUM_ICMPV6,
+                                                           0)));
+    TEST_ASSERT_EQUAL_INT(CONFIG_GNRC_NETIF_PKTQ_POOL_SIZE,
+                          gnrc_netif_pktq_usage());
+    TEST_ASSERT(&ctrl.netif == gnrc_netif_pktq_get(&_netif));
+    /* the last bulk packet made room */
+    for (unsigned i = 0; i < CONFIG_GNRC_NETIF_PKTQ_POOL_SIZE - 1; i++) {
+        gnrc_pktsnip_t *pkt = gnrc_netif_pktq_get(&_netif);
+
+        TEST_ASSERT(bulk[i] == pkt);
+        gnrc_pktbuf_release(pkt);
+    }
+    TEST_ASSERT_NULL(gnrc_netif_pktq_get(&_netif));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktq_get__codel(void)
+{
+    gnrc_pktsnip_t *pkt[4];
+
+    gnrc_pktbuf_init();
+    for (unsigned i = 0; i < ARRAY_SIZE(pkt); i++) {
+        pkt[i] = _alloc_pkt(0);
+        TEST_ASSERT_NOT_NULL(pkt[i]);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif, pkt[i]));
+    }
+    /* above target: start of the interval */
+    xtimer_usleep(2 * CONFIG_GNRC_NETIF_PKTQ_CODEL_TARGET_US);
+    TEST_ASSERT(pkt[0] == gnrc_netif_pktq_get(&_netif));
+    gnrc_pktbuf_release(pkt[0]);
+    /* above target for a whole interval: drop */
+    xtimer_usleep(CONFIG_GNRC_NETIF_PKTQ_CODEL_INTERVAL_US +
+                  CONFIG_GNRC_NETIF_PKTQ_CODEL_TARGET_US);
+    TEST_ASSERT(pkt[2] == gnrc_netif_pktq_get(&_netif));
+    gnrc_pktbuf_release(pkt[2]);
+    /* the last packet is not dropped, it is no standing queue */
+    TEST_ASSERT(pkt[3] == gnrc_netif_pktq_get(&_netif));
+    gnrc_pktbuf_release(pkt[3]);
+    TEST_ASSERT_NULL(gnrc_netif_pktq_get(&_netif));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_usage());
+}
+
+static void test_pktq_stats(void)
+{
+    netstats_queue_t *stats = &_netif.send_queue.stats[GNRC_NETIF_PKTQ_CLASS_DEFAULT];
+    gnrc_pktsnip_t pkt_in[2] = { 0 };
+
+    memset(_netif.send_queue.stats, 0, sizeof(_netif.send_queue.stats));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif, &pkt_in[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif, &pkt_in[1]));
+    TEST_ASSERT_NOT_NULL(gnrc_netif_pktq_get(&_netif));
+    /* pushing back is no new packet */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_push_back(&_netif, &pkt_in[0]));
+    TEST_ASSERT_EQUAL_INT(2, stats->enqueued);
+    TEST_ASSERT_EQUAL_INT(2, stats->depth);
+    TEST_ASSERT_EQUAL_INT(2, stats->depth_max);
+    TEST_ASSERT_EQUAL_INT(0, stats->overflows);
+    TEST_ASSERT_EQUAL_INT(0, _netif.send_queue.stats[GNRC_NETIF_PKTQ_CLASS_CTRL].enqueued);
+}
+
 static Test *test_gnrc_netif_pktq(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -144,6 +371,14 @@ static Test *test_gnrc_netif_pktq(void)
         new_TestFixture(test_pktq_push_back_get1),
         new_TestFixture(test_pktq_push_back_get3),
         new_TestFixture(test_pktq_empty),
+        new_TestFixture(test_pktq_classify__undef),
+        new_TestFixture(test_pktq_classify__ipv6),
+        new_TestFixture(test_pktq_classify__iphc),
+        new_TestFixture(test_pktq_put_get__classes),
+        new_TestFixture(test_pktq_push_back__class),
+        new_TestFixture(test_pktq_put__evict),
+        new_TestFixture(test_pktq_get__codel),
+        new_TestFixture(test_pktq_stats),
     };
 
     EMB_UNIT_TESTCALLER(pktq_tests, set_up, NULL, fixtures);
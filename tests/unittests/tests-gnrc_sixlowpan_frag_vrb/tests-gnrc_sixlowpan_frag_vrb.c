@@ -143,6 +143,53 @@ static void test_vrb_get__after_add(void)
     TEST_ASSERT(res1 == res2);
 }
 
+static void test_vrb_get__many(void)
+{
+    gnrc_sixlowpan_frag_rb_base_t base = _base;
+    gnrc_sixlowpan_frag_vrb_t *res[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+
+    /* entries from different sources with the same tags end up in different
+     * buckets of the hash index or in the same chain */
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        base.src[0] = i & 1;
+        base.tag = TEST_TAG + (i / 2);
+        TEST_ASSERT_NOT_NULL((res[i] = gnrc_sixlowpan_frag_vrb_add(
+                &base, &_dummy_netif, _out_dst, sizeof(_out_dst)
+            )));
+    }
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        base.src[0] = i & 1;
+        base.tag = TEST_TAG + (i / 2);
+        TEST_ASSERT(res[i] == gnrc_sixlowpan_frag_vrb_get(base.src,
+                                                          base.src_len,
+                                                          base.tag));
+    }
+}
+
+static void test_vrb_get__reused_entry(void)
+{
+    gnrc_sixlowpan_frag_rb_base_t base = _base;
+    gnrc_sixlowpan_frag_vrb_t *res1, *res2;
+
+    TEST_ASSERT_NOT_NULL((res1 = gnrc_sixlowpan_frag_vrb_add(&base,
+                                                             &_dummy_netif,
+                                                             _out_dst,
+                                                             sizeof(_out_dst))));
+    gnrc_sixlowpan_frag_vrb_rm(res1);
+    base.tag++;
+    /* the entry is reused for the new datagram and has to be found under its
+     * new index */
+    TEST_ASSERT_NOT_NULL((res2 = gnrc_sixlowpan_frag_vrb_add(&base,
+                                                             &_dummy_netif,
+                                                             _out_dst,
+                                                             sizeof(_out_dst))));
+    TEST_ASSERT(res1 == res2);
+    TEST_ASSERT(res2 == gnrc_sixlowpan_frag_vrb_get(base.src, base.src_len,
+                                                    base.tag));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_base.src, _base.src_len,
+                                                 _base.tag));
+}
+
 static void test_vrb_rm(void)
 {
     gnrc_sixlowpan_frag_vrb_t *res;
@@ -179,6 +226,8 @@ static Test *tests_gnrc_sixlowpan_frag_vrb_tests(void)
         new_TestFixture(test_vrb_add__full),
         new_TestFixture(test_vrb_get__empty),
         new_TestFixture(test_vrb_get__after_add),
+        new_TestFixture(test_vrb_get__many),
+        new_TestFixture(test_vrb_get__reused_entry),
         new_TestFixture(test_vrb_rm),
         new_TestFixture(test_vrb_gc),
     };
@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/nanocoap.h"
+#include "net/nanocoap/cache.h"
+
+#include "tests-nanocoap_cache.h"
+
+#define _BUF_SIZE (128U)
+
+static const uint8_t _etag[] = { 0xde, 0xad, 0xbe, 0xef };
+
+static size_t _req(coap_pkt_t *pkt, uint8_t *buf, unsigned code,
+                   const char *path)
+{
+    uint8_t token[2] = { 0xda, 0xec };
+    ssize_t len = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON, token,
+                                 sizeof(token), code, 1);
+
+    coap_pkt_init(pkt, buf, _BUF_SIZE, len);
+    coap_opt_add_string(pkt, COAP_OPT_URI_PATH, path, '/');
+    return coap_opt_finish(pkt, COAP_OPT_FINISH_NONE);
+}
+
+static size_t _resp(coap_pkt_t *pkt, uint8_t *buf, size_t buf_len,
+                    unsigned code, const uint8_t *etag, size_t etag_len,
+                    uint32_t max_age, size_t payload_len)
+{
+    ssize_t len = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON, NULL, 0,
+                                 code, 1);
+
+    coap_pkt_init(pkt, buf, buf_len, len);
+    if (etag_len > 0) {
+        coap_opt_add_opaque(pkt, COAP_OPT_ETAG, etag, etag_len);
+    }
+    coap_opt_add_uint(pkt, COAP_OPT_MAX_AGE, max_age);
+    if (payload_len == 0) {
+        return coap_opt_finish(pkt, COAP_OPT_FINISH_NONE);
+    }
+    len = coap_opt_finish(pkt, COAP_OPT_FINISH_PAYLOAD);
+    memset(pkt->payload, 'x', payload_len);
+    pkt->payload_len = payload_len;
+    return len + payload_len;
+}
+
+static void _key(uint8_t *key, const char *path)
+{
+    uint8_t buf[_BUF_SIZE];
+    coap_pkt_t pkt;
+
+    _req(&pkt, buf, COAP_METHOD_GET, path);
+    nanocoap_cache_key_generate(&pkt, NULL, 0, key);
+}
+
+static void _store(const uint8_t *key, uint32_t max_age, uint32_t now)
+{
+    uint8_t buf[_BUF_SIZE];
+    coap_pkt_t pkt;
+    size_t len = _resp(&pkt, buf, sizeof(buf), COAP_CODE_CONTENT, NULL, 0,
+                       max_age, 4);
+
+    TEST_ASSERT_NOT_NULL(nanocoap_cache_process(key, COAP_METHOD_GET, &pkt,
+                                                len, now));
+}
+
+static void set_up(void)
+{
+    nanocoap_cache_init();
+}
+
+static void test_nanocoap_cache__key(void)
+{
+    uint8_t buf[_BUF_SIZE];
+    coap_pkt_t pkt;
+    uint8_t key1[CONFIG_NANOCOAP_CACHE_KEY_LENGTH];
+    uint8_t key2[CONFIG_NANOCOAP_CACHE_KEY_LENGTH];
+    const char ctx[] = "server";
+
+    _key(key1, "/sensors/temp");
+    _key(key2, "/sensors/temp");
+    TEST_ASSERT_EQUAL_INT(0, memcmp(key1, key2, sizeof(key1)));
+
+    /* path segments are keyed separately */
+    _key(key2, "/sensors/tem/p");
+    TEST_ASSERT(memcmp(key1, key2, sizeof(key1)) != 0);
+
+    /* other method */
+    _req(&pkt, buf, COAP_METHOD_PUT, "/sensors/temp");
+    nanocoap_cache_key_generate(&pkt, NULL, 0, key2);
+    TEST_ASSERT(memcmp(key1, key2, sizeof(key1)) != 0);
+
+    /* ETag is not part of the key, the context is */
+    _req(&pkt, buf, COAP_METHOD_GET, "/sensors/temp");
+    coap_pkt_init(&pkt, buf, _BUF_SIZE, coap_get_total_hdr_len(&pkt));
+    coap_opt_add_opaque(&pkt, COAP_OPT_ETAG, _etag, sizeof(_etag));
+    coap_opt_add_string(&pkt, COAP_OPT_URI_PATH, "/sensors/temp", '/');
+    nanocoap_cache_key_generate(&pkt, NULL, 0, key2);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(key1, key2, sizeof(key1)));
+    nanocoap_cache_key_generate(&pkt, ctx, sizeof(ctx), key2);
+    TEST_ASSERT(memcmp(key1, key2, sizeof(key1)) != 0);
+}
+
+static void test_nanocoap_cache__store_lookup(void)
+{
+    uint8_t key[CONFIG_NANOCOAP_CACHE_KEY_LENGTH];
+    uint8_t etag[COAP_ETAG_LENGTH_MAX];
+    nanocoap_cache_entry_t *ce;
+    nanocoap_cache_stats_t stats;
+
+    _key(key, "/time");
+    TEST_ASSERT_NULL(nanocoap_cache_key_lookup(key, 0));
+    _store(key, 10, 1000);
+
+    ce = nanocoap_cache_key_lookup(key, 6500);
+    TEST_ASSERT_NOT_NULL(ce);
+    TEST_ASSERT(!nanocoap_cache_entry_is_stale(ce, 6500));
+    TEST_ASSERT_EQUAL_INT(4, nanocoap_cache_entry_max_age(ce, 6500));
+    TEST_ASSERT_EQUAL_INT(0, nanocoap_cache_entry_get_etag(ce, etag));
+
+    ce = nanocoap_cache_key_lookup(key, 11000);
+    TEST_ASSERT_NOT_NULL(ce);
+    TEST_ASSERT(nanocoap_cache_entry_is_stale(ce, 11000));
+    TEST_ASSERT_EQUAL_INT(0, nanocoap_cache_entry_max_age(ce, 11000));
+
+    nanocoap_cache_stats_get(&stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.hits);
+    TEST_ASSERT_EQUAL_INT(2, stats.misses);
+}
+
+static void test_nanocoap_cache__validate(void)
+{
+    uint8_t key[CONFIG_NANOCOAP_CACHE_KEY_LENGTH];
+    uint8_t etag[COAP_ETAG_LENGTH_MAX];
+    uint8_t buf[_BUF_SIZE];
+    coap_pkt_t pkt;
+    nanocoap_cache_entry_t *ce;
+    nanocoap_cache_stats_t stats;
+    size_t len;
+
+    _key(key, "/time");
+    len = _resp(&pkt, buf, sizeof(buf), COAP_CODE_CONTENT, _etag, sizeof(_etag),
+                1, 4);
+    TEST_ASSERT_NOT_NULL(nanocoap_cache_process(key, COAP_METHOD_GET, &pkt,
+                                                len, 0));
+    ce = nanocoap_cache_key_lookup(key, 2000);
+    TEST_ASSERT(nanocoap_cache_entry_is_stale(ce, 2000));
+    TEST_ASSERT_EQUAL_INT(sizeof(_etag),
+                          nanocoap_cache_entry_get_etag(ce, etag));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(etag, _etag, sizeof(_etag)));
+
+    len = _resp(&pkt, buf, sizeof(buf), COAP_CODE_VALID, _etag, sizeof(_etag),
+                5, 0);
+    TEST_ASSERT(ce == nanocoap_cache_process(key, COAP_METHOD_GET, &pkt,
+                                             len, 2000));
+    TEST_ASSERT(!nanocoap_cache_entry_is_stale(ce, 6000));
+    /* the stored response is kept */
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_CONTENT,
+                          ((coap_hdr_t *)ce->response_buf)->code);
+
+    nanocoap_cache_stats_get(&stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.validations);
+
+    /* any other response removes the entry */
+    len = _resp(&pkt, buf, sizeof(buf), COAP_CODE_404, NULL, 0, 5, 0);
+    TEST_ASSERT_NULL(nanocoap_cache_process(key, COAP_METHOD_GET, &pkt,
+                                            len, 3000));
+    TEST_ASSERT_NULL(nanocoap_cache_key_lookup(key, 3000));
+}
+
+static void test_nanocoap_cache__not_cacheable(void)
+{
+    uint8_t key[CONFIG_NANOCOAP_CACHE_KEY_LENGTH];
+    uint8_t buf[CONFIG_NANOCOAP_CACHE_RESPONSE_SIZE + 16];
+    coap_pkt_t pkt;
+    size_t len;
+
+    _key(key, "/large");
+    len = _resp(&pkt, buf, sizeof(buf), COAP_CODE_CONTENT, NULL, 0, 60,
+                CONFIG_NANOCOAP_CACHE_RESPONSE_SIZE);
+    TEST_ASSERT_NULL(nanocoap_cache_process(key, COAP_METHOD_GET, &pkt,
+                                            len, 0));
+    len = _resp(&pkt, buf, sizeof(buf), COAP_CODE_CONTENT, NULL, 0, 60, 4);
+    TEST_ASSERT_NULL(nanocoap_cache_process(key, COAP_METHOD_POST, &pkt,
+                                            len, 0));
+    TEST_ASSERT_NULL(nanocoap_cache_key_lookup(key, 0));
+}
+
+static void test_nanocoap_cache__lru(void)
+{
+    uint8_t key[CONFIG_NANOCOAP_CACHE_ENTRIES + 1][CONFIG_NANOCOAP_CACHE_KEY_LENGTH];
+    nanocoap_cache_stats_t stats;
+    char path[8];
+
+    for (unsigned i = 0; i <= CONFIG_NANOCOAP_CACHE_ENTRIES; i++) {
+        path[0] = '/';
+        path[1] = 'a' + i;
+        path[2] = '\0';
+        _key(key[i], path);
+    }
+    for (unsigned i = 0; i < CONFIG_NANOCOAP_CACHE_ENTRIES; i++) {
+        _store(key[i], 60, 0);
+    }
+    /* the first entry is used again, the second is the oldest then */
+    TEST_ASSERT_NOT_NULL(nanocoap_cache_key_lookup(key[0], 0));
+    _store(key[CONFIG_NANOCOAP_CACHE_ENTRIES], 60, 0);
+
+    TEST_ASSERT_NOT_NULL(nanocoap_cache_key_lookup(key[0], 0));
+    TEST_ASSERT_NULL(nanocoap_cache_key_lookup(key[1], 0));
+    for (unsigned i = 2; i <= CONFIG_NANOCOAP_CACHE_ENTRIES; i++) {
+        TEST_ASSERT_NOT_NULL(nanocoap_cache_key_lookup(key[i], 0));
+    }
+    nanocoap_cache_stats_get(&stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.evictions);
+}
+
+Test *tests_nanocoap_cache_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_nanocoap_cache__key),
+        new_TestFixture(test_nanocoap_cache__store_lookup),
+        new_TestFixture(test_nanocoap_cache__validate),
+        new_TestFixture(test_nanocoap_cache__not_cacheable),
+        new_TestFixture(test_nanocoap_cache__lru),
+    };
+
+    EMB_UNIT_TESTCALLER(nanocoap_cache_tests, set_up, NULL, fixtures);
+
+    return (Test *)&nanocoap_cache_tests;
+}
+
+void tests_nanocoap_cache(void)
+{
+    TESTS_RUN(tests_nanocoap_cache_tests());
+}
+/** @} */
@@ -139,6 +139,33 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+void test_netreg_getnext__interleaved(void)
+{
+    gnrc_netreg_entry_t other[] = {
+        GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16 + 1, TEST_UINT8),
+        GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL, TEST_UINT8),
+    };
+    gnrc_netreg_entry_t *res = NULL;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &other[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &other[1]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[1]));
+    TEST_ASSERT_EQUAL_INT(2, gnrc_netreg_lookup_all(GNRC_NETTYPE_TEST, TEST_UINT16, &res));
+    TEST_ASSERT(res == &entries[1]);
+    TEST_ASSERT((res = gnrc_netreg_getnext(res)) == &entries[0]);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_lookup_all(GNRC_NETTYPE_TEST, TEST_UINT16 + 1, &res));
+    TEST_ASSERT(res == &other[0]);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_lookup_all(GNRC_NETTYPE_TEST,
+                                                    GNRC_NETREG_DEMUX_CTX_ALL, &res));
+    TEST_ASSERT(res == &other[1]);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_lookup_all(GNRC_NETTYPE_TEST, TEST_UINT16 + 2, &res));
+    TEST_ASSERT_NULL(res);
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &other[0]);
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &other[1]);
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -155,6 +182,7 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__2_entries),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
+        new_TestFixture(test_netreg_getnext__interleaved),
     };
 
     EMB_UNIT_TESTCALLER(netreg_tests, set_up, NULL, fixtures);
@@ -13,7 +13,9 @@
  * @file
  */
 #include <errno.h>
+#include <inttypes.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <sys/uio.h>
 
 #include "embUnit.h"
@@ -22,9 +24,15 @@
 #include "net/gnrc/pkt.h"
 #include "net/gnrc/pktbuf.h"
 
+#include "ztimer.h"
+
 #include "unittests-constants.h"
 #include "tests-pktbuf.h"
 
+#ifdef MODULE_GNRC_PKTBUF_SEGFIT
+#include "pktbuf_segfit.h"
+#endif
+
 typedef struct __attribute__((packed)) {
     uint8_t u8;
     uint16_t u16;
@@ -813,7 +821,8 @@ static void test_pktbuf_start_write__pkt_users_2(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
-#ifndef MODULE_GNRC_PKTBUF_MALLOC
+/* slab pages of gnrc_pktbuf_segfit keep space that the huge packet needs */
+#if !defined(MODULE_GNRC_PKTBUF_MALLOC) && !defined(MODULE_GNRC_PKTBUF_SEGFIT)
 static void test_pktbuf_reverse_snips__too_full(void)
 {
     gnrc_pktsnip_t *pkt, *pkt_next, *pkt_huge;
@@ -835,7 +844,7 @@ static void test_pktbuf_reverse_snips__too_full(void)
     gnrc_pktbuf_release(pkt_next);
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
-#endif /* MODULE_GNRC_PKTBUF_MALLOC */
+#endif /* !MODULE_GNRC_PKTBUF_MALLOC && !MODULE_GNRC_PKTBUF_SEGFIT */
 
 static void test_pktbuf_reverse_snips__success(void)
 {
@@ -852,6 +861,88 @@ static void test_pktbuf_reverse_snips__success(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
+#define STRESS_PKTS_NUMOF   (24U)
+#define STRESS_ROUNDS       (20000U)
+#define STRESS_FRAG_SIZE    (100U)      /* a 6LoWPAN fragment */
+#define STRESS_HDR_SIZE     (40U)       /* an IPv6 header */
+#define STRESS_MTU          (1280U)
+
+static uint32_t _stress_rand(uint32_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+/*
+ * Allocates and releases fragment-sized and full-MTU packets in a
+ * deterministic random order.
+ * Expected result: the packet buffer stays sane and is empty in the end. The
+ * failure rate and the time for all allocations and releases are printed, so
+ * the packet buffer implementations can be compared.
+ */
+static void test_pktbuf__stress(void)
+{
+    gnrc_pktsnip_t *pkts[STRESS_PKTS_NUMOF] = { NULL };
+    uint32_t state = 0x6c0ff1e5, time = 0;
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+    unsigned allocs = 0, frees = 0, failed = 0;
+
+    for (unsigned round = 0; round < STRESS_ROUNDS; round++) {
+        uint32_t r = _stress_rand(&state);
+        unsigned idx = r % STRESS_PKTS_NUMOF;
+
+        if ((round % 256) == 0) {
+            /* the sanity check is not timed */
+            time += ztimer_now(ZTIMER_USEC) - start;
+            TEST_ASSERT(gnrc_pktbuf_is_sane());
+            start = ztimer_now(ZTIMER_USEC);
+        }
+        if (pkts[idx] != NULL) {
+            gnrc_pktbuf_release(pkts[idx]);
+            pkts[idx] = NULL;
+            frees++;
+            continue;
+        }
+        /* 3 out of 4 packets are fragments, with varying length */
+        size_t size = ((r >> 8) & 0x3) ? (STRESS_FRAG_SIZE - ((r >> 10) & 0x1f))
+                                       : STRESS_MTU;
+
+        pkts[idx] = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_UNDEF);
+        if ((pkts[idx] != NULL) && ((r >> 16) & 0x1)) {
+            gnrc_pktsnip_t *hdr = gnrc_pktbuf_add(pkts[idx], NULL, STRESS_HDR_SIZE,
+                                                  GNRC_NETTYPE_UNDEF);
+
+            if (hdr == NULL) {
+                gnrc_pktbuf_release(pkts[idx]);
+            }
+            pkts[idx] = hdr;
+        }
+        allocs++;
+        if (pkts[idx] == NULL) {
+            failed++;
+        }
+    }
+    time += ztimer_now(ZTIMER_USEC) - start;
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+#ifdef MODULE_GNRC_PKTBUF_SEGFIT
+    gnrc_pktbuf_segfit_stats_t stats;
+
+    gnrc_pktbuf_segfit_get_stats(&stats);
+    printf("\npktbuf stress: max used: %u bytes, free: %u bytes in %u blocks "
+           "(largest: %u bytes)", stats.max_used, stats.free,
+           stats.free_blocks, stats.largest_free);
+#endif
+    for (unsigned i = 0; i < STRESS_PKTS_NUMOF; i++) {
+        gnrc_pktbuf_release(pkts[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    printf("\npktbuf stress: %u/%u allocations failed (%u%%), "
+           "%u allocations and %u releases took %" PRIu32 " us\n",
+           failed, allocs, (failed * 100U) / allocs, allocs, frees, time);
+}
+
 Test *tests_pktbuf_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -906,10 +997,11 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_start_write__NULL),
         new_TestFixture(test_pktbuf_start_write__pkt_users_1),
         new_TestFixture(test_pktbuf_start_write__pkt_users_2),
-#ifndef MODULE_GNRC_PKTBUF_MALLOC
+#if !defined(MODULE_GNRC_PKTBUF_MALLOC) && !defined(MODULE_GNRC_PKTBUF_SEGFIT)
         new_TestFixture(test_pktbuf_reverse_snips__too_full),
-#endif /* MODULE_GNRC_PKTBUF_MALLOC */
+#endif /* !MODULE_GNRC_PKTBUF_MALLOC && !MODULE_GNRC_PKTBUF_SEGFIT */
         new_TestFixture(test_pktbuf_reverse_snips__success),
+        new_TestFixture(test_pktbuf__stress),
     };
 
     EMB_UNIT_TESTCALLER(gnrc_pktbuf_tests, set_up, NULL, fixtures);
@@ -213,6 +213,83 @@ static void test_add(void)
     }
 }
 
+static void test_add_get_wrap(void)
+{
+    for (int i = 0; i < (int)sizeof(_io_buffer); i++) {
+        _io_buffer[i] = TEST_INPUT + i;
+    }
+    /* move the read and write positions to the middle of the buffer */
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE / 2, tsrb_add(&_tsrb, _io_buffer,
+                                                    BUFFER_SIZE / 2));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE / 2, tsrb_drop(&_tsrb, BUFFER_SIZE));
+    /* this wraps around the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_add(&_tsrb, _io_buffer,
+                                                sizeof(_io_buffer)));
+    memset(&_io_buffer[BUFFER_SIZE], IO_BUFFER_CANARY, BUFFER_SIZE);
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_peek(&_tsrb,
+                                                 &_io_buffer[BUFFER_SIZE],
+                                                 BUFFER_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_io_buffer, &_io_buffer[BUFFER_SIZE],
+                                    BUFFER_SIZE));
+    memset(&_io_buffer[BUFFER_SIZE], IO_BUFFER_CANARY, BUFFER_SIZE);
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_get(&_tsrb,
+                                                &_io_buffer[BUFFER_SIZE],
+                                                BUFFER_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_io_buffer, &_io_buffer[BUFFER_SIZE],
+                                    BUFFER_SIZE));
+    TEST_ASSERT_EQUAL_INT(1, tsrb_empty(&_tsrb));
+}
+
+static void test_reserve_commit(void)
+{
+    uint8_t *span;
+
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_reserve(&_tsrb, &span));
+    TEST_ASSERT(span == _tsrb_buffer);
+    memset(span, TEST_INPUT, TEST_DROP_NUM);
+    tsrb_commit(&_tsrb, TEST_DROP_NUM);
+    TEST_ASSERT_EQUAL_INT(TEST_DROP_NUM, tsrb_avail(&_tsrb));
+    TEST_ASSERT_EQUAL_INT(TEST_INPUT, tsrb_get_one(&_tsrb));
+
+    /* the span ends at the end of the buffer memory */
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - TEST_DROP_NUM,
+                          tsrb_reserve(&_tsrb, &span));
+    TEST_ASSERT(span == &_tsrb_buffer[TEST_DROP_NUM]);
+    tsrb_commit(&_tsrb, BUFFER_SIZE - TEST_DROP_NUM);
+    /* the remainder wraps around, up to the read position */
+    TEST_ASSERT_EQUAL_INT(1, tsrb_reserve(&_tsrb, &span));
+    TEST_ASSERT(span == _tsrb_buffer);
+    tsrb_commit(&_tsrb, 1);
+    TEST_ASSERT_EQUAL_INT(1, tsrb_full(&_tsrb));
+    TEST_ASSERT_EQUAL_INT(0, tsrb_reserve(&_tsrb, &span));
+}
+
+static void test_peek_span(void)
+{
+    const uint8_t *span;
+
+    TEST_ASSERT_EQUAL_INT(0, tsrb_peek_span(&_tsrb, &span));
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0, tsrb_add_one(&_tsrb, TEST_INPUT + i));
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_DROP_NUM, tsrb_drop(&_tsrb, TEST_DROP_NUM));
+    for (int i = 0; i < (int)TEST_DROP_NUM; i++) {
+        TEST_ASSERT_EQUAL_INT(0, tsrb_add_one(&_tsrb, TEST_INPUT));
+    }
+
+    /* the span ends at the end of the buffer memory */
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - TEST_DROP_NUM,
+                          tsrb_peek_span(&_tsrb, &span));
+    for (int i = 0; i < (int)(BUFFER_SIZE - TEST_DROP_NUM); i++) {
+        TEST_ASSERT_EQUAL_INT((uint8_t)(TEST_INPUT + TEST_DROP_NUM + i),
+                              span[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_avail(&_tsrb));
+    tsrb_drop(&_tsrb, BUFFER_SIZE - TEST_DROP_NUM);
+    TEST_ASSERT_EQUAL_INT(TEST_DROP_NUM, tsrb_peek_span(&_tsrb, &span));
+    TEST_ASSERT(span == _tsrb_buffer);
+}
+
 static Test *tests_tsrb_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -228,6 +305,9 @@ static Test *tests_tsrb_tests(void)
         new_TestFixture(test_drop),
         new_TestFixture(test_add_one),
         new_TestFixture(test_add),
+        new_TestFixture(test_add_get_wrap),
+        new_TestFixture(test_reserve_commit),
+        new_TestFixture(test_peek_span),
     };
 
     EMB_UNIT_TESTCALLER(tsrb_tests, NULL, tear_down, fixtures);
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       ztimer coalescing test application
+ *
+ * Runs periodic timers with jittery periods on ZTIMER_USEC and ZTIMER_MSEC,
+ * first without and then with slack, and compares the number of timer
+ * interrupts.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "kernel_defines.h"
+#include "test_utils/expect.h"
+#include "time_units.h"
+#include "ztimer.h"
+
+#define TIMERS_NUMOF    (8U)
+#define PERIOD_MS       (20U)
+#define JITTER_MS       (10U)
+#define SLACK_MS        (10U)
+#define RUN_MS          (1000U)
+
+typedef struct {
+    ztimer_t timer;
+    ztimer_clock_t *clock;
+    uint32_t ticks_per_ms;
+    uint32_t earliest;
+} workload_timer_t;
+
+static workload_timer_t _timers[TIMERS_NUMOF];
+static uint32_t _slack_ms;
+static bool _running;
+static unsigned _expired;
+static unsigned _early;
+
+static uint32_t _rand(void)
+{
+    /* deterministic, so both runs see the same kind of load */
+    static uint32_t state = 1;
+
+    state = state * 1103515245U + 12345U;
+    return state >> 16;
+}
+
+static void _arm(workload_timer_t *w)
+{
+    uint32_t val = (PERIOD_MS + _rand() % JITTER_MS) * w->ticks_per_ms;
+
+    w->earliest = ztimer_set_slack(w->clock, &w->timer, val,
+                                   _slack_ms * w->ticks_per_ms) + val;
+}
+
+static void _cb(void *arg)
+{
+    workload_timer_t *w = arg;
+    int32_t diff = ztimer_now(w->clock) - w->earliest;
+
+    /* ztimer subtracts adjust_set from every target on purpose */
+    if (diff < -(int32_t)w->clock->adjust_set) {
+        _early++;
+    }
+    _expired++;
+    if (_running) {
+        _arm(w);
+    }
+}
+
+static unsigned _run(uint32_t slack_ms)
+{
+    ztimer_coalesce_stats_t before, after;
+
+    _slack_ms = slack_ms;
+    _expired = 0;
+    _running = true;
+    ztimer_coalesce_stats(&before);
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        _arm(&_timers[i]);
+    }
+    ztimer_sleep(ZTIMER_MSEC, RUN_MS);
+    _running = false;
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        ztimer_remove(_timers[i].clock, &_timers[i].timer);
+    }
+    ztimer_coalesce_stats(&after);
+
+    unsigned wakeups = after.wakeups - before.wakeups;
+    printf("slack %" PRIu32 " ms: %u timers expired, %u wakeups, "
+           "%" PRIu32 " coalesced\n", slack_ms, _expired, wakeups,
+           after.coalesced - before.coalesced);
+    expect(_expired > 0);
+
+    /* wakeups per 100 expired timers */
+    return (100 * wakeups) / _expired;
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        bool usec = (i % 2) == 0;
+        _timers[i] = (workload_timer_t){
+            .timer = { .callback = _cb, .arg = &_timers[i] },
+            .clock = usec ? ZTIMER_USEC : ZTIMER_MSEC,
+            .ticks_per_ms = usec ? US_PER_MS : 1,
+        };
+    }
+
+    unsigned exact = _run(0);
+    unsigned coalesced = _run(SLACK_MS);
+
+    printf("wakeups per 100 timers: %u without slack, %u with slack\n",
+           exact, coalesced);
+    expect(_early == 0);
+    /* with slack, several timers share one interrupt */
+    expect(4 * coalesced < 3 * exact);
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"slack 0 ms: (\d+) timers expired, (\d+) wakeups, 0 coalesced\r\n")
+    child.expect(r"slack (\d+) ms: (\d+) timers expired, (\d+) wakeups, "
+                 r"(\d+) coalesced\r\n")
+    assert int(child.match.group(4)) > 0
+    child.expect(r"wakeups per 100 timers: \d+ without slack, \d+ with slack\r\n")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))